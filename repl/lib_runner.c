@@ -5,13 +5,13 @@
 #include "toy_interpreter.h"
 
 #include "repl_tools.h"
+#include "repl_cache.h"
 
 #include <stdlib.h>
 
 typedef struct Toy_Runner {
 	Toy_Interpreter interpreter;
-	const unsigned char* bytecode;
-	size_t size;
+	Toy_RefBytecode* source; //shared with the interpreter while running, never copied
 
 	bool dirty;
 } Toy_Runner;
@@ -61,7 +61,8 @@ static int nativeLoadScript(Toy_Interpreter* interpreter, Toy_LiteralArray* argu
 		return -1;
 	}
 
-	const unsigned char* bytecode = Toy_compileString(source, &fileSize);
+	//unchanged scripts are only compiled once
+	Toy_RefBytecode* bytecode = Toy_compileCached(source);
 	free((void*)source);
 
 	if (!bytecode) {
@@ -76,10 +77,13 @@ static int nativeLoadScript(Toy_Interpreter* interpreter, Toy_LiteralArray* argu
 	Toy_setInterpreterAssert(&runner->interpreter, interpreter->assertOutput);
 	Toy_setInterpreterError(&runner->interpreter, interpreter->errorOutput);
 	runner->interpreter.hooks = interpreter->hooks;
+	runner->interpreter.profile = interpreter->profile;
+	runner->interpreter.calls = NULL;
+	runner->interpreter.callMemory = interpreter->callMemory;
 	runner->interpreter.scope = NULL;
+	Toy_initLiteralArray(&runner->interpreter.stack);
 	Toy_resetInterpreter(&runner->interpreter);
-	runner->bytecode = bytecode;
-	runner->size = fileSize;
+	runner->source = bytecode;
 	runner->dirty = false;
 
 	//build the opaque object, and push it to the stack
@@ -126,11 +130,10 @@ static int nativeLoadScriptBytecode(Toy_Interpreter* interpreter, Toy_LiteralArr
 	const char* filePath = Toy_toCString(TOY_AS_STRING(filePathLiteral));
 	size_t filePathLength = Toy_lengthRefString(TOY_AS_STRING(filePathLiteral));
 
-	//load the bytecode
-	size_t fileSize = 0;
-	unsigned char* bytecode = (unsigned char*)Toy_readFile(filePath, &fileSize);
+	//map the bytecode, rather than reading it
+	Toy_RefBytecode* source = Toy_mapBinaryFile(filePath);
 
-	if (!bytecode) {
+	if (!source) {
 		interpreter->errorOutput("Failed to load bytecode file\n");
 		return -1;
 	}
@@ -141,10 +144,13 @@ static int nativeLoadScriptBytecode(Toy_Interpreter* interpreter, Toy_LiteralArr
 	Toy_setInterpreterAssert(&runner->interpreter, interpreter->assertOutput);
 	Toy_setInterpreterError(&runner->interpreter, interpreter->errorOutput);
 	runner->interpreter.hooks = interpreter->hooks;
+	runner->interpreter.profile = interpreter->profile;
+	runner->interpreter.calls = NULL;
+	runner->interpreter.callMemory = interpreter->callMemory;
 	runner->interpreter.scope = NULL;
+	Toy_initLiteralArray(&runner->interpreter.stack);
 	Toy_resetInterpreter(&runner->interpreter);
-	runner->bytecode = bytecode;
-	runner->size = fileSize;
+	runner->source = source;
 	runner->dirty = false;
 
 	//build the opaque object, and push it to the stack
@@ -191,10 +197,7 @@ static int nativeRunScript(Toy_Interpreter* interpreter, Toy_LiteralArray* argum
 		return -1;
 	}
 
-	unsigned char* bytecodeCopy = TOY_ALLOCATE(unsigned char, runner->size);
-	memcpy(bytecodeCopy, runner->bytecode, runner->size); //need a COPY of the bytecode, because the interpreter eats it
-
-	Toy_runInterpreter(&runner->interpreter, bytecodeCopy, runner->size);
+	Toy_runInterpreterShared(&runner->interpreter, runner->source);
 	runner->dirty = true;
 
 	//cleanup
@@ -433,7 +436,7 @@ static int nativeFreeScript(Toy_Interpreter* interpreter, Toy_LiteralArray* argu
 	//clear out the runner object
 	runner->interpreter.hooks = NULL;
 	Toy_freeInterpreter(&runner->interpreter);
-	TOY_FREE_ARRAY(unsigned char, runner->bytecode, runner->size);
+	Toy_deleteRefBytecode(runner->source);
 
 	TOY_FREE(Toy_Runner, runner);
 
@@ -1,15 +1,29 @@
 #include "lib_standard.h"
 
 #include "toy_memory.h"
+#include "toy_string_kernels.h"
 
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
-#include <ctype.h>
 
-static int nativeClock(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+//the arguments are borrowed from the caller's stack - taking the last one leaves null in it's place, so it's owned here instead
+static Toy_Literal popArgument(Toy_Literal* arguments, int* count) {
+	if (*count <= 0) {
+		return TOY_TO_NULL_LITERAL;
+	}
+
+	(*count)--;
+
+	Toy_Literal ret = arguments[*count];
+	arguments[*count] = TOY_TO_NULL_LITERAL;
+
+	return ret;
+}
+
+static int nativeClock(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//no arguments
-	if (arguments->count != 0) {
+	if (count != 0) {
 		interpreter->errorOutput("Incorrect number of arguments to clock\n");
 		return -1;
 	}
@@ -32,14 +46,14 @@ static int nativeClock(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments
 	return 1;
 }
 
-static int nativeHash(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
-	if (arguments->count != 1) {
+static int nativeHash(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	if (count != 1) {
 		interpreter->errorOutput("Incorrect number of arguments to hash\n");
 		return -1;
 	}
 
 	//get the self
-	Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
 
 	//parse to value if needed
 	Toy_Literal selfLiteralIdn = selfLiteral;
@@ -62,14 +76,14 @@ static int nativeHash(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments)
 	return 1;
 }
 
-static int nativeAbs(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
-	if (arguments->count != 1) {
+static int nativeAbs(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	if (count != 1) {
 		interpreter->errorOutput("Incorrect number of arguments to abs\n");
 		return -1;
 	}
 
 	//get the self
-	Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
 
 	//parse to value if needed
 	Toy_Literal selfLiteralIdn = selfLiteral;
@@ -105,14 +119,14 @@ static int nativeAbs(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments)
 	return 1;
 }
 
-static int nativeCeil(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
-	if (arguments->count != 1) {
+static int nativeCeil(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	if (count != 1) {
 		interpreter->errorOutput("Incorrect number of arguments to ceil\n");
 		return -1;
 	}
 
 	//get the self
-	Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
 
 	//parse to value if needed
 	Toy_Literal selfLiteralIdn = selfLiteral;
@@ -149,14 +163,14 @@ static int nativeCeil(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments)
 	return 1;
 }
 
-static int nativeFloor(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
-	if (arguments->count != 1) {
+static int nativeFloor(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	if (count != 1) {
 		interpreter->errorOutput("Incorrect number of arguments to floor\n");
 		return -1;
 	}
 
 	//get the self
-	Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
 
 	//parse to value if needed
 	Toy_Literal selfLiteralIdn = selfLiteral;
@@ -193,14 +207,14 @@ static int nativeFloor(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments
 	return 1;
 }
 
-static int nativeMax(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+static int nativeMax(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//return value
 	Toy_Literal resultLiteral = TOY_TO_NULL_LITERAL;
 
 	//iterate over all arguments
 	do {
 		//get the self
-		Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+		Toy_Literal selfLiteral = popArgument(arguments, &count);
 
 		//parse to value if needed
 		Toy_Literal selfLiteralIdn = selfLiteral;
@@ -245,7 +259,7 @@ static int nativeMax(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments)
 			resultLiteral = selfLiteral;
 		}
 	}
-	while (arguments->count > 0);
+	while (count > 0);
 
 	Toy_pushLiteralArray(&interpreter->stack, resultLiteral);
 
@@ -254,14 +268,14 @@ static int nativeMax(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments)
 	return 1;
 }
 
-static int nativeMin(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+static int nativeMin(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//return value
 	Toy_Literal resultLiteral = TOY_TO_NULL_LITERAL;
 
 	//iterate over all arguments
 	do {
 		//get the self
-		Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+		Toy_Literal selfLiteral = popArgument(arguments, &count);
 
 		//parse to value if needed
 		Toy_Literal selfLiteralIdn = selfLiteral;
@@ -306,7 +320,7 @@ static int nativeMin(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments)
 			resultLiteral = selfLiteral;
 		}
 	}
-	while (arguments->count > 0);
+	while (count > 0);
 
 	Toy_pushLiteralArray(&interpreter->stack, resultLiteral);
 
@@ -315,14 +329,14 @@ static int nativeMin(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments)
 	return 1;
 }
 
-static int nativeRound(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
-	if (arguments->count != 1) {
+static int nativeRound(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	if (count != 1) {
 		interpreter->errorOutput("Incorrect number of arguments to round\n");
 		return -1;
 	}
 
 	//get the self
-	Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
 
 	//parse to value if needed
 	Toy_Literal selfLiteralIdn = selfLiteral;
@@ -365,16 +379,16 @@ static int nativeRound(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments
 	return 1;
 }
 
-static int nativeConcat(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+static int nativeConcat(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//no arguments
-	if (arguments->count != 2) {
+	if (count != 2) {
 		interpreter->errorOutput("Incorrect number of arguments to concat\n");
 		return -1;
 	}
 
 	//get the args
-	Toy_Literal otherLiteral = Toy_popLiteralArray(arguments);
-	Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+	Toy_Literal otherLiteral = popArgument(arguments, &count);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
 
 	//parse to value if needed
 	Toy_Literal selfLiteralIdn = selfLiteral;
@@ -460,7 +474,9 @@ static int nativeConcat(Toy_Interpreter* interpreter, Toy_LiteralArray* argument
 
 		//allocate the space and generate
 		char* buffer = TOY_ALLOCATE(char, length);
-		snprintf(buffer, length, "%s%s", Toy_toCString(TOY_AS_STRING(selfLiteral)), Toy_toCString(TOY_AS_STRING(otherLiteral)));
+		memcpy(buffer, Toy_toCString(TOY_AS_STRING(selfLiteral)), TOY_AS_STRING(selfLiteral)->length);
+		memcpy(buffer + TOY_AS_STRING(selfLiteral)->length, Toy_toCString(TOY_AS_STRING(otherLiteral)), TOY_AS_STRING(otherLiteral)->length);
+		buffer[length - 1] = '\0';
 
 		Toy_Literal result = TOY_TO_STRING_LITERAL(Toy_createRefString(buffer));
 
@@ -481,16 +497,16 @@ static int nativeConcat(Toy_Interpreter* interpreter, Toy_LiteralArray* argument
 	return -1;
 }
 
-static int nativeContainsKey(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+static int nativeContainsKey(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//no arguments
-	if (arguments->count != 2) {
+	if (count != 2) {
 		interpreter->errorOutput("Incorrect number of arguments to containsKey\n");
 		return -1;
 	}
 
 	//get the args
-	Toy_Literal keyLiteral = Toy_popLiteralArray(arguments);
-	Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+	Toy_Literal keyLiteral = popArgument(arguments, &count);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
 
 	//parse to value if needed
 	Toy_Literal selfLiteralIdn = selfLiteral;
@@ -532,16 +548,16 @@ static int nativeContainsKey(Toy_Interpreter* interpreter, Toy_LiteralArray* arg
 	return 1;
 }
 
-static int nativeContainsValue(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+static int nativeContainsValue(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//no arguments
-	if (arguments->count != 2) {
+	if (count != 2) {
 		interpreter->errorOutput("Incorrect number of arguments to containsValue\n");
 		return -1;
 	}
 
 	//get the args
-	Toy_Literal valueLiteral = Toy_popLiteralArray(arguments);
-	Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+	Toy_Literal valueLiteral = popArgument(arguments, &count);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
 
 	//parse to value if needed
 	Toy_Literal selfLiteralIdn = selfLiteral;
@@ -608,16 +624,16 @@ static int nativeContainsValue(Toy_Interpreter* interpreter, Toy_LiteralArray* a
 	return 1;
 }
 
-static int nativeEvery(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+static int nativeEvery(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//no arguments
-	if (arguments->count != 2) {
+	if (count != 2) {
 		interpreter->errorOutput("Incorrect number of arguments to every\n");
 		return -1;
 	}
 
 	//get the args
-	Toy_Literal fnLiteral = Toy_popLiteralArray(arguments);
-	Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+	Toy_Literal fnLiteral = popArgument(arguments, &count);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
 
 	//parse to value if needed
 	Toy_Literal selfLiteralIdn = selfLiteral;
@@ -730,16 +746,16 @@ static int nativeEvery(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments
 	return 1;
 }
 
-static int nativeFilter(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+static int nativeFilter(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//no arguments
-	if (arguments->count != 2) {
+	if (count != 2) {
 		interpreter->errorOutput("Incorrect number of arguments to filter\n");
 		return -1;
 	}
 
 	//get the args
-	Toy_Literal fnLiteral = Toy_popLiteralArray(arguments);
-	Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+	Toy_Literal fnLiteral = popArgument(arguments, &count);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
 
 	//parse to value if needed
 	Toy_Literal selfLiteralIdn = selfLiteral;
@@ -850,16 +866,16 @@ static int nativeFilter(Toy_Interpreter* interpreter, Toy_LiteralArray* argument
 	return 1;
 }
 
-static int nativeForEach(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+static int nativeForEach(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//no arguments
-	if (arguments->count != 2) {
+	if (count != 2) {
 		interpreter->errorOutput("Incorrect number of arguments to forEach\n");
 		return -1;
 	}
 
 	//get the args
-	Toy_Literal fnLiteral = Toy_popLiteralArray(arguments);
-	Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+	Toy_Literal fnLiteral = popArgument(arguments, &count);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
 
 	//parse to value if needed
 	Toy_Literal selfLiteralIdn = selfLiteral;
@@ -935,14 +951,14 @@ static int nativeForEach(Toy_Interpreter* interpreter, Toy_LiteralArray* argumen
 	return 0;
 }
 
-static int nativeGetKeys(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
-	if (arguments->count != 1) {
+static int nativeGetKeys(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	if (count != 1) {
 		interpreter->errorOutput("Incorrect number of arguments to getKeys\n");
 		return -1;
 	}
 
 	//get the self
-	Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
 
 	//parse to value if needed
 	Toy_Literal selfLiteralIdn = selfLiteral;
@@ -985,14 +1001,14 @@ static int nativeGetKeys(Toy_Interpreter* interpreter, Toy_LiteralArray* argumen
 	return 1;
 }
 
-static int nativeGetValues(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
-	if (arguments->count != 1) {
+static int nativeGetValues(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	if (count != 1) {
 		interpreter->errorOutput("Incorrect number of arguments to getValues\n");
 		return -1;
 	}
 
 	//get the self
-	Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
 
 	//parse to value if needed
 	Toy_Literal selfLiteralIdn = selfLiteral;
@@ -1035,16 +1051,16 @@ static int nativeGetValues(Toy_Interpreter* interpreter, Toy_LiteralArray* argum
 	return 1;
 }
 
-static int nativeIndexOf(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+static int nativeIndexOf(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//no arguments
-	if (arguments->count != 2) {
+	if (count != 2) {
 		interpreter->errorOutput("Incorrect number of arguments to indexOf\n");
 		return -1;
 	}
 
 	//get the args
-	Toy_Literal valueLiteral = Toy_popLiteralArray(arguments);
-	Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+	Toy_Literal valueLiteral = popArgument(arguments, &count);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
 
 	//parse to value if needed
 	Toy_Literal selfLiteralIdn = selfLiteral;
@@ -1063,6 +1079,20 @@ static int nativeIndexOf(Toy_Interpreter* interpreter, Toy_LiteralArray* argumen
 		return -1;
 	}
 
+	//search the string for the matching substring
+	if (TOY_IS_STRING(selfLiteral) && TOY_IS_STRING(valueLiteral)) {
+		int index = Toy_kernelFind(Toy_toCString(TOY_AS_STRING(selfLiteral)), Toy_lengthRefString(TOY_AS_STRING(selfLiteral)), Toy_toCString(TOY_AS_STRING(valueLiteral)), Toy_lengthRefString(TOY_AS_STRING(valueLiteral)));
+		Toy_Literal resultLiteral = index >= 0 ? TOY_TO_INTEGER_LITERAL(index) : TOY_TO_NULL_LITERAL;
+
+		//return the result and clean up
+		Toy_pushLiteralArray(&interpreter->stack, resultLiteral);
+		Toy_freeLiteral(resultLiteral);
+		Toy_freeLiteral(selfLiteral);
+		Toy_freeLiteral(valueLiteral);
+
+		return 1;
+	}
+
 	//check type
 	if (!TOY_IS_ARRAY(selfLiteral)) {
 		interpreter->errorOutput("Incorrect argument type passed to indexOf\n");
@@ -1084,20 +1114,108 @@ static int nativeIndexOf(Toy_Interpreter* interpreter, Toy_LiteralArray* argumen
 	Toy_pushLiteralArray(&interpreter->stack, resultLiteral);
 	Toy_freeLiteral(resultLiteral);
 	Toy_freeLiteral(selfLiteral);
+	Toy_freeLiteral(valueLiteral);
+
+	return 1;
+}
+
+static int nativeJoin(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	//no arguments
+	if (count != 2) {
+		interpreter->errorOutput("Incorrect number of arguments to join\n");
+		return -1;
+	}
+
+	//get the args
+	Toy_Literal separatorLiteral = popArgument(arguments, &count);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
+
+	//parse to value if needed
+	Toy_Literal selfLiteralIdn = selfLiteral;
+	if (TOY_IS_IDENTIFIER(selfLiteral) && Toy_parseIdentifierToValue(interpreter, &selfLiteral)) {
+		Toy_freeLiteral(selfLiteralIdn);
+	}
+
+	Toy_Literal separatorLiteralIdn = separatorLiteral;
+	if (TOY_IS_IDENTIFIER(separatorLiteral) && Toy_parseIdentifierToValue(interpreter, &separatorLiteral)) {
+		Toy_freeLiteral(separatorLiteralIdn);
+	}
+
+	if (TOY_IS_IDENTIFIER(selfLiteral) || TOY_IS_IDENTIFIER(separatorLiteral)) {
+		Toy_freeLiteral(selfLiteral);
+		Toy_freeLiteral(separatorLiteral);
+		return -1;
+	}
+
+	//check type
+	if (!TOY_IS_ARRAY(selfLiteral) || !TOY_IS_STRING(separatorLiteral)) {
+		interpreter->errorOutput("Incorrect argument type passed to join\n");
+		Toy_freeLiteral(selfLiteral);
+		Toy_freeLiteral(separatorLiteral);
+		return -1;
+	}
+
+	Toy_LiteralArray* self = TOY_AS_ARRAY(selfLiteral);
+	Toy_RefString* separatorRefString = TOY_AS_STRING(separatorLiteral);
+
+	//measure the result first, so it can be built in one pass
+	size_t length = 0;
+	for (int i = 0; i < self->count; i++) {
+		if (!TOY_IS_STRING(self->literals[i])) {
+			interpreter->errorOutput("Incorrect argument type passed to join (expected an array of strings)\n");
+			Toy_freeLiteral(selfLiteral);
+			Toy_freeLiteral(separatorLiteral);
+			return -1;
+		}
+
+		length += Toy_lengthRefString(TOY_AS_STRING(self->literals[i])) + (i > 0 ? Toy_lengthRefString(separatorRefString) : 0);
+	}
+
+	if (length + 1 > TOY_MAX_STRING_LENGTH) {
+		interpreter->errorOutput("Can't join these strings, result is too long (error found in join)\n");
+		Toy_freeLiteral(selfLiteral);
+		Toy_freeLiteral(separatorLiteral);
+		return -1;
+	}
+
+	//copy each piece into place
+	char* buffer = TOY_ALLOCATE(char, length + 1);
+	size_t offset = 0;
+
+	for (int i = 0; i < self->count; i++) {
+		if (i > 0) {
+			memcpy(buffer + offset, Toy_toCString(separatorRefString), Toy_lengthRefString(separatorRefString));
+			offset += Toy_lengthRefString(separatorRefString);
+		}
+
+		memcpy(buffer + offset, Toy_toCString(TOY_AS_STRING(self->literals[i])), Toy_lengthRefString(TOY_AS_STRING(self->literals[i])));
+		offset += Toy_lengthRefString(TOY_AS_STRING(self->literals[i]));
+	}
+	buffer[length] = '\0';
+
+	Toy_Literal resultLiteral = TOY_TO_STRING_LITERAL(Toy_createRefStringLength(buffer, length));
+
+	//return the result and clean up
+	Toy_pushLiteralArray(&interpreter->stack, resultLiteral);
+
+	TOY_FREE_ARRAY(char, buffer, length + 1);
+	Toy_freeLiteral(resultLiteral);
+	Toy_freeLiteral(selfLiteral);
+	Toy_freeLiteral(separatorLiteral);
 
 	return 1;
 }
 
-static int nativeMap(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+static int nativeMap(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//no arguments
-	if (arguments->count != 2) {
+	if (count != 2) {
 		interpreter->errorOutput("Incorrect number of arguments to map\n");
 		return -1;
 	}
 
 	//get the args
-	Toy_Literal fnLiteral = Toy_popLiteralArray(arguments);
-	Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+	Toy_Literal fnLiteral = popArgument(arguments, &count);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
 
 	//parse to value if needed
 	Toy_Literal selfLiteralIdn = selfLiteral;
@@ -1197,17 +1315,17 @@ static int nativeMap(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments)
 	return 0;
 }
 
-static int nativeReduce(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+static int nativeReduce(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//no arguments
-	if (arguments->count != 3) {
+	if (count != 3) {
 		interpreter->errorOutput("Incorrect number of arguments to reduce\n");
 		return -1;
 	}
 
 	//get the args
-	Toy_Literal fnLiteral = Toy_popLiteralArray(arguments);
-	Toy_Literal defaultLiteral = Toy_popLiteralArray(arguments);
-	Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+	Toy_Literal fnLiteral = popArgument(arguments, &count);
+	Toy_Literal defaultLiteral = popArgument(arguments, &count);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
 
 	//parse to value if needed
 	Toy_Literal selfLiteralIdn = selfLiteral;
@@ -1305,16 +1423,128 @@ static int nativeReduce(Toy_Interpreter* interpreter, Toy_LiteralArray* argument
 	return 0;
 }
 
-static int nativeSome(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+static int nativeReplace(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//no arguments
-	if (arguments->count != 2) {
+	if (count != 3) {
+		interpreter->errorOutput("Incorrect number of arguments to replace\n");
+		return -1;
+	}
+
+	//get the args
+	Toy_Literal replacementLiteral = popArgument(arguments, &count);
+	Toy_Literal patternLiteral = popArgument(arguments, &count);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
+
+	//parse to value if needed
+	Toy_Literal selfLiteralIdn = selfLiteral;
+	if (TOY_IS_IDENTIFIER(selfLiteral) && Toy_parseIdentifierToValue(interpreter, &selfLiteral)) {
+		Toy_freeLiteral(selfLiteralIdn);
+	}
+
+	Toy_Literal patternLiteralIdn = patternLiteral;
+	if (TOY_IS_IDENTIFIER(patternLiteral) && Toy_parseIdentifierToValue(interpreter, &patternLiteral)) {
+		Toy_freeLiteral(patternLiteralIdn);
+	}
+
+	Toy_Literal replacementLiteralIdn = replacementLiteral;
+	if (TOY_IS_IDENTIFIER(replacementLiteral) && Toy_parseIdentifierToValue(interpreter, &replacementLiteral)) {
+		Toy_freeLiteral(replacementLiteralIdn);
+	}
+
+	if (TOY_IS_IDENTIFIER(selfLiteral) || TOY_IS_IDENTIFIER(patternLiteral) || TOY_IS_IDENTIFIER(replacementLiteral)) {
+		Toy_freeLiteral(selfLiteral);
+		Toy_freeLiteral(patternLiteral);
+		Toy_freeLiteral(replacementLiteral);
+		return -1;
+	}
+
+	//check type
+	if (!TOY_IS_STRING(selfLiteral) || !TOY_IS_STRING(patternLiteral) || !TOY_IS_STRING(replacementLiteral)) {
+		interpreter->errorOutput("Incorrect argument type passed to replace\n");
+		Toy_freeLiteral(selfLiteral);
+		Toy_freeLiteral(patternLiteral);
+		Toy_freeLiteral(replacementLiteral);
+		return -1;
+	}
+
+	Toy_RefString* selfRefString = TOY_AS_STRING(selfLiteral);
+	Toy_RefString* patternRefString = TOY_AS_STRING(patternLiteral);
+	Toy_RefString* replacementRefString = TOY_AS_STRING(replacementLiteral);
+
+	if (Toy_lengthRefString(patternRefString) == 0) {
+		interpreter->errorOutput("Can't replace an empty pattern (error found in replace)\n");
+		Toy_freeLiteral(selfLiteral);
+		Toy_freeLiteral(patternLiteral);
+		Toy_freeLiteral(replacementLiteral);
+		return -1;
+	}
+
+	//measure the result first, so it can be built in one pass
+	int matches = Toy_kernelCount(Toy_toCString(selfRefString), Toy_lengthRefString(selfRefString), Toy_toCString(patternRefString), Toy_lengthRefString(patternRefString));
+	size_t length = Toy_lengthRefString(selfRefString) - matches * Toy_lengthRefString(patternRefString) + matches * Toy_lengthRefString(replacementRefString);
+
+	if (length + 1 > TOY_MAX_STRING_LENGTH) {
+		interpreter->errorOutput("Can't replace within this string, result is too long (error found in replace)\n");
+		Toy_freeLiteral(selfLiteral);
+		Toy_freeLiteral(patternLiteral);
+		Toy_freeLiteral(replacementLiteral);
+		return -1;
+	}
+
+	//nothing to replace
+	if (matches == 0) {
+		Toy_pushLiteralArray(&interpreter->stack, selfLiteral);
+		Toy_freeLiteral(selfLiteral);
+		Toy_freeLiteral(patternLiteral);
+		Toy_freeLiteral(replacementLiteral);
+		return 1;
+	}
+
+	//copy the unmatched spans and the replacements into place
+	const char* self = Toy_toCString(selfRefString);
+	char* buffer = TOY_ALLOCATE(char, length + 1);
+	size_t selfOffset = 0;
+	size_t bufferOffset = 0;
+
+	for (int i = 0; i < matches; i++) {
+		int found = Toy_kernelFind(self + selfOffset, Toy_lengthRefString(selfRefString) - selfOffset, Toy_toCString(patternRefString), Toy_lengthRefString(patternRefString));
+
+		memcpy(buffer + bufferOffset, self + selfOffset, found);
+		bufferOffset += found;
+
+		memcpy(buffer + bufferOffset, Toy_toCString(replacementRefString), Toy_lengthRefString(replacementRefString));
+		bufferOffset += Toy_lengthRefString(replacementRefString);
+
+		selfOffset += found + Toy_lengthRefString(patternRefString);
+	}
+
+	memcpy(buffer + bufferOffset, self + selfOffset, Toy_lengthRefString(selfRefString) - selfOffset);
+	buffer[length] = '\0';
+
+	Toy_Literal resultLiteral = TOY_TO_STRING_LITERAL(Toy_createRefStringLength(buffer, length));
+
+	//return the result and clean up
+	Toy_pushLiteralArray(&interpreter->stack, resultLiteral);
+
+	TOY_FREE_ARRAY(char, buffer, length + 1);
+	Toy_freeLiteral(resultLiteral);
+	Toy_freeLiteral(selfLiteral);
+	Toy_freeLiteral(patternLiteral);
+	Toy_freeLiteral(replacementLiteral);
+
+	return 1;
+}
+
+static int nativeSome(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	//no arguments
+	if (count != 2) {
 		interpreter->errorOutput("Incorrect number of arguments to some\n");
 		return -1;
 	}
 
 	//get the args
-	Toy_Literal fnLiteral = Toy_popLiteralArray(arguments);
-	Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+	Toy_Literal fnLiteral = popArgument(arguments, &count);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
 
 	//parse to value if needed
 	Toy_Literal selfLiteralIdn = selfLiteral;
@@ -1475,16 +1705,16 @@ static void recursiveLiteralQuicksortUtil(Toy_Interpreter* interpreter, Toy_Lite
 	recursiveLiteralQuicksortUtil(interpreter, &ptr[runner + 1], literalCount - runner - 1, fnCompareLiteral);
 }
 
-static int nativeSort(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+static int nativeSort(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//no arguments
-	if (arguments->count != 2) {
+	if (count != 2) {
 		interpreter->errorOutput("Incorrect number of arguments to sort\n");
 		return -1;
 	}
 
 	//get the args
-	Toy_Literal fnLiteral = Toy_popLiteralArray(arguments);
-	Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+	Toy_Literal fnLiteral = popArgument(arguments, &count);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
 
 	//parse to value if needed
 	Toy_Literal selfLiteralIdn = selfLiteral;
@@ -1524,125 +1754,141 @@ static int nativeSort(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments)
 	return 1;
 }
 
-static int nativeToLower(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+static int nativeSplit(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//no arguments
-	if (arguments->count != 1) {
-		interpreter->errorOutput("Incorrect number of arguments to toLower\n");
+	if (count != 2) {
+		interpreter->errorOutput("Incorrect number of arguments to split\n");
 		return -1;
 	}
 
-	//get the argument to a C-string
-	Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+	//get the args
+	Toy_Literal separatorLiteral = popArgument(arguments, &count);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
 
+	//parse to value if needed
 	Toy_Literal selfLiteralIdn = selfLiteral;
 	if (TOY_IS_IDENTIFIER(selfLiteral) && Toy_parseIdentifierToValue(interpreter, &selfLiteral)) {
 		Toy_freeLiteral(selfLiteralIdn);
 	}
 
-	if (TOY_IS_IDENTIFIER(selfLiteral)) {
+	Toy_Literal separatorLiteralIdn = separatorLiteral;
+	if (TOY_IS_IDENTIFIER(separatorLiteral) && Toy_parseIdentifierToValue(interpreter, &separatorLiteral)) {
+		Toy_freeLiteral(separatorLiteralIdn);
+	}
+
+	if (TOY_IS_IDENTIFIER(selfLiteral) || TOY_IS_IDENTIFIER(separatorLiteral)) {
 		Toy_freeLiteral(selfLiteral);
+		Toy_freeLiteral(separatorLiteral);
 		return -1;
 	}
 
-	if (!TOY_IS_STRING(selfLiteral)) {
-		interpreter->errorOutput("Incorrect argument type passed to toLower\n");
+	//check type
+	if (!TOY_IS_STRING(selfLiteral) || !TOY_IS_STRING(separatorLiteral)) {
+		interpreter->errorOutput("Incorrect argument type passed to split\n");
 		Toy_freeLiteral(selfLiteral);
+		Toy_freeLiteral(separatorLiteral);
 		return -1;
 	}
 
-	Toy_RefString* selfRefString = TOY_AS_STRING(selfLiteral);
-	const char* self = Toy_toCString(selfRefString);
+	const char* self = Toy_toCString(TOY_AS_STRING(selfLiteral));
+	size_t selfLength = Toy_lengthRefString(TOY_AS_STRING(selfLiteral));
+	const char* separator = Toy_toCString(TOY_AS_STRING(separatorLiteral));
+	size_t separatorLength = Toy_lengthRefString(TOY_AS_STRING(separatorLiteral));
 
-	//allocate buffer space for the result
-	char* result = TOY_ALLOCATE(char, Toy_lengthRefString(selfRefString) + 1);
+	Toy_LiteralArray* result = TOY_ALLOCATE(Toy_LiteralArray, 1);
+	Toy_initLiteralArray(result);
 
-	//set each new character
-	for (int i = 0; i < (int)Toy_lengthRefString(selfRefString); i++) {
-		result[i] = tolower(self[i]);
-	}
-	result[Toy_lengthRefString(selfRefString)] = '\0'; //end the string
+	//each piece is created straight from the source string
+	size_t offset = 0;
+	while (offset < selfLength || (offset == selfLength && separatorLength > 0)) {
+		int found = separatorLength > 0 ? Toy_kernelFind(self + offset, selfLength - offset, separator, separatorLength) : 1; //an empty separator splits every character
 
-	//wrap up and push the new result onto the stack
-	Toy_RefString* resultRefString = Toy_createRefStringLength(result, Toy_lengthRefString(selfRefString)); //internal copy
-	Toy_Literal resultLiteral = TOY_TO_STRING_LITERAL(resultRefString); //NO copy
+		size_t pieceLength = found >= 0 ? (size_t)found : selfLength - offset;
 
-	Toy_pushLiteralArray(&interpreter->stack, resultLiteral); //internal copy
+		Toy_Literal pieceLiteral = TOY_TO_STRING_LITERAL(Toy_createRefStringLength(self + offset, pieceLength));
+		Toy_pushLiteralArray(result, pieceLiteral);
+		Toy_freeLiteral(pieceLiteral);
 
-	//cleanup
-	TOY_FREE_ARRAY(char, result, Toy_lengthRefString(resultRefString) + 1);
-	Toy_freeLiteral(resultLiteral);
-	Toy_freeLiteral(selfLiteral);
+		if (found < 0) {
+			break;
+		}
 
-	return 1;
-}
+		offset += pieceLength + separatorLength;
+	}
 
-static char* toStringUtilObject = NULL;
-static void toStringUtil(const char* input) {
-	size_t len = strlen(input) + 1;
+	Toy_Literal resultLiteral = TOY_TO_ARRAY_LITERAL(result);
 
-	if (len > TOY_MAX_STRING_LENGTH) {
-		len = TOY_MAX_STRING_LENGTH; //TODO: don't truncate
-	}
+	//return the result and clean up
+	Toy_pushLiteralArray(&interpreter->stack, resultLiteral);
 
-	toStringUtilObject = TOY_ALLOCATE(char, len);
+	Toy_freeLiteral(resultLiteral);
+	Toy_freeLiteral(selfLiteral);
+	Toy_freeLiteral(separatorLiteral);
 
-	snprintf(toStringUtilObject, len, "%s", input);
+	return 1;
 }
 
-static int nativeToString(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+static int nativeStartsWith(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//no arguments
-	if (arguments->count != 1) {
-		interpreter->errorOutput("Incorrect number of arguments to toString\n");
+	if (count != 2) {
+		interpreter->errorOutput("Incorrect number of arguments to startsWith\n");
 		return -1;
 	}
 
-	//get the argument
-	Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+	//get the args
+	Toy_Literal prefixLiteral = popArgument(arguments, &count);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
 
-	//parse to a value
+	//parse to value if needed
 	Toy_Literal selfLiteralIdn = selfLiteral;
 	if (TOY_IS_IDENTIFIER(selfLiteral) && Toy_parseIdentifierToValue(interpreter, &selfLiteral)) {
 		Toy_freeLiteral(selfLiteralIdn);
 	}
 
-	if (TOY_IS_IDENTIFIER(selfLiteral)) {
+	Toy_Literal prefixLiteralIdn = prefixLiteral;
+	if (TOY_IS_IDENTIFIER(prefixLiteral) && Toy_parseIdentifierToValue(interpreter, &prefixLiteral)) {
+		Toy_freeLiteral(prefixLiteralIdn);
+	}
+
+	if (TOY_IS_IDENTIFIER(selfLiteral) || TOY_IS_IDENTIFIER(prefixLiteral)) {
 		Toy_freeLiteral(selfLiteral);
+		Toy_freeLiteral(prefixLiteral);
 		return -1;
 	}
 
-	//BUGFIX: probably an undefined variable
-	if (TOY_IS_IDENTIFIER(selfLiteral)) {
+	//check type
+	if (!TOY_IS_STRING(selfLiteral) || !TOY_IS_STRING(prefixLiteral)) {
+		interpreter->errorOutput("Incorrect argument type passed to startsWith\n");
 		Toy_freeLiteral(selfLiteral);
+		Toy_freeLiteral(prefixLiteral);
 		return -1;
 	}
 
-	//print it to a custom function
-	Toy_printLiteralCustom(selfLiteral, toStringUtil);
-
-	//create the resulting string and push it
-	Toy_Literal result = TOY_TO_STRING_LITERAL(Toy_createRefString(toStringUtilObject)); //internal copy
+	Toy_RefString* selfRefString = TOY_AS_STRING(selfLiteral);
+	Toy_RefString* prefixRefString = TOY_AS_STRING(prefixLiteral);
 
-	Toy_pushLiteralArray(&interpreter->stack, result);
+	bool result = Toy_lengthRefString(prefixRefString) <= Toy_lengthRefString(selfRefString) && memcmp(Toy_toCString(selfRefString), Toy_toCString(prefixRefString), Toy_lengthRefString(prefixRefString)) == 0;
+	Toy_Literal resultLiteral = TOY_TO_BOOLEAN_LITERAL(result);
 
-	//cleanup
-	TOY_FREE_ARRAY(char, toStringUtilObject, Toy_lengthRefString( TOY_AS_STRING(result) ) + 1);
-	toStringUtilObject = NULL;
+	//return the result and clean up
+	Toy_pushLiteralArray(&interpreter->stack, resultLiteral);
 
-	Toy_freeLiteral(result);
+	Toy_freeLiteral(resultLiteral);
 	Toy_freeLiteral(selfLiteral);
+	Toy_freeLiteral(prefixLiteral);
 
 	return 1;
 }
 
-static int nativeToUpper(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+static int nativeToLower(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//no arguments
-	if (arguments->count != 1) {
-		interpreter->errorOutput("Incorrect number of arguments to toUpper\n");
+	if (count != 1) {
+		interpreter->errorOutput("Incorrect number of arguments to toLower\n");
 		return -1;
 	}
 
 	//get the argument to a C-string
-	Toy_Literal selfLiteral = Toy_popLiteralArray(arguments);
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
 
 	Toy_Literal selfLiteralIdn = selfLiteral;
 	if (TOY_IS_IDENTIFIER(selfLiteral) && Toy_parseIdentifierToValue(interpreter, &selfLiteral)) {
@@ -1655,7 +1901,7 @@ static int nativeToUpper(Toy_Interpreter* interpreter, Toy_LiteralArray* argumen
 	}
 
 	if (!TOY_IS_STRING(selfLiteral)) {
-		interpreter->errorOutput("Incorrect argument type passed to toUpper\n");
+		interpreter->errorOutput("Incorrect argument type passed to toLower\n");
 		Toy_freeLiteral(selfLiteral);
 		return -1;
 	}
@@ -1667,9 +1913,7 @@ static int nativeToUpper(Toy_Interpreter* interpreter, Toy_LiteralArray* argumen
 	char* result = TOY_ALLOCATE(char, Toy_lengthRefString(selfRefString) + 1);
 
 	//set each new character
-	for (int i = 0; i < (int)Toy_lengthRefString(selfRefString); i++) {
-		result[i] = toupper(self[i]);
-	}
+	Toy_kernelToLower(result, self, Toy_lengthRefString(selfRefString));
 	result[Toy_lengthRefString(selfRefString)] = '\0'; //end the string
 
 	//wrap up and push the new result onto the stack
@@ -1686,220 +1930,119 @@ static int nativeToUpper(Toy_Interpreter* interpreter, Toy_LiteralArray* argumen
 	return 1;
 }
 
-static int nativeTrim(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
-	if (arguments->count < 1 || arguments->count > 2) {
-		interpreter->errorOutput("Incorrect number of arguments to trim\n");
-		return -1;
+static char* toStringUtilObject = NULL;
+static void toStringUtil(const char* input) {
+	size_t len = strlen(input) + 1;
+
+	if (len > TOY_MAX_STRING_LENGTH) {
+		len = TOY_MAX_STRING_LENGTH; //TODO: don't truncate
 	}
 
-	//get the arguments
-	Toy_Literal trimCharsLiteral;
-	Toy_Literal selfLiteral;
+	toStringUtilObject = TOY_ALLOCATE(char, len);
 
-	if (arguments->count == 2) {
-		trimCharsLiteral = Toy_popLiteralArray(arguments);
+	snprintf(toStringUtilObject, len, "%s", input);
+}
 
-		Toy_Literal trimCharsLiteralIdn = trimCharsLiteral;
-		if (TOY_IS_IDENTIFIER(trimCharsLiteral) && Toy_parseIdentifierToValue(interpreter, &trimCharsLiteral)) {
-			Toy_freeLiteral(trimCharsLiteralIdn);
-		}
-	}
-	else {
-		trimCharsLiteral = TOY_TO_STRING_LITERAL(Toy_createRefString(" \t\n\r"));
+static int nativeToString(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	//no arguments
+	if (count != 1) {
+		interpreter->errorOutput("Incorrect number of arguments to toString\n");
+		return -1;
 	}
-	selfLiteral = Toy_popLiteralArray(arguments);
 
+	//get the argument
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
+
+	//parse to a value
 	Toy_Literal selfLiteralIdn = selfLiteral;
 	if (TOY_IS_IDENTIFIER(selfLiteral) && Toy_parseIdentifierToValue(interpreter, &selfLiteral)) {
 		Toy_freeLiteral(selfLiteralIdn);
 	}
 
-	if (TOY_IS_IDENTIFIER(selfLiteral) || TOY_IS_IDENTIFIER(trimCharsLiteral)) {
+	if (TOY_IS_IDENTIFIER(selfLiteral)) {
 		Toy_freeLiteral(selfLiteral);
-		Toy_freeLiteral(trimCharsLiteral);
 		return -1;
 	}
 
-	if (!TOY_IS_STRING(selfLiteral) || !TOY_IS_STRING(trimCharsLiteral)) {
-		interpreter->errorOutput("Incorrect argument type passed to trim\n");
-		Toy_freeLiteral(trimCharsLiteral);
+	//BUGFIX: probably an undefined variable
+	if (TOY_IS_IDENTIFIER(selfLiteral)) {
 		Toy_freeLiteral(selfLiteral);
 		return -1;
 	}
 
-	//unwrap the arguments
-	Toy_RefString* trimCharsRefString = TOY_AS_STRING(trimCharsLiteral);
-	Toy_RefString* selfRefString = TOY_AS_STRING(selfLiteral);
-
-	//allocate space for the new string
-	size_t bufferBegin = 0;
-	size_t bufferEnd = Toy_lengthRefString(selfRefString);
-
-	//for each character in self, check it against each character in trimChars - on a fail, go to end
-	for (int i = 0; i < (int)Toy_lengthRefString(selfRefString); i++) {
-		int trimIndex = 0;
-
-		while (trimIndex < (int)Toy_lengthRefString(trimCharsRefString)) {
-			//there is a match - DON'T increment anymore
-			if (Toy_toCString(selfRefString)[i] == Toy_toCString(trimCharsRefString)[trimIndex]) {
-				break;
-			}
-
-			trimIndex++;
-		}
-
-		//if the match is found, increment buffer begin
-		if (trimIndex < (int)Toy_lengthRefString(trimCharsRefString)) {
-			bufferBegin++;
-			continue;
-		}
-		else {
-			break;
-		}
-	}
-
-	//again, from the back
-	for (int i = (int)Toy_lengthRefString(selfRefString); i >= 0; i--) {
-		int trimIndex = 0;
-
-		while (trimIndex < (int)Toy_lengthRefString(trimCharsRefString)) {
-			//there is a match - DON'T increment anymore
-			if (Toy_toCString(selfRefString)[i-1] == Toy_toCString(trimCharsRefString)[trimIndex]) {
-				break;
-			}
-
-			trimIndex++;
-		}
-
-		//if the match is found, increment buffer begin
-		if (trimIndex < (int)Toy_lengthRefString(trimCharsRefString)) {
-			bufferEnd--;
-			continue;
-		}
-		else {
-			break;
-		}
-	}
+	//print it to a custom function
+	Toy_printLiteralCustom(selfLiteral, toStringUtil);
 
-	//generate the result
-	Toy_Literal resultLiteral;
-	if (bufferBegin >= bufferEnd) { //catch errors
-		resultLiteral = TOY_TO_STRING_LITERAL(Toy_createRefString(""));
-	}
-	else {
-		char buffer[TOY_MAX_STRING_LENGTH];
-		snprintf(buffer, bufferEnd - bufferBegin + 1, "%s", &Toy_toCString(selfRefString)[ bufferBegin ]);
-		resultLiteral = TOY_TO_STRING_LITERAL(Toy_createRefString(buffer)); //internal copy
-	}
+	//create the resulting string and push it
+	Toy_Literal result = TOY_TO_STRING_LITERAL(Toy_createRefString(toStringUtilObject)); //internal copy
 
-	//wrap up the buffer and return it
-	Toy_pushLiteralArray(&interpreter->stack, resultLiteral); //internal copy
+	Toy_pushLiteralArray(&interpreter->stack, result);
 
 	//cleanup
-	Toy_freeLiteral(resultLiteral);
-	Toy_freeLiteral(trimCharsLiteral);
+	TOY_FREE_ARRAY(char, toStringUtilObject, Toy_lengthRefString( TOY_AS_STRING(result) ) + 1);
+	toStringUtilObject = NULL;
+
+	Toy_freeLiteral(result);
 	Toy_freeLiteral(selfLiteral);
 
 	return 1;
 }
 
-static int nativeTrimBegin(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
-	if (arguments->count < 1 || arguments->count > 2) {
-		interpreter->errorOutput("Incorrect number of arguments to trimBegin\n");
+static int nativeToUpper(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	//no arguments
+	if (count != 1) {
+		interpreter->errorOutput("Incorrect number of arguments to toUpper\n");
 		return -1;
 	}
 
-	//get the arguments
-	Toy_Literal trimCharsLiteral;
-	Toy_Literal selfLiteral;
-
-	if (arguments->count == 2) {
-		trimCharsLiteral = Toy_popLiteralArray(arguments);
-
-		Toy_Literal trimCharsLiteralIdn = trimCharsLiteral;
-		if (TOY_IS_IDENTIFIER(trimCharsLiteral) && Toy_parseIdentifierToValue(interpreter, &trimCharsLiteral)) {
-			Toy_freeLiteral(trimCharsLiteralIdn);
-		}
-	}
-	else {
-		trimCharsLiteral = TOY_TO_STRING_LITERAL(Toy_createRefString(" \t\n\r"));
-	}
-	selfLiteral = Toy_popLiteralArray(arguments);
+	//get the argument to a C-string
+	Toy_Literal selfLiteral = popArgument(arguments, &count);
 
 	Toy_Literal selfLiteralIdn = selfLiteral;
 	if (TOY_IS_IDENTIFIER(selfLiteral) && Toy_parseIdentifierToValue(interpreter, &selfLiteral)) {
 		Toy_freeLiteral(selfLiteralIdn);
 	}
 
-	if (TOY_IS_IDENTIFIER(selfLiteral) || TOY_IS_IDENTIFIER(trimCharsLiteral)) {
+	if (TOY_IS_IDENTIFIER(selfLiteral)) {
 		Toy_freeLiteral(selfLiteral);
-		Toy_freeLiteral(trimCharsLiteral);
 		return -1;
 	}
 
-	if (!TOY_IS_STRING(selfLiteral) || !TOY_IS_STRING(trimCharsLiteral)) {
-		interpreter->errorOutput("Incorrect argument type passed to trimBegin\n");
-		Toy_freeLiteral(trimCharsLiteral);
+	if (!TOY_IS_STRING(selfLiteral)) {
+		interpreter->errorOutput("Incorrect argument type passed to toUpper\n");
 		Toy_freeLiteral(selfLiteral);
 		return -1;
 	}
 
-	//unwrap the arguments
-	Toy_RefString* trimCharsRefString = TOY_AS_STRING(trimCharsLiteral);
 	Toy_RefString* selfRefString = TOY_AS_STRING(selfLiteral);
+	const char* self = Toy_toCString(selfRefString);
 
-	//allocate space for the new string
-	size_t bufferBegin = 0;
-	size_t bufferEnd = Toy_lengthRefString(selfRefString);
-
-	//for each character in self, check it against each character in trimChars - on a fail, go to end
-	for (int i = 0; i < (int)Toy_lengthRefString(selfRefString); i++) {
-		int trimIndex = 0;
-
-		while (trimIndex < (int)Toy_lengthRefString(trimCharsRefString)) {
-			//there is a match - DON'T increment anymore
-			if (Toy_toCString(selfRefString)[i] == Toy_toCString(trimCharsRefString)[trimIndex]) {
-				break;
-			}
-
-			trimIndex++;
-		}
+	//allocate buffer space for the result
+	char* result = TOY_ALLOCATE(char, Toy_lengthRefString(selfRefString) + 1);
 
-		//if the match is found, increment buffer begin
-		if (trimIndex < (int)Toy_lengthRefString(trimCharsRefString)) {
-			bufferBegin++;
-			continue;
-		}
-		else {
-			break;
-		}
-	}
+	//set each new character
+	Toy_kernelToUpper(result, self, Toy_lengthRefString(selfRefString));
+	result[Toy_lengthRefString(selfRefString)] = '\0'; //end the string
 
-	//generate the result
-	Toy_Literal resultLiteral;
-	if (bufferBegin >= bufferEnd) { //catch errors
-		resultLiteral = TOY_TO_STRING_LITERAL(Toy_createRefString(""));
-	}
-	else {
-		char buffer[TOY_MAX_STRING_LENGTH];
-		snprintf(buffer, bufferEnd - bufferBegin + 1, "%s", &Toy_toCString(selfRefString)[ bufferBegin ]);
-		resultLiteral = TOY_TO_STRING_LITERAL(Toy_createRefString(buffer)); //internal copy
-	}
+	//wrap up and push the new result onto the stack
+	Toy_RefString* resultRefString = Toy_createRefStringLength(result, Toy_lengthRefString(selfRefString)); //internal copy
+	Toy_Literal resultLiteral = TOY_TO_STRING_LITERAL(resultRefString); //NO copy
 
-	//wrap up the buffer and return it
 	Toy_pushLiteralArray(&interpreter->stack, resultLiteral); //internal copy
 
 	//cleanup
+	TOY_FREE_ARRAY(char, result, Toy_lengthRefString(resultRefString) + 1);
 	Toy_freeLiteral(resultLiteral);
-	Toy_freeLiteral(trimCharsLiteral);
 	Toy_freeLiteral(selfLiteral);
 
 	return 1;
 }
 
-static int nativeTrimEnd(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
-	if (arguments->count < 1 || arguments->count > 2) {
-		interpreter->errorOutput("Incorrect number of arguments to trimEnd\n");
+static int trimUtil(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count, bool trimBegin, bool trimEnd, const char* fnName) {
+	if (count < 1 || count > 2) {
+		char buffer[256];
+		snprintf(buffer, 256, "Incorrect number of arguments to %s\n", fnName);
+		interpreter->errorOutput(buffer);
 		return -1;
 	}
 
@@ -1907,8 +2050,8 @@ static int nativeTrimEnd(Toy_Interpreter* interpreter, Toy_LiteralArray* argumen
 	Toy_Literal trimCharsLiteral;
 	Toy_Literal selfLiteral;
 
-	if (arguments->count == 2) {
-		trimCharsLiteral = Toy_popLiteralArray(arguments);
+	if (count == 2) {
+		trimCharsLiteral = popArgument(arguments, &count);
 
 		Toy_Literal trimCharsLiteralIdn = trimCharsLiteral;
 		if (TOY_IS_IDENTIFIER(trimCharsLiteral) && Toy_parseIdentifierToValue(interpreter, &trimCharsLiteral)) {
@@ -1918,7 +2061,7 @@ static int nativeTrimEnd(Toy_Interpreter* interpreter, Toy_LiteralArray* argumen
 	else {
 		trimCharsLiteral = TOY_TO_STRING_LITERAL(Toy_createRefString(" \t\n\r"));
 	}
-	selfLiteral = Toy_popLiteralArray(arguments);
+	selfLiteral = popArgument(arguments, &count);
 
 	Toy_Literal selfLiteralIdn = selfLiteral;
 	if (TOY_IS_IDENTIFIER(selfLiteral) && Toy_parseIdentifierToValue(interpreter, &selfLiteral)) {
@@ -1932,7 +2075,9 @@ static int nativeTrimEnd(Toy_Interpreter* interpreter, Toy_LiteralArray* argumen
 	}
 
 	if (!TOY_IS_STRING(selfLiteral) || !TOY_IS_STRING(trimCharsLiteral)) {
-		interpreter->errorOutput("Incorrect argument type passed to trimEnd\n");
+		char buffer[256];
+		snprintf(buffer, 256, "Incorrect argument type passed to %s\n", fnName);
+		interpreter->errorOutput(buffer);
 		Toy_freeLiteral(trimCharsLiteral);
 		Toy_freeLiteral(selfLiteral);
 		return -1;
@@ -1942,42 +2087,24 @@ static int nativeTrimEnd(Toy_Interpreter* interpreter, Toy_LiteralArray* argumen
 	Toy_RefString* trimCharsRefString = TOY_AS_STRING(trimCharsLiteral);
 	Toy_RefString* selfRefString = TOY_AS_STRING(selfLiteral);
 
-	//allocate space for the new string
-	size_t bufferBegin = 0;
-	size_t bufferEnd = Toy_lengthRefString(selfRefString);
-
-	//again, from the back
-	for (int i = (int)Toy_lengthRefString(selfRefString); i >= 0; i--) {
-		int trimIndex = 0;
-
-		while (trimIndex < (int)Toy_lengthRefString(trimCharsRefString)) {
-			//there is a match - DON'T increment anymore
-			if (Toy_toCString(selfRefString)[i-1] == Toy_toCString(trimCharsRefString)[trimIndex]) {
-				break;
-			}
+	const char* self = Toy_toCString(selfRefString);
+	size_t length = Toy_lengthRefString(selfRefString);
 
-			trimIndex++;
-		}
+	//scan inwards from either end
+	size_t bufferBegin = trimBegin ? Toy_kernelSpanBegin(self, length, Toy_toCString(trimCharsRefString), Toy_lengthRefString(trimCharsRefString)) : 0;
+	size_t bufferEnd = length;
 
-		//if the match is found, increment buffer begin
-		if (trimIndex < (int)Toy_lengthRefString(trimCharsRefString)) {
-			bufferEnd--;
-			continue;
-		}
-		else {
-			break;
-		}
+	if (trimEnd && bufferBegin < length) {
+		bufferEnd -= Toy_kernelSpanEnd(self + bufferBegin, length - bufferBegin, Toy_toCString(trimCharsRefString), Toy_lengthRefString(trimCharsRefString));
 	}
 
-	//generate the result
+	//generate the result straight from the source string
 	Toy_Literal resultLiteral;
 	if (bufferBegin >= bufferEnd) { //catch errors
 		resultLiteral = TOY_TO_STRING_LITERAL(Toy_createRefString(""));
 	}
 	else {
-		char buffer[TOY_MAX_STRING_LENGTH];
-		snprintf(buffer, bufferEnd - bufferBegin + 1, "%s", &Toy_toCString(selfRefString)[ bufferBegin ]);
-		resultLiteral = TOY_TO_STRING_LITERAL(Toy_createRefString(buffer)); //internal copy
+		resultLiteral = TOY_TO_STRING_LITERAL(Toy_createRefStringLength(self + bufferBegin, bufferEnd - bufferBegin)); //internal copy
 	}
 
 	//wrap up the buffer and return it
@@ -1991,10 +2118,22 @@ static int nativeTrimEnd(Toy_Interpreter* interpreter, Toy_LiteralArray* argumen
 	return 1;
 }
 
+static int nativeTrim(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	return trimUtil(interpreter, arguments, count, true, true, "trim");
+}
+
+static int nativeTrimBegin(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	return trimUtil(interpreter, arguments, count, true, false, "trimBegin");
+}
+
+static int nativeTrimEnd(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	return trimUtil(interpreter, arguments, count, false, true, "trimEnd");
+}
+
 //call the hook
 typedef struct Natives {
 	char* name;
-	Toy_NativeFn fn;
+	Toy_NativeViewFn fn;
 } Natives;
 
 int Toy_hookStandard(Toy_Interpreter* interpreter, Toy_Literal identifier, Toy_Literal alias) {
@@ -2021,11 +2160,15 @@ int Toy_hookStandard(Toy_Interpreter* interpreter, Toy_Literal identifier, Toy_L
 		{"forEach", nativeForEach}, //array, dictionary
 		{"getKeys", nativeGetKeys}, //dictionary
 		{"getValues", nativeGetValues}, //dictionary
-		{"indexOf", nativeIndexOf}, //array
+		{"indexOf", nativeIndexOf}, //array, string
+		{"join", nativeJoin}, //array
 		{"map", nativeMap}, //array, dictionary
 		{"reduce", nativeReduce}, //array, dictionary
+		{"replace", nativeReplace}, //string
 		{"some", nativeSome}, //array, dictionary
 		{"sort", nativeSort}, //array
+		{"split", nativeSplit}, //string
+		{"startsWith", nativeStartsWith}, //string
 		{"toLower", nativeToLower}, //string
 		{"toString", nativeToString}, //array, dictionary
 		{"toUpper", nativeToUpper}, //string
@@ -2051,7 +2194,7 @@ int Toy_hookStandard(Toy_Interpreter* interpreter, Toy_Literal identifier, Toy_L
 		//load the dict with functions
 		for (int i = 0; natives[i].name; i++) {
 			Toy_Literal name = TOY_TO_STRING_LITERAL(Toy_createRefString(natives[i].name));
-			Toy_Literal func = TOY_TO_FUNCTION_NATIVE_LITERAL(natives[i].fn);
+			Toy_Literal func = TOY_TO_FUNCTION_NATIVE_VIEW_LITERAL(natives[i].fn);
 
 			Toy_setLiteralDictionary(dictionary, name, func);
 
@@ -2079,7 +2222,7 @@ int Toy_hookStandard(Toy_Interpreter* interpreter, Toy_Literal identifier, Toy_L
 
 	//default
 	for (int i = 0; natives[i].name; i++) {
-		Toy_injectNativeFn(interpreter, natives[i].name, natives[i].fn);
+		Toy_injectNativeViewFn(interpreter, natives[i].name, natives[i].fn);
 	}
 
 	return 0;
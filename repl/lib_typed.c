@@ -0,0 +1,1408 @@
+#include "lib_typed.h"
+
+#include "toy_memory.h"
+
+#include <stdio.h>
+#include <string.h>
+
+//vector paths - with gcc or clang on x86, every path is built and the widest one the CPU supports is chosen at runtime
+//otherwise, only the paths enabled at compile time are built (see the optimisation options in the root makefile)
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define TYPED_RUNTIME_DISPATCH
+#define TYPED_AVX2
+#define TYPED_SSE41
+#define TYPED_SSE2
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define TYPED_AVX2
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__SSE4_1__)
+#define TYPED_SSE41
+#endif
+#if defined(__SSE2__)
+#define TYPED_SSE2
+#endif
+#define TARGET_AVX2
+#define TARGET_SSE41
+#define TARGET_SSE2
+#endif
+
+//contiguous storage for a single numeric type - ints and floats are both 4 bytes (see toy_common.c)
+typedef struct Toy_TypedArray {
+	Toy_LiteralType type; //TOY_LITERAL_INTEGER or TOY_LITERAL_FLOAT
+	int count;
+	union {
+		int* ints;
+		float* floats;
+	};
+} Toy_TypedArray;
+
+typedef enum Toy_TypedCompare {
+	TOY_TYPED_LESS,
+	TOY_TYPED_EQUAL,
+	TOY_TYPED_GREATER,
+} Toy_TypedCompare;
+
+//what this CPU can run - __builtin_cpu_supports only reads what was detected at startup, so it's cheap enough to ask on every call
+#ifdef TYPED_AVX2
+static bool hasAvx2(void) {
+#ifdef TYPED_RUNTIME_DISPATCH
+	return __builtin_cpu_supports("avx2");
+#else
+	return true;
+#endif
+}
+#endif
+
+#ifdef TYPED_SSE41
+static bool hasSse41(void) {
+#ifdef TYPED_RUNTIME_DISPATCH
+	return __builtin_cpu_supports("sse4.1");
+#else
+	return true;
+#endif
+}
+#endif
+
+#ifdef TYPED_SSE2
+static bool hasSse2(void) {
+#ifdef TYPED_RUNTIME_DISPATCH
+	return __builtin_cpu_supports("sse2");
+#else
+	return true;
+#endif
+}
+#endif
+
+//bulk kernels - each vector path returns how far it got, a narrower path only runs if a wider one had nothing to do, and the scalar loops handle the tails
+#ifdef TYPED_AVX2
+TARGET_AVX2 static int fillAvx2(int* dst, int bits, int count) {
+	int i = 0;
+	__m256i v = _mm256_set1_epi32(bits);
+	for (; i + 8 <= count; i += 8) {
+		_mm256_storeu_si256((__m256i*)(dst + i), v);
+	}
+	return i;
+}
+
+TARGET_AVX2 static int addIntAvx2(int* dst, const int* src, int count) {
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256i a = _mm256_loadu_si256((const __m256i*)(dst + i));
+		__m256i b = _mm256_loadu_si256((const __m256i*)(src + i));
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_add_epi32(a, b));
+	}
+	return i;
+}
+
+TARGET_AVX2 static int mulIntAvx2(int* dst, const int* src, int count) {
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256i a = _mm256_loadu_si256((const __m256i*)(dst + i));
+		__m256i b = _mm256_loadu_si256((const __m256i*)(src + i));
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_mullo_epi32(a, b));
+	}
+	return i;
+}
+
+TARGET_AVX2 static int scaleIntAvx2(int* dst, int scale, int count) {
+	int i = 0;
+	__m256i k = _mm256_set1_epi32(scale);
+	for (; i + 8 <= count; i += 8) {
+		__m256i a = _mm256_loadu_si256((const __m256i*)(dst + i));
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_mullo_epi32(a, k));
+	}
+	return i;
+}
+
+TARGET_AVX2 static int addFloatAvx2(float* dst, const float* src, int count) {
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		_mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_loadu_ps(src + i)));
+	}
+	return i;
+}
+
+TARGET_AVX2 static int mulFloatAvx2(float* dst, const float* src, int count) {
+	int i = 0;
+	for (; i + 8 <= count; i += 8) {
+		_mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(dst + i), _mm256_loadu_ps(src + i)));
+	}
+	return i;
+}
+
+TARGET_AVX2 static int scaleFloatAvx2(float* dst, float scale, int count) {
+	int i = 0;
+	__m256 k = _mm256_set1_ps(scale);
+	for (; i + 8 <= count; i += 8) {
+		_mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(dst + i), k));
+	}
+	return i;
+}
+
+TARGET_AVX2 static int dotIntAvx2(const int* lhs, const int* rhs, int count, unsigned int* result) {
+	int i = 0;
+	__m256i acc = _mm256_setzero_si256();
+	for (; i + 8 <= count; i += 8) {
+		__m256i a = _mm256_loadu_si256((const __m256i*)(lhs + i));
+		__m256i b = _mm256_loadu_si256((const __m256i*)(rhs + i));
+		acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(a, b));
+	}
+	unsigned int lanes[8];
+	_mm256_storeu_si256((__m256i*)lanes, acc);
+	for (int l = 0; l < 8; l++) {
+		*result += lanes[l];
+	}
+	return i;
+}
+
+TARGET_AVX2 static int dotFloatAvx2(const float* lhs, const float* rhs, int count, float* lanes) {
+	int i = 0;
+	__m256 acc = _mm256_setzero_ps();
+	for (; i + 8 <= count; i += 8) {
+		acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(lhs + i), _mm256_loadu_ps(rhs + i)));
+	}
+	_mm256_storeu_ps(lanes, acc);
+	return i;
+}
+
+TARGET_AVX2 static int sumIntAvx2(const int* src, int count, unsigned int* result) {
+	int i = 0;
+	__m256i acc = _mm256_setzero_si256();
+	for (; i + 8 <= count; i += 8) {
+		acc = _mm256_add_epi32(acc, _mm256_loadu_si256((const __m256i*)(src + i)));
+	}
+	unsigned int lanes[8];
+	_mm256_storeu_si256((__m256i*)lanes, acc);
+	for (int l = 0; l < 8; l++) {
+		*result += lanes[l];
+	}
+	return i;
+}
+
+TARGET_AVX2 static int sumFloatAvx2(const float* src, int count, float* lanes) {
+	int i = 0;
+	__m256 acc = _mm256_setzero_ps();
+	for (; i + 8 <= count; i += 8) {
+		acc = _mm256_add_ps(acc, _mm256_loadu_ps(src + i));
+	}
+	_mm256_storeu_ps(lanes, acc);
+	return i;
+}
+
+TARGET_AVX2 static int extremeIntAvx2(const int* src, int count, bool greatest, int* result) {
+	if (count < 8) {
+		return 0;
+	}
+	int i = 8;
+	__m256i acc = _mm256_loadu_si256((const __m256i*)src);
+	for (; i + 8 <= count; i += 8) {
+		__m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+		acc = greatest ? _mm256_max_epi32(acc, v) : _mm256_min_epi32(acc, v);
+	}
+	int lanes[8];
+	_mm256_storeu_si256((__m256i*)lanes, acc);
+	for (int l = 0; l < 8; l++) {
+		*result = greatest ? (lanes[l] > *result ? lanes[l] : *result) : (lanes[l] < *result ? lanes[l] : *result);
+	}
+	return i;
+}
+
+TARGET_AVX2 static int extremeFloatAvx2(const float* src, int count, bool greatest, float* result) {
+	if (count < 8) {
+		return 0;
+	}
+	int i = 8;
+	__m256 acc = _mm256_loadu_ps(src);
+	for (; i + 8 <= count; i += 8) {
+		__m256 v = _mm256_loadu_ps(src + i);
+		acc = greatest ? _mm256_max_ps(acc, v) : _mm256_min_ps(acc, v);
+	}
+	float lanes[8];
+	_mm256_storeu_ps(lanes, acc);
+	for (int l = 0; l < 8; l++) {
+		*result = greatest ? (lanes[l] > *result ? lanes[l] : *result) : (lanes[l] < *result ? lanes[l] : *result);
+	}
+	return i;
+}
+
+TARGET_AVX2 static int compareIntAvx2(int* mask, const int* src, int value, int count, Toy_TypedCompare compare) {
+	int i = 0;
+	__m256i k = _mm256_set1_epi32(value);
+	__m256i one = _mm256_set1_epi32(1);
+	for (; i + 8 <= count; i += 8) {
+		__m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+		__m256i m;
+		switch(compare) {
+			case TOY_TYPED_LESS: m = _mm256_cmpgt_epi32(k, v); break;
+			case TOY_TYPED_EQUAL: m = _mm256_cmpeq_epi32(v, k); break;
+			default: m = _mm256_cmpgt_epi32(v, k); break;
+		}
+		_mm256_storeu_si256((__m256i*)(mask + i), _mm256_and_si256(m, one));
+	}
+	return i;
+}
+
+TARGET_AVX2 static int compareFloatAvx2(int* mask, const float* src, float value, int count, Toy_TypedCompare compare) {
+	int i = 0;
+	__m256 k = _mm256_set1_ps(value);
+	__m256i one = _mm256_set1_epi32(1);
+	for (; i + 8 <= count; i += 8) {
+		__m256 v = _mm256_loadu_ps(src + i);
+		__m256 m;
+		switch(compare) {
+			case TOY_TYPED_LESS: m = _mm256_cmp_ps(v, k, _CMP_LT_OQ); break;
+			case TOY_TYPED_EQUAL: m = _mm256_cmp_ps(v, k, _CMP_EQ_OQ); break;
+			default: m = _mm256_cmp_ps(v, k, _CMP_GT_OQ); break;
+		}
+		_mm256_storeu_si256((__m256i*)(mask + i), _mm256_and_si256(_mm256_castps_si256(m), one));
+	}
+	return i;
+}
+#endif
+
+#ifdef TYPED_SSE41
+TARGET_SSE41 static int mulIntSse41(int* dst, const int* src, int count) {
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128i a = _mm_loadu_si128((const __m128i*)(dst + i));
+		__m128i b = _mm_loadu_si128((const __m128i*)(src + i));
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_mullo_epi32(a, b));
+	}
+	return i;
+}
+
+TARGET_SSE41 static int scaleIntSse41(int* dst, int scale, int count) {
+	int i = 0;
+	__m128i k = _mm_set1_epi32(scale);
+	for (; i + 4 <= count; i += 4) {
+		__m128i a = _mm_loadu_si128((const __m128i*)(dst + i));
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_mullo_epi32(a, k));
+	}
+	return i;
+}
+
+TARGET_SSE41 static int dotIntSse41(const int* lhs, const int* rhs, int count, unsigned int* result) {
+	int i = 0;
+	__m128i acc = _mm_setzero_si128();
+	for (; i + 4 <= count; i += 4) {
+		__m128i a = _mm_loadu_si128((const __m128i*)(lhs + i));
+		__m128i b = _mm_loadu_si128((const __m128i*)(rhs + i));
+		acc = _mm_add_epi32(acc, _mm_mullo_epi32(a, b));
+	}
+	unsigned int lanes[4];
+	_mm_storeu_si128((__m128i*)lanes, acc);
+	for (int l = 0; l < 4; l++) {
+		*result += lanes[l];
+	}
+	return i;
+}
+
+TARGET_SSE41 static int extremeIntSse41(const int* src, int count, bool greatest, int* result) {
+	if (count < 4) {
+		return 0;
+	}
+	int i = 4;
+	__m128i acc = _mm_loadu_si128((const __m128i*)src);
+	for (; i + 4 <= count; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+		acc = greatest ? _mm_max_epi32(acc, v) : _mm_min_epi32(acc, v);
+	}
+	int lanes[4];
+	_mm_storeu_si128((__m128i*)lanes, acc);
+	for (int l = 0; l < 4; l++) {
+		*result = greatest ? (lanes[l] > *result ? lanes[l] : *result) : (lanes[l] < *result ? lanes[l] : *result);
+	}
+	return i;
+}
+#endif
+
+#ifdef TYPED_SSE2
+TARGET_SSE2 static int fillSse2(int* dst, int bits, int count) {
+	int i = 0;
+	__m128i v = _mm_set1_epi32(bits);
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_si128((__m128i*)(dst + i), v);
+	}
+	return i;
+}
+
+TARGET_SSE2 static int addIntSse2(int* dst, const int* src, int count) {
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128i a = _mm_loadu_si128((const __m128i*)(dst + i));
+		__m128i b = _mm_loadu_si128((const __m128i*)(src + i));
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_add_epi32(a, b));
+	}
+	return i;
+}
+
+TARGET_SSE2 static int addFloatSse2(float* dst, const float* src, int count) {
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+	}
+	return i;
+}
+
+TARGET_SSE2 static int mulFloatSse2(float* dst, const float* src, int count) {
+	int i = 0;
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+	}
+	return i;
+}
+
+TARGET_SSE2 static int scaleFloatSse2(float* dst, float scale, int count) {
+	int i = 0;
+	__m128 k = _mm_set1_ps(scale);
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), k));
+	}
+	return i;
+}
+
+//float reductions keep eight lanes, as the AVX2 path does
+TARGET_SSE2 static int dotFloatSse2(const float* lhs, const float* rhs, int count, float* lanes) {
+	int i = 0;
+	__m128 low = _mm_setzero_ps();
+	__m128 high = _mm_setzero_ps();
+	for (; i + 8 <= count; i += 8) {
+		low = _mm_add_ps(low, _mm_mul_ps(_mm_loadu_ps(lhs + i), _mm_loadu_ps(rhs + i)));
+		high = _mm_add_ps(high, _mm_mul_ps(_mm_loadu_ps(lhs + i + 4), _mm_loadu_ps(rhs + i + 4)));
+	}
+	_mm_storeu_ps(lanes, low);
+	_mm_storeu_ps(lanes + 4, high);
+	return i;
+}
+
+TARGET_SSE2 static int sumIntSse2(const int* src, int count, unsigned int* result) {
+	int i = 0;
+	__m128i acc = _mm_setzero_si128();
+	for (; i + 4 <= count; i += 4) {
+		acc = _mm_add_epi32(acc, _mm_loadu_si128((const __m128i*)(src + i)));
+	}
+	unsigned int lanes[4];
+	_mm_storeu_si128((__m128i*)lanes, acc);
+	for (int l = 0; l < 4; l++) {
+		*result += lanes[l];
+	}
+	return i;
+}
+
+TARGET_SSE2 static int sumFloatSse2(const float* src, int count, float* lanes) {
+	int i = 0;
+	__m128 low = _mm_setzero_ps();
+	__m128 high = _mm_setzero_ps();
+	for (; i + 8 <= count; i += 8) {
+		low = _mm_add_ps(low, _mm_loadu_ps(src + i));
+		high = _mm_add_ps(high, _mm_loadu_ps(src + i + 4));
+	}
+	_mm_storeu_ps(lanes, low);
+	_mm_storeu_ps(lanes + 4, high);
+	return i;
+}
+
+TARGET_SSE2 static int extremeFloatSse2(const float* src, int count, bool greatest, float* result) {
+	if (count < 4) {
+		return 0;
+	}
+	int i = 4;
+	__m128 acc = _mm_loadu_ps(src);
+	for (; i + 4 <= count; i += 4) {
+		__m128 v = _mm_loadu_ps(src + i);
+		acc = greatest ? _mm_max_ps(acc, v) : _mm_min_ps(acc, v);
+	}
+	float lanes[4];
+	_mm_storeu_ps(lanes, acc);
+	for (int l = 0; l < 4; l++) {
+		*result = greatest ? (lanes[l] > *result ? lanes[l] : *result) : (lanes[l] < *result ? lanes[l] : *result);
+	}
+	return i;
+}
+
+TARGET_SSE2 static int compareIntSse2(int* mask, const int* src, int value, int count, Toy_TypedCompare compare) {
+	int i = 0;
+	__m128i k = _mm_set1_epi32(value);
+	__m128i one = _mm_set1_epi32(1);
+	for (; i + 4 <= count; i += 4) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128i m;
+		switch(compare) {
+			case TOY_TYPED_LESS: m = _mm_cmplt_epi32(v, k); break;
+			case TOY_TYPED_EQUAL: m = _mm_cmpeq_epi32(v, k); break;
+			default: m = _mm_cmpgt_epi32(v, k); break;
+		}
+		_mm_storeu_si128((__m128i*)(mask + i), _mm_and_si128(m, one));
+	}
+	return i;
+}
+
+TARGET_SSE2 static int compareFloatSse2(int* mask, const float* src, float value, int count, Toy_TypedCompare compare) {
+	int i = 0;
+	__m128 k = _mm_set1_ps(value);
+	__m128i one = _mm_set1_epi32(1);
+	for (; i + 4 <= count; i += 4) {
+		__m128 v = _mm_loadu_ps(src + i);
+		__m128 m;
+		switch(compare) {
+			case TOY_TYPED_LESS: m = _mm_cmplt_ps(v, k); break;
+			case TOY_TYPED_EQUAL: m = _mm_cmpeq_ps(v, k); break;
+			default: m = _mm_cmpgt_ps(v, k); break;
+		}
+		_mm_storeu_si128((__m128i*)(mask + i), _mm_and_si128(_mm_castps_si128(m), one));
+	}
+	return i;
+}
+#endif
+
+static void kernelFill(int* dst, int bits, int count) {
+	int i = 0;
+#ifdef TYPED_AVX2
+	if (hasAvx2()) {
+		i = fillAvx2(dst, bits, count);
+	}
+#endif
+#ifdef TYPED_SSE2
+	if (i == 0 && hasSse2()) {
+		i = fillSse2(dst, bits, count);
+	}
+#endif
+	for (; i < count; i++) {
+		dst[i] = bits;
+	}
+}
+
+static void kernelAddInt(int* dst, const int* src, int count) {
+	int i = 0;
+#ifdef TYPED_AVX2
+	if (hasAvx2()) {
+		i = addIntAvx2(dst, src, count);
+	}
+#endif
+#ifdef TYPED_SSE2
+	if (i == 0 && hasSse2()) {
+		i = addIntSse2(dst, src, count);
+	}
+#endif
+	for (; i < count; i++) {
+		dst[i] = (int)((unsigned int)dst[i] + (unsigned int)src[i]); //wrap like the vector lanes do
+	}
+}
+
+static void kernelMulInt(int* dst, const int* src, int count) {
+	int i = 0;
+#ifdef TYPED_AVX2
+	if (hasAvx2()) {
+		i = mulIntAvx2(dst, src, count);
+	}
+#endif
+#ifdef TYPED_SSE41
+	if (i == 0 && hasSse41()) {
+		i = mulIntSse41(dst, src, count);
+	}
+#endif
+	for (; i < count; i++) {
+		dst[i] = (int)((unsigned int)dst[i] * (unsigned int)src[i]);
+	}
+}
+
+static void kernelScaleInt(int* dst, int scale, int count) {
+	int i = 0;
+#ifdef TYPED_AVX2
+	if (hasAvx2()) {
+		i = scaleIntAvx2(dst, scale, count);
+	}
+#endif
+#ifdef TYPED_SSE41
+	if (i == 0 && hasSse41()) {
+		i = scaleIntSse41(dst, scale, count);
+	}
+#endif
+	for (; i < count; i++) {
+		dst[i] = (int)((unsigned int)dst[i] * (unsigned int)scale);
+	}
+}
+
+static void kernelAddFloat(float* dst, const float* src, int count) {
+	int i = 0;
+#ifdef TYPED_AVX2
+	if (hasAvx2()) {
+		i = addFloatAvx2(dst, src, count);
+	}
+#endif
+#ifdef TYPED_SSE2
+	if (i == 0 && hasSse2()) {
+		i = addFloatSse2(dst, src, count);
+	}
+#endif
+	for (; i < count; i++) {
+		dst[i] += src[i];
+	}
+}
+
+static void kernelMulFloat(float* dst, const float* src, int count) {
+	int i = 0;
+#ifdef TYPED_AVX2
+	if (hasAvx2()) {
+		i = mulFloatAvx2(dst, src, count);
+	}
+#endif
+#ifdef TYPED_SSE2
+	if (i == 0 && hasSse2()) {
+		i = mulFloatSse2(dst, src, count);
+	}
+#endif
+	for (; i < count; i++) {
+		dst[i] *= src[i];
+	}
+}
+
+static void kernelScaleFloat(float* dst, float scale, int count) {
+	int i = 0;
+#ifdef TYPED_AVX2
+	if (hasAvx2()) {
+		i = scaleFloatAvx2(dst, scale, count);
+	}
+#endif
+#ifdef TYPED_SSE2
+	if (i == 0 && hasSse2()) {
+		i = scaleFloatSse2(dst, scale, count);
+	}
+#endif
+	for (; i < count; i++) {
+		dst[i] *= scale;
+	}
+}
+
+static int kernelDotInt(const int* lhs, const int* rhs, int count) {
+	unsigned int result = 0;
+	int i = 0;
+#ifdef TYPED_AVX2
+	if (hasAvx2()) {
+		i = dotIntAvx2(lhs, rhs, count, &result);
+	}
+#endif
+#ifdef TYPED_SSE41
+	if (i == 0 && hasSse41()) {
+		i = dotIntSse41(lhs, rhs, count, &result);
+	}
+#endif
+	for (; i < count; i++) {
+		result += (unsigned int)lhs[i] * (unsigned int)rhs[i];
+	}
+	return (int)result;
+}
+
+//float additions don't reorder freely, so every path adds into the same eight lanes, then the lanes in order, then the tail - the result doesn't depend on the CPU
+static float kernelDotFloat(const float* lhs, const float* rhs, int count) {
+	float lanes[8] = {0};
+	int i = 0;
+#ifdef TYPED_AVX2
+	if (hasAvx2()) {
+		i = dotFloatAvx2(lhs, rhs, count, lanes);
+	}
+#endif
+#ifdef TYPED_SSE2
+	if (i == 0 && hasSse2()) {
+		i = dotFloatSse2(lhs, rhs, count, lanes);
+	}
+#endif
+	for (; i + 8 <= count; i += 8) {
+		for (int l = 0; l < 8; l++) {
+			lanes[l] += lhs[i + l] * rhs[i + l];
+		}
+	}
+	float result = 0;
+	for (int l = 0; l < 8; l++) {
+		result += lanes[l];
+	}
+	for (; i < count; i++) {
+		result += lhs[i] * rhs[i];
+	}
+	return result;
+}
+
+static int kernelSumInt(const int* src, int count) {
+	unsigned int result = 0;
+	int i = 0;
+#ifdef TYPED_AVX2
+	if (hasAvx2()) {
+		i = sumIntAvx2(src, count, &result);
+	}
+#endif
+#ifdef TYPED_SSE2
+	if (i == 0 && hasSse2()) {
+		i = sumIntSse2(src, count, &result);
+	}
+#endif
+	for (; i < count; i++) {
+		result += (unsigned int)src[i];
+	}
+	return (int)result;
+}
+
+//in the same order as kernelDotFloat
+static float kernelSumFloat(const float* src, int count) {
+	float lanes[8] = {0};
+	int i = 0;
+#ifdef TYPED_AVX2
+	if (hasAvx2()) {
+		i = sumFloatAvx2(src, count, lanes);
+	}
+#endif
+#ifdef TYPED_SSE2
+	if (i == 0 && hasSse2()) {
+		i = sumFloatSse2(src, count, lanes);
+	}
+#endif
+	for (; i + 8 <= count; i += 8) {
+		for (int l = 0; l < 8; l++) {
+			lanes[l] += src[i + l];
+		}
+	}
+	float result = 0;
+	for (int l = 0; l < 8; l++) {
+		result += lanes[l];
+	}
+	for (; i < count; i++) {
+		result += src[i];
+	}
+	return result;
+}
+
+//expects count > 0
+static int kernelExtremeInt(const int* src, int count, bool greatest) {
+	int result = src[0];
+	int i = 0;
+#ifdef TYPED_AVX2
+	if (hasAvx2()) {
+		i = extremeIntAvx2(src, count, greatest, &result);
+	}
+#endif
+#ifdef TYPED_SSE41
+	if (i == 0 && hasSse41()) {
+		i = extremeIntSse41(src, count, greatest, &result);
+	}
+#endif
+	for (; i < count; i++) {
+		result = greatest ? (src[i] > result ? src[i] : result) : (src[i] < result ? src[i] : result);
+	}
+	return result;
+}
+
+//expects count > 0
+static float kernelExtremeFloat(const float* src, int count, bool greatest) {
+	float result = src[0];
+	int i = 0;
+#ifdef TYPED_AVX2
+	if (hasAvx2()) {
+		i = extremeFloatAvx2(src, count, greatest, &result);
+	}
+#endif
+#ifdef TYPED_SSE2
+	if (i == 0 && hasSse2()) {
+		i = extremeFloatSse2(src, count, greatest, &result);
+	}
+#endif
+	for (; i < count; i++) {
+		result = greatest ? (src[i] > result ? src[i] : result) : (src[i] < result ? src[i] : result);
+	}
+	return result;
+}
+
+//writes 1 or 0 into the mask for each element
+static void kernelCompareInt(int* mask, const int* src, int value, int count, Toy_TypedCompare compare) {
+	int i = 0;
+#ifdef TYPED_AVX2
+	if (hasAvx2()) {
+		i = compareIntAvx2(mask, src, value, count, compare);
+	}
+#endif
+#ifdef TYPED_SSE2
+	if (i == 0 && hasSse2()) {
+		i = compareIntSse2(mask, src, value, count, compare);
+	}
+#endif
+	for (; i < count; i++) {
+		switch(compare) {
+			case TOY_TYPED_LESS: mask[i] = src[i] < value; break;
+			case TOY_TYPED_EQUAL: mask[i] = src[i] == value; break;
+			default: mask[i] = src[i] > value; break;
+		}
+	}
+}
+
+static void kernelCompareFloat(int* mask, const float* src, float value, int count, Toy_TypedCompare compare) {
+	int i = 0;
+#ifdef TYPED_AVX2
+	if (hasAvx2()) {
+		i = compareFloatAvx2(mask, src, value, count, compare);
+	}
+#endif
+#ifdef TYPED_SSE2
+	if (i == 0 && hasSse2()) {
+		i = compareFloatSse2(mask, src, value, count, compare);
+	}
+#endif
+	for (; i < count; i++) {
+		switch(compare) {
+			case TOY_TYPED_LESS: mask[i] = src[i] < value; break;
+			case TOY_TYPED_EQUAL: mask[i] = src[i] == value; break;
+			default: mask[i] = src[i] > value; break;
+		}
+	}
+}
+
+//utils
+static Toy_TypedArray* allocateTypedArray(Toy_LiteralType type, int count) {
+	Toy_TypedArray* typed = TOY_ALLOCATE(Toy_TypedArray, 1);
+	typed->type = type;
+	typed->count = count;
+	typed->ints = NULL;
+
+	if (count > 0) {
+		typed->ints = TOY_ALLOCATE(int, count);
+		memset(typed->ints, 0, sizeof(int) * count);
+	}
+
+	return typed;
+}
+
+static void freeTypedArray(Toy_TypedArray* typed) {
+	if (typed->count > 0) {
+		TOY_FREE_ARRAY(int, typed->ints, typed->count);
+	}
+	TOY_FREE(Toy_TypedArray, typed);
+}
+
+static int pushTypedArray(Toy_Interpreter* interpreter, Toy_TypedArray* typed) {
+	Toy_Literal typedLiteral = TOY_TO_OPAQUE_LITERAL(typed, TOY_OPAQUE_TAG_TYPED);
+	Toy_pushLiteralArray(&interpreter->stack, typedLiteral);
+	Toy_freeLiteral(typedLiteral);
+	return 1;
+}
+
+static int pushResult(Toy_Interpreter* interpreter, Toy_Literal result) {
+	Toy_pushLiteralArray(&interpreter->stack, result);
+	Toy_freeLiteral(result);
+	return 1;
+}
+
+//take the last argument from the caller's stack, leaving null in it's slot
+static Toy_Literal popArgument(Toy_Literal* arguments, int* count) {
+	if (*count <= 0) {
+		return TOY_TO_NULL_LITERAL;
+	}
+
+	(*count)--;
+
+	Toy_Literal literal = arguments[*count];
+	arguments[*count] = TOY_TO_NULL_LITERAL;
+	return literal;
+}
+
+//resolve an argument that may be an identifier, taking ownership of it
+static bool resolveArgument(Toy_Interpreter* interpreter, Toy_Literal literal, Toy_Literal* literalPtr) {
+	Toy_Literal literalIdn = literal;
+	if (TOY_IS_IDENTIFIER(literal) && Toy_parseIdentifierToValue(interpreter, &literal)) {
+		Toy_freeLiteral(literalIdn);
+	}
+
+	if (TOY_IS_IDENTIFIER(literal)) {
+		Toy_freeLiteral(literal);
+		return false;
+	}
+
+	*literalPtr = literal;
+	return true;
+}
+
+static Toy_TypedArray* popTypedArray(Toy_Interpreter* interpreter, Toy_Literal* arguments, int* count, const char* fnName) {
+	Toy_Literal typedLiteral = TOY_TO_NULL_LITERAL;
+
+	if (!resolveArgument(interpreter, popArgument(arguments, count), &typedLiteral)) {
+		return NULL;
+	}
+
+	if (!TOY_IS_OPAQUE(typedLiteral) || TOY_GET_OPAQUE_TAG(typedLiteral) != TOY_OPAQUE_TAG_TYPED) {
+		char buffer[256];
+		snprintf(buffer, 256, "Unrecognized opaque literal in %s\n", fnName);
+		interpreter->errorOutput(buffer);
+		Toy_freeLiteral(typedLiteral);
+		return NULL;
+	}
+
+	return TOY_AS_OPAQUE(typedLiteral); //opaque literals are shallow, nothing to free
+}
+
+static bool popInteger(Toy_Interpreter* interpreter, Toy_Literal* arguments, int* count, const char* fnName, int* valuePtr) {
+	Toy_Literal literal = TOY_TO_NULL_LITERAL;
+
+	if (!resolveArgument(interpreter, popArgument(arguments, count), &literal)) {
+		return false;
+	}
+
+	if (!TOY_IS_INTEGER(literal)) {
+		char buffer[256];
+		snprintf(buffer, 256, "Incorrect argument type passed to %s (expected integer)\n", fnName);
+		interpreter->errorOutput(buffer);
+		Toy_freeLiteral(literal);
+		return false;
+	}
+
+	*valuePtr = TOY_AS_INTEGER(literal);
+	return true;
+}
+
+//ints widen to floats, floats never narrow to ints - the element is popped before the typed array that decides it's type, so it's given here
+static bool readElement(Toy_Interpreter* interpreter, Toy_Literal elementLiteral, Toy_TypedArray* typed, const char* fnName, int* intPtr, float* floatPtr) {
+	Toy_Literal literal = TOY_TO_NULL_LITERAL;
+
+	if (!resolveArgument(interpreter, elementLiteral, &literal)) {
+		return false;
+	}
+
+	if (typed->type == TOY_LITERAL_INTEGER && TOY_IS_INTEGER(literal)) {
+		*intPtr = TOY_AS_INTEGER(literal);
+		return true;
+	}
+
+	if (typed->type == TOY_LITERAL_FLOAT && (TOY_IS_INTEGER(literal) || TOY_IS_FLOAT(literal))) {
+		*floatPtr = TOY_IS_INTEGER(literal) ? (float)TOY_AS_INTEGER(literal) : TOY_AS_FLOAT(literal);
+		return true;
+	}
+
+	char buffer[256];
+	snprintf(buffer, 256, "Incorrect element type passed to %s\n", fnName);
+	interpreter->errorOutput(buffer);
+	Toy_freeLiteral(literal);
+	return false;
+}
+
+static bool checkArgumentCount(Toy_Interpreter* interpreter, int count, int expected, const char* fnName) {
+	if (count != expected) {
+		char buffer[256];
+		snprintf(buffer, 256, "Incorrect number of arguments to %s\n", fnName);
+		interpreter->errorOutput(buffer);
+		return false;
+	}
+
+	return true;
+}
+
+static bool checkMatchingTypedArrays(Toy_Interpreter* interpreter, Toy_TypedArray* lhs, Toy_TypedArray* rhs, const char* fnName) {
+	if (lhs->type != rhs->type || lhs->count != rhs->count) {
+		char buffer[256];
+		snprintf(buffer, 256, "Mismatched typed arrays passed to %s (types and lengths must match)\n", fnName);
+		interpreter->errorOutput(buffer);
+		return false;
+	}
+
+	return true;
+}
+
+//Toy native functions
+static int createTypedArrayUtil(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count, Toy_LiteralType type, const char* fnName) {
+	int length = 0;
+
+	if (!checkArgumentCount(interpreter, count, 1, fnName) || !popInteger(interpreter, arguments, &count, fnName, &length)) {
+		return -1;
+	}
+
+	if (length < 0) {
+		interpreter->errorOutput("Can't create a typed array with a negative length\n");
+		return -1;
+	}
+
+	return pushTypedArray(interpreter, allocateTypedArray(type, length));
+}
+
+static int nativeCreateIntArray(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	return createTypedArrayUtil(interpreter, arguments, count, TOY_LITERAL_INTEGER, "createIntArray");
+}
+
+static int nativeCreateFloatArray(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	return createTypedArrayUtil(interpreter, arguments, count, TOY_LITERAL_FLOAT, "createFloatArray");
+}
+
+static int nativeToTypedArray(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	Toy_Literal arrayLiteral = TOY_TO_NULL_LITERAL;
+
+	if (!checkArgumentCount(interpreter, count, 1, "toTypedArray") || !resolveArgument(interpreter, popArgument(arguments, &count), &arrayLiteral)) {
+		return -1;
+	}
+
+	if (!TOY_IS_ARRAY(arrayLiteral)) {
+		interpreter->errorOutput("Incorrect argument type passed to toTypedArray (expected array)\n");
+		Toy_freeLiteral(arrayLiteral);
+		return -1;
+	}
+
+	Toy_LiteralArray* array = TOY_AS_ARRAY(arrayLiteral);
+
+	//any float promotes the whole array
+	Toy_LiteralType type = TOY_LITERAL_INTEGER;
+	for (int i = 0; i < array->count; i++) {
+		if (TOY_IS_FLOAT(array->literals[i])) {
+			type = TOY_LITERAL_FLOAT;
+		}
+		else if (!TOY_IS_INTEGER(array->literals[i])) {
+			interpreter->errorOutput("Only integers and floats can be stored in a typed array\n");
+			Toy_freeLiteral(arrayLiteral);
+			return -1;
+		}
+	}
+
+	Toy_TypedArray* typed = allocateTypedArray(type, array->count);
+
+	for (int i = 0; i < array->count; i++) {
+		if (type == TOY_LITERAL_INTEGER) {
+			typed->ints[i] = TOY_AS_INTEGER(array->literals[i]);
+		}
+		else {
+			typed->floats[i] = TOY_IS_INTEGER(array->literals[i]) ? (float)TOY_AS_INTEGER(array->literals[i]) : TOY_AS_FLOAT(array->literals[i]);
+		}
+	}
+
+	Toy_freeLiteral(arrayLiteral);
+
+	return pushTypedArray(interpreter, typed);
+}
+
+static int nativeFromTypedArray(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	if (!checkArgumentCount(interpreter, count, 1, "fromTypedArray")) {
+		return -1;
+	}
+
+	Toy_TypedArray* typed = popTypedArray(interpreter, arguments, &count, "fromTypedArray");
+	if (!typed) {
+		return -1;
+	}
+
+	Toy_LiteralArray* array = TOY_ALLOCATE(Toy_LiteralArray, 1);
+	Toy_initLiteralArray(array);
+
+	for (int i = 0; i < typed->count; i++) {
+		Toy_Literal element = typed->type == TOY_LITERAL_INTEGER ? TOY_TO_INTEGER_LITERAL(typed->ints[i]) : TOY_TO_FLOAT_LITERAL(typed->floats[i]);
+		Toy_pushLiteralArray(array, element);
+	}
+
+	return pushResult(interpreter, TOY_TO_ARRAY_LITERAL(array));
+}
+
+static int nativeTypedLength(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	if (!checkArgumentCount(interpreter, count, 1, "typedLength")) {
+		return -1;
+	}
+
+	Toy_TypedArray* typed = popTypedArray(interpreter, arguments, &count, "typedLength");
+	if (!typed) {
+		return -1;
+	}
+
+	return pushResult(interpreter, TOY_TO_INTEGER_LITERAL(typed->count));
+}
+
+static int nativeTypedGet(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	int index = 0;
+
+	if (!checkArgumentCount(interpreter, count, 2, "typedGet") || !popInteger(interpreter, arguments, &count, "typedGet", &index)) {
+		return -1;
+	}
+
+	Toy_TypedArray* typed = popTypedArray(interpreter, arguments, &count, "typedGet");
+	if (!typed) {
+		return -1;
+	}
+
+	if (index < 0 || index >= typed->count) {
+		interpreter->errorOutput("Index out of bounds in typedGet\n");
+		return -1;
+	}
+
+	return pushResult(interpreter, typed->type == TOY_LITERAL_INTEGER ? TOY_TO_INTEGER_LITERAL(typed->ints[index]) : TOY_TO_FLOAT_LITERAL(typed->floats[index]));
+}
+
+static int nativeTypedSet(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	if (!checkArgumentCount(interpreter, count, 3, "typedSet")) {
+		return -1;
+	}
+
+	//the element type depends on the typed array, so it's read last
+	Toy_Literal valueLiteral = popArgument(arguments, &count);
+	int index = 0;
+
+	if (!popInteger(interpreter, arguments, &count, "typedSet", &index)) {
+		Toy_freeLiteral(valueLiteral);
+		return -1;
+	}
+
+	Toy_TypedArray* typed = popTypedArray(interpreter, arguments, &count, "typedSet");
+	if (!typed) {
+		Toy_freeLiteral(valueLiteral);
+		return -1;
+	}
+
+	int intValue = 0;
+	float floatValue = 0;
+	if (!readElement(interpreter, valueLiteral, typed, "typedSet", &intValue, &floatValue)) {
+		return -1;
+	}
+
+	if (index < 0 || index >= typed->count) {
+		interpreter->errorOutput("Index out of bounds in typedSet\n");
+		return -1;
+	}
+
+	if (typed->type == TOY_LITERAL_INTEGER) {
+		typed->ints[index] = intValue;
+	}
+	else {
+		typed->floats[index] = floatValue;
+	}
+
+	return 0;
+}
+
+static int nativeTypedSlice(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	int first = 0;
+	int second = 0;
+
+	if (!checkArgumentCount(interpreter, count, 3, "typedSlice") || !popInteger(interpreter, arguments, &count, "typedSlice", &second) || !popInteger(interpreter, arguments, &count, "typedSlice", &first)) {
+		return -1;
+	}
+
+	Toy_TypedArray* typed = popTypedArray(interpreter, arguments, &count, "typedSlice");
+	if (!typed) {
+		return -1;
+	}
+
+	//inclusive bounds, matching the slice notation
+	if (first < 0 || second >= typed->count || first > second) {
+		interpreter->errorOutput("Index out of bounds in typedSlice\n");
+		return -1;
+	}
+
+	Toy_TypedArray* slice = allocateTypedArray(typed->type, second - first + 1);
+	memcpy(slice->ints, typed->ints + first, sizeof(int) * slice->count);
+
+	return pushTypedArray(interpreter, slice);
+}
+
+static int nativeTypedFill(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	if (!checkArgumentCount(interpreter, count, 2, "typedFill")) {
+		return -1;
+	}
+
+	Toy_Literal valueLiteral = popArgument(arguments, &count);
+
+	Toy_TypedArray* typed = popTypedArray(interpreter, arguments, &count, "typedFill");
+	if (!typed) {
+		Toy_freeLiteral(valueLiteral);
+		return -1;
+	}
+
+	int intValue = 0;
+	float floatValue = 0;
+	if (!readElement(interpreter, valueLiteral, typed, "typedFill", &intValue, &floatValue)) {
+		return -1;
+	}
+
+	if (typed->type == TOY_LITERAL_FLOAT) {
+		memcpy(&intValue, &floatValue, sizeof(int)); //fill by bit pattern
+	}
+
+	kernelFill(typed->ints, intValue, typed->count);
+
+	return 0;
+}
+
+static int elementwiseUtil(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count, bool multiply, const char* fnName) {
+	if (!checkArgumentCount(interpreter, count, 2, fnName)) {
+		return -1;
+	}
+
+	Toy_TypedArray* rhs = popTypedArray(interpreter, arguments, &count, fnName);
+	Toy_TypedArray* lhs = rhs ? popTypedArray(interpreter, arguments, &count, fnName) : NULL;
+
+	if (!lhs || !checkMatchingTypedArrays(interpreter, lhs, rhs, fnName)) {
+		return -1;
+	}
+
+	//the result is written into the first argument
+	if (lhs->type == TOY_LITERAL_INTEGER) {
+		if (multiply) {
+			kernelMulInt(lhs->ints, rhs->ints, lhs->count);
+		}
+		else {
+			kernelAddInt(lhs->ints, rhs->ints, lhs->count);
+		}
+	}
+	else {
+		if (multiply) {
+			kernelMulFloat(lhs->floats, rhs->floats, lhs->count);
+		}
+		else {
+			kernelAddFloat(lhs->floats, rhs->floats, lhs->count);
+		}
+	}
+
+	return 0;
+}
+
+static int nativeTypedAdd(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	return elementwiseUtil(interpreter, arguments, count, false, "typedAdd");
+}
+
+static int nativeTypedMul(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	return elementwiseUtil(interpreter, arguments, count, true, "typedMul");
+}
+
+static int nativeTypedScale(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	if (!checkArgumentCount(interpreter, count, 2, "typedScale")) {
+		return -1;
+	}
+
+	Toy_Literal scaleLiteral = popArgument(arguments, &count);
+
+	Toy_TypedArray* typed = popTypedArray(interpreter, arguments, &count, "typedScale");
+	if (!typed) {
+		Toy_freeLiteral(scaleLiteral);
+		return -1;
+	}
+
+	int intValue = 0;
+	float floatValue = 0;
+	if (!readElement(interpreter, scaleLiteral, typed, "typedScale", &intValue, &floatValue)) {
+		return -1;
+	}
+
+	if (typed->type == TOY_LITERAL_INTEGER) {
+		kernelScaleInt(typed->ints, intValue, typed->count);
+	}
+	else {
+		kernelScaleFloat(typed->floats, floatValue, typed->count);
+	}
+
+	return 0;
+}
+
+static int nativeTypedSum(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	if (!checkArgumentCount(interpreter, count, 1, "typedSum")) {
+		return -1;
+	}
+
+	Toy_TypedArray* typed = popTypedArray(interpreter, arguments, &count, "typedSum");
+	if (!typed) {
+		return -1;
+	}
+
+	if (typed->type == TOY_LITERAL_INTEGER) {
+		return pushResult(interpreter, TOY_TO_INTEGER_LITERAL(kernelSumInt(typed->ints, typed->count)));
+	}
+	else {
+		return pushResult(interpreter, TOY_TO_FLOAT_LITERAL(kernelSumFloat(typed->floats, typed->count)));
+	}
+}
+
+static int extremeUtil(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count, bool greatest, const char* fnName) {
+	if (!checkArgumentCount(interpreter, count, 1, fnName)) {
+		return -1;
+	}
+
+	Toy_TypedArray* typed = popTypedArray(interpreter, arguments, &count, fnName);
+	if (!typed) {
+		return -1;
+	}
+
+	//nothing to compare
+	if (typed->count == 0) {
+		return pushResult(interpreter, TOY_TO_NULL_LITERAL);
+	}
+
+	if (typed->type == TOY_LITERAL_INTEGER) {
+		return pushResult(interpreter, TOY_TO_INTEGER_LITERAL(kernelExtremeInt(typed->ints, typed->count, greatest)));
+	}
+	else {
+		return pushResult(interpreter, TOY_TO_FLOAT_LITERAL(kernelExtremeFloat(typed->floats, typed->count, greatest)));
+	}
+}
+
+static int nativeTypedMin(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	return extremeUtil(interpreter, arguments, count, false, "typedMin");
+}
+
+static int nativeTypedMax(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	return extremeUtil(interpreter, arguments, count, true, "typedMax");
+}
+
+static int nativeTypedDot(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	if (!checkArgumentCount(interpreter, count, 2, "typedDot")) {
+		return -1;
+	}
+
+	Toy_TypedArray* rhs = popTypedArray(interpreter, arguments, &count, "typedDot");
+	Toy_TypedArray* lhs = rhs ? popTypedArray(interpreter, arguments, &count, "typedDot") : NULL;
+
+	if (!lhs || !checkMatchingTypedArrays(interpreter, lhs, rhs, "typedDot")) {
+		return -1;
+	}
+
+	if (lhs->type == TOY_LITERAL_INTEGER) {
+		return pushResult(interpreter, TOY_TO_INTEGER_LITERAL(kernelDotInt(lhs->ints, rhs->ints, lhs->count)));
+	}
+	else {
+		return pushResult(interpreter, TOY_TO_FLOAT_LITERAL(kernelDotFloat(lhs->floats, rhs->floats, lhs->count)));
+	}
+}
+
+static int compareUtil(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count, Toy_TypedCompare compare, const char* fnName) {
+	if (!checkArgumentCount(interpreter, count, 2, fnName)) {
+		return -1;
+	}
+
+	Toy_Literal valueLiteral = popArgument(arguments, &count);
+
+	Toy_TypedArray* typed = popTypedArray(interpreter, arguments, &count, fnName);
+	if (!typed) {
+		Toy_freeLiteral(valueLiteral);
+		return -1;
+	}
+
+	int intValue = 0;
+	float floatValue = 0;
+	if (!readElement(interpreter, valueLiteral, typed, fnName, &intValue, &floatValue)) {
+		return -1;
+	}
+
+	//masks are always int arrays of 0 and 1
+	Toy_TypedArray* mask = allocateTypedArray(TOY_LITERAL_INTEGER, typed->count);
+
+	if (typed->type == TOY_LITERAL_INTEGER) {
+		kernelCompareInt(mask->ints, typed->ints, intValue, typed->count, compare);
+	}
+	else {
+		kernelCompareFloat(mask->ints, typed->floats, floatValue, typed->count, compare);
+	}
+
+	return pushTypedArray(interpreter, mask);
+}
+
+static int nativeTypedLessMask(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	return compareUtil(interpreter, arguments, count, TOY_TYPED_LESS, "typedLessMask");
+}
+
+static int nativeTypedEqualMask(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	return compareUtil(interpreter, arguments, count, TOY_TYPED_EQUAL, "typedEqualMask");
+}
+
+static int nativeTypedGreaterMask(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	return compareUtil(interpreter, arguments, count, TOY_TYPED_GREATER, "typedGreaterMask");
+}
+
+static int nativeFreeTypedArray(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	if (!checkArgumentCount(interpreter, count, 1, "freeTypedArray")) {
+		return -1;
+	}
+
+	Toy_TypedArray* typed = popTypedArray(interpreter, arguments, &count, "freeTypedArray");
+	if (!typed) {
+		return -1;
+	}
+
+	freeTypedArray(typed);
+
+	return 0;
+}
+
+//call the hook
+typedef struct Natives {
+	const char* name;
+	Toy_NativeViewFn fn;
+} Natives;
+
+int Toy_hookTyped(Toy_Interpreter* interpreter, Toy_Literal identifier, Toy_Literal alias) {
+	//build the natives list
+	Natives natives[] = {
+		{"createIntArray", nativeCreateIntArray},
+		{"createFloatArray", nativeCreateFloatArray},
+		{"toTypedArray", nativeToTypedArray},
+		{"fromTypedArray", nativeFromTypedArray},
+		{"typedLength", nativeTypedLength},
+		{"typedGet", nativeTypedGet},
+		{"typedSet", nativeTypedSet},
+		{"typedSlice", nativeTypedSlice},
+		{"typedFill", nativeTypedFill},
+		{"typedAdd", nativeTypedAdd},
+		{"typedMul", nativeTypedMul},
+		{"typedScale", nativeTypedScale},
+		{"typedSum", nativeTypedSum},
+		{"typedMin", nativeTypedMin},
+		{"typedMax", nativeTypedMax},
+		{"typedDot", nativeTypedDot},
+		{"typedLessMask", nativeTypedLessMask},
+		{"typedEqualMask", nativeTypedEqualMask},
+		{"typedGreaterMask", nativeTypedGreaterMask},
+		{"freeTypedArray", nativeFreeTypedArray},
+		{NULL, NULL}
+	};
+
+	//store the library in an aliased dictionary
+	if (!TOY_IS_NULL(alias)) {
+		//make sure the name isn't taken
+		if (Toy_isDelcaredScopeVariable(interpreter->scope, alias)) {
+			interpreter->errorOutput("Can't override an existing variable\n");
+			Toy_freeLiteral(alias);
+			return -1;
+		}
+
+		//create the dictionary to load up with functions
+		Toy_LiteralDictionary* dictionary = TOY_ALLOCATE(Toy_LiteralDictionary, 1);
+		Toy_initLiteralDictionary(dictionary);
+
+		//load the dict with functions
+		for (int i = 0; natives[i].name; i++) {
+			Toy_Literal name = TOY_TO_STRING_LITERAL(Toy_createRefString(natives[i].name));
+			Toy_Literal func = TOY_TO_FUNCTION_NATIVE_VIEW_LITERAL(natives[i].fn);
+
+			Toy_setLiteralDictionary(dictionary, name, func);
+
+			Toy_freeLiteral(name);
+			Toy_freeLiteral(func);
+		}
+
+		//build the type
+		Toy_Literal type = TOY_TO_TYPE_LITERAL(TOY_LITERAL_DICTIONARY, true);
+		Toy_Literal strType = TOY_TO_TYPE_LITERAL(TOY_LITERAL_STRING, true);
+		Toy_Literal fnType = TOY_TO_TYPE_LITERAL(TOY_LITERAL_FUNCTION_NATIVE, true);
+		TOY_TYPE_PUSH_SUBTYPE(&type, strType);
+		TOY_TYPE_PUSH_SUBTYPE(&type, fnType);
+
+		//set scope
+		Toy_Literal dict = TOY_TO_DICTIONARY_LITERAL(dictionary);
+		Toy_declareScopeVariable(interpreter->scope, alias, type);
+		Toy_setScopeVariable(interpreter->scope, alias, dict, false);
+
+		//cleanup
+		Toy_freeLiteral(dict);
+		Toy_freeLiteral(type);
+		return 0;
+	}
+
+	//default
+	for (int i = 0; natives[i].name; i++) {
+		Toy_injectNativeViewFn(interpreter, natives[i].name, natives[i].fn);
+	}
+
+	return 0;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "toy_interpreter.h"
+
+//contiguous int or float arrays, held as opaque literals and worked on in bulk
+//indexing and slicing are the natives typedGet, typedSet and typedSlice - "a[i]" and "a[x:y]" don't apply to the opaque value
+//the bulk natives (typedFill, typedAdd, typedMul, typedScale, typedSum, typedMin, typedMax, typedDot and the masks) use the widest vector path this CPU supports
+//float typedSum and typedDot add in eight interleaved lanes, so they can differ in the last bits from adding the elements one by one
+int Toy_hookTyped(Toy_Interpreter* interpreter, Toy_Literal identifier, Toy_Literal alias);
+
+#define TOY_OPAQUE_TAG_TYPED 300
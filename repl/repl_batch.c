@@ -0,0 +1,339 @@
+//for threads & directory listings
+#if defined(__linux__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "repl_batch.h"
+#include "repl_tools.h"
+
+#include "toy_console_colors.h"
+#include "toy_memory.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//the list of files to compile, and how each one went
+typedef struct {
+	char* path;
+	bool success;
+	double seconds;
+} BatchEntry;
+
+typedef struct {
+	BatchEntry* entries;
+	int capacity;
+	int count;
+	int next; //the next entry for a worker to take
+#ifdef _WIN32
+	CRITICAL_SECTION lock;
+#else
+	pthread_mutex_t lock;
+#endif
+} Batch;
+
+static double now() {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static bool hasExtension(const char* path, const char* extension) {
+	const char* dot = strrchr(path, '.');
+	return dot != NULL && !strcmp(dot, extension);
+}
+
+static void pushEntry(Batch* batch, const char* path, size_t length) {
+	if (batch->count + 1 > batch->capacity) {
+		int oldCapacity = batch->capacity;
+		batch->capacity = TOY_GROW_CAPACITY(oldCapacity);
+		batch->entries = TOY_GROW_ARRAY(BatchEntry, batch->entries, oldCapacity, batch->capacity);
+	}
+
+	BatchEntry* entry = &batch->entries[batch->count++];
+
+	entry->path = TOY_ALLOCATE(char, length + 1);
+	memcpy(entry->path, path, length);
+	entry->path[length] = '\0';
+
+	entry->success = false;
+	entry->seconds = 0;
+}
+
+//manifests list one path per line - blank lines and lines starting with '#' are skipped
+static bool readManifest(Batch* batch, const char* path) {
+	size_t size = 0;
+	char* manifest = (char*)Toy_readFile(path, &size);
+
+	if (manifest == NULL) {
+		return false;
+	}
+
+	for (char* line = manifest; *line != '\0';) {
+		size_t length = strcspn(line, "\r\n");
+
+		if (length > 0 && line[0] != '#') {
+			pushEntry(batch, line, length);
+		}
+
+		line += length;
+		line += strspn(line, "\r\n");
+	}
+
+	free(manifest);
+	return true;
+}
+
+//directories are searched recursively
+static bool readDirectory(Batch* batch, const char* path) {
+#ifdef _WIN32
+	char pattern[MAX_PATH];
+	snprintf(pattern, MAX_PATH, "%s\\*", path);
+
+	WIN32_FIND_DATAA data;
+	HANDLE handle = FindFirstFileA(pattern, &data);
+
+	if (handle == INVALID_HANDLE_VALUE) {
+		fprintf(stderr, TOY_CC_ERROR "Could not open directory \"%s\"\n" TOY_CC_RESET, path);
+		return false;
+	}
+
+	do {
+		if (!strcmp(data.cFileName, ".") || !strcmp(data.cFileName, "..")) {
+			continue;
+		}
+
+		char child[MAX_PATH];
+		int length = snprintf(child, MAX_PATH, "%s\\%s", path, data.cFileName);
+
+		if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+			readDirectory(batch, child);
+		}
+		else if (hasExtension(child, ".toy")) {
+			pushEntry(batch, child, length);
+		}
+	} while (FindNextFileA(handle, &data));
+
+	FindClose(handle);
+	return true;
+#else
+	DIR* dir = opendir(path);
+
+	if (dir == NULL) {
+		fprintf(stderr, TOY_CC_ERROR "Could not open directory \"%s\"\n" TOY_CC_RESET, path);
+		return false;
+	}
+
+	struct dirent* ent;
+	while ((ent = readdir(dir)) != NULL) {
+		if (!strcmp(ent->d_name, ".") || !strcmp(ent->d_name, "..")) {
+			continue;
+		}
+
+		char child[4096];
+		int length = snprintf(child, 4096, "%s/%s", path, ent->d_name);
+
+		struct stat info;
+		if (stat(child, &info) != 0) {
+			continue;
+		}
+
+		if (S_ISDIR(info.st_mode)) {
+			readDirectory(batch, child);
+		}
+		else if (hasExtension(child, ".toy")) {
+			pushEntry(batch, child, length);
+		}
+	}
+
+	closedir(dir);
+	return true;
+#endif
+}
+
+static bool isDirectory(const char* path) {
+#ifdef _WIN32
+	DWORD attributes = GetFileAttributesA(path);
+	return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY);
+#else
+	struct stat info;
+	return stat(path, &info) == 0 && S_ISDIR(info.st_mode);
+#endif
+}
+
+static int countProcessors() {
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (int)info.dwNumberOfProcessors;
+#else
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? (int)count : 1;
+#endif
+}
+
+static void compileEntry(BatchEntry* entry) {
+	double start = now();
+
+	if (!hasExtension(entry->path, ".toy")) {
+		fprintf(stderr, TOY_CC_ERROR "Bad file extension in batch (expected '.toy'): %s\n" TOY_CC_RESET, entry->path);
+		return;
+	}
+
+	size_t size = 0;
+	char* source = (char*)Toy_readFile(entry->path, &size);
+
+	if (source == NULL) {
+		return;
+	}
+
+	const unsigned char* tb = Toy_compileString(source, &size);
+	free(source);
+
+	if (tb == NULL) {
+		fprintf(stderr, TOY_CC_ERROR "Failed to compile \"%s\"\n" TOY_CC_RESET, entry->path);
+		return;
+	}
+
+	//swap ".toy" for ".tb"
+	size_t length = strlen(entry->path);
+	char* outfile = TOY_ALLOCATE(char, length);
+	memcpy(outfile, entry->path, length - 3);
+	strcpy(outfile + length - 3, "tb");
+
+	entry->success = Toy_writeFile(outfile, tb, size) == 0;
+
+	TOY_FREE_ARRAY(char, outfile, length);
+	TOY_FREE_ARRAY(unsigned char, tb, size);
+
+	entry->seconds = now() - start;
+}
+
+//each worker takes the next file in the list until none are left, so a slow file doesn't hold up the others
+#ifdef _WIN32
+static DWORD WINAPI worker(LPVOID arg) {
+#else
+static void* worker(void* arg) {
+#endif
+	Batch* batch = (Batch*)arg;
+
+	for (;;) {
+#ifdef _WIN32
+		EnterCriticalSection(&batch->lock);
+		int index = batch->next++;
+		LeaveCriticalSection(&batch->lock);
+#else
+		pthread_mutex_lock(&batch->lock);
+		int index = batch->next++;
+		pthread_mutex_unlock(&batch->lock);
+#endif
+
+		if (index >= batch->count) {
+			break;
+		}
+
+		compileEntry(&batch->entries[index]);
+	}
+
+#ifdef _WIN32
+	return 0;
+#else
+	return NULL;
+#endif
+}
+
+int Toy_compileBatch(const char* path, int jobs) {
+	double start = now();
+
+	Batch batch = { .entries = NULL, .capacity = 0, .count = 0, .next = 0 };
+
+	if (!(isDirectory(path) ? readDirectory(&batch, path) : readManifest(&batch, path))) {
+		return -1;
+	}
+
+	if (jobs <= 0) {
+		jobs = countProcessors();
+	}
+
+	if (jobs > batch.count) {
+		jobs = batch.count > 0 ? batch.count : 1;
+	}
+
+	//run the workers, with this thread acting as the first one
+#ifdef _WIN32
+	InitializeCriticalSection(&batch.lock);
+	HANDLE* threads = TOY_ALLOCATE(HANDLE, jobs);
+
+	for (int i = 1; i < jobs; i++) {
+		threads[i] = CreateThread(NULL, 0, worker, &batch, 0, NULL);
+	}
+
+	worker(&batch);
+
+	for (int i = 1; i < jobs; i++) {
+		WaitForSingleObject(threads[i], INFINITE);
+		CloseHandle(threads[i]);
+	}
+
+	TOY_FREE_ARRAY(HANDLE, threads, jobs);
+	DeleteCriticalSection(&batch.lock);
+#else
+	pthread_mutex_init(&batch.lock, NULL);
+	pthread_t* threads = TOY_ALLOCATE(pthread_t, jobs);
+
+	for (int i = 1; i < jobs; i++) {
+		pthread_create(&threads[i], NULL, worker, &batch);
+	}
+
+	worker(&batch);
+
+	for (int i = 1; i < jobs; i++) {
+		pthread_join(threads[i], NULL);
+	}
+
+	TOY_FREE_ARRAY(pthread_t, threads, jobs);
+	pthread_mutex_destroy(&batch.lock);
+#endif
+
+	//timing summary
+	int failures = 0;
+	double compileSeconds = 0;
+	BatchEntry* slowest = NULL;
+
+	for (int i = 0; i < batch.count; i++) {
+		if (!batch.entries[i].success) {
+			failures++;
+			continue;
+		}
+
+		compileSeconds += batch.entries[i].seconds;
+
+		if (slowest == NULL || batch.entries[i].seconds > slowest->seconds) {
+			slowest = &batch.entries[i];
+		}
+	}
+
+	printf("Compiled %d of %d files on %d thread%s in %.3fs (%.3fs of compile time)\n", batch.count - failures, batch.count, jobs, jobs == 1 ? "" : "s", now() - start, compileSeconds);
+
+	if (slowest != NULL) {
+		printf("Slowest file: %s (%.3fs)\n", slowest->path, slowest->seconds);
+	}
+
+	for (int i = 0; i < batch.count; i++) {
+		TOY_FREE_ARRAY(char, batch.entries[i].path, strlen(batch.entries[i].path) + 1);
+	}
+
+	TOY_FREE_ARRAY(BatchEntry, batch.entries, batch.capacity);
+
+	return failures;
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "toy_common.h"
+
+//compiles every .toy file listed in a manifest (one path per line), or found under a directory, into a .tb file beside it
+//jobs is the number of threads to use, or 0 for one per processor; returns the number of files that failed
+int Toy_compileBatch(const char* path, int jobs);
@@ -0,0 +1,291 @@
+#include "repl_cache.h"
+#include "repl_tools.h"
+
+#include "toy_console_colors.h"
+#include "toy_memory.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+//SHA-256, as specified in FIPS 180-4
+typedef struct {
+	uint32_t state[8];
+	unsigned char block[64];
+	size_t blockCount;
+	uint64_t totalLength;
+} SHA256;
+
+static const uint32_t roundConstants[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+#define ROTATE(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void initSHA256(SHA256* sha) {
+	static const uint32_t initial[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+	memcpy(sha->state, initial, sizeof(initial));
+	sha->blockCount = 0;
+	sha->totalLength = 0;
+}
+
+static void compressSHA256(SHA256* sha) {
+	uint32_t w[64];
+
+	for (int i = 0; i < 16; i++) {
+		w[i] = (uint32_t)sha->block[i * 4] << 24 | (uint32_t)sha->block[i * 4 + 1] << 16 | (uint32_t)sha->block[i * 4 + 2] << 8 | (uint32_t)sha->block[i * 4 + 3];
+	}
+
+	for (int i = 16; i < 64; i++) {
+		uint32_t s0 = ROTATE(w[i - 15], 7) ^ ROTATE(w[i - 15], 18) ^ (w[i - 15] >> 3);
+		uint32_t s1 = ROTATE(w[i - 2], 17) ^ ROTATE(w[i - 2], 19) ^ (w[i - 2] >> 10);
+		w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+	}
+
+	uint32_t a = sha->state[0], b = sha->state[1], c = sha->state[2], d = sha->state[3];
+	uint32_t e = sha->state[4], f = sha->state[5], g = sha->state[6], h = sha->state[7];
+
+	for (int i = 0; i < 64; i++) {
+		uint32_t t1 = h + (ROTATE(e, 6) ^ ROTATE(e, 11) ^ ROTATE(e, 25)) + ((e & f) ^ (~e & g)) + roundConstants[i] + w[i];
+		uint32_t t2 = (ROTATE(a, 2) ^ ROTATE(a, 13) ^ ROTATE(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+		h = g;
+		g = f;
+		f = e;
+		e = d + t1;
+		d = c;
+		c = b;
+		b = a;
+		a = t1 + t2;
+	}
+
+	sha->state[0] += a; sha->state[1] += b; sha->state[2] += c; sha->state[3] += d;
+	sha->state[4] += e; sha->state[5] += f; sha->state[6] += g; sha->state[7] += h;
+}
+
+static void updateSHA256(SHA256* sha, const unsigned char* data, size_t length) {
+	sha->totalLength += length;
+
+	while (length > 0) {
+		size_t count = 64 - sha->blockCount < length ? 64 - sha->blockCount : length;
+		memcpy(sha->block + sha->blockCount, data, count);
+		sha->blockCount += count;
+		data += count;
+		length -= count;
+
+		if (sha->blockCount == 64) {
+			compressSHA256(sha);
+			sha->blockCount = 0;
+		}
+	}
+}
+
+static void finalSHA256(SHA256* sha, unsigned char digest[TOY_SHA256_SIZE]) {
+	uint64_t bits = sha->totalLength * 8;
+
+	//a single set bit, then zeroes up to the last 8 bytes of a block, which hold the length
+	static const unsigned char padding[64] = { 0x80 };
+	updateSHA256(sha, padding, sha->blockCount < 56 ? 56 - sha->blockCount : 120 - sha->blockCount);
+
+	for (int i = 0; i < 8; i++) {
+		sha->block[56 + i] = (unsigned char)(bits >> (56 - i * 8));
+	}
+	compressSHA256(sha);
+
+	for (int i = 0; i < 8; i++) {
+		digest[i * 4] = (unsigned char)(sha->state[i] >> 24);
+		digest[i * 4 + 1] = (unsigned char)(sha->state[i] >> 16);
+		digest[i * 4 + 2] = (unsigned char)(sha->state[i] >> 8);
+		digest[i * 4 + 3] = (unsigned char)(sha->state[i]);
+	}
+}
+
+void Toy_hashSHA256(const unsigned char* data, size_t length, unsigned char digest[TOY_SHA256_SIZE]) {
+	SHA256 sha;
+	initSHA256(&sha);
+	updateSHA256(&sha, data, length);
+	finalSHA256(&sha, digest);
+}
+
+//the cache itself - it's small, so entries are found with a linear search, and the least recently used one is replaced
+typedef struct {
+	unsigned char key[TOY_SHA256_SIZE];
+	Toy_RefBytecode* bytecode;
+	unsigned int lastUsed;
+} CacheEntry;
+
+static CacheEntry* entries = NULL;
+static int entryCapacity = 0;
+static int entryCount = 0;
+static unsigned int useCounter = 0;
+static unsigned int tempCounter = 0;
+static char* directory = NULL;
+static Toy_CompileCacheStats stats = { 0 };
+
+void Toy_initCompileCache(int capacity, const char* dir) {
+	Toy_freeCompileCache();
+
+	if (capacity > 0) {
+		entries = TOY_ALLOCATE(CacheEntry, capacity);
+		entryCapacity = capacity;
+	}
+
+	if (dir != NULL) {
+		directory = TOY_ALLOCATE(char, strlen(dir) + 1);
+		strcpy(directory, dir);
+	}
+}
+
+void Toy_freeCompileCache() {
+	for (int i = 0; i < entryCount; i++) {
+		Toy_deleteRefBytecode(entries[i].bytecode);
+	}
+
+	TOY_FREE_ARRAY(CacheEntry, entries, entryCapacity);
+
+	if (directory != NULL) {
+		TOY_FREE_ARRAY(char, directory, strlen(directory) + 1);
+	}
+
+	entries = NULL;
+	entryCapacity = 0;
+	entryCount = 0;
+	useCounter = 0;
+	directory = NULL;
+	stats = (Toy_CompileCacheStats){ 0 };
+}
+
+Toy_CompileCacheStats Toy_getCompileCacheStats() {
+	return stats;
+}
+
+//anything that changes the compiler's output is part of the key
+void Toy_hashCompileCacheKey(const char* source, unsigned char key[TOY_SHA256_SIZE]) {
+	char version[128];
+	int length = snprintf(version, 128, "%d.%d.%d %s %d %d %d", TOY_VERSION_MAJOR, TOY_VERSION_MINOR, TOY_VERSION_PATCH, TOY_VERSION_BUILD, Toy_commandLine.optimize, Toy_commandLine.enableInlining, Toy_commandLine.registers);
+
+	SHA256 sha;
+	initSHA256(&sha);
+	updateSHA256(&sha, (const unsigned char*)version, length + 1);
+	updateSHA256(&sha, (const unsigned char*)source, strlen(source));
+	finalSHA256(&sha, key);
+}
+
+static void rememberBytecode(const unsigned char key[TOY_SHA256_SIZE], Toy_RefBytecode* bytecode) {
+	if (entryCapacity == 0) {
+		return;
+	}
+
+	CacheEntry* entry = &entries[entryCount];
+
+	if (entryCount < entryCapacity) {
+		entryCount++;
+	}
+	else {
+		entry = &entries[0];
+		for (int i = 1; i < entryCount; i++) {
+			if (entries[i].lastUsed < entry->lastUsed) {
+				entry = &entries[i];
+			}
+		}
+
+		Toy_deleteRefBytecode(entry->bytecode);
+	}
+
+	memcpy(entry->key, key, TOY_SHA256_SIZE);
+	entry->bytecode = Toy_copyRefBytecode(bytecode);
+	entry->lastUsed = ++useCounter;
+}
+
+//the directory's files are named by the hex digest
+static void makeCachePath(const unsigned char key[TOY_SHA256_SIZE], char* path, size_t size, const char* suffix) {
+	int length = snprintf(path, size, "%s/", directory);
+
+	for (int i = 0; i < TOY_SHA256_SIZE; i++) {
+		length += snprintf(path + length, size - length, "%02x", key[i]);
+	}
+
+	snprintf(path + length, size - length, "%s", suffix);
+}
+
+Toy_RefBytecode* Toy_compileCached(const char* source) {
+	unsigned char key[TOY_SHA256_SIZE];
+	Toy_hashCompileCacheKey(source, key);
+
+	//check memory
+	for (int i = 0; i < entryCount; i++) {
+		if (!memcmp(entries[i].key, key, TOY_SHA256_SIZE)) {
+			entries[i].lastUsed = ++useCounter;
+			stats.memoryHits++;
+			return Toy_copyRefBytecode(entries[i].bytecode);
+		}
+	}
+
+	//check the disk
+	char path[4096];
+	if (directory != NULL) {
+		makeCachePath(key, path, 4096, ".tb");
+
+		FILE* file = fopen(path, "rb");
+		if (file != NULL) {
+			fclose(file);
+
+			Toy_RefBytecode* bytecode = Toy_mapBinaryFile(path);
+			if (bytecode != NULL) {
+				rememberBytecode(key, bytecode);
+				stats.diskHits++;
+				return bytecode;
+			}
+		}
+	}
+
+	//compile it
+	size_t size = 0;
+	const unsigned char* tb = Toy_compileString(source, &size);
+
+	if (!tb) {
+		return NULL;
+	}
+
+	stats.misses++;
+
+	//written under a temporary name first, so other processes never read a partial file - the name is unique to each writer
+	if (directory != NULL) {
+		char suffix[64];
+		snprintf(suffix, 64, ".%ld.%u.tmp", (long)getpid(), ++tempCounter);
+
+		char temp[4096];
+		makeCachePath(key, temp, 4096, suffix);
+
+		bool written = Toy_writeFile(temp, tb, size) == 0;
+
+#ifdef _WIN32
+		if (written) {
+			remove(path); //rename() won't replace an existing file here
+		}
+#endif
+
+		//on POSIX, rename() replaces the file atomically
+		if (!written || rename(temp, path) != 0) {
+			remove(temp);
+		}
+	}
+
+	Toy_RefBytecode* bytecode = Toy_createRefBytecode(tb, size, Toy_releaseOwnedBytecode);
+	rememberBytecode(key, bytecode);
+
+	return bytecode;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "toy_common.h"
+#include "toy_refbytecode.h"
+
+//compiled scripts are cached by a hash of their source, along with the compiler's version & options
+//recently used bytecode is kept in memory, and an optional directory keeps "<hash>.tb" files between runs
+void Toy_initCompileCache(int capacity, const char* directory); //capacity 0 disables the in-memory cache
+void Toy_freeCompileCache();
+
+//returns a new reference to the bytecode, compiling only when needed - NULL on error
+Toy_RefBytecode* Toy_compileCached(const char* source);
+
+typedef struct Toy_CompileCacheStats {
+	int memoryHits;
+	int diskHits;
+	int misses;
+} Toy_CompileCacheStats;
+
+Toy_CompileCacheStats Toy_getCompileCacheStats();
+
+//SHA-256, and the cache's key for a source, exposed for testing
+#define TOY_SHA256_SIZE 32
+void Toy_hashSHA256(const unsigned char* data, size_t length, unsigned char digest[TOY_SHA256_SIZE]);
+void Toy_hashCompileCacheKey(const char* source, unsigned char digest[TOY_SHA256_SIZE]);
@@ -1,8 +1,11 @@
 #include "repl_tools.h"
+#include "repl_batch.h"
+#include "repl_cache.h"
 #include "lib_about.h"
 #include "lib_standard.h"
 #include "lib_random.h"
 #include "lib_runner.h"
+#include "lib_typed.h"
 
 #include "toy_console_colors.h"
 
@@ -29,6 +32,7 @@ void repl(const char* initialInput) {
 	Toy_injectNativeHook(&interpreter, "standard", Toy_hookStandard);
 	Toy_injectNativeHook(&interpreter, "random", Toy_hookRandom);
 	Toy_injectNativeHook(&interpreter, "runner", Toy_hookRunner);
+	Toy_injectNativeHook(&interpreter, "typed", Toy_hookTyped);
 
 	for(;;) {
 		if (!initialInput) {
@@ -107,6 +111,9 @@ int main(int argc, const char* argv[]) {
 	Toy_initDriveSystem();
 	Toy_setDrivePath("scripts", "scripts");
 
+	//scripts loaded more than once are only compiled once
+	Toy_initCompileCache(64, Toy_commandLine.cachedir);
+
 	//command line specific actions
 	if (Toy_commandLine.error) {
 		Toy_usageCommandLine(argc, argv);
@@ -142,6 +149,7 @@ int main(int argc, const char* argv[]) {
 
 		//lib cleanup
 		Toy_freeDriveSystem();
+		Toy_freeCompileCache();
 
 		return 0;
 	}
@@ -152,6 +160,7 @@ int main(int argc, const char* argv[]) {
 
 		//lib cleanup
 		Toy_freeDriveSystem();
+		Toy_freeCompileCache();
 
 		return 0;
 	}
@@ -184,6 +193,17 @@ int main(int argc, const char* argv[]) {
 		return 0;
 	}
 
+	//compile many source files at once
+	if (Toy_commandLine.batchfile) {
+		int failures = Toy_compileBatch(Toy_commandLine.batchfile, Toy_commandLine.jobs);
+
+		//lib cleanup
+		Toy_freeDriveSystem();
+		Toy_freeCompileCache();
+
+		return failures == 0 ? 0 : 1;
+	}
+
 	//run binary
 	if (Toy_commandLine.binaryfile) {
 		//only works on tb files
@@ -198,6 +218,7 @@ int main(int argc, const char* argv[]) {
 
 		//lib cleanup
 		Toy_freeDriveSystem();
+		Toy_freeCompileCache();
 
 		return 0;
 	}
@@ -219,6 +240,7 @@ int main(int argc, const char* argv[]) {
 
 	//lib cleanup
 	Toy_freeDriveSystem();
+	Toy_freeCompileCache();
 
 	return 0;
 }
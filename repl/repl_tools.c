@@ -1,19 +1,36 @@
+//for mmap
+#if defined(__linux__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "repl_tools.h"
+#include "repl_cache.h"
 #include "lib_about.h"
 #include "lib_standard.h"
 #include "lib_random.h"
 #include "lib_runner.h"
+#include "lib_typed.h"
 
 #include "toy_console_colors.h"
 
 #include "toy_lexer.h"
 #include "toy_parser.h"
+#include "toy_ast_optimizer.h"
 #include "toy_compiler.h"
+#include "toy_optimizer.h"
 #include "toy_interpreter.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TOY_MMAP_AVAILABLE
+#endif
+
 //IO functions
 const unsigned char* Toy_readFile(const char* path, size_t* fileSize) {
 	FILE* file = fopen(path, "rb");
@@ -48,6 +65,55 @@ const unsigned char* Toy_readFile(const char* path, size_t* fileSize) {
 	return buffer;
 }
 
+#ifdef TOY_MMAP_AVAILABLE
+static void releaseMappedFile(const unsigned char* bytecode, size_t length) {
+	munmap((void*)bytecode, length);
+}
+#else
+static void releaseReadFile(const unsigned char* bytecode, size_t length) {
+	free((void*)bytecode);
+}
+#endif
+
+Toy_RefBytecode* Toy_mapBinaryFile(const char* path) {
+#ifdef TOY_MMAP_AVAILABLE
+	int fd = open(path, O_RDONLY);
+
+	if (fd < 0) {
+		fprintf(stderr, TOY_CC_ERROR "Could not open file \"%s\"\n" TOY_CC_RESET, path);
+		return NULL;
+	}
+
+	struct stat info;
+	if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+		fprintf(stderr, TOY_CC_ERROR "Could not read file \"%s\"\n" TOY_CC_RESET, path);
+		close(fd);
+		return NULL;
+	}
+
+	//read-only and private, so every interpreter can share the same pages
+	void* mapping = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd); //the mapping outlives the descriptor
+
+	if (mapping == MAP_FAILED) {
+		fprintf(stderr, TOY_CC_ERROR "Could not map file \"%s\"\n" TOY_CC_RESET, path);
+		return NULL;
+	}
+
+	return Toy_createRefBytecode((const unsigned char*)mapping, (size_t)info.st_size, releaseMappedFile);
+#else
+	//no mmap, so read it instead
+	size_t size = 0;
+	const unsigned char* tb = Toy_readFile(path, &size);
+
+	if (!tb) {
+		return NULL;
+	}
+
+	return Toy_createRefBytecode(tb, size, releaseReadFile);
+#endif
+}
+
 int Toy_writeFile(const char* path, const unsigned char* bytes, size_t size) {
 	FILE* file = fopen(path, "wb");
 
@@ -72,33 +138,56 @@ int Toy_writeFile(const char* path, const unsigned char* bytes, size_t size) {
 const unsigned char* Toy_compileString(const char* source, size_t* size) {
 	Toy_Lexer lexer;
 	Toy_Parser parser;
+	Toy_ASTOptimizer astOptimizer;
 	Toy_Compiler compiler;
 
 	Toy_initLexer(&lexer, source);
 	Toy_initParser(&parser, &lexer);
+	Toy_initASTOptimizer(&astOptimizer);
 	Toy_initCompiler(&compiler);
 
-	//step 1 - run the parser until the end of the source
+	astOptimizer.inlining = Toy_commandLine.enableInlining;
+	compiler.registers = Toy_commandLine.registers;
+
+	//step 1 - run the parser until the end of the source, folding the constants in each node
 	Toy_ASTNode* node = Toy_scanParser(&parser);
 	while(node != NULL) {
 		//on error, pack up and leave
 		if (node->type == TOY_AST_NODE_ERROR) {
 			Toy_freeASTNode(node);
 			Toy_freeCompiler(&compiler);
+			Toy_freeASTOptimizer(&astOptimizer);
 			Toy_freeParser(&parser);
 			return NULL;
 		}
 
+		Toy_optimizeASTNode(&astOptimizer, node);
 		Toy_writeCompiler(&compiler, node);
 		Toy_freeASTNode(node);
 		node = Toy_scanParser(&parser);
 	}
 
-	//step 2 - get the bytecode dump
+	if (Toy_commandLine.verbose) {
+		printf(TOY_CC_NOTICE "Folded %d expressions, removed %d branches and inlined %d calls\n" TOY_CC_RESET, astOptimizer.nodesFolded, astOptimizer.branchesRemoved, astOptimizer.callsInlined);
+	}
+
+	//step 2 - optionally clean up the bytecode
+	if (Toy_commandLine.optimize) {
+		Toy_OptimizerStats stats;
+		Toy_initOptimizerStats(&stats);
+		Toy_optimizeCompiler(&compiler, &stats);
+
+		if (Toy_commandLine.verbose) {
+			printf(TOY_CC_NOTICE "Optimizer removed %d instructions (%d bytes) and threaded %d jumps\n" TOY_CC_RESET, stats.instructionsRemoved, stats.bytesRemoved, stats.jumpsThreaded);
+		}
+	}
+
+	//step 3 - get the bytecode dump
 	const unsigned char* tb = Toy_collateCompiler(&compiler, size);
 
 	//cleanup
 	Toy_freeCompiler(&compiler);
+	Toy_freeASTOptimizer(&astOptimizer);
 	Toy_freeParser(&parser);
 	//no lexer to clean up
 
@@ -107,6 +196,17 @@ const unsigned char* Toy_compileString(const char* source, size_t* size) {
 }
 
 void Toy_runBinary(const unsigned char* tb, size_t size) {
+	//the shared buffer takes ownership of the binary data
+	Toy_RefBytecode* source = Toy_createRefBytecode(tb, size, Toy_releaseOwnedBytecode);
+	Toy_runSharedBinary(source);
+	Toy_deleteRefBytecode(source);
+}
+
+static void printProfile(const char* output) {
+	printf("%s", output);
+}
+
+void Toy_runSharedBinary(Toy_RefBytecode* source) {
 	Toy_Interpreter interpreter;
 	Toy_initInterpreter(&interpreter);
 
@@ -115,29 +215,41 @@ void Toy_runBinary(const unsigned char* tb, size_t size) {
 	Toy_injectNativeHook(&interpreter, "standard", Toy_hookStandard);
 	Toy_injectNativeHook(&interpreter, "random", Toy_hookRandom);
 	Toy_injectNativeHook(&interpreter, "runner", Toy_hookRunner);
+	Toy_injectNativeHook(&interpreter, "typed", Toy_hookTyped);
 
-	Toy_runInterpreter(&interpreter, tb, (int)size);
+	//optionally look for candidate superinstructions
+	Toy_OpcodeProfile profile;
+	if (Toy_commandLine.profile) {
+		Toy_initOpcodeProfile(&profile);
+		interpreter.profile = &profile;
+	}
+
+	Toy_runInterpreterShared(&interpreter, source);
 	Toy_freeInterpreter(&interpreter);
+
+	if (Toy_commandLine.profile) {
+		Toy_printOpcodeProfile(&profile, 10, printProfile);
+		Toy_freeOpcodeProfile(&profile);
+	}
 }
 
 void Toy_runBinaryFile(const char* fname) {
-	size_t size = 0; //not used
-	const unsigned char* tb = Toy_readFile(fname, &size);
-	if (!tb) {
+	Toy_RefBytecode* source = Toy_mapBinaryFile(fname);
+	if (!source) {
 		return;
 	}
-	Toy_runBinary(tb, size);
-	//interpreter takes ownership of the binary data
+	Toy_runSharedBinary(source);
+	Toy_deleteRefBytecode(source);
 }
 
 void Toy_runSource(const char* source) {
-	size_t size = 0;
-	const unsigned char* tb = Toy_compileString(source, &size);
+	Toy_RefBytecode* tb = Toy_compileCached(source);
 	if (!tb) {
 		return;
 	}
 
-	Toy_runBinary(tb, size);
+	Toy_runSharedBinary(tb);
+	Toy_deleteRefBytecode(tb);
 }
 
 void Toy_runSourceFile(const char* fname) {
@@ -0,0 +1,84 @@
+#include "toy_arena.h"
+
+#include "toy_memory.h"
+
+#include <string.h>
+
+//everything handed out is aligned for pointers & literals
+#define ALIGN(size) (((size) + 7) & ~(size_t)7)
+
+static Toy_ArenaBlock* allocateBlock(size_t capacity) {
+	Toy_ArenaBlock* block = (Toy_ArenaBlock*)Toy_reallocate(NULL, 0, sizeof(Toy_ArenaBlock) + capacity);
+
+	block->next = NULL;
+	block->capacity = capacity;
+	block->count = 0;
+
+	return block;
+}
+
+void Toy_initArena(Toy_Arena* arena, size_t blockSize) {
+	arena->blocks = NULL;
+	arena->blockSize = blockSize;
+}
+
+void* Toy_allocateArena(Toy_Arena* arena, size_t size) {
+	size = ALIGN(size);
+
+	//oversized requests get a block of their own, behind the one being filled
+	if (size > arena->blockSize) {
+		Toy_ArenaBlock* block = allocateBlock(size);
+		block->count = size;
+
+		if (arena->blocks == NULL) {
+			arena->blocks = block;
+		}
+		else {
+			block->next = arena->blocks->next;
+			arena->blocks->next = block;
+		}
+
+		return block->data;
+	}
+
+	if (arena->blocks == NULL || arena->blocks->count + size > arena->blocks->capacity) {
+		Toy_ArenaBlock* block = allocateBlock(arena->blockSize);
+		block->next = arena->blocks;
+		arena->blocks = block;
+	}
+
+	void* ptr = arena->blocks->data + arena->blocks->count;
+	arena->blocks->count += size;
+
+	return ptr;
+}
+
+void* Toy_growArena(Toy_Arena* arena, void* pointer, size_t oldSize, size_t newSize) {
+	if (pointer == NULL) {
+		return Toy_allocateArena(arena, newSize);
+	}
+
+	oldSize = ALIGN(oldSize);
+	newSize = ALIGN(newSize);
+
+	//the last allocation can simply be extended
+	Toy_ArenaBlock* block = arena->blocks;
+	if ((unsigned char*)pointer + oldSize == block->data + block->count && block->count - oldSize + newSize <= block->capacity) {
+		block->count = block->count - oldSize + newSize;
+		return pointer;
+	}
+
+	//otherwise, move it - the old space is released with everything else
+	void* ptr = Toy_allocateArena(arena, newSize);
+	memcpy(ptr, pointer, oldSize < newSize ? oldSize : newSize);
+
+	return ptr;
+}
+
+void Toy_freeArena(Toy_Arena* arena) {
+	while (arena->blocks != NULL) {
+		Toy_ArenaBlock* next = arena->blocks->next;
+		Toy_reallocate(arena->blocks, sizeof(Toy_ArenaBlock) + arena->blocks->capacity, 0);
+		arena->blocks = next;
+	}
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "toy_common.h"
+
+//an arena hands out memory from large blocks, which are all released at once - for things that share a lifetime, like the AST
+typedef struct Toy_ArenaBlock {
+	struct Toy_ArenaBlock* next;
+	size_t capacity;
+	size_t count;
+	unsigned char data[];
+} Toy_ArenaBlock;
+
+typedef struct Toy_Arena {
+	Toy_ArenaBlock* blocks; //the first block is the one being filled
+	size_t blockSize;
+} Toy_Arena;
+
+#define TOY_ARENA_ALLOCATE(arena, type, count)						((type*)Toy_allocateArena(arena, sizeof(type) * (count)))
+#define TOY_ARENA_GROW_ARRAY(arena, type, pointer, oldCount, count)	((type*)Toy_growArena(arena, pointer, sizeof(type) * (oldCount), sizeof(type) * (count)))
+
+TOY_API void Toy_initArena(Toy_Arena* arena, size_t blockSize);
+TOY_API void* Toy_allocateArena(Toy_Arena* arena, size_t size);
+TOY_API void* Toy_growArena(Toy_Arena* arena, void* pointer, size_t oldSize, size_t newSize); //grows in place when the pointer was the last thing allocated
+TOY_API void Toy_freeArena(Toy_Arena* arena);
@@ -1,11 +1,9 @@
 #include "toy_ast_node.h"
 
-#include "toy_memory.h"
-
 #include <stdio.h>
 #include <stdlib.h>
 
-static void freeASTNodeCustom(Toy_ASTNode* node, bool freeSelf) {
+void Toy_freeASTNode(Toy_ASTNode* node) {
 	//don't free a NULL node
 	if (node == NULL) {
 		return;
@@ -40,20 +38,14 @@ static void freeASTNodeCustom(Toy_ASTNode* node, bool freeSelf) {
 		break;
 
 		case TOY_AST_NODE_BLOCK:
-			if (node->block.capacity > 0) {
-				for (int i = 0; i < node->block.count; i++) {
-					freeASTNodeCustom(node->block.nodes + i, false);
-				}
-				TOY_FREE_ARRAY(Toy_ASTNode, node->block.nodes, node->block.capacity);
+			for (int i = 0; i < node->block.count; i++) {
+				Toy_freeASTNode(node->block.nodes + i);
 			}
 		break;
 
 		case TOY_AST_NODE_COMPOUND:
-			if (node->compound.capacity > 0) {
-				for (int i = 0; i < node->compound.count; i++) {
-					freeASTNodeCustom(node->compound.nodes + i, false);
-				}
-				TOY_FREE_ARRAY(Toy_ASTNode, node->compound.nodes, node->compound.capacity);
+			for (int i = 0; i < node->compound.count; i++) {
+				Toy_freeASTNode(node->compound.nodes + i);
 			}
 		break;
 
@@ -69,22 +61,19 @@ static void freeASTNodeCustom(Toy_ASTNode* node, bool freeSelf) {
 		break;
 
 		case TOY_AST_NODE_VAR_DECL:
-			Toy_freeLiteral(node->varDecl.identifier);
-			Toy_freeLiteral(node->varDecl.typeLiteral);
+			Toy_freeLiteral(*node->varDecl.identifier);
+			Toy_freeLiteral(*node->varDecl.typeLiteral);
 			Toy_freeASTNode(node->varDecl.expression);
 		break;
 
 		case TOY_AST_NODE_FN_COLLECTION:
-			if (node->fnCollection.capacity > 0) {
-				for (int i = 0; i < node->fnCollection.count; i++) {
-					freeASTNodeCustom(node->fnCollection.nodes + i, false);
-				}
-				TOY_FREE_ARRAY(Toy_ASTNode, node->fnCollection.nodes, node->fnCollection.capacity);
+			for (int i = 0; i < node->fnCollection.count; i++) {
+				Toy_freeASTNode(node->fnCollection.nodes + i);
 			}
 		break;
 
 		case TOY_AST_NODE_FN_DECL:
-			Toy_freeLiteral(node->fnDecl.identifier);
+			Toy_freeLiteral(*node->fnDecl.identifier);
 			Toy_freeASTNode(node->fnDecl.arguments);
 			Toy_freeASTNode(node->fnDecl.returns);
 			Toy_freeASTNode(node->fnDecl.block);
@@ -138,44 +127,36 @@ static void freeASTNodeCustom(Toy_ASTNode* node, bool freeSelf) {
 		break;
 
 		case TOY_AST_NODE_IMPORT:
-			Toy_freeLiteral(node->import.identifier);
-			Toy_freeLiteral(node->import.alias);
+			Toy_freeLiteral(*node->import.identifier);
+			Toy_freeLiteral(*node->import.alias);
 		break;
 
 		case TOY_AST_NODE_PASS:
 			//EMPTY
 		break;
 	}
-
-	if (freeSelf) {
-		TOY_FREE(Toy_ASTNode, node);
-	}
-}
-
-void Toy_freeASTNode(Toy_ASTNode* node) {
-	freeASTNodeCustom(node, true);
 }
 
 //various emitters
-void Toy_emitASTNodeLiteral(Toy_ASTNode** nodeHandle, Toy_Literal literal) {
+void Toy_emitASTNodeLiteral(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_Literal literal) {
 	//allocate a new node
-	*nodeHandle = TOY_ALLOCATE(Toy_ASTNode, 1);
+	*nodeHandle = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	(*nodeHandle)->type = TOY_AST_NODE_LITERAL;
 	(*nodeHandle)->atomic.literal = Toy_copyLiteral(literal);
 }
 
-void Toy_emitASTNodeUnary(Toy_ASTNode** nodeHandle, Toy_Opcode opcode, Toy_ASTNode* child) {
+void Toy_emitASTNodeUnary(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_Opcode opcode, Toy_ASTNode* child) {
 	//allocate a new node
-	*nodeHandle = TOY_ALLOCATE(Toy_ASTNode, 1);
+	*nodeHandle = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	(*nodeHandle)->type = TOY_AST_NODE_UNARY;
 	(*nodeHandle)->unary.opcode = opcode;
 	(*nodeHandle)->unary.child = child;
 }
 
-void Toy_emitASTNodeBinary(Toy_ASTNode** nodeHandle, Toy_ASTNode* rhs, Toy_Opcode opcode) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeBinary(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* rhs, Toy_Opcode opcode) {
+	Toy_ASTNode* tmp = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	tmp->type = TOY_AST_NODE_BINARY;
 	tmp->binary.opcode = opcode;
@@ -185,8 +166,8 @@ void Toy_emitASTNodeBinary(Toy_ASTNode** nodeHandle, Toy_ASTNode* rhs, Toy_Opcod
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeTernary(Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath, Toy_ASTNode* elsePath) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeTernary(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath, Toy_ASTNode* elsePath) {
+	Toy_ASTNode* tmp = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	tmp->type = TOY_AST_NODE_TERNARY;
 	tmp->ternary.condition = condition;
@@ -196,8 +177,8 @@ void Toy_emitASTNodeTernary(Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, To
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeGrouping(Toy_ASTNode** nodeHandle) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeGrouping(Toy_Arena* arena, Toy_ASTNode** nodeHandle) {
+	Toy_ASTNode* tmp = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	tmp->type = TOY_AST_NODE_GROUPING;
 	tmp->grouping.child = *nodeHandle;
@@ -205,8 +186,8 @@ void Toy_emitASTNodeGrouping(Toy_ASTNode** nodeHandle) {
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeBlock(Toy_ASTNode** nodeHandle) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeBlock(Toy_Arena* arena, Toy_ASTNode** nodeHandle) {
+	Toy_ASTNode* tmp = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	tmp->type = TOY_AST_NODE_BLOCK;
 	tmp->block.nodes = NULL; //NOTE: appended by the parser
@@ -216,8 +197,8 @@ void Toy_emitASTNodeBlock(Toy_ASTNode** nodeHandle) {
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeCompound(Toy_ASTNode** nodeHandle, Toy_LiteralType literalType) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeCompound(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_LiteralType literalType) {
+	Toy_ASTNode* tmp = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	tmp->type = TOY_AST_NODE_COMPOUND;
 	tmp->compound.literalType = literalType;
@@ -235,8 +216,8 @@ void Toy_setASTNodePair(Toy_ASTNode* node, Toy_ASTNode* left, Toy_ASTNode* right
 	node->pair.right = right;
 }
 
-void Toy_emitASTNodeIndex(Toy_ASTNode** nodeHandle, Toy_ASTNode* first, Toy_ASTNode* second, Toy_ASTNode* third) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeIndex(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* first, Toy_ASTNode* second, Toy_ASTNode* third) {
+	Toy_ASTNode* tmp = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	tmp->type = TOY_AST_NODE_INDEX;
 	tmp->index.first = first;
@@ -246,19 +227,21 @@ void Toy_emitASTNodeIndex(Toy_ASTNode** nodeHandle, Toy_ASTNode* first, Toy_ASTN
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeVarDecl(Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_Literal typeLiteral, Toy_ASTNode* expression) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeVarDecl(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_Literal typeLiteral, Toy_ASTNode* expression) {
+	Toy_ASTNode* tmp = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	tmp->type = TOY_AST_NODE_VAR_DECL;
-	tmp->varDecl.identifier = identifier;
-	tmp->varDecl.typeLiteral = typeLiteral;
+	tmp->varDecl.identifier = TOY_ARENA_ALLOCATE(arena, Toy_Literal, 2);
+	tmp->varDecl.typeLiteral = tmp->varDecl.identifier + 1;
+	*tmp->varDecl.identifier = identifier;
+	*tmp->varDecl.typeLiteral = typeLiteral;
 	tmp->varDecl.expression = expression;
 
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeFnCollection(Toy_ASTNode** nodeHandle) { //a collection of nodes, intended for use with functions
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeFnCollection(Toy_Arena* arena, Toy_ASTNode** nodeHandle) { //a collection of nodes, intended for use with functions
+	Toy_ASTNode* tmp = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	tmp->type = TOY_AST_NODE_FN_COLLECTION;
 	tmp->fnCollection.nodes = NULL;
@@ -268,11 +251,12 @@ void Toy_emitASTNodeFnCollection(Toy_ASTNode** nodeHandle) { //a collection of n
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeFnDecl(Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_ASTNode* arguments, Toy_ASTNode* returns, Toy_ASTNode* block) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeFnDecl(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_ASTNode* arguments, Toy_ASTNode* returns, Toy_ASTNode* block) {
+	Toy_ASTNode* tmp = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	tmp->type = TOY_AST_NODE_FN_DECL;
-	tmp->fnDecl.identifier = identifier;
+	tmp->fnDecl.identifier = TOY_ARENA_ALLOCATE(arena, Toy_Literal, 1);
+	*tmp->fnDecl.identifier = identifier;
 	tmp->fnDecl.arguments = arguments;
 	tmp->fnDecl.returns = returns;
 	tmp->fnDecl.block = block;
@@ -280,8 +264,8 @@ void Toy_emitASTNodeFnDecl(Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeFnCall(Toy_ASTNode** nodeHandle, Toy_ASTNode* arguments) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeFnCall(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* arguments) {
+	Toy_ASTNode* tmp = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	tmp->type = TOY_AST_NODE_FN_CALL;
 	tmp->fnCall.arguments = arguments;
@@ -290,8 +274,8 @@ void Toy_emitASTNodeFnCall(Toy_ASTNode** nodeHandle, Toy_ASTNode* arguments) {
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeFnReturn(Toy_ASTNode** nodeHandle, Toy_ASTNode* returns) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeFnReturn(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* returns) {
+	Toy_ASTNode* tmp = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	tmp->type = TOY_AST_NODE_FN_RETURN;
 	tmp->returns.returns = returns;
@@ -299,8 +283,8 @@ void Toy_emitASTNodeFnReturn(Toy_ASTNode** nodeHandle, Toy_ASTNode* returns) {
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeIf(Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath, Toy_ASTNode* elsePath) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeIf(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath, Toy_ASTNode* elsePath) {
+	Toy_ASTNode* tmp = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	tmp->type = TOY_AST_NODE_IF;
 	tmp->pathIf.condition = condition;
@@ -310,8 +294,8 @@ void Toy_emitASTNodeIf(Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_AST
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeWhile(Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeWhile(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath) {
+	Toy_ASTNode* tmp = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	tmp->type = TOY_AST_NODE_WHILE;
 	tmp->pathWhile.condition = condition;
@@ -320,8 +304,8 @@ void Toy_emitASTNodeWhile(Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeFor(Toy_ASTNode** nodeHandle, Toy_ASTNode* preClause, Toy_ASTNode* condition, Toy_ASTNode* postClause, Toy_ASTNode* thenPath) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeFor(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* preClause, Toy_ASTNode* condition, Toy_ASTNode* postClause, Toy_ASTNode* thenPath) {
+	Toy_ASTNode* tmp = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	tmp->type = TOY_AST_NODE_FOR;
 	tmp->pathFor.preClause = preClause;
@@ -332,24 +316,24 @@ void Toy_emitASTNodeFor(Toy_ASTNode** nodeHandle, Toy_ASTNode* preClause, Toy_AS
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeBreak(Toy_ASTNode** nodeHandle) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeBreak(Toy_Arena* arena, Toy_ASTNode** nodeHandle) {
+	Toy_ASTNode* tmp = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	tmp->type = TOY_AST_NODE_BREAK;
 
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeContinue(Toy_ASTNode** nodeHandle) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeContinue(Toy_Arena* arena, Toy_ASTNode** nodeHandle) {
+	Toy_ASTNode* tmp = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	tmp->type = TOY_AST_NODE_CONTINUE;
 
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodePrefixIncrement(Toy_ASTNode** nodeHandle, Toy_Literal identifier) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodePrefixIncrement(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier) {
+	Toy_ASTNode* tmp = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	tmp->type = TOY_AST_NODE_PREFIX_INCREMENT;
 	tmp->prefixIncrement.identifier = Toy_copyLiteral(identifier);
@@ -357,8 +341,8 @@ void Toy_emitASTNodePrefixIncrement(Toy_ASTNode** nodeHandle, Toy_Literal identi
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodePrefixDecrement(Toy_ASTNode** nodeHandle, Toy_Literal identifier) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodePrefixDecrement(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier) {
+	Toy_ASTNode* tmp = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	tmp->type = TOY_AST_NODE_PREFIX_DECREMENT;
 	tmp->prefixDecrement.identifier = Toy_copyLiteral(identifier);
@@ -366,8 +350,8 @@ void Toy_emitASTNodePrefixDecrement(Toy_ASTNode** nodeHandle, Toy_Literal identi
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodePostfixIncrement(Toy_ASTNode** nodeHandle, Toy_Literal identifier) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodePostfixIncrement(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier) {
+	Toy_ASTNode* tmp = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	tmp->type = TOY_AST_NODE_POSTFIX_INCREMENT;
 	tmp->postfixIncrement.identifier = Toy_copyLiteral(identifier);
@@ -375,8 +359,8 @@ void Toy_emitASTNodePostfixIncrement(Toy_ASTNode** nodeHandle, Toy_Literal ident
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodePostfixDecrement(Toy_ASTNode** nodeHandle, Toy_Literal identifier) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodePostfixDecrement(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier) {
+	Toy_ASTNode* tmp = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	tmp->type = TOY_AST_NODE_POSTFIX_DECREMENT;
 	tmp->postfixDecrement.identifier = Toy_copyLiteral(identifier);
@@ -384,18 +368,20 @@ void Toy_emitASTNodePostfixDecrement(Toy_ASTNode** nodeHandle, Toy_Literal ident
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeImport(Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_Literal alias) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeImport(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_Literal alias) {
+	Toy_ASTNode* tmp = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	tmp->type = TOY_AST_NODE_IMPORT;
-	tmp->import.identifier = Toy_copyLiteral(identifier);
-	tmp->import.alias = Toy_copyLiteral(alias);
+	tmp->import.identifier = TOY_ARENA_ALLOCATE(arena, Toy_Literal, 2);
+	tmp->import.alias = tmp->import.identifier + 1;
+	*tmp->import.identifier = Toy_copyLiteral(identifier);
+	*tmp->import.alias = Toy_copyLiteral(alias);
 
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodePass(Toy_ASTNode** nodeHandle) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodePass(Toy_Arena* arena, Toy_ASTNode** nodeHandle) {
+	Toy_ASTNode* tmp = TOY_ARENA_ALLOCATE(arena, Toy_ASTNode, 1);
 
 	tmp->type = TOY_AST_NODE_PASS;
 
@@ -1,11 +1,12 @@
 #pragma once
 
 #include "toy_common.h"
+#include "toy_arena.h"
 #include "toy_literal.h"
 #include "toy_opcodes.h"
 #include "toy_token_types.h"
 
-//nodes are the intermediaries between parsers and compilers
+//nodes are the intermediaries between parsers and compilers - they live in an arena, which the parser releases all at once
 typedef union Toy_private_node Toy_ASTNode;
 
 typedef enum Toy_ASTNodeType {
@@ -38,7 +39,7 @@ typedef enum Toy_ASTNodeType {
 } Toy_ASTNodeType;
 
 //literals
-void Toy_emitASTNodeLiteral(Toy_ASTNode** nodeHandle, Toy_Literal literal);
+void Toy_emitASTNodeLiteral(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_Literal literal);
 
 typedef struct Toy_NodeLiteral {
 	Toy_ASTNodeType type;
@@ -46,7 +47,7 @@ typedef struct Toy_NodeLiteral {
 } Toy_NodeLiteral;
 
 //unary operator
-void Toy_emitASTNodeUnary(Toy_ASTNode** nodeHandle, Toy_Opcode opcode, Toy_ASTNode* child);
+void Toy_emitASTNodeUnary(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_Opcode opcode, Toy_ASTNode* child);
 
 typedef struct Toy_NodeUnary {
 	Toy_ASTNodeType type;
@@ -55,7 +56,7 @@ typedef struct Toy_NodeUnary {
 } Toy_NodeUnary;
 
 //binary operator
-void Toy_emitASTNodeBinary(Toy_ASTNode** nodeHandle, Toy_ASTNode* rhs, Toy_Opcode opcode); //handled node becomes lhs
+void Toy_emitASTNodeBinary(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* rhs, Toy_Opcode opcode); //handled node becomes lhs
 
 typedef struct Toy_NodeBinary {
 	Toy_ASTNodeType type;
@@ -65,7 +66,7 @@ typedef struct Toy_NodeBinary {
 } Toy_NodeBinary;
 
 //ternary operator
-void Toy_emitASTNodeTernary(Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath, Toy_ASTNode* elsePath);
+void Toy_emitASTNodeTernary(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath, Toy_ASTNode* elsePath);
 
 typedef struct Toy_NodeTernary {
 	Toy_ASTNodeType type;
@@ -75,7 +76,7 @@ typedef struct Toy_NodeTernary {
 } Toy_NodeTernary;
 
 //grouping of other AST nodes
-void Toy_emitASTNodeGrouping(Toy_ASTNode** nodeHandle);
+void Toy_emitASTNodeGrouping(Toy_Arena* arena, Toy_ASTNode** nodeHandle);
 
 typedef struct Toy_NodeGrouping {
 	Toy_ASTNodeType type;
@@ -83,7 +84,7 @@ typedef struct Toy_NodeGrouping {
 } Toy_NodeGrouping;
 
 //block of statement nodes
-void Toy_emitASTNodeBlock(Toy_ASTNode** nodeHandle);
+void Toy_emitASTNodeBlock(Toy_Arena* arena, Toy_ASTNode** nodeHandle);
 
 typedef struct Toy_NodeBlock {
 	Toy_ASTNodeType type;
@@ -93,7 +94,7 @@ typedef struct Toy_NodeBlock {
 } Toy_NodeBlock;
 
 //compound literals (array, dictionary)
-void Toy_emitASTNodeCompound(Toy_ASTNode** nodeHandle, Toy_LiteralType literalType);
+void Toy_emitASTNodeCompound(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_LiteralType literalType);
 
 typedef struct Toy_NodeCompound {
 	Toy_ASTNodeType type;
@@ -111,7 +112,7 @@ typedef struct Toy_NodePair {
 	Toy_ASTNode* right;
 } Toy_NodePair;
 
-void Toy_emitASTNodeIndex(Toy_ASTNode** nodeHandle, Toy_ASTNode* first, Toy_ASTNode* second, Toy_ASTNode* third);
+void Toy_emitASTNodeIndex(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* first, Toy_ASTNode* second, Toy_ASTNode* third);
 
 typedef struct Toy_NodeIndex {
 	Toy_ASTNodeType type;
@@ -121,17 +122,18 @@ typedef struct Toy_NodeIndex {
 } Toy_NodeIndex;
 
 //variable declaration
-void Toy_emitASTNodeVarDecl(Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_Literal type, Toy_ASTNode* expression);
+void Toy_emitASTNodeVarDecl(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_Literal type, Toy_ASTNode* expression);
 
+//NOTE: declarations keep their literals out of line, so every node stays small
 typedef struct Toy_NodeVarDecl {
 	Toy_ASTNodeType type;
-	Toy_Literal identifier;
-	Toy_Literal typeLiteral;
+	Toy_Literal* identifier;
+	Toy_Literal* typeLiteral;
 	Toy_ASTNode* expression;
 } Toy_NodeVarDecl;
 
 //NOTE: fnCollection is used by fnDecl, fnCall and fnReturn
-void Toy_emitASTNodeFnCollection(Toy_ASTNode** nodeHandle);
+void Toy_emitASTNodeFnCollection(Toy_Arena* arena, Toy_ASTNode** nodeHandle);
 
 typedef struct Toy_NodeFnCollection {
 	Toy_ASTNodeType type;
@@ -141,18 +143,18 @@ typedef struct Toy_NodeFnCollection {
 } Toy_NodeFnCollection;
 
 //function declaration
-void Toy_emitASTNodeFnDecl(Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_ASTNode* arguments, Toy_ASTNode* returns, Toy_ASTNode* block);
+void Toy_emitASTNodeFnDecl(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_ASTNode* arguments, Toy_ASTNode* returns, Toy_ASTNode* block);
 
 typedef struct Toy_NodeFnDecl {
 	Toy_ASTNodeType type;
-	Toy_Literal identifier;
+	Toy_Literal* identifier;
 	Toy_ASTNode* arguments;
 	Toy_ASTNode* returns;
 	Toy_ASTNode* block;
 } Toy_NodeFnDecl;
 
 //function call
-void Toy_emitASTNodeFnCall(Toy_ASTNode** nodeHandle, Toy_ASTNode* arguments);
+void Toy_emitASTNodeFnCall(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* arguments);
 
 typedef struct Toy_NodeFnCall {
 	Toy_ASTNodeType type;
@@ -161,7 +163,7 @@ typedef struct Toy_NodeFnCall {
 } Toy_NodeFnCall;
 
 //function return
-void Toy_emitASTNodeFnReturn(Toy_ASTNode** nodeHandle, Toy_ASTNode* returns);
+void Toy_emitASTNodeFnReturn(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* returns);
 
 typedef struct Toy_NodeFnReturn {
 	Toy_ASTNodeType type;
@@ -169,11 +171,11 @@ typedef struct Toy_NodeFnReturn {
 } Toy_NodeFnReturn;
 
 //control flow path - if-else, while, for, break, continue, return
-void Toy_emitASTNodeIf(Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath, Toy_ASTNode* elsePath);
-void Toy_emitASTNodeWhile(Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath);
-void Toy_emitASTNodeFor(Toy_ASTNode** nodeHandle, Toy_ASTNode* preClause, Toy_ASTNode* condition, Toy_ASTNode* postClause, Toy_ASTNode* thenPath);
-void Toy_emitASTNodeBreak(Toy_ASTNode** nodeHandle);
-void Toy_emitASTNodeContinue(Toy_ASTNode** nodeHandle);
+void Toy_emitASTNodeIf(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath, Toy_ASTNode* elsePath);
+void Toy_emitASTNodeWhile(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath);
+void Toy_emitASTNodeFor(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* preClause, Toy_ASTNode* condition, Toy_ASTNode* postClause, Toy_ASTNode* thenPath);
+void Toy_emitASTNodeBreak(Toy_Arena* arena, Toy_ASTNode** nodeHandle);
+void Toy_emitASTNodeContinue(Toy_Arena* arena, Toy_ASTNode** nodeHandle);
 
 typedef struct Toy_NodeIf {
 	Toy_ASTNodeType type;
@@ -205,10 +207,10 @@ typedef struct Toy_NodeContinue {
 } Toy_NodeContinue;
 
 //pre-post increment/decrement
-void Toy_emitASTNodePrefixIncrement(Toy_ASTNode** nodeHandle, Toy_Literal identifier);
-void Toy_emitASTNodePrefixDecrement(Toy_ASTNode** nodeHandle, Toy_Literal identifier);
-void Toy_emitASTNodePostfixIncrement(Toy_ASTNode** nodeHandle, Toy_Literal identifier);
-void Toy_emitASTNodePostfixDecrement(Toy_ASTNode** nodeHandle, Toy_Literal identifier);
+void Toy_emitASTNodePrefixIncrement(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier);
+void Toy_emitASTNodePrefixDecrement(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier);
+void Toy_emitASTNodePostfixIncrement(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier);
+void Toy_emitASTNodePostfixDecrement(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier);
 
 typedef struct Toy_NodePrefixIncrement {
 	Toy_ASTNodeType type;
@@ -231,16 +233,16 @@ typedef struct Toy_NodePostfixDecrement {
 } Toy_NodePostfixDecrement;
 
 //import a library
-void Toy_emitASTNodeImport(Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_Literal alias);
+void Toy_emitASTNodeImport(Toy_Arena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_Literal alias);
 
 typedef struct Toy_NodeImport {
 	Toy_ASTNodeType type;
-	Toy_Literal identifier;
-	Toy_Literal alias;
+	Toy_Literal* identifier;
+	Toy_Literal* alias;
 } Toy_NodeImport;
 
 //for doing nothing
-void Toy_emitASTNodePass(Toy_ASTNode** nodeHandle);
+void Toy_emitASTNodePass(Toy_Arena* arena, Toy_ASTNode** nodeHandle);
 
 union Toy_private_node {
 	Toy_ASTNodeType type;
@@ -270,4 +272,5 @@ union Toy_private_node {
 	Toy_NodeImport import;
 };
 
+//releases the literals held by a node & it's children - the memory itself belongs to the arena
 TOY_API void Toy_freeASTNode(Toy_ASTNode* node);
@@ -0,0 +1,1280 @@
+#include "toy_ast_optimizer.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static void optimizeNode(Toy_ASTOptimizer* optimizer, Toy_ASTNode* node);
+
+//utils
+static bool isFoldable(Toy_Literal literal) {
+	return TOY_IS_BOOLEAN(literal) || TOY_IS_INTEGER(literal) || TOY_IS_FLOAT(literal) || TOY_IS_STRING(literal);
+}
+
+static bool isConstantNode(Toy_ASTNode* node) {
+	return node != NULL && node->type == TOY_AST_NODE_LITERAL && isFoldable(node->atomic.literal);
+}
+
+static bool isIdentifierNode(Toy_ASTNode* node) {
+	return node != NULL && node->type == TOY_AST_NODE_LITERAL && TOY_IS_IDENTIFIER(node->atomic.literal);
+}
+
+//nodes can be stored inline in arrays, so swap the contents instead of the pointers - the replacement must be detached from the node first
+static void replaceNode(Toy_ASTNode* node, Toy_ASTNode* replacement) {
+	Toy_ASTNode tmp = *node;
+	*node = *replacement;
+	*replacement = tmp;
+
+	Toy_freeASTNode(replacement); //frees the old contents
+}
+
+//the parser's arena owns the memory, so replacements are built on the stack and copied in
+static void replaceWithLiteral(Toy_ASTOptimizer* optimizer, Toy_ASTNode* node, Toy_Literal literal) {
+	Toy_ASTNode literalNode;
+	literalNode.type = TOY_AST_NODE_LITERAL;
+	literalNode.atomic.literal = Toy_copyLiteral(literal);
+	replaceNode(node, &literalNode);
+
+	optimizer->nodesFolded++;
+}
+
+static void replaceWithPass(Toy_ASTOptimizer* optimizer, Toy_ASTNode* node) {
+	Toy_ASTNode passNode;
+	passNode.type = TOY_AST_NODE_PASS;
+	replaceNode(node, &passNode);
+
+	optimizer->branchesRemoved++;
+}
+
+//scopes mirror those of the interpreter, but only constants hold values
+static void declareVariable(Toy_ASTOptimizer* optimizer, Toy_Literal identifier, Toy_Literal type, Toy_Literal value) {
+	//anything else only shadows the constants further out, but keeps it's declared type for checking arguments
+	if (!TOY_IS_TYPE(type) || !TOY_AS_TYPE(type).constant || !isFoldable(value)) {
+		Toy_declareScopeVariable(optimizer->scope, identifier, TOY_TO_TYPE_LITERAL(TOY_IS_TYPE(type) ? TOY_AS_TYPE(type).typeOf : TOY_LITERAL_ANY, false));
+		return;
+	}
+
+	//a redefinition is an error at runtime, so leave the original alone
+	if (!Toy_declareScopeVariable(optimizer->scope, identifier, type)) {
+		return;
+	}
+
+	//BUGFIX: the same coercion as the interpreter
+	if (TOY_AS_TYPE(type).typeOf == TOY_LITERAL_FLOAT && TOY_IS_INTEGER(value)) {
+		value = TOY_TO_FLOAT_LITERAL(TOY_AS_INTEGER(value));
+	}
+
+	//if the type doesn't match, the value is left as null - the interpreter will raise the error
+	Toy_setScopeVariable(optimizer->scope, identifier, value, false);
+}
+
+static void declareShadow(Toy_ASTOptimizer* optimizer, Toy_Literal identifier) {
+	declareVariable(optimizer, identifier, TOY_TO_NULL_LITERAL, TOY_TO_NULL_LITERAL);
+}
+
+static Toy_Scope* findDeclaringScope(Toy_ASTOptimizer* optimizer, Toy_Literal identifier) {
+	for (Toy_Scope* scope = optimizer->scope; scope != NULL; scope = scope->ancestor) {
+		if (Toy_existsLiteralDictionary(&scope->variables, identifier)) {
+			return scope;
+		}
+
+		//a function body may run after something further out has been declared
+		if (scope == optimizer->boundary) {
+			return NULL;
+		}
+	}
+
+	return NULL;
+}
+
+static bool findConstant(Toy_ASTOptimizer* optimizer, Toy_Literal identifier, Toy_Literal* valueHandle) {
+	Toy_Scope* scope = findDeclaringScope(optimizer, identifier);
+
+	if (scope == NULL) {
+		return false;
+	}
+
+	Toy_Literal type = Toy_getLiteralDictionary(&scope->types, identifier);
+	Toy_Literal value = Toy_getLiteralDictionary(&scope->variables, identifier);
+
+	bool constant = TOY_AS_TYPE(type).constant && isFoldable(value);
+
+	Toy_freeLiteral(type);
+
+	if (!constant) {
+		Toy_freeLiteral(value);
+		return false;
+	}
+
+	*valueHandle = value;
+	return true;
+}
+
+//the declared type of a variable, or "any" when it isn't known here
+static Toy_LiteralType findType(Toy_ASTOptimizer* optimizer, Toy_Literal identifier) {
+	Toy_Scope* scope = findDeclaringScope(optimizer, identifier);
+
+	if (scope == NULL) {
+		return TOY_LITERAL_ANY;
+	}
+
+	Toy_Literal type = Toy_getLiteralDictionary(&scope->types, identifier);
+	Toy_LiteralType result = TOY_AS_TYPE(type).typeOf;
+	Toy_freeLiteral(type);
+
+	return result;
+}
+
+//"length" is the only builtin without side effects, and can be shadowed like any other variable
+static bool isPureBuiltin(Toy_ASTOptimizer* optimizer, Toy_ASTNode* callee) {
+	if (!isIdentifierNode(callee) || !Toy_equalsRefStringCString(TOY_AS_IDENTIFIER(callee->atomic.literal), "length")) {
+		return false;
+	}
+
+	for (Toy_Scope* scope = optimizer->scope; scope != NULL; scope = scope->ancestor) {
+		if (Toy_existsLiteralDictionary(&scope->variables, callee->atomic.literal)) {
+			return false;
+		}
+
+		//builtins are in the outermost scope, which can't declare them again
+		if (scope == optimizer->boundary && scope->ancestor != NULL) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//folding, which mirrors the interpreter - anything that would cause an error is left for runtime
+static bool foldArithmetic(Toy_Opcode opcode, Toy_Literal lhs, Toy_Literal rhs, Toy_Literal* result) {
+	//special case for string concatenation ONLY
+	if (TOY_IS_STRING(lhs) && TOY_IS_STRING(rhs) && opcode == TOY_OP_ADDITION) {
+		int totalLength = TOY_AS_STRING(lhs)->length + TOY_AS_STRING(rhs)->length;
+		if (totalLength > TOY_MAX_STRING_LENGTH) {
+			return false;
+		}
+
+		char buffer[TOY_MAX_STRING_LENGTH + 1];
+		snprintf(buffer, TOY_MAX_STRING_LENGTH + 1, "%s%s", Toy_toCString(TOY_AS_STRING(lhs)), Toy_toCString(TOY_AS_STRING(rhs)));
+		*result = TOY_TO_STRING_LITERAL(Toy_createRefStringLength(buffer, totalLength));
+		return true;
+	}
+
+	//type coersion
+	if (TOY_IS_FLOAT(lhs) && TOY_IS_INTEGER(rhs)) {
+		rhs = TOY_TO_FLOAT_LITERAL(TOY_AS_INTEGER(rhs));
+	}
+
+	if (TOY_IS_INTEGER(lhs) && TOY_IS_FLOAT(rhs)) {
+		lhs = TOY_TO_FLOAT_LITERAL(TOY_AS_INTEGER(lhs));
+	}
+
+	if (TOY_IS_INTEGER(lhs) && TOY_IS_INTEGER(rhs)) {
+		switch(opcode) {
+			case TOY_OP_ADDITION:
+				*result = TOY_TO_INTEGER_LITERAL( TOY_AS_INTEGER(lhs) + TOY_AS_INTEGER(rhs) );
+				return true;
+
+			case TOY_OP_SUBTRACTION:
+				*result = TOY_TO_INTEGER_LITERAL( TOY_AS_INTEGER(lhs) - TOY_AS_INTEGER(rhs) );
+				return true;
+
+			case TOY_OP_MULTIPLICATION:
+				*result = TOY_TO_INTEGER_LITERAL( TOY_AS_INTEGER(lhs) * TOY_AS_INTEGER(rhs) );
+				return true;
+
+			case TOY_OP_DIVISION:
+				if (TOY_AS_INTEGER(rhs) == 0) {
+					return false;
+				}
+				*result = TOY_TO_INTEGER_LITERAL( TOY_AS_INTEGER(lhs) / TOY_AS_INTEGER(rhs) );
+				return true;
+
+			case TOY_OP_MODULO:
+				if (TOY_AS_INTEGER(rhs) == 0) {
+					return false;
+				}
+				*result = TOY_TO_INTEGER_LITERAL( TOY_AS_INTEGER(lhs) % TOY_AS_INTEGER(rhs) );
+				return true;
+
+			default:
+				return false;
+		}
+	}
+
+	if (TOY_IS_FLOAT(lhs) && TOY_IS_FLOAT(rhs)) {
+		switch(opcode) {
+			case TOY_OP_ADDITION:
+				*result = TOY_TO_FLOAT_LITERAL( TOY_AS_FLOAT(lhs) + TOY_AS_FLOAT(rhs) );
+				return true;
+
+			case TOY_OP_SUBTRACTION:
+				*result = TOY_TO_FLOAT_LITERAL( TOY_AS_FLOAT(lhs) - TOY_AS_FLOAT(rhs) );
+				return true;
+
+			case TOY_OP_MULTIPLICATION:
+				*result = TOY_TO_FLOAT_LITERAL( TOY_AS_FLOAT(lhs) * TOY_AS_FLOAT(rhs) );
+				return true;
+
+			case TOY_OP_DIVISION:
+				if (TOY_AS_FLOAT(rhs) == 0) {
+					return false;
+				}
+				*result = TOY_TO_FLOAT_LITERAL( TOY_AS_FLOAT(lhs) / TOY_AS_FLOAT(rhs) );
+				return true;
+
+			default:
+				return false; //including modulo on floats
+		}
+	}
+
+	return false;
+}
+
+static bool foldComparison(Toy_Opcode opcode, Toy_Literal lhs, Toy_Literal rhs, Toy_Literal* result) {
+	if (opcode == TOY_OP_COMPARE_EQUAL || opcode == TOY_OP_COMPARE_NOT_EQUAL) {
+		bool equal = Toy_literalsAreEqual(lhs, rhs);
+		*result = TOY_TO_BOOLEAN_LITERAL(opcode == TOY_OP_COMPARE_EQUAL ? equal : !equal);
+		return true;
+	}
+
+	if (!(TOY_IS_INTEGER(lhs) || TOY_IS_FLOAT(lhs)) || !(TOY_IS_INTEGER(rhs) || TOY_IS_FLOAT(rhs))) {
+		return false;
+	}
+
+	//convert to floats, like the interpreter
+	float l = TOY_IS_INTEGER(lhs) ? (float)TOY_AS_INTEGER(lhs) : TOY_AS_FLOAT(lhs);
+	float r = TOY_IS_INTEGER(rhs) ? (float)TOY_AS_INTEGER(rhs) : TOY_AS_FLOAT(rhs);
+
+	switch(opcode) {
+		case TOY_OP_COMPARE_LESS:
+			*result = TOY_TO_BOOLEAN_LITERAL(l < r);
+			return true;
+
+		case TOY_OP_COMPARE_LESS_EQUAL:
+			*result = TOY_TO_BOOLEAN_LITERAL(l <= r);
+			return true;
+
+		case TOY_OP_COMPARE_GREATER:
+			*result = TOY_TO_BOOLEAN_LITERAL(l > r);
+			return true;
+
+		case TOY_OP_COMPARE_GREATER_EQUAL:
+			*result = TOY_TO_BOOLEAN_LITERAL(l >= r);
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+static bool foldCast(Toy_Literal type, Toy_Literal value, Toy_Literal* result) {
+	if (!TOY_IS_TYPE(type)) {
+		return false;
+	}
+
+	switch(TOY_AS_TYPE(type).typeOf) {
+		case TOY_LITERAL_BOOLEAN:
+			*result = TOY_TO_BOOLEAN_LITERAL(TOY_IS_TRUTHY(value));
+			return true;
+
+		case TOY_LITERAL_INTEGER:
+			if (TOY_IS_BOOLEAN(value)) {
+				*result = TOY_TO_INTEGER_LITERAL(TOY_AS_BOOLEAN(value) ? 1 : 0);
+			}
+			else if (TOY_IS_INTEGER(value)) {
+				*result = value;
+			}
+			else if (TOY_IS_FLOAT(value)) {
+				*result = TOY_TO_INTEGER_LITERAL(TOY_AS_FLOAT(value));
+			}
+			else {
+				int val = 0;
+				sscanf(Toy_toCString(TOY_AS_STRING(value)), "%d", &val);
+				*result = TOY_TO_INTEGER_LITERAL(val);
+			}
+			return true;
+
+		case TOY_LITERAL_FLOAT:
+			if (TOY_IS_BOOLEAN(value)) {
+				*result = TOY_TO_FLOAT_LITERAL(TOY_AS_BOOLEAN(value) ? 1 : 0);
+			}
+			else if (TOY_IS_INTEGER(value)) {
+				*result = TOY_TO_FLOAT_LITERAL(TOY_AS_INTEGER(value));
+			}
+			else if (TOY_IS_FLOAT(value)) {
+				*result = value;
+			}
+			else {
+				float val = 0;
+				sscanf(Toy_toCString(TOY_AS_STRING(value)), "%f", &val);
+				*result = TOY_TO_FLOAT_LITERAL(val);
+			}
+			return true;
+
+		case TOY_LITERAL_STRING: {
+			if (TOY_IS_STRING(value)) {
+				*result = Toy_copyLiteral(value);
+				return true;
+			}
+
+			char buffer[128];
+
+			if (TOY_IS_BOOLEAN(value)) {
+				snprintf(buffer, 128, "%s", TOY_AS_BOOLEAN(value) ? "true" : "false");
+			}
+			else if (TOY_IS_INTEGER(value)) {
+				snprintf(buffer, 128, "%d", TOY_AS_INTEGER(value));
+			}
+			else {
+				snprintf(buffer, 128, "%g", TOY_AS_FLOAT(value));
+			}
+
+			*result = TOY_TO_STRING_LITERAL(Toy_createRefStringLength(buffer, strlen(buffer)));
+			return true;
+		}
+
+		default:
+			return false;
+	}
+}
+
+//calls with a literal argument: "length(x)" or "x.length()"
+static bool foldBuiltinCall(Toy_ASTOptimizer* optimizer, Toy_ASTNode* node, Toy_Literal* result) {
+	Toy_ASTNode* callee = NULL;
+	Toy_ASTNode* call = NULL;
+	Toy_Literal argument = TOY_TO_NULL_LITERAL;
+
+	if (node->binary.opcode == TOY_OP_FN_CALL) {
+		callee = node->binary.left;
+		call = node->binary.right;
+
+		if (call->type != TOY_AST_NODE_FN_CALL || call->fnCall.argumentCount != 1 || call->fnCall.arguments->fnCollection.count != 1 || !isConstantNode(&call->fnCall.arguments->fnCollection.nodes[0])) {
+			return false;
+		}
+
+		argument = Toy_copyLiteral(call->fnCall.arguments->fnCollection.nodes[0].atomic.literal);
+	}
+	else {
+		//the receiver of a dot is passed as the first argument
+		Toy_ASTNode* right = node->binary.right;
+
+		if (right->type != TOY_AST_NODE_BINARY || right->binary.opcode != TOY_OP_DOT || right->binary.right->type != TOY_AST_NODE_FN_CALL || right->binary.right->fnCall.argumentCount != 1) {
+			return false;
+		}
+
+		callee = right->binary.left;
+
+		if (isConstantNode(node->binary.left)) {
+			argument = Toy_copyLiteral(node->binary.left->atomic.literal);
+		}
+		else if (!isIdentifierNode(node->binary.left) || !findConstant(optimizer, node->binary.left->atomic.literal, &argument)) {
+			return false;
+		}
+	}
+
+	bool folded = false;
+
+	if (TOY_IS_STRING(argument) && isPureBuiltin(optimizer, callee)) {
+		*result = TOY_TO_INTEGER_LITERAL(TOY_AS_STRING(argument)->length);
+		folded = true;
+	}
+
+	Toy_freeLiteral(argument);
+	return folded;
+}
+
+//inlining - a function like "fn name(a, b) { return expression; }" is replaced by it's expression at direct calls
+#define TOY_INLINE_MAX_NODES 16
+
+typedef struct Toy_private_inline_function {
+	struct Toy_private_inline_function* next;
+	Toy_Literal* parameters;
+	Toy_Literal* types;
+	int count;
+	Toy_Literal returnType; //null when none is given
+	Toy_ASTNode* expression;
+} Toy_InlineFunction;
+
+//the parameters are checked without running the interpreter, so only the simple types are allowed
+static bool isInlineType(Toy_Literal type) {
+	if (!TOY_IS_TYPE(type)) {
+		return false;
+	}
+
+	switch(TOY_AS_TYPE(type).typeOf) {
+		case TOY_LITERAL_ANY:
+		case TOY_LITERAL_BOOLEAN:
+		case TOY_LITERAL_INTEGER:
+		case TOY_LITERAL_FLOAT:
+		case TOY_LITERAL_STRING:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+static bool isParameter(Toy_ASTNode* parameters, Toy_Literal identifier) {
+	for (int i = 0; i < parameters->fnCollection.count; i++) {
+		if (Toy_literalsAreEqual(*parameters->fnCollection.nodes[i].varDecl.identifier, identifier)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static int sumInlineNodes(int lhs, int rhs) {
+	return lhs < 0 || rhs < 0 ? -1 : lhs + rhs;
+}
+
+//the size of an expression, or -1 if it can't be inlined - it can't call anything, assign anything, or read anything but the parameters
+static int countInlineNodes(Toy_ASTNode* node, Toy_ASTNode* parameters) {
+	if (node == NULL) {
+		return -1;
+	}
+
+	switch(node->type) {
+		case TOY_AST_NODE_LITERAL:
+			if (isConstantNode(node) || (isIdentifierNode(node) && isParameter(parameters, node->atomic.literal))) {
+				return 1;
+			}
+			return -1;
+
+		case TOY_AST_NODE_UNARY:
+			if (node->unary.opcode != TOY_OP_NEGATE && node->unary.opcode != TOY_OP_INVERT) {
+				return -1;
+			}
+			return sumInlineNodes(1, countInlineNodes(node->unary.child, parameters));
+
+		case TOY_AST_NODE_BINARY:
+			switch(TOY_GENERIC_OPCODE(node->binary.opcode)) {
+				case TOY_OP_ADDITION:
+				case TOY_OP_SUBTRACTION:
+				case TOY_OP_MULTIPLICATION:
+				case TOY_OP_DIVISION:
+				case TOY_OP_MODULO:
+				case TOY_OP_COMPARE_EQUAL:
+				case TOY_OP_COMPARE_NOT_EQUAL:
+				case TOY_OP_COMPARE_LESS:
+				case TOY_OP_COMPARE_LESS_EQUAL:
+				case TOY_OP_COMPARE_GREATER:
+				case TOY_OP_COMPARE_GREATER_EQUAL:
+				case TOY_OP_AND:
+				case TOY_OP_OR:
+					return sumInlineNodes(1, sumInlineNodes(countInlineNodes(node->binary.left, parameters), countInlineNodes(node->binary.right, parameters)));
+
+				default:
+					return -1;
+			}
+
+		case TOY_AST_NODE_GROUPING:
+			return sumInlineNodes(1, countInlineNodes(node->grouping.child, parameters));
+
+		case TOY_AST_NODE_TERNARY:
+			return sumInlineNodes(1, sumInlineNodes(countInlineNodes(node->ternary.condition, parameters), sumInlineNodes(countInlineNodes(node->ternary.thenPath, parameters), countInlineNodes(node->ternary.elsePath, parameters))));
+
+		default:
+			return -1;
+	}
+}
+
+//copy an expression into the optimizer's arena, substituting the arguments for the parameters of the function (if any)
+static Toy_ASTNode* copyInlineNode(Toy_ASTOptimizer* optimizer, Toy_ASTNode* node, Toy_InlineFunction* fn, Toy_ASTNode* arguments) {
+	Toy_ASTNode* copy = TOY_ARENA_ALLOCATE(&optimizer->arena, Toy_ASTNode, 1);
+	*copy = *node;
+
+	switch(node->type) {
+		case TOY_AST_NODE_LITERAL: {
+			Toy_Literal literal = node->atomic.literal;
+
+			for (int i = 0; fn != NULL && TOY_IS_IDENTIFIER(literal) && i < fn->count; i++) {
+				if (Toy_literalsAreEqual(fn->parameters[i], literal)) {
+					literal = arguments->fnCollection.nodes[i].atomic.literal;
+					break;
+				}
+			}
+
+			copy->atomic.literal = Toy_copyLiteral(literal);
+		}
+		break;
+
+		case TOY_AST_NODE_UNARY:
+			copy->unary.child = copyInlineNode(optimizer, node->unary.child, fn, arguments);
+		break;
+
+		case TOY_AST_NODE_BINARY:
+			copy->binary.left = copyInlineNode(optimizer, node->binary.left, fn, arguments);
+			copy->binary.right = copyInlineNode(optimizer, node->binary.right, fn, arguments);
+		break;
+
+		case TOY_AST_NODE_GROUPING:
+			copy->grouping.child = copyInlineNode(optimizer, node->grouping.child, fn, arguments);
+		break;
+
+		case TOY_AST_NODE_TERNARY:
+			copy->ternary.condition = copyInlineNode(optimizer, node->ternary.condition, fn, arguments);
+			copy->ternary.thenPath = copyInlineNode(optimizer, node->ternary.thenPath, fn, arguments);
+			copy->ternary.elsePath = copyInlineNode(optimizer, node->ternary.elsePath, fn, arguments);
+		break;
+
+		default:
+			//only the nodes counted by countInlineNodes() are recorded
+		break;
+	}
+
+	return copy;
+}
+
+//called once the body has been optimized, with the function's identifier declared in the current scope
+static void recordInlineFunction(Toy_ASTOptimizer* optimizer, Toy_ASTNode* node) {
+	Toy_ASTNode* parameters = node->fnDecl.arguments;
+	Toy_ASTNode* returns = node->fnDecl.returns;
+	Toy_ASTNode* block = node->fnDecl.block;
+
+	//the body must return a single value, and nothing else
+	if (block == NULL || block->type != TOY_AST_NODE_BLOCK || block->block.count != 1 || block->block.nodes[0].type != TOY_AST_NODE_FN_RETURN || block->block.nodes[0].returns.returns->fnCollection.count != 1) {
+		return;
+	}
+
+	//returning "any" is always an error, as the interpreter compares the exact types
+	if (returns->fnCollection.count > 1 || (returns->fnCollection.count == 1 && (!isInlineType(returns->fnCollection.nodes[0].atomic.literal) || TOY_AS_TYPE(returns->fnCollection.nodes[0].atomic.literal).typeOf == TOY_LITERAL_ANY))) {
+		return;
+	}
+
+	//no rest parameter, or anything that fails to be declared
+	for (int i = 0; i < parameters->fnCollection.count; i++) {
+		if (!isInlineType(*parameters->fnCollection.nodes[i].varDecl.typeLiteral)) {
+			return;
+		}
+
+		for (int j = 0; j < i; j++) {
+			if (Toy_literalsAreEqual(*parameters->fnCollection.nodes[i].varDecl.identifier, *parameters->fnCollection.nodes[j].varDecl.identifier)) {
+				return;
+			}
+		}
+	}
+
+	Toy_ASTNode* expression = &block->block.nodes[0].returns.returns->fnCollection.nodes[0];
+	int size = countInlineNodes(expression, parameters);
+
+	if (size < 0 || size > TOY_INLINE_MAX_NODES) {
+		return;
+	}
+
+	//the parser's nodes are freed after compiling, so keep copies
+	Toy_InlineFunction* fn = TOY_ARENA_ALLOCATE(&optimizer->arena, Toy_InlineFunction, 1);
+
+	fn->count = parameters->fnCollection.count;
+	fn->parameters = TOY_ARENA_ALLOCATE(&optimizer->arena, Toy_Literal, fn->count);
+	fn->types = TOY_ARENA_ALLOCATE(&optimizer->arena, Toy_Literal, fn->count);
+
+	for (int i = 0; i < fn->count; i++) {
+		fn->parameters[i] = Toy_copyLiteral(*parameters->fnCollection.nodes[i].varDecl.identifier);
+		fn->types[i] = Toy_copyLiteral(*parameters->fnCollection.nodes[i].varDecl.typeLiteral);
+	}
+
+	fn->returnType = returns->fnCollection.count == 1 ? Toy_copyLiteral(returns->fnCollection.nodes[0].atomic.literal) : TOY_TO_NULL_LITERAL;
+	fn->expression = copyInlineNode(optimizer, expression, NULL, NULL);
+
+	fn->next = optimizer->functions;
+	optimizer->functions = fn;
+
+	//the scope holds the function as it's value, so it's shadowed & forgotten like any other variable
+	Toy_setScopeVariable(optimizer->scope, *node->fnDecl.identifier, TOY_TO_OPAQUE_LITERAL(fn, 0), false);
+}
+
+//whether evaluating an expression always reads a variable - if not, an undeclared argument wouldn't raise an error
+static bool isAlwaysRead(Toy_ASTNode* node, Toy_Literal identifier) {
+	switch(node->type) {
+		case TOY_AST_NODE_LITERAL:
+			return TOY_IS_IDENTIFIER(node->atomic.literal) && Toy_literalsAreEqual(node->atomic.literal, identifier);
+
+		case TOY_AST_NODE_UNARY:
+			return isAlwaysRead(node->unary.child, identifier);
+
+		case TOY_AST_NODE_BINARY:
+			//the right side of a logical operator may be skipped
+			return isAlwaysRead(node->binary.left, identifier) || (node->binary.opcode != TOY_OP_AND && node->binary.opcode != TOY_OP_OR && isAlwaysRead(node->binary.right, identifier));
+
+		case TOY_AST_NODE_GROUPING:
+			return isAlwaysRead(node->grouping.child, identifier);
+
+		case TOY_AST_NODE_TERNARY:
+			return isAlwaysRead(node->ternary.condition, identifier);
+
+		default:
+			return false;
+	}
+}
+
+//the interpreter type checks each argument as it's declared, so the same must be known to pass here
+static bool isInlineArgument(Toy_ASTOptimizer* optimizer, Toy_ASTNode* argument, Toy_Literal type, bool read) {
+	Toy_LiteralType typeOf = TOY_AS_TYPE(type).typeOf;
+
+	if (isConstantNode(argument)) {
+		return typeOf == TOY_LITERAL_ANY || typeOf == argument->atomic.literal.type;
+	}
+
+	//variables of the right type may also be null, which is always allowed
+	if (isIdentifierNode(argument) && read && findDeclaringScope(optimizer, argument->atomic.literal) != NULL) {
+		return typeOf == TOY_LITERAL_ANY || typeOf == findType(optimizer, argument->atomic.literal);
+	}
+
+	return false;
+}
+
+//the type of an expression when it doesn't raise an error, or "any" when it's unknown - variables may also be null
+static Toy_LiteralType inferType(Toy_ASTOptimizer* optimizer, Toy_ASTNode* node, bool* nullable) {
+	*nullable = false;
+
+	switch(node->type) {
+		case TOY_AST_NODE_LITERAL:
+			if (isConstantNode(node)) {
+				return node->atomic.literal.type;
+			}
+
+			if (isIdentifierNode(node)) {
+				*nullable = true;
+				return findType(optimizer, node->atomic.literal);
+			}
+
+			return TOY_LITERAL_ANY;
+
+		case TOY_AST_NODE_UNARY: {
+			//anything but a number or boolean is an error, including null
+			Toy_LiteralType child = inferType(optimizer, node->unary.child, nullable);
+			*nullable = false;
+
+			if (node->unary.opcode == TOY_OP_INVERT) {
+				return TOY_LITERAL_BOOLEAN;
+			}
+
+			return child == TOY_LITERAL_INTEGER || child == TOY_LITERAL_FLOAT ? child : TOY_LITERAL_ANY;
+		}
+
+		case TOY_AST_NODE_BINARY: {
+			bool lhsNullable = false;
+			bool rhsNullable = false;
+			Toy_LiteralType lhs = inferType(optimizer, node->binary.left, &lhsNullable);
+			Toy_LiteralType rhs = inferType(optimizer, node->binary.right, &rhsNullable);
+
+			switch(TOY_GENERIC_OPCODE(node->binary.opcode)) {
+				case TOY_OP_ADDITION:
+					if (lhs == TOY_LITERAL_STRING && rhs == TOY_LITERAL_STRING) {
+						return TOY_LITERAL_STRING;
+					}
+					//fallthrough
+
+				case TOY_OP_SUBTRACTION:
+				case TOY_OP_MULTIPLICATION:
+				case TOY_OP_DIVISION:
+					if (lhs == TOY_LITERAL_INTEGER && rhs == TOY_LITERAL_INTEGER) {
+						return TOY_LITERAL_INTEGER;
+					}
+
+					//type coersion
+					if ((lhs == TOY_LITERAL_INTEGER || lhs == TOY_LITERAL_FLOAT) && (rhs == TOY_LITERAL_INTEGER || rhs == TOY_LITERAL_FLOAT)) {
+						return TOY_LITERAL_FLOAT;
+					}
+
+					return TOY_LITERAL_ANY;
+
+				case TOY_OP_MODULO:
+					return lhs == TOY_LITERAL_INTEGER && rhs == TOY_LITERAL_INTEGER ? TOY_LITERAL_INTEGER : TOY_LITERAL_ANY;
+
+				case TOY_OP_COMPARE_EQUAL:
+				case TOY_OP_COMPARE_NOT_EQUAL:
+				case TOY_OP_COMPARE_LESS:
+				case TOY_OP_COMPARE_LESS_EQUAL:
+				case TOY_OP_COMPARE_GREATER:
+				case TOY_OP_COMPARE_GREATER_EQUAL:
+					return TOY_LITERAL_BOOLEAN;
+
+				//the result is one of the operands
+				case TOY_OP_AND:
+				case TOY_OP_OR:
+					*nullable = lhsNullable || rhsNullable;
+					return lhs == rhs ? lhs : TOY_LITERAL_ANY;
+
+				default:
+					return TOY_LITERAL_ANY;
+			}
+		}
+
+		case TOY_AST_NODE_GROUPING:
+			return inferType(optimizer, node->grouping.child, nullable);
+
+		case TOY_AST_NODE_TERNARY: {
+			bool thenNullable = false;
+			bool elseNullable = false;
+			Toy_LiteralType thenType = inferType(optimizer, node->ternary.thenPath, &thenNullable);
+			Toy_LiteralType elseType = inferType(optimizer, node->ternary.elsePath, &elseNullable);
+
+			*nullable = thenNullable || elseNullable;
+			return thenType == elseType ? thenType : TOY_LITERAL_ANY;
+		}
+
+		default:
+			return TOY_LITERAL_ANY;
+	}
+}
+
+static bool isNumberType(Toy_LiteralType type) {
+	return type == TOY_LITERAL_INTEGER || type == TOY_LITERAL_FLOAT;
+}
+
+//whether an expression may raise an error - a call stops there & returns null, but an inlined expression would stop the whole script
+static bool canRaise(Toy_ASTOptimizer* optimizer, Toy_ASTNode* node) {
+	bool lhsNullable = false;
+	bool rhsNullable = false;
+
+	switch(node->type) {
+		case TOY_AST_NODE_LITERAL:
+			return false;
+
+		case TOY_AST_NODE_UNARY: {
+			Toy_LiteralType child = inferType(optimizer, node->unary.child, &lhsNullable);
+
+			if (lhsNullable || canRaise(optimizer, node->unary.child)) {
+				return true;
+			}
+
+			return node->unary.opcode == TOY_OP_INVERT ? child != TOY_LITERAL_BOOLEAN : !isNumberType(child);
+		}
+
+		case TOY_AST_NODE_BINARY: {
+			if (canRaise(optimizer, node->binary.left) || canRaise(optimizer, node->binary.right)) {
+				return true;
+			}
+
+			Toy_LiteralType lhs = inferType(optimizer, node->binary.left, &lhsNullable);
+			Toy_LiteralType rhs = inferType(optimizer, node->binary.right, &rhsNullable);
+
+			switch(TOY_GENERIC_OPCODE(node->binary.opcode)) {
+				//these take anything
+				case TOY_OP_COMPARE_EQUAL:
+				case TOY_OP_COMPARE_NOT_EQUAL:
+				case TOY_OP_AND:
+				case TOY_OP_OR:
+					return false;
+
+				//the divisor must be a constant other than zero
+				case TOY_OP_DIVISION:
+				case TOY_OP_MODULO: {
+					Toy_Literal divisor = node->binary.right->atomic.literal;
+
+					if (!isConstantNode(node->binary.right) || (TOY_IS_INTEGER(divisor) && TOY_AS_INTEGER(divisor) == 0) || (TOY_IS_FLOAT(divisor) && TOY_AS_FLOAT(divisor) == 0)) {
+						return true;
+					}
+				}
+				//fallthrough
+
+				//only numbers, never null - even strings can be too long to concatenate
+				default: {
+					bool nullable = false;
+					return lhsNullable || rhsNullable || !isNumberType(lhs) || !isNumberType(rhs) || inferType(optimizer, node, &nullable) == TOY_LITERAL_ANY; //modulo on floats
+				}
+			}
+		}
+
+		case TOY_AST_NODE_GROUPING:
+			return canRaise(optimizer, node->grouping.child);
+
+		case TOY_AST_NODE_TERNARY:
+			return canRaise(optimizer, node->ternary.condition) || canRaise(optimizer, node->ternary.thenPath) || canRaise(optimizer, node->ternary.elsePath);
+
+		default:
+			return true;
+	}
+}
+
+//"name(x, y)" - there's no call left, so there's no frame to push and nothing counted towards the recursion limit
+static bool inlineCall(Toy_ASTOptimizer* optimizer, Toy_ASTNode* node) {
+	Toy_ASTNode* callee = node->binary.left;
+	Toy_ASTNode* call = node->binary.right;
+
+	if (!optimizer->inlining || !isIdentifierNode(callee) || call->type != TOY_AST_NODE_FN_CALL) {
+		return false;
+	}
+
+	//the function must be the one this name refers to, wherever the call is run
+	Toy_Scope* scope = findDeclaringScope(optimizer, callee->atomic.literal);
+
+	if (scope == NULL) {
+		return false;
+	}
+
+	Toy_Literal value = Toy_getLiteralDictionary(&scope->variables, callee->atomic.literal);
+
+	if (!TOY_IS_OPAQUE(value)) {
+		Toy_freeLiteral(value);
+		return false;
+	}
+
+	Toy_InlineFunction* fn = (Toy_InlineFunction*)TOY_AS_OPAQUE(value);
+	Toy_ASTNode* arguments = call->fnCall.arguments;
+
+	if (call->fnCall.argumentCount != fn->count || arguments->fnCollection.count != fn->count) {
+		return false;
+	}
+
+	for (int i = 0; i < fn->count; i++) {
+		if (!isInlineArgument(optimizer, &arguments->fnCollection.nodes[i], fn->types[i], isAlwaysRead(fn->expression, fn->parameters[i]))) {
+			return false;
+		}
+	}
+
+	Toy_ASTNode* expression = copyInlineNode(optimizer, fn->expression, fn, arguments);
+
+	//errors must stay within the call, like a division by zero
+	if (canRaise(optimizer, expression)) {
+		Toy_freeASTNode(expression);
+		return false;
+	}
+
+	//the interpreter compares the exact type of a returned value, so it must be known to match
+	if (TOY_IS_TYPE(fn->returnType)) {
+		bool nullable = false;
+
+		if (inferType(optimizer, expression, &nullable) != TOY_AS_TYPE(fn->returnType).typeOf || nullable) {
+			Toy_freeASTNode(expression);
+			return false;
+		}
+	}
+
+	replaceNode(node, expression);
+	optimizer->callsInlined++;
+
+	//the arguments may allow it to be folded further
+	optimizeNode(optimizer, node);
+
+	return true;
+}
+
+//node optimizers
+static void optimizeUnary(Toy_ASTOptimizer* optimizer, Toy_ASTNode* node) {
+	//typeof reads the declared type of a variable, not it's value
+	if (node->unary.opcode == TOY_OP_TYPE_OF) {
+		return;
+	}
+
+	optimizeNode(optimizer, node->unary.child);
+
+	if (!isConstantNode(node->unary.child)) {
+		return;
+	}
+
+	Toy_Literal literal = node->unary.child->atomic.literal;
+
+	if (node->unary.opcode == TOY_OP_NEGATE && TOY_IS_INTEGER(literal)) {
+		replaceWithLiteral(optimizer, node, TOY_TO_INTEGER_LITERAL(-TOY_AS_INTEGER(literal)));
+	}
+	else if (node->unary.opcode == TOY_OP_NEGATE && TOY_IS_FLOAT(literal)) {
+		replaceWithLiteral(optimizer, node, TOY_TO_FLOAT_LITERAL(-TOY_AS_FLOAT(literal)));
+	}
+	else if (node->unary.opcode == TOY_OP_INVERT && TOY_IS_BOOLEAN(literal)) {
+		replaceWithLiteral(optimizer, node, TOY_TO_BOOLEAN_LITERAL(!TOY_AS_BOOLEAN(literal)));
+	}
+}
+
+//when both sides are declared as numbers, the interpreter can skip the checks & coercions
+static void specializeBinary(Toy_ASTOptimizer* optimizer, Toy_ASTNode* node) {
+	bool nullable = false;
+	Toy_LiteralType lhs = inferType(optimizer, node->binary.left, &nullable);
+	Toy_LiteralType rhs = inferType(optimizer, node->binary.right, &nullable);
+
+	bool integers = lhs == TOY_LITERAL_INTEGER && rhs == TOY_LITERAL_INTEGER;
+	bool floats = (lhs == TOY_LITERAL_FLOAT && (rhs == TOY_LITERAL_INTEGER || rhs == TOY_LITERAL_FLOAT)) || (rhs == TOY_LITERAL_FLOAT && lhs == TOY_LITERAL_INTEGER);
+
+	Toy_Opcode opcode = node->binary.opcode;
+
+	//WARNING: enum trickery
+	if (integers && opcode >= TOY_OP_ADDITION && opcode <= TOY_OP_MODULO) {
+		node->binary.opcode = TOY_OP_ADDITION_INT + (opcode - TOY_OP_ADDITION);
+	}
+	else if (floats && opcode >= TOY_OP_ADDITION && opcode <= TOY_OP_DIVISION) {
+		node->binary.opcode = TOY_OP_ADDITION_FLOAT + (opcode - TOY_OP_ADDITION);
+	}
+	else if (integers && opcode >= TOY_OP_COMPARE_LESS && opcode <= TOY_OP_COMPARE_GREATER_EQUAL) {
+		node->binary.opcode = TOY_OP_COMPARE_LESS_INT + (opcode - TOY_OP_COMPARE_LESS);
+	}
+}
+
+static void optimizeBinary(Toy_ASTOptimizer* optimizer, Toy_ASTNode* node) {
+	Toy_Opcode opcode = TOY_GENERIC_OPCODE(node->binary.opcode); //nodes can be optimized again after inlining
+	Toy_Literal result = TOY_TO_NULL_LITERAL;
+	bool folded = false;
+
+	switch(opcode) {
+		case TOY_OP_VAR_ASSIGN:
+		case TOY_OP_VAR_ADDITION_ASSIGN:
+		case TOY_OP_VAR_SUBTRACTION_ASSIGN:
+		case TOY_OP_VAR_MULTIPLICATION_ASSIGN:
+		case TOY_OP_VAR_DIVISION_ASSIGN:
+		case TOY_OP_VAR_MODULO_ASSIGN:
+			//the left side is the target, not a value
+			optimizeNode(optimizer, node->binary.right);
+			return;
+
+		case TOY_OP_FN_CALL:
+		case TOY_OP_DOT:
+		case TOY_OP_INDEX:
+			//identifiers on the left are called or indexed, rather than read
+			if (!isIdentifierNode(node->binary.left)) {
+				optimizeNode(optimizer, node->binary.left);
+			}
+			optimizeNode(optimizer, node->binary.right);
+
+			if (opcode == TOY_OP_FN_CALL && inlineCall(optimizer, node)) {
+				return;
+			}
+
+			if (opcode != TOY_OP_INDEX) {
+				folded = foldBuiltinCall(optimizer, node, &result);
+			}
+		break;
+
+		case TOY_OP_GROUPING_BEGIN:
+			//casts are wrapped in this by the parser - drop the wrapper once the cast is gone
+			optimizeNode(optimizer, node->binary.right);
+
+			if (node->binary.left->type == TOY_AST_NODE_LITERAL && TOY_IS_TYPE(node->binary.left->atomic.literal) && isConstantNode(node->binary.right)) {
+				result = Toy_copyLiteral(node->binary.right->atomic.literal);
+				folded = true;
+			}
+		break;
+
+		case TOY_OP_TYPE_CAST:
+			optimizeNode(optimizer, node->binary.right);
+
+			if (node->binary.left->type == TOY_AST_NODE_LITERAL && isConstantNode(node->binary.right)) {
+				folded = foldCast(node->binary.left->atomic.literal, node->binary.right->atomic.literal, &result);
+			}
+		break;
+
+		default:
+			optimizeNode(optimizer, node->binary.left);
+			optimizeNode(optimizer, node->binary.right);
+
+			if (!isConstantNode(node->binary.left) || !isConstantNode(node->binary.right)) {
+				specializeBinary(optimizer, node);
+				return;
+			}
+
+			Toy_Literal lhs = node->binary.left->atomic.literal;
+			Toy_Literal rhs = node->binary.right->atomic.literal;
+
+			switch(opcode) {
+				case TOY_OP_ADDITION:
+				case TOY_OP_SUBTRACTION:
+				case TOY_OP_MULTIPLICATION:
+				case TOY_OP_DIVISION:
+				case TOY_OP_MODULO:
+					folded = foldArithmetic(opcode, lhs, rhs, &result);
+				break;
+
+				case TOY_OP_COMPARE_EQUAL:
+				case TOY_OP_COMPARE_NOT_EQUAL:
+				case TOY_OP_COMPARE_LESS:
+				case TOY_OP_COMPARE_LESS_EQUAL:
+				case TOY_OP_COMPARE_GREATER:
+				case TOY_OP_COMPARE_GREATER_EQUAL:
+					folded = foldComparison(opcode, lhs, rhs, &result);
+				break;
+
+				//short-circuit support - the result is one of the operands
+				case TOY_OP_AND:
+					result = Toy_copyLiteral(TOY_IS_TRUTHY(lhs) ? rhs : lhs);
+					folded = true;
+				break;
+
+				case TOY_OP_OR:
+					result = Toy_copyLiteral(TOY_IS_TRUTHY(lhs) ? lhs : rhs);
+					folded = true;
+				break;
+
+				default:
+				break;
+			}
+		break;
+	}
+
+	if (folded) {
+		replaceWithLiteral(optimizer, node, result);
+		Toy_freeLiteral(result);
+	}
+}
+
+//a declaration as the only statement of a branch is conditional, so it can't be relied on afterwards
+static void optimizeBranch(Toy_ASTOptimizer* optimizer, Toy_ASTNode* node) {
+	if (node != NULL && node->type == TOY_AST_NODE_VAR_DECL) {
+		optimizeNode(optimizer, node->varDecl.expression);
+		declareShadow(optimizer, *node->varDecl.identifier);
+		return;
+	}
+
+	optimizeNode(optimizer, node);
+}
+
+//replace a branching node with one of it's paths, then carry on as if it was always there
+static void takeBranch(Toy_ASTOptimizer* optimizer, Toy_ASTNode* node, Toy_ASTNode* path) {
+	if (path == NULL) {
+		replaceWithPass(optimizer, node);
+		return;
+	}
+
+	replaceNode(node, path);
+	optimizer->branchesRemoved++;
+
+	optimizeNode(optimizer, node);
+}
+
+static void optimizeNode(Toy_ASTOptimizer* optimizer, Toy_ASTNode* node) {
+	if (node == NULL) {
+		return;
+	}
+
+	switch(node->type) {
+		case TOY_AST_NODE_LITERAL: {
+			Toy_Literal value = TOY_TO_NULL_LITERAL;
+
+			//constant propagation
+			if (TOY_IS_IDENTIFIER(node->atomic.literal) && findConstant(optimizer, node->atomic.literal, &value)) {
+				replaceWithLiteral(optimizer, node, value);
+				Toy_freeLiteral(value);
+			}
+		}
+		break;
+
+		case TOY_AST_NODE_UNARY:
+			optimizeUnary(optimizer, node);
+		break;
+
+		case TOY_AST_NODE_BINARY:
+			optimizeBinary(optimizer, node);
+		break;
+
+		case TOY_AST_NODE_TERNARY:
+			optimizeNode(optimizer, node->ternary.condition);
+
+			if (isConstantNode(node->ternary.condition)) {
+				Toy_ASTNode* path = TOY_IS_TRUTHY(node->ternary.condition->atomic.literal) ? node->ternary.thenPath : node->ternary.elsePath;
+
+				//detach the path being kept
+				if (path == node->ternary.thenPath) {
+					node->ternary.thenPath = NULL;
+				}
+				else {
+					node->ternary.elsePath = NULL;
+				}
+
+				takeBranch(optimizer, node, path);
+				break;
+			}
+
+			optimizeNode(optimizer, node->ternary.thenPath);
+			optimizeNode(optimizer, node->ternary.elsePath);
+		break;
+
+		case TOY_AST_NODE_GROUPING:
+			optimizeNode(optimizer, node->grouping.child);
+
+			if (isConstantNode(node->grouping.child)) {
+				Toy_ASTNode* child = node->grouping.child;
+				node->grouping.child = NULL;
+				replaceNode(node, child);
+			}
+		break;
+
+		case TOY_AST_NODE_BLOCK: {
+			Toy_Scope* boundary = optimizer->boundary;
+			optimizer->scope = Toy_pushScope(optimizer->scope);
+
+			for (int i = 0; i < node->block.count; i++) {
+				optimizeNode(optimizer, &node->block.nodes[i]);
+			}
+
+			optimizer->scope = Toy_popScope(optimizer->scope);
+			optimizer->boundary = boundary;
+		}
+		break;
+
+		case TOY_AST_NODE_INDEX:
+			optimizeNode(optimizer, node->index.first);
+			optimizeNode(optimizer, node->index.second);
+			optimizeNode(optimizer, node->index.third);
+		break;
+
+		case TOY_AST_NODE_VAR_DECL:
+			optimizeNode(optimizer, node->varDecl.expression);
+			declareVariable(optimizer, *node->varDecl.identifier, *node->varDecl.typeLiteral, node->varDecl.expression != NULL && node->varDecl.expression->type == TOY_AST_NODE_LITERAL ? node->varDecl.expression->atomic.literal : TOY_TO_NULL_LITERAL);
+		break;
+
+		case TOY_AST_NODE_FN_COLLECTION:
+			for (int i = 0; i < node->fnCollection.count; i++) {
+				optimizeNode(optimizer, &node->fnCollection.nodes[i]);
+			}
+		break;
+
+		case TOY_AST_NODE_FN_DECL: {
+			//a redefinition is an error at runtime, so don't record it
+			bool declared = Toy_declareScopeVariable(optimizer->scope, *node->fnDecl.identifier, TOY_TO_TYPE_LITERAL(TOY_LITERAL_ANY, false));
+
+			//the body only sees constants from where the function is declared
+			Toy_Scope* boundary = optimizer->boundary;
+			optimizer->boundary = optimizer->scope;
+			optimizer->scope = Toy_pushScope(optimizer->scope);
+
+			for (int i = 0; i < node->fnDecl.arguments->fnCollection.count; i++) {
+				Toy_ASTNode* parameter = &node->fnDecl.arguments->fnCollection.nodes[i];
+				declareVariable(optimizer, *parameter->varDecl.identifier, *parameter->varDecl.typeLiteral, TOY_TO_NULL_LITERAL);
+			}
+
+			optimizeNode(optimizer, node->fnDecl.block);
+
+			optimizer->scope = Toy_popScope(optimizer->scope);
+			optimizer->boundary = boundary;
+
+			if (declared && optimizer->inlining) {
+				recordInlineFunction(optimizer, node);
+			}
+		}
+		break;
+
+		case TOY_AST_NODE_FN_CALL:
+			optimizeNode(optimizer, node->fnCall.arguments);
+		break;
+
+		case TOY_AST_NODE_FN_RETURN:
+			optimizeNode(optimizer, node->returns.returns);
+		break;
+
+		case TOY_AST_NODE_IF:
+			optimizeNode(optimizer, node->pathIf.condition);
+
+			if (isConstantNode(node->pathIf.condition)) {
+				Toy_ASTNode* path = NULL;
+
+				if (TOY_IS_TRUTHY(node->pathIf.condition->atomic.literal)) {
+					path = node->pathIf.thenPath;
+					node->pathIf.thenPath = NULL;
+				}
+				else {
+					path = node->pathIf.elsePath;
+					node->pathIf.elsePath = NULL;
+				}
+
+				takeBranch(optimizer, node, path);
+				break;
+			}
+
+			optimizeBranch(optimizer, node->pathIf.thenPath);
+			optimizeBranch(optimizer, node->pathIf.elsePath);
+		break;
+
+		case TOY_AST_NODE_WHILE:
+			optimizeNode(optimizer, node->pathWhile.condition);
+
+			if (isConstantNode(node->pathWhile.condition) && !TOY_IS_TRUTHY(node->pathWhile.condition->atomic.literal)) {
+				replaceWithPass(optimizer, node);
+				break;
+			}
+
+			optimizeBranch(optimizer, node->pathWhile.thenPath);
+		break;
+
+		case TOY_AST_NODE_FOR: {
+			//the clauses have their own scope, and so does the body
+			Toy_Scope* boundary = optimizer->boundary;
+			optimizer->scope = Toy_pushScope(optimizer->scope);
+
+			optimizeNode(optimizer, node->pathFor.preClause);
+			optimizeNode(optimizer, node->pathFor.condition);
+
+			if (isConstantNode(node->pathFor.condition) && !TOY_IS_TRUTHY(node->pathFor.condition->atomic.literal)) {
+				optimizer->scope = Toy_popScope(optimizer->scope);
+				optimizer->boundary = boundary;
+
+				//only the pre-clause is ever run, and a single node is an array of one
+				Toy_ASTNode block;
+				block.type = TOY_AST_NODE_BLOCK;
+				block.block.nodes = node->pathFor.preClause;
+				block.block.capacity = 1;
+				block.block.count = node->pathFor.preClause != NULL ? 1 : 0;
+
+				node->pathFor.preClause = NULL;
+
+				replaceNode(node, &block);
+				optimizer->branchesRemoved++;
+				break;
+			}
+
+			optimizer->scope = Toy_pushScope(optimizer->scope);
+			optimizeNode(optimizer, node->pathFor.thenPath);
+			optimizer->scope = Toy_popScope(optimizer->scope);
+
+			optimizeNode(optimizer, node->pathFor.postClause);
+
+			optimizer->scope = Toy_popScope(optimizer->scope);
+			optimizer->boundary = boundary;
+		}
+		break;
+
+		case TOY_AST_NODE_IMPORT:
+			//the names imported here aren't known, so they may shadow anything further out
+			optimizer->boundary = optimizer->scope;
+		break;
+
+		case TOY_AST_NODE_ERROR:
+		case TOY_AST_NODE_COMPOUND:
+		case TOY_AST_NODE_PAIR:
+		case TOY_AST_NODE_BREAK:
+		case TOY_AST_NODE_CONTINUE:
+		case TOY_AST_NODE_PREFIX_INCREMENT:
+		case TOY_AST_NODE_POSTFIX_INCREMENT:
+		case TOY_AST_NODE_PREFIX_DECREMENT:
+		case TOY_AST_NODE_POSTFIX_DECREMENT:
+		case TOY_AST_NODE_PASS:
+			//NO-OP
+		break;
+	}
+}
+
+//exposed functions
+void Toy_initASTOptimizer(Toy_ASTOptimizer* optimizer) {
+	optimizer->scope = Toy_pushScope(NULL);
+	optimizer->boundary = NULL;
+	Toy_initArena(&optimizer->arena, 1024 * 4);
+	optimizer->functions = NULL;
+	optimizer->inlining = true;
+	optimizer->nodesFolded = 0;
+	optimizer->branchesRemoved = 0;
+	optimizer->callsInlined = 0;
+}
+
+void Toy_freeASTOptimizer(Toy_ASTOptimizer* optimizer) {
+	while (optimizer->scope != NULL) {
+		optimizer->scope = Toy_popScope(optimizer->scope);
+	}
+
+	optimizer->boundary = NULL;
+
+	//the arena holds the functions, but not their literals
+	for (Toy_InlineFunction* fn = optimizer->functions; fn != NULL; fn = fn->next) {
+		for (int i = 0; i < fn->count; i++) {
+			Toy_freeLiteral(fn->parameters[i]);
+			Toy_freeLiteral(fn->types[i]);
+		}
+
+		Toy_freeLiteral(fn->returnType);
+		Toy_freeASTNode(fn->expression);
+	}
+
+	optimizer->functions = NULL;
+	Toy_freeArena(&optimizer->arena);
+}
+
+void Toy_optimizeASTNode(Toy_ASTOptimizer* optimizer, Toy_ASTNode* node) {
+	optimizeNode(optimizer, node);
+}
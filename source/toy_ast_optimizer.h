@@ -0,0 +1,24 @@
+#pragma once
+
+#include "toy_common.h"
+#include "toy_arena.h"
+#include "toy_ast_node.h"
+#include "toy_scope.h"
+
+//folds constant expressions, removes dead branches & inlines small functions in the AST, between the parser and the compiler
+typedef struct Toy_ASTOptimizer {
+	Toy_Scope* scope; //the constants (and anything shadowing them) declared so far
+	Toy_Scope* boundary; //lookups stop here, as declarations further out may still change
+	Toy_Arena arena; //copies of the inlined functions, & the nodes substituted from them
+	struct Toy_private_inline_function* functions; //every function small enough to inline
+	bool inlining; //can be disabled for debugging
+	int nodesFolded;
+	int branchesRemoved;
+	int callsInlined;
+} Toy_ASTOptimizer;
+
+TOY_API void Toy_initASTOptimizer(Toy_ASTOptimizer* optimizer);
+TOY_API void Toy_freeASTOptimizer(Toy_ASTOptimizer* optimizer); //NOTE: free the nodes first, as inlined calls are stored in the optimizer's arena
+
+//rewrites each top-level node in place, in the order they are parsed - constants are remembered between calls
+TOY_API void Toy_optimizeASTNode(Toy_ASTOptimizer* optimizer, Toy_ASTNode* node);
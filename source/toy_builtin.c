@@ -1128,17 +1128,17 @@ int Toy_private_index(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments)
 	return -1;
 }
 
-int Toy_private_set(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+int Toy_private_set(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//if wrong number of arguments, fail
-	if (arguments->count != 3) {
+	if (count != 3) {
 		interpreter->errorOutput("Incorrect number of arguments to set\n");
 		return -1;
 	}
 
-	Toy_Literal idn = arguments->literals[0];
-	Toy_Literal obj = arguments->literals[0];
-	Toy_Literal key = arguments->literals[1];
-	Toy_Literal val = arguments->literals[2];
+	Toy_Literal idn = arguments[0];
+	Toy_Literal obj = arguments[0];
+	Toy_Literal key = arguments[1];
+	Toy_Literal val = arguments[2];
 
 	if (!TOY_IS_IDENTIFIER(idn)) {
 		interpreter->errorOutput("Expected identifier in set\n");
@@ -1264,15 +1264,15 @@ int Toy_private_set(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
 	return 0;
 }
 
-int Toy_private_get(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+int Toy_private_get(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//if wrong number of arguments, fail
-	if (arguments->count != 2) {
+	if (count != 2) {
 		interpreter->errorOutput("Incorrect number of arguments to get");
 		return -1;
 	}
 
-	Toy_Literal obj = arguments->literals[0];
-	Toy_Literal key = arguments->literals[1];
+	Toy_Literal obj = arguments[0];
+	Toy_Literal key = arguments[1];
 
 	bool freeObj = false;
 	if (TOY_IS_IDENTIFIER(obj)) {
@@ -1345,16 +1345,16 @@ int Toy_private_get(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
 	}
 }
 
-int Toy_private_push(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+int Toy_private_push(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//if wrong number of arguments, fail
-	if (arguments->count != 2) {
+	if (count != 2) {
 		interpreter->errorOutput("Incorrect number of arguments to push\n");
 		return -1;
 	}
 
-	Toy_Literal idn = arguments->literals[0];
-	Toy_Literal obj = arguments->literals[0];
-	Toy_Literal val = arguments->literals[1];
+	Toy_Literal idn = arguments[0];
+	Toy_Literal obj = arguments[0];
+	Toy_Literal val = arguments[1];
 
 	if (!TOY_IS_IDENTIFIER(idn)) {
 		interpreter->errorOutput("Expected identifier in push\n");
@@ -1420,15 +1420,15 @@ int Toy_private_push(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments)
 	}
 }
 
-int Toy_private_pop(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+int Toy_private_pop(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//if wrong number of arguments, fail
-	if (arguments->count != 1) {
+	if (count != 1) {
 		interpreter->errorOutput("Incorrect number of arguments to pop\n");
 		return -1;
 	}
 
-	Toy_Literal idn = arguments->literals[0];
-	Toy_Literal obj = arguments->literals[0];
+	Toy_Literal idn = arguments[0];
+	Toy_Literal obj = arguments[0];
 
 	if (!TOY_IS_IDENTIFIER(idn)) {
 		interpreter->errorOutput("Expected identifier in pop\n");
@@ -1467,14 +1467,14 @@ int Toy_private_pop(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
 	}
 }
 
-int Toy_private_length(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+int Toy_private_length(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//if wrong number of arguments, fail
-	if (arguments->count != 1) {
+	if (count != 1) {
 		interpreter->errorOutput("Incorrect number of arguments to length\n");
 		return -1;
 	}
 
-	Toy_Literal obj = arguments->literals[0];
+	Toy_Literal obj = arguments[0];
 
 	bool freeObj = false;
 	if (TOY_IS_IDENTIFIER(obj)) {
@@ -1522,15 +1522,15 @@ int Toy_private_length(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments
 	return 1;
 }
 
-int Toy_private_clear(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
+int Toy_private_clear(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
 	//if wrong number of arguments, fail
-	if (arguments->count != 1) {
+	if (count != 1) {
 		interpreter->errorOutput("Incorrect number of arguments to clear\n");
 		return -1;
 	}
 
-	Toy_Literal idn = arguments->literals[0];
-	Toy_Literal obj = arguments->literals[0];
+	Toy_Literal idn = arguments[0];
+	Toy_Literal obj = arguments[0];
 
 	if (!TOY_IS_IDENTIFIER(idn)) {
 		interpreter->errorOutput("expected identifier in clear\n");
@@ -1592,3 +1592,22 @@ int Toy_private_clear(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments)
 	Toy_freeLiteral(obj);
 	return 1;
 }
+
+const Toy_Builtin Toy_private_builtins[TOY_BUILTIN_COUNT] = {
+	{ "set", Toy_private_set },
+	{ "get", Toy_private_get },
+	{ "push", Toy_private_push },
+	{ "pop", Toy_private_pop },
+	{ "length", Toy_private_length },
+	{ "clear", Toy_private_clear },
+};
+
+int Toy_private_findBuiltin(Toy_RefString* name) {
+	for (int i = 0; i < TOY_BUILTIN_COUNT; i++) {
+		if (Toy_equalsRefStringCString(name, Toy_private_builtins[i].name)) {
+			return i;
+		}
+	}
+
+	return -1;
+}
@@ -5,10 +5,23 @@
 //the _index function is a historical oddity - it's used whenever a compound is indexed
 int Toy_private_index(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments);
 
-//globally available native functions
-int Toy_private_set(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments);
-int Toy_private_get(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments);
-int Toy_private_push(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments);
-int Toy_private_pop(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments);
-int Toy_private_length(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments);
-int Toy_private_clear(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments);
+//globally available native functions, which read their arguments in place
+int Toy_private_set(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count);
+int Toy_private_get(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count);
+int Toy_private_push(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count);
+int Toy_private_pop(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count);
+int Toy_private_length(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count);
+int Toy_private_clear(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count);
+
+//the globally available natives, in the order of their indexes after TOY_OP_BUILTIN
+typedef struct Toy_Builtin {
+	char* name;
+	Toy_NativeViewFn fn;
+} Toy_Builtin;
+
+#define TOY_BUILTIN_COUNT 6
+
+extern const Toy_Builtin Toy_private_builtins[TOY_BUILTIN_COUNT];
+
+//returns the index of the builtin with this name, or -1
+int Toy_private_findBuiltin(Toy_RefString* name);
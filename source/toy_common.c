@@ -1,6 +1,7 @@
 #include "toy_common.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 
@@ -28,8 +29,15 @@ Toy_CommandLine Toy_commandLine = {
 	.outfile = "out.tb",
 	.source = NULL,
 	.initialfile = NULL,
+	.batchfile = NULL,
+	.jobs = 0,
+	.cachedir = NULL,
 	.enablePrintNewline = true,
-	.verbose = false
+	.verbose = false,
+	.optimize = false,
+	.enableInlining = true,
+	.registers = false,
+	.profile = false
 };
 
 void Toy_initCommandLine(int argc, const char* argv[]) {
@@ -89,6 +97,51 @@ void Toy_initCommandLine(int argc, const char* argv[]) {
 			continue;
 		}
 
+		if ((!strcmp(argv[i], "-b") || !strcmp(argv[i], "--batch")) && i + 1 < argc) {
+			Toy_commandLine.batchfile = (char*)argv[i + 1];
+			i++;
+			Toy_commandLine.error = false;
+			continue;
+		}
+
+		if ((!strcmp(argv[i], "-j") || !strcmp(argv[i], "--jobs")) && i + 1 < argc) {
+			Toy_commandLine.jobs = atoi(argv[i + 1]);
+			i++;
+			Toy_commandLine.error = false;
+			continue;
+		}
+
+		if ((!strcmp(argv[i], "-k") || !strcmp(argv[i], "--cache")) && i + 1 < argc) {
+			Toy_commandLine.cachedir = (char*)argv[i + 1];
+			i++;
+			Toy_commandLine.error = false;
+			continue;
+		}
+
+		if (!strcmp(argv[i], "-O") || !strcmp(argv[i], "--optimize")) {
+			Toy_commandLine.optimize = true;
+			Toy_commandLine.error = false;
+			continue;
+		}
+
+		if (!strcmp(argv[i], "--no-inline")) {
+			Toy_commandLine.enableInlining = false;
+			Toy_commandLine.error = false;
+			continue;
+		}
+
+		if (!strcmp(argv[i], "-r") || !strcmp(argv[i], "--registers")) {
+			Toy_commandLine.registers = true;
+			Toy_commandLine.error = false;
+			continue;
+		}
+
+		if (!strcmp(argv[i], "-p") || !strcmp(argv[i], "--profile")) {
+			Toy_commandLine.profile = true;
+			Toy_commandLine.error = false;
+			continue;
+		}
+
 		if (!strcmp(argv[i], "-n")) {
 			Toy_commandLine.enablePrintNewline = false;
 			Toy_commandLine.error = false;
@@ -110,7 +163,7 @@ void Toy_initCommandLine(int argc, const char* argv[]) {
 }
 
 void Toy_usageCommandLine(int argc, const char* argv[]) {
-	printf("Usage: %s [ file.tb | -h | -v | -d | -f file.toy | -i source | -c file.toy -o out.tb | -t file.toy ]\n\n", argv[0]);
+	printf("Usage: %s [ file.tb | -h | -v | -d | -O | --no-inline | -r | -p | -f file.toy | -i source | -c file.toy -o out.tb | -b manifest -j jobs | -k directory | -t file.toy ]\n\n", argv[0]);
 }
 
 void Toy_helpCommandLine(int argc, const char* argv[]) {
@@ -123,7 +176,14 @@ void Toy_helpCommandLine(int argc, const char* argv[]) {
 	printf("  -i, --input source\t\tParse, compile and execute this given string of source code.\n");
 	printf("  -c, --compile filename\tParse and compile the specified source file into an output file.\n");
 	printf("  -o, --output outfile\t\tName of the output file built with --compile (default: out.tb).\n");
+	printf("  -b, --batch path\t\tCompile every file listed in a manifest, or found in a directory, beside its source.\n");
+	printf("  -j, --jobs count\t\tNumber of threads used by --batch (default: one per processor).\n");
+	printf("  -k, --cache directory\t\tKeep compiled scripts in this directory, to skip compiling them again.\n");
 	printf("  -t, --initial filename\tStart the repl as normal, after first running the given file.\n");
+	printf("  -O, --optimize\t\tRun the bytecode optimizer when compiling.\n");
+	printf("      --no-inline\t\tDon't inline calls to small functions, for debugging.\n");
+	printf("  -r, --registers\t\tCompile function bodies for the register engine, where possible.\n");
+	printf("  -p, --profile\t\t\tCount the opcode sequences executed, and show the most frequent.\n");
 	printf("  -n\t\t\t\tDisable the newline character at the end of the print statement.\n");
 }
 
@@ -5,8 +5,9 @@
 #include <stdint.h>
 
 #define TOY_VERSION_MAJOR 1
-#define TOY_VERSION_MINOR 1
-#define TOY_VERSION_PATCH 2
+#define TOY_VERSION_MINOR 9
+#define TOY_VERSION_PATCH 0
+#define TOY_VERSION_MINOR_MINIMUM 3 //bytecode from earlier versions uses a different layout
 #define TOY_VERSION_BUILD __DATE__ " " __TIME__
 
 //platform/compiler-specific instructions
@@ -41,8 +42,15 @@ typedef struct {
 	char* outfile; //defaults to out.tb
 	char* source;
 	char* initialfile;
+	char* batchfile; //a manifest or directory of files to compile
+	int jobs; //threads used by --batch, 0 for one per processor
+	char* cachedir; //keeps compiled scripts between runs
 	bool enablePrintNewline;
 	bool verbose;
+	bool optimize;
+	bool enableInlining; //small functions are inlined by the AST optimizer
+	bool registers; //function bodies are compiled for the register engine
+	bool profile;
 } Toy_CommandLine;
 
 //these are intended for the repl only, despite using the api prefix
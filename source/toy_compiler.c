@@ -7,20 +7,108 @@
 #include "toy_literal_dictionary.h"
 
 #include "toy_console_colors.h"
+#include "toy_builtin.h"
 
 #include <stdio.h>
 #include <string.h>
+#include <limits.h>
 
 void Toy_initCompiler(Toy_Compiler* compiler) {
 	Toy_initLiteralArray(&compiler->literalCache);
 	compiler->bytecode = NULL;
 	compiler->capacity = 0;
 	compiler->count = 0;
+	Toy_initLiteralArray(&compiler->jumpSites);
+	compiler->literalIndex = NULL;
+	compiler->literalIndexCapacity = 0;
+	compiler->registers = false;
 	compiler->panic = false;
 }
 
+//functions are never equal, and the rest can't be hashed
+static bool isIndexableLiteral(Toy_Literal literal) {
+	switch(literal.type) {
+		case TOY_LITERAL_FUNCTION:
+		case TOY_LITERAL_FUNCTION_NATIVE:
+		case TOY_LITERAL_FUNCTION_HOOK:
+		case TOY_LITERAL_FUNCTION_INTERMEDIATE:
+		case TOY_LITERAL_FUNCTION_ARG_REST:
+		case TOY_LITERAL_OPAQUE:
+		case TOY_LITERAL_INDEX_BLANK:
+			return false;
+
+		default:
+			return true;
+	}
+}
+
+//the slot holding "literal" in the index, or the empty slot where it belongs
+static int findIndexSlot(Toy_Compiler* compiler, Toy_Literal literal) {
+	//mix in the type, as only literals of the same type are merged
+	unsigned int hash = (unsigned int)Toy_hashLiteral(literal) * 31 + literal.type;
+	int slot = hash & (compiler->literalIndexCapacity - 1);
+
+	//linear probing, entries are the cache index + 1, so 0 is empty
+	while (compiler->literalIndex[slot] != 0) {
+		Toy_Literal entry = compiler->literalCache.literals[compiler->literalIndex[slot] - 1];
+
+		if (entry.type == literal.type && Toy_literalsAreEqual(entry, literal)) {
+			return slot;
+		}
+
+		slot = (slot + 1) & (compiler->literalIndexCapacity - 1);
+	}
+
+	return slot;
+}
+
+static void indexLiteral(Toy_Compiler* compiler, int index) {
+	int slot = findIndexSlot(compiler, compiler->literalCache.literals[index]);
+
+	//only the first of any duplicates is found
+	if (compiler->literalIndex[slot] == 0) {
+		compiler->literalIndex[slot] = index + 1;
+	}
+}
+
+//find a literal in the cache that matches the "literal" argument, without scanning the whole cache
+static int findLiteralInCache(Toy_Compiler* compiler, Toy_Literal literal) {
+	if (compiler->literalIndexCapacity == 0 || !isIndexableLiteral(literal)) {
+		return -1;
+	}
+
+	return compiler->literalIndex[findIndexSlot(compiler, literal)] - 1;
+}
+
+static int pushLiteralToCache(Toy_Compiler* compiler, Toy_Literal literal) {
+	int index = Toy_pushLiteralArray(&compiler->literalCache, literal);
+
+	//keep the load below 3/4, rebuilding the index in cache order when it grows
+	if ((compiler->literalCache.count) * 4 > compiler->literalIndexCapacity * 3) {
+		int oldCapacity = compiler->literalIndexCapacity;
+
+		compiler->literalIndexCapacity = TOY_GROW_CAPACITY_FAST(oldCapacity);
+		compiler->literalIndex = TOY_GROW_ARRAY(int, compiler->literalIndex, oldCapacity, compiler->literalIndexCapacity);
+		memset(compiler->literalIndex, 0, sizeof(int) * compiler->literalIndexCapacity);
+
+		for (int i = 0; i < compiler->literalCache.count; i++) {
+			if (isIndexableLiteral(compiler->literalCache.literals[i])) {
+				indexLiteral(compiler, i);
+			}
+		}
+
+		return index;
+	}
+
+	if (isIndexableLiteral(literal)) {
+		indexLiteral(compiler, index);
+	}
+
+	return index;
+}
+
 //separated out, so it can be recursive
-static int writeLiteralTypeToCache(Toy_LiteralArray* literalCache, Toy_Literal literal) {
+static int writeLiteralTypeToCache(Toy_Compiler* compiler, Toy_Literal literal) {
 	bool shouldFree = false;
 
 	//if it's a compound type, recurse and store the results
@@ -34,7 +122,7 @@ static int writeLiteralTypeToCache(Toy_LiteralArray* literalCache, Toy_Literal l
 
 		for (int i = 0; i < TOY_AS_TYPE(literal).count; i++) {
 			//write the values to the cache, and the indexes to the store
-			int subIndex = writeLiteralTypeToCache(literalCache, ((Toy_Literal*)(TOY_AS_TYPE(literal).subtypes))[i]);
+			int subIndex = writeLiteralTypeToCache(compiler, ((Toy_Literal*)(TOY_AS_TYPE(literal).subtypes))[i]);
 
 			Toy_Literal lit = TOY_TO_INTEGER_LITERAL(subIndex);
 			Toy_pushLiteralArray(store, lit);
@@ -48,9 +136,9 @@ static int writeLiteralTypeToCache(Toy_LiteralArray* literalCache, Toy_Literal l
 	}
 
 	//optimisation: check if exactly this literal array exists
-	int index = Toy_findLiteralIndex(literalCache, literal);
+	int index = findLiteralInCache(compiler, literal);
 	if (index < 0) {
-		index = Toy_pushLiteralArray(literalCache, literal);
+		index = pushLiteralToCache(compiler, literal);
 	}
 
 	if (shouldFree) {
@@ -74,9 +162,9 @@ static int writeNodeCompoundToCache(Toy_Compiler* compiler, Toy_ASTNode* node) {
 			switch(node->compound.nodes[i].pair.left->type) {
 				case TOY_AST_NODE_LITERAL: {
 					//keys are literals
-					int key = Toy_findLiteralIndex(&compiler->literalCache, node->compound.nodes[i].pair.left->atomic.literal);
+					int key = findLiteralInCache(compiler, node->compound.nodes[i].pair.left->atomic.literal);
 					if (key < 0) {
-						key = Toy_pushLiteralArray(&compiler->literalCache, node->compound.nodes[i].pair.left->atomic.literal);
+						key = pushLiteralToCache(compiler, node->compound.nodes[i].pair.left->atomic.literal);
 					}
 
 					Toy_Literal literal =  TOY_TO_INTEGER_LITERAL(key);
@@ -103,9 +191,9 @@ static int writeNodeCompoundToCache(Toy_Compiler* compiler, Toy_ASTNode* node) {
 			switch(node->compound.nodes[i].pair.right->type) {
 				case TOY_AST_NODE_LITERAL: {
 					//values are literals
-					int val = Toy_findLiteralIndex(&compiler->literalCache, node->compound.nodes[i].pair.right->atomic.literal);
+					int val = findLiteralInCache(compiler, node->compound.nodes[i].pair.right->atomic.literal);
 					if (val < 0) {
-						val = Toy_pushLiteralArray(&compiler->literalCache, node->compound.nodes[i].pair.right->atomic.literal);
+						val = pushLiteralToCache(compiler, node->compound.nodes[i].pair.right->atomic.literal);
 					}
 
 					Toy_Literal literal = TOY_TO_INTEGER_LITERAL(val);
@@ -117,158 +205,1170 @@ static int writeNodeCompoundToCache(Toy_Compiler* compiler, Toy_ASTNode* node) {
 				case TOY_AST_NODE_COMPOUND: {
 						int val = writeNodeCompoundToCache(compiler, node->compound.nodes[i].pair.right);
 
-						Toy_Literal literal = TOY_TO_INTEGER_LITERAL(val);
-						Toy_pushLiteralArray(store, literal);
-						Toy_freeLiteral(literal);
-				}
+						Toy_Literal literal = TOY_TO_INTEGER_LITERAL(val);
+						Toy_pushLiteralArray(store, literal);
+						Toy_freeLiteral(literal);
+				}
+				break;
+
+				default:
+					fprintf(stderr, TOY_CC_ERROR "[internal] Unrecognized value node type in writeNodeCompoundToCache()\n" TOY_CC_RESET);
+					return -1;
+			}
+		}
+
+		//push the store to the cache, with instructions about how pack it
+		Toy_Literal literal = TOY_TO_DICTIONARY_LITERAL((Toy_LiteralDictionary*)store); //cast from array to dict, because it's intermediate
+		literal.type = TOY_LITERAL_DICTIONARY_INTERMEDIATE; //god damn it - nested in a dictionary
+		index = pushLiteralToCache(compiler, literal);
+		Toy_freeLiteral(literal);
+	}
+
+	else if (node->compound.literalType == TOY_LITERAL_ARRAY) {
+		//ensure each literal value is in the cache, individually
+		for (int i = 0; i < node->compound.count; i++) {
+			switch(node->compound.nodes[i].type) {
+				case TOY_AST_NODE_LITERAL: {
+					//values
+					int val = findLiteralInCache(compiler, node->compound.nodes[i].atomic.literal);
+					if (val < 0) {
+						val = pushLiteralToCache(compiler, node->compound.nodes[i].atomic.literal);
+					}
+
+					Toy_Literal literal = TOY_TO_INTEGER_LITERAL(val);
+					Toy_pushLiteralArray(store, literal);
+					Toy_freeLiteral(literal);
+				}
+				break;
+
+				case TOY_AST_NODE_COMPOUND: {
+					int val = writeNodeCompoundToCache(compiler, &node->compound.nodes[i]);
+
+					Toy_Literal literal = TOY_TO_INTEGER_LITERAL(val);
+					index = Toy_pushLiteralArray(store, literal);
+					Toy_freeLiteral(literal);
+				}
+				break;
+
+				default:
+					fprintf(stderr, TOY_CC_ERROR "[internal] Unrecognized node type in writeNodeCompoundToCache()\n" TOY_CC_RESET);
+					return -1;
+			}
+		}
+
+		//push the store to the cache, with instructions about how pack it
+		Toy_Literal literal = TOY_TO_ARRAY_LITERAL(store);
+		literal.type = TOY_LITERAL_ARRAY_INTERMEDIATE; //god damn it - nested in an array
+		index = pushLiteralToCache(compiler, literal);
+		Toy_freeLiteral(literal);
+	}
+	else {
+		fprintf(stderr, TOY_CC_ERROR "[internal] Unrecognized compound type in writeNodeCompoundToCache()\n" TOY_CC_RESET);
+		return -1;
+	}
+
+	return index;
+}
+
+static int writeNodeCollectionToCache(Toy_Compiler* compiler, Toy_ASTNode* node) {
+	Toy_LiteralArray* store = TOY_ALLOCATE(Toy_LiteralArray, 1);
+	Toy_initLiteralArray(store);
+
+	//ensure each literal value is in the cache, individually
+	for (int i = 0; i < node->fnCollection.count; i++) {
+		switch(node->fnCollection.nodes[i].type) {
+			case TOY_AST_NODE_VAR_DECL: {
+				//write each piece of the declaration to the cache
+				int identifierIndex = pushLiteralToCache(compiler, *node->fnCollection.nodes[i].varDecl.identifier); //store without duplication optimisation
+				int typeIndex = writeLiteralTypeToCache(compiler, *node->fnCollection.nodes[i].varDecl.typeLiteral);
+
+				Toy_Literal identifierLiteral =  TOY_TO_INTEGER_LITERAL(identifierIndex);
+				Toy_pushLiteralArray(store, identifierLiteral);
+				Toy_freeLiteral(identifierLiteral);
+
+				Toy_Literal typeLiteral = TOY_TO_INTEGER_LITERAL(typeIndex);
+				Toy_pushLiteralArray(store, typeLiteral);
+				Toy_freeLiteral(typeLiteral);
+			}
+			break;
+
+			case TOY_AST_NODE_LITERAL: {
+				//write each piece of the declaration to the cache
+				int typeIndex = writeLiteralTypeToCache(compiler, node->fnCollection.nodes[i].atomic.literal);
+
+				Toy_Literal typeLiteral = TOY_TO_INTEGER_LITERAL(typeIndex);
+				Toy_pushLiteralArray(store, typeLiteral);
+				Toy_freeLiteral(typeLiteral);
+			}
+			break;
+
+			default:
+				fprintf(stderr, TOY_CC_ERROR "[internal] Unrecognized node type in writeNodeCollectionToCache()\n" TOY_CC_RESET);
+				return -1;
+		}
+	}
+
+	//store the store
+	Toy_Literal literal = TOY_TO_ARRAY_LITERAL(store);
+	int storeIndex = pushLiteralToCache(compiler, literal);
+	Toy_freeLiteral(literal);
+
+	return storeIndex;
+}
+
+static void growCompiler(Toy_Compiler* compiler, int amount) {
+	if (compiler->count + amount > compiler->capacity) {
+		int oldCapacity = compiler->capacity;
+
+		compiler->capacity = TOY_GROW_CAPACITY_FAST(oldCapacity);
+		compiler->bytecode = TOY_GROW_ARRAY(unsigned char, compiler->bytecode, oldCapacity, compiler->capacity);
+	}
+}
+
+//the narrowest operand that can hold an index
+static int indexWidth(int index) {
+	if (index >= 65536) {
+		return 4;
+	}
+	else if (index >= 256) {
+		return 2;
+	}
+	return 1;
+}
+
+static void writeIndexToCompiler(Toy_Compiler* compiler, int index, int width) {
+	switch(width) {
+		case 1:
+			compiler->bytecode[compiler->count++] = (unsigned char)index; //1 byte
+		break;
+
+		case 2: {
+			unsigned short value = (unsigned short)index;
+			memcpy(compiler->bytecode + compiler->count, &value, sizeof(unsigned short)); //2 bytes
+			compiler->count += sizeof(unsigned short);
+		}
+		break;
+
+		default:
+			memcpy(compiler->bytecode + compiler->count, &index, sizeof(int)); //4 bytes
+			compiler->count += sizeof(int);
+		break;
+	}
+}
+
+static void writeLiteralIndexToCompiler(Toy_Compiler* compiler, int index) {
+	growCompiler(compiler, 1 + sizeof(int));
+
+	int width = indexWidth(index);
+
+	//push a "long" or "wide" index as needed
+	compiler->bytecode[compiler->count++] = width == 1 ? TOY_OP_LITERAL : width == 2 ? TOY_OP_LITERAL_LONG : TOY_OP_LITERAL_WIDE; //1 byte
+	writeIndexToCompiler(compiler, index, width);
+}
+
+static int writeLiteralToCache(Toy_Compiler* compiler, Toy_Literal literal) {
+	//get the index
+	int index = findLiteralInCache(compiler, literal);
+
+	if (index < 0) {
+		if (TOY_IS_TYPE(literal)) {
+			//check for the type literal as value
+			index = writeLiteralTypeToCache(compiler, literal);
+		}
+		else {
+			index = pushLiteralToCache(compiler, literal);
+		}
+	}
+
+	return index;
+}
+
+static int writeLiteralToCompiler(Toy_Compiler* compiler, Toy_Literal literal) {
+	int index = writeLiteralToCache(compiler, literal);
+
+	//push the literal to the bytecode
+	writeLiteralIndexToCompiler(compiler, index);
+
+	return index;
+}
+
+//the callee of "length(x)" or "x.length()" etc. is pushed as the builtin itself, unless it's shadowed at runtime
+static bool writeBuiltinToCompiler(Toy_Compiler* compiler, Toy_ASTNode* node) {
+	if ((node->binary.opcode != TOY_OP_FN_CALL && node->binary.opcode != TOY_OP_DOT) || node->binary.right->type != TOY_AST_NODE_FN_CALL) {
+		return false;
+	}
+
+	Toy_ASTNode* callee = node->binary.left;
+
+	if (callee->type != TOY_AST_NODE_LITERAL || !TOY_IS_IDENTIFIER(callee->atomic.literal)) {
+		return false;
+	}
+
+	int builtin = Toy_private_findBuiltin(TOY_AS_IDENTIFIER(callee->atomic.literal));
+
+	if (builtin < 0) {
+		return false;
+	}
+
+	int index = writeLiteralToCache(compiler, callee->atomic.literal);
+
+	if (index > USHRT_MAX) {
+		return false;
+	}
+
+	unsigned short name = (unsigned short)index;
+
+	growCompiler(compiler, 2 + sizeof(unsigned short));
+	compiler->bytecode[compiler->count++] = TOY_OP_BUILTIN; //1 byte
+	compiler->bytecode[compiler->count++] = (unsigned char)builtin; //1 byte
+	memcpy(compiler->bytecode + compiler->count, &name, sizeof(unsigned short)); //2 bytes
+	compiler->count += sizeof(unsigned short);
+
+	return true;
+}
+
+static void writeJumpTarget(Toy_Compiler* compiler, int site, int target) {
+	memcpy(compiler->bytecode + site, &target, sizeof(int));
+}
+
+//jumps are always written wide, and narrowed when collating if every target fits
+static int writeJumpToCompiler(Toy_Compiler* compiler, Toy_Opcode opcode, int target) {
+	growCompiler(compiler, 1 + sizeof(int));
+
+	compiler->bytecode[compiler->count++] = (unsigned char)opcode; //1 byte
+	int site = compiler->count;
+	writeJumpTarget(compiler, site, target); //4 bytes
+	compiler->count += sizeof(int);
+
+	//remember the jump for later
+	Toy_Literal literal = TOY_TO_INTEGER_LITERAL(site);
+	Toy_pushLiteralArray(&compiler->jumpSites, literal);
+	Toy_freeLiteral(literal);
+
+	return site;
+}
+
+//superinstructions - each replaces a run of opcodes that the profiler found to be common
+static bool writeLiteralPairToCompiler(Toy_Compiler* compiler, Toy_Literal first, Toy_Literal second) {
+	int firstIndex = writeLiteralToCache(compiler, first);
+	int secondIndex = writeLiteralToCache(compiler, second);
+
+	//the fused forms only take 1-byte indexes
+	if (indexWidth(firstIndex) != 1 || indexWidth(secondIndex) != 1) {
+		return false;
+	}
+
+	growCompiler(compiler, 3);
+	compiler->bytecode[compiler->count++] = TOY_OP_LITERAL_PAIR; //1 byte
+	compiler->bytecode[compiler->count++] = (unsigned char)firstIndex; //1 byte
+	compiler->bytecode[compiler->count++] = (unsigned char)secondIndex; //1 byte
+
+	return true;
+}
+
+//"lhs = first op second", instead of three literals, the arithmetic and the assignment
+static bool writeVarArithmeticAssignToCompiler(Toy_Compiler* compiler, Toy_Opcode opcode, Toy_Literal lhs, Toy_Literal first, Toy_Literal second) {
+	int lhsIndex = writeLiteralToCache(compiler, lhs);
+	int firstIndex = writeLiteralToCache(compiler, first);
+	int secondIndex = writeLiteralToCache(compiler, second);
+
+	if (indexWidth(lhsIndex) != 1 || indexWidth(firstIndex) != 1 || indexWidth(secondIndex) != 1) {
+		return false;
+	}
+
+	growCompiler(compiler, 5);
+	compiler->bytecode[compiler->count++] = TOY_OP_VAR_ARITHMETIC_ASSIGN; //1 byte
+	compiler->bytecode[compiler->count++] = (unsigned char)opcode; //1 byte
+	compiler->bytecode[compiler->count++] = (unsigned char)lhsIndex; //1 byte
+	compiler->bytecode[compiler->count++] = (unsigned char)firstIndex; //1 byte
+	compiler->bytecode[compiler->count++] = (unsigned char)secondIndex; //1 byte
+
+	return true;
+}
+
+//"identifier = identifier +/- 1", as written by the increment & decrement operators
+static void writeIncrementToCompiler(Toy_Compiler* compiler, Toy_Literal identifier, Toy_Opcode opcode) {
+	Toy_Literal increment = TOY_TO_INTEGER_LITERAL(1);
+
+	if (writeVarArithmeticAssignToCompiler(compiler, opcode, identifier, identifier, increment)) {
+		return;
+	}
+
+	//push the literal to the stack (twice: add + assign)
+	writeLiteralToCompiler(compiler, identifier);
+	writeLiteralToCompiler(compiler, identifier);
+
+	//push the increment / decrement
+	writeLiteralToCompiler(compiler, increment);
+
+	//push the add or subtract opcode
+	compiler->bytecode[compiler->count++] = (unsigned char)opcode; //1 byte
+
+	//push the assign
+	compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_VAR_ASSIGN; //1 byte
+}
+
+static bool isComparison(Toy_Opcode opcode) {
+	return TOY_GENERIC_OPCODE(opcode) >= TOY_OP_COMPARE_EQUAL && TOY_GENERIC_OPCODE(opcode) <= TOY_OP_COMPARE_GREATER_EQUAL;
+}
+
+//the jump out of an if, while or for - when the condition ends in a comparison, the comparison moves into the jump
+static int writeConditionJumpToCompiler(Toy_Compiler* compiler, Toy_ASTNode* condition) {
+	if (condition->type == TOY_AST_NODE_BINARY && isComparison(condition->binary.opcode) && compiler->count > 0 && compiler->bytecode[compiler->count - 1] == condition->binary.opcode) {
+		compiler->count--; //unwrite the comparison
+
+		int site = writeJumpToCompiler(compiler, TOY_OP_COMPARE_JUMP_WIDE, 0);
+
+		//the compare jump has it's own fast path for integers
+		growCompiler(compiler, 1);
+		compiler->bytecode[compiler->count++] = (unsigned char)TOY_GENERIC_OPCODE(condition->binary.opcode); //1 byte
+
+		return site;
+	}
+
+	return writeJumpToCompiler(compiler, TOY_OP_IF_FALSE_JUMP_WIDE, 0);
+}
+
+//NOTE: jumpOfsets are included, because function arg and return indexes are embedded in the code body i.e. need to include their sizes in the jump
+//NOTE: rootNode should NOT include groupings and blocks
+//the parameters & returns come first in every function, whichever engine runs the body
+static Toy_Compiler* createFunctionCompiler(Toy_Compiler* compiler, Toy_ASTNode* node) {
+	Toy_Compiler* fnCompiler = TOY_ALLOCATE(Toy_Compiler, 1);
+	Toy_initCompiler(fnCompiler);
+	fnCompiler->registers = compiler->registers;
+	Toy_writeCompiler(fnCompiler, node->fnDecl.arguments); //can be empty, but not NULL
+	Toy_writeCompiler(fnCompiler, node->fnDecl.returns); //can be empty, but not NULL
+	return fnCompiler;
+}
+
+//the register code generator - a second back end for function bodies, run over the same nodes
+//anything it doesn't support is left to the stack generator, by failing the whole function
+#define REGISTER_RESULT 0 //holds the result of the latest expression statement, which is returned by default
+#define REGISTER_CONSTANTS 64 //how many constants are loaded into registers when a function is called
+
+typedef struct RegisterLocal {
+	Toy_Literal identifier; //borrowed from the nodes
+	int reg;
+	int depth;
+	bool writable; //typed and constant variables are left to the stack, for their checks
+} RegisterLocal;
+
+typedef struct RegisterCompiler {
+	Toy_Compiler* compiler; //for the literal cache
+	unsigned char* code;
+	int capacity;
+	int count;
+	RegisterLocal locals[TOY_REGISTER_COUNT];
+	int localCount;
+	int depth;
+	int next; //the lowest free register
+	int frameSize;
+	int constants[REGISTER_CONSTANTS]; //literal indexes, loaded into the registers after the result
+	int constantCount;
+	bool collecting; //the first pass only finds the constants, the second writes the code
+	Toy_LiteralArray* breakSites;
+	Toy_LiteralArray* continueSites;
+	bool failed;
+} RegisterCompiler;
+
+static void emitRegisterByte(RegisterCompiler* rc, int byte) {
+	if (rc->count + 1 > rc->capacity) {
+		int oldCapacity = rc->capacity;
+		rc->capacity = TOY_GROW_CAPACITY_FAST(oldCapacity);
+		rc->code = TOY_GROW_ARRAY(unsigned char, rc->code, oldCapacity, rc->capacity);
+	}
+
+	rc->code[rc->count++] = (unsigned char)byte;
+}
+
+static void emitRegisterShort(RegisterCompiler* rc, int value) {
+	//the code is discarded if anything is too large
+	if (value < 0 || value > 0xFFFF) {
+		rc->failed = true;
+	}
+
+	unsigned short bytes = (unsigned short)value;
+	emitRegisterByte(rc, ((unsigned char*)&bytes)[0]);
+	emitRegisterByte(rc, ((unsigned char*)&bytes)[1]);
+}
+
+static int emitRegisterJump(RegisterCompiler* rc) {
+	int site = rc->count;
+	emitRegisterShort(rc, 0);
+	return site;
+}
+
+static void patchRegisterJump(RegisterCompiler* rc, int site, int target) {
+	unsigned short bytes = (unsigned short)target;
+	memcpy(rc->code + site, &bytes, sizeof(unsigned short));
+}
+
+static void patchRegisterJumps(RegisterCompiler* rc, Toy_LiteralArray* sites, int target) {
+	for (int i = 0; i < sites->count; i++) {
+		patchRegisterJump(rc, TOY_AS_INTEGER(sites->literals[i]), target);
+	}
+}
+
+static int pushRegister(RegisterCompiler* rc) {
+	if (rc->next >= TOY_REGISTER_COUNT) {
+		rc->failed = true;
+		return REGISTER_RESULT;
+	}
+
+	if (rc->next + 1 > rc->frameSize) {
+		rc->frameSize = rc->next + 1;
+	}
+
+	return rc->next++;
+}
+
+static int writeRegisterLiteral(RegisterCompiler* rc, Toy_Literal literal) {
+	int index = writeLiteralToCache(rc->compiler, literal);
+
+	if (index > 0xFFFF) {
+		rc->failed = true;
+	}
+
+	return index;
+}
+
+//the register holding a constant, or -1 if there's no room for it
+static int findRegisterConstant(RegisterCompiler* rc, Toy_Literal literal) {
+	int index = writeRegisterLiteral(rc, literal);
+
+	for (int i = 0; i < rc->constantCount; i++) {
+		if (rc->constants[i] == index) {
+			return REGISTER_RESULT + 1 + i;
+		}
+	}
+
+	if (rc->collecting && rc->constantCount < REGISTER_CONSTANTS) {
+		rc->constants[rc->constantCount++] = index;
+		return REGISTER_RESULT + rc->constantCount;
+	}
+
+	return -1;
+}
+
+static RegisterLocal* findRegisterLocal(RegisterCompiler* rc, Toy_Literal identifier) {
+	for (int i = rc->localCount - 1; i >= 0; i--) {
+		if (Toy_literalsAreEqual(rc->locals[i].identifier, identifier)) {
+			return &rc->locals[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void declareRegisterLocal(RegisterCompiler* rc, Toy_Literal identifier, int reg, bool writable) {
+	if (rc->localCount >= TOY_REGISTER_COUNT) {
+		rc->failed = true;
+		return;
+	}
+
+	rc->locals[rc->localCount++] = (RegisterLocal){ .identifier = identifier, .reg = reg, .depth = rc->depth, .writable = writable };
+}
+
+static bool isRegisterValue(Toy_Literal literal) {
+	return TOY_IS_NULL(literal) || TOY_IS_BOOLEAN(literal) || TOY_IS_INTEGER(literal) || TOY_IS_FLOAT(literal) || TOY_IS_STRING(literal);
+}
+
+//the stack only reads a variable once the operator runs, so a global on the left is read after the right side
+static bool isGlobalIdentifier(RegisterCompiler* rc, Toy_ASTNode* node) {
+	while (node->type == TOY_AST_NODE_GROUPING) {
+		node = node->grouping.child;
+	}
+
+	return node->type == TOY_AST_NODE_LITERAL && TOY_IS_IDENTIFIER(node->atomic.literal) && findRegisterLocal(rc, node->atomic.literal) == NULL;
+}
+
+static bool isRegisterBinary(Toy_Opcode opcode) {
+	opcode = TOY_GENERIC_OPCODE(opcode);
+	return (opcode >= TOY_OP_ADDITION && opcode <= TOY_OP_MODULO) || (opcode >= TOY_OP_COMPARE_EQUAL && opcode <= TOY_OP_COMPARE_GREATER_EQUAL) || opcode == TOY_OP_AND || opcode == TOY_OP_OR;
+}
+
+static void emitRegisterMove(RegisterCompiler* rc, int dst, int src) {
+	if (dst != src) {
+		emitRegisterByte(rc, TOY_REG_MOVE);
+		emitRegisterByte(rc, dst);
+		emitRegisterByte(rc, src);
+	}
+}
+
+static void writeRegisterExpression(RegisterCompiler* rc, Toy_ASTNode* node, int dst);
+
+//the register already holding the value of a node, or a new one it's written to
+static int writeRegisterOperand(RegisterCompiler* rc, Toy_ASTNode* node) {
+	while (node->type == TOY_AST_NODE_GROUPING) {
+		node = node->grouping.child;
+	}
+
+	if (node->type == TOY_AST_NODE_LITERAL) {
+		if (TOY_IS_IDENTIFIER(node->atomic.literal)) {
+			RegisterLocal* local = findRegisterLocal(rc, node->atomic.literal);
+			if (local != NULL) {
+				return local->reg;
+			}
+		}
+		else if (isRegisterValue(node->atomic.literal)) {
+			int reg = findRegisterConstant(rc, node->atomic.literal);
+			if (reg >= 0) {
+				return reg;
+			}
+		}
+	}
+
+	int reg = pushRegister(rc);
+	writeRegisterExpression(rc, node, reg);
+	return reg;
+}
+
+static void writeRegisterOperands(RegisterCompiler* rc, Toy_ASTNode* left, Toy_ASTNode* right, int* lhs, int* rhs) {
+	if (isGlobalIdentifier(rc, left)) {
+		*rhs = writeRegisterOperand(rc, right);
+		*lhs = writeRegisterOperand(rc, left);
+	}
+	else {
+		*lhs = writeRegisterOperand(rc, left);
+		*rhs = writeRegisterOperand(rc, right);
+	}
+}
+
+//the jump out of an if, while, for or ternary, returning the site of it's target
+static int writeRegisterConditionJump(RegisterCompiler* rc, Toy_ASTNode* condition) {
+	int top = rc->next;
+	int site;
+
+	if (condition->type == TOY_AST_NODE_BINARY && isComparison(condition->binary.opcode)) {
+		int lhs = 0;
+		int rhs = 0;
+		writeRegisterOperands(rc, condition->binary.left, condition->binary.right, &lhs, &rhs);
+
+		emitRegisterByte(rc, TOY_REG_COMPARE_JUMP);
+		emitRegisterByte(rc, TOY_GENERIC_OPCODE(condition->binary.opcode));
+		emitRegisterByte(rc, lhs);
+		emitRegisterByte(rc, rhs);
+		site = emitRegisterJump(rc);
+	}
+	else {
+		int src = writeRegisterOperand(rc, condition);
+
+		emitRegisterByte(rc, TOY_REG_JUMP_IF_FALSE);
+		emitRegisterByte(rc, src);
+		site = emitRegisterJump(rc);
+	}
+
+	rc->next = top;
+	return site;
+}
+
+//arguments that are locals are named, so natives can reach them through the scope - globals are passed by name, as the stack does
+//a tail call is left for the caller to make, so it must be followed by the return of dst
+static void writeRegisterCall(RegisterCompiler* rc, Toy_ASTNode* node, int dst, bool tail) {
+	Toy_ASTNode* callee = node->binary.left;
+	Toy_ASTNode* arguments = node->binary.right->fnCall.arguments;
+
+	if (callee->type != TOY_AST_NODE_LITERAL || !TOY_IS_IDENTIFIER(callee->atomic.literal) || node->binary.right->fnCall.argumentCount != arguments->fnCollection.count || arguments->fnCollection.count > 255) {
+		rc->failed = true;
+		return;
+	}
+
+	int top = rc->next;
+	int count = arguments->fnCollection.count;
+	int registers[256];
+	int names[256];
+
+	for (int i = 0; i < count; i++) {
+		Toy_ASTNode* argument = &arguments->fnCollection.nodes[i];
+		names[i] = TOY_REGISTER_NO_NAME;
+
+		if (argument->type == TOY_AST_NODE_LITERAL && TOY_IS_IDENTIFIER(argument->atomic.literal)) {
+			RegisterLocal* local = findRegisterLocal(rc, argument->atomic.literal);
+
+			if (local != NULL) {
+				registers[i] = local->reg;
+				names[i] = writeRegisterLiteral(rc, argument->atomic.literal);
+			}
+			else {
+				//the identifier itself, as a constant
+				registers[i] = findRegisterConstant(rc, argument->atomic.literal);
+
+				if (registers[i] < 0) {
+					registers[i] = pushRegister(rc);
+					emitRegisterByte(rc, TOY_REG_LITERAL);
+					emitRegisterByte(rc, registers[i]);
+					emitRegisterShort(rc, writeRegisterLiteral(rc, argument->atomic.literal));
+				}
+			}
+			continue;
+		}
+
+		registers[i] = writeRegisterOperand(rc, argument);
+	}
+
+	//the callee is read last, like the stack
+	int reg = writeRegisterOperand(rc, callee);
+
+	emitRegisterByte(rc, tail ? TOY_REG_TAIL_CALL : TOY_REG_CALL);
+	emitRegisterByte(rc, dst);
+	emitRegisterByte(rc, reg);
+	emitRegisterShort(rc, writeRegisterLiteral(rc, callee->atomic.literal));
+	emitRegisterByte(rc, count);
+
+	for (int i = 0; i < count; i++) {
+		emitRegisterByte(rc, registers[i]);
+		emitRegisterShort(rc, names[i]);
+	}
+
+	rc->next = top;
+}
+
+//"++x" and "x--" etc. - only on variables in registers
+static void writeRegisterIncrement(RegisterCompiler* rc, Toy_Literal identifier, Toy_Opcode opcode, bool prefix, int dst) {
+	RegisterLocal* local = findRegisterLocal(rc, identifier);
+
+	if (local == NULL || !local->writable) {
+		rc->failed = true;
+		return;
+	}
+
+	int top = rc->next;
+	int one = findRegisterConstant(rc, TOY_TO_INTEGER_LITERAL(1));
+
+	if (one < 0) {
+		one = pushRegister(rc);
+		emitRegisterByte(rc, TOY_REG_LITERAL);
+		emitRegisterByte(rc, one);
+		emitRegisterShort(rc, writeRegisterLiteral(rc, TOY_TO_INTEGER_LITERAL(1)));
+	}
+
+	//the old value is kept aside, in case it's being assigned to itself
+	int old = local->reg;
+	if (!prefix) {
+		old = dst == local->reg ? pushRegister(rc) : dst;
+		emitRegisterMove(rc, old, local->reg);
+	}
+
+	emitRegisterByte(rc, TOY_REG_BINARY);
+	emitRegisterByte(rc, opcode);
+	emitRegisterByte(rc, local->reg);
+	emitRegisterByte(rc, local->reg);
+	emitRegisterByte(rc, one);
+
+	emitRegisterMove(rc, dst, prefix ? local->reg : old);
+
+	rc->next = top;
+}
+
+static void writeRegisterExpression(RegisterCompiler* rc, Toy_ASTNode* node, int dst) {
+	int top = rc->next;
+
+	switch(node->type) {
+		case TOY_AST_NODE_LITERAL: {
+			Toy_Literal literal = node->atomic.literal;
+
+			if (TOY_IS_IDENTIFIER(literal)) {
+				RegisterLocal* local = findRegisterLocal(rc, literal);
+
+				if (local != NULL) {
+					emitRegisterMove(rc, dst, local->reg);
+				}
+				else {
+					emitRegisterByte(rc, TOY_REG_GLOBAL);
+					emitRegisterByte(rc, dst);
+					emitRegisterShort(rc, writeRegisterLiteral(rc, literal));
+				}
+			}
+			else if (isRegisterValue(literal)) {
+				int reg = findRegisterConstant(rc, literal);
+
+				if (reg >= 0) {
+					emitRegisterMove(rc, dst, reg);
+				}
+				else {
+					emitRegisterByte(rc, TOY_REG_LITERAL);
+					emitRegisterByte(rc, dst);
+					emitRegisterShort(rc, writeRegisterLiteral(rc, literal));
+				}
+			}
+			else {
+				rc->failed = true;
+			}
+		}
+		break;
+
+		case TOY_AST_NODE_GROUPING:
+			writeRegisterExpression(rc, node->grouping.child, dst);
+		break;
+
+		case TOY_AST_NODE_UNARY: {
+			if (node->unary.opcode != TOY_OP_NEGATE && node->unary.opcode != TOY_OP_INVERT) {
+				rc->failed = true;
+				break;
+			}
+
+			int src = writeRegisterOperand(rc, node->unary.child);
+
+			emitRegisterByte(rc, TOY_REG_UNARY);
+			emitRegisterByte(rc, node->unary.opcode);
+			emitRegisterByte(rc, dst);
+			emitRegisterByte(rc, src);
+		}
+		break;
+
+		case TOY_AST_NODE_BINARY: {
+			if (node->binary.opcode == TOY_OP_FN_CALL) {
+				writeRegisterCall(rc, node, dst, false);
+				break;
+			}
+
+			if (!isRegisterBinary(node->binary.opcode)) {
+				rc->failed = true;
+				break;
+			}
+
+			int lhs = 0;
+			int rhs = 0;
+			writeRegisterOperands(rc, node->binary.left, node->binary.right, &lhs, &rhs);
+
+			emitRegisterByte(rc, TOY_REG_BINARY);
+			emitRegisterByte(rc, TOY_GENERIC_OPCODE(node->binary.opcode));
+			emitRegisterByte(rc, dst);
+			emitRegisterByte(rc, lhs);
+			emitRegisterByte(rc, rhs);
+		}
+		break;
+
+		case TOY_AST_NODE_TERNARY: {
+			int jumpToElse = writeRegisterConditionJump(rc, node->ternary.condition);
+			writeRegisterExpression(rc, node->ternary.thenPath, dst);
+
+			emitRegisterByte(rc, TOY_REG_JUMP);
+			int jumpToEnd = emitRegisterJump(rc);
+
+			patchRegisterJump(rc, jumpToElse, rc->count);
+			writeRegisterExpression(rc, node->ternary.elsePath, dst);
+			patchRegisterJump(rc, jumpToEnd, rc->count);
+		}
+		break;
+
+		case TOY_AST_NODE_PREFIX_INCREMENT:
+			writeRegisterIncrement(rc, node->prefixIncrement.identifier, TOY_OP_ADDITION, true, dst);
+		break;
+
+		case TOY_AST_NODE_PREFIX_DECREMENT:
+			writeRegisterIncrement(rc, node->prefixDecrement.identifier, TOY_OP_SUBTRACTION, true, dst);
+		break;
+
+		case TOY_AST_NODE_POSTFIX_INCREMENT:
+			writeRegisterIncrement(rc, node->postfixIncrement.identifier, TOY_OP_ADDITION, false, dst);
+		break;
+
+		case TOY_AST_NODE_POSTFIX_DECREMENT:
+			writeRegisterIncrement(rc, node->postfixDecrement.identifier, TOY_OP_SUBTRACTION, false, dst);
+		break;
+
+		default:
+			rc->failed = true;
+		break;
+	}
+
+	rc->next = top;
+}
+
+static void writeRegisterStatement(RegisterCompiler* rc, Toy_ASTNode* node);
+
+//blocks are scopes at compile time only - their registers are reused afterwards
+static void writeRegisterScope(RegisterCompiler* rc, Toy_ASTNode* node) {
+	int localCount = rc->localCount;
+	int top = rc->next;
+	rc->depth++;
+
+	writeRegisterStatement(rc, node);
+
+	rc->depth--;
+	rc->next = top;
+	rc->localCount = localCount;
+}
+
+//the stack is cleared after each loop, taking the result of any expression statement with it
+static void writeRegisterLoopEnd(RegisterCompiler* rc) {
+	int reg = findRegisterConstant(rc, TOY_TO_NULL_LITERAL);
+
+	if (reg >= 0) {
+		emitRegisterMove(rc, REGISTER_RESULT, reg);
+	}
+	else {
+		emitRegisterByte(rc, TOY_REG_LITERAL);
+		emitRegisterByte(rc, REGISTER_RESULT);
+		emitRegisterShort(rc, writeRegisterLiteral(rc, TOY_TO_NULL_LITERAL));
+	}
+}
+
+static void writeRegisterStatement(RegisterCompiler* rc, Toy_ASTNode* node) {
+	switch(node->type) {
+		case TOY_AST_NODE_BLOCK: {
+			int localCount = rc->localCount;
+			int top = rc->next;
+			rc->depth++;
+
+			for (int i = 0; i < node->block.count && !rc->failed; i++) {
+				writeRegisterStatement(rc, &node->block.nodes[i]);
+			}
+
+			rc->depth--;
+			rc->next = top;
+			rc->localCount = localCount;
+		}
+		break;
+
+		case TOY_AST_NODE_VAR_DECL: {
+			Toy_Literal type = *node->varDecl.typeLiteral;
+
+			if (TOY_AS_TYPE(type).typeOf != TOY_LITERAL_ANY || TOY_AS_TYPE(type).constant) {
+				rc->failed = true;
+				break;
+			}
+
+			//redeclaring in the same scope is an error, which the stack reports
+			RegisterLocal* local = findRegisterLocal(rc, *node->varDecl.identifier);
+			if (local != NULL && local->depth == rc->depth) {
+				rc->failed = true;
+				break;
+			}
+
+			//the value is found before the variable exists
+			int reg = pushRegister(rc);
+			writeRegisterExpression(rc, node->varDecl.expression, reg);
+			declareRegisterLocal(rc, *node->varDecl.identifier, reg, true);
+		}
+		break;
+
+		case TOY_AST_NODE_UNARY: {
+			if (node->unary.opcode != TOY_OP_PRINT) {
+				writeRegisterExpression(rc, node, REGISTER_RESULT);
+				break;
+			}
+
+			int top = rc->next;
+			int src = writeRegisterOperand(rc, node->unary.child);
+
+			emitRegisterByte(rc, TOY_REG_PRINT);
+			emitRegisterByte(rc, src);
+
+			rc->next = top;
+		}
+		break;
+
+		case TOY_AST_NODE_BINARY: {
+			int top = rc->next;
+
+			if (node->binary.opcode == TOY_OP_ASSERT) {
+				int lhs = 0;
+				int rhs = 0;
+				writeRegisterOperands(rc, node->binary.left, node->binary.right, &lhs, &rhs);
+
+				emitRegisterByte(rc, TOY_REG_ASSERT);
+				emitRegisterByte(rc, lhs);
+				emitRegisterByte(rc, rhs);
+			}
+			else if (node->binary.opcode >= TOY_OP_VAR_ASSIGN && node->binary.opcode <= TOY_OP_VAR_MODULO_ASSIGN) {
+				Toy_ASTNode* left = node->binary.left;
+
+				if (left->type != TOY_AST_NODE_LITERAL || !TOY_IS_IDENTIFIER(left->atomic.literal)) {
+					rc->failed = true;
+					break;
+				}
+
+				Toy_Opcode opcode = TOY_OP_ADDITION + (node->binary.opcode - TOY_OP_VAR_ADDITION_ASSIGN); //WARNING: enum trickery
+				RegisterLocal* local = findRegisterLocal(rc, left->atomic.literal);
+
+				if (local != NULL) {
+					if (!local->writable) {
+						rc->failed = true;
+						break;
+					}
+
+					if (node->binary.opcode == TOY_OP_VAR_ASSIGN) {
+						writeRegisterExpression(rc, node->binary.right, local->reg);
+						break;
+					}
+
+					int rhs = writeRegisterOperand(rc, node->binary.right);
+
+					emitRegisterByte(rc, TOY_REG_BINARY);
+					emitRegisterByte(rc, opcode);
+					emitRegisterByte(rc, local->reg);
+					emitRegisterByte(rc, local->reg);
+					emitRegisterByte(rc, rhs);
+				}
+				else {
+					//globals keep their types & constness, so the assignment is checked by the scope
+					int src = writeRegisterOperand(rc, node->binary.right);
+
+					if (node->binary.opcode != TOY_OP_VAR_ASSIGN) {
+						int value = pushRegister(rc);
+						writeRegisterExpression(rc, left, value);
+
+						emitRegisterByte(rc, TOY_REG_BINARY);
+						emitRegisterByte(rc, opcode);
+						emitRegisterByte(rc, value);
+						emitRegisterByte(rc, value);
+						emitRegisterByte(rc, src);
+						src = value;
+					}
+
+					emitRegisterByte(rc, TOY_REG_SET_GLOBAL);
+					emitRegisterShort(rc, writeRegisterLiteral(rc, left->atomic.literal));
+					emitRegisterByte(rc, src);
+				}
+			}
+			else {
+				writeRegisterExpression(rc, node, REGISTER_RESULT);
+			}
+
+			rc->next = top;
+		}
+		break;
+
+		case TOY_AST_NODE_IF: {
+			int jumpToElse = writeRegisterConditionJump(rc, node->pathIf.condition);
+			writeRegisterStatement(rc, node->pathIf.thenPath);
+
+			if (node->pathIf.elsePath) {
+				emitRegisterByte(rc, TOY_REG_JUMP);
+				int jumpToEnd = emitRegisterJump(rc);
+
+				patchRegisterJump(rc, jumpToElse, rc->count);
+				writeRegisterStatement(rc, node->pathIf.elsePath);
+				patchRegisterJump(rc, jumpToEnd, rc->count);
+			}
+			else {
+				patchRegisterJump(rc, jumpToElse, rc->count);
+			}
+		}
+		break;
+
+		case TOY_AST_NODE_WHILE: {
+			Toy_LiteralArray* outerBreaks = rc->breakSites;
+			Toy_LiteralArray* outerContinues = rc->continueSites;
+			Toy_LiteralArray breakSites;
+			Toy_LiteralArray continueSites;
+			Toy_initLiteralArray(&breakSites);
+			Toy_initLiteralArray(&continueSites);
+			rc->breakSites = &breakSites;
+			rc->continueSites = &continueSites;
+
+			int start = rc->count;
+			int jumpToEnd = writeRegisterConditionJump(rc, node->pathWhile.condition);
+
+			writeRegisterStatement(rc, node->pathWhile.thenPath);
+
+			emitRegisterByte(rc, TOY_REG_JUMP);
+			patchRegisterJump(rc, emitRegisterJump(rc), start);
+			patchRegisterJump(rc, jumpToEnd, rc->count);
+
+			patchRegisterJumps(rc, &breakSites, rc->count);
+			patchRegisterJumps(rc, &continueSites, start);
+			writeRegisterLoopEnd(rc);
+
+			Toy_freeLiteralArray(&breakSites);
+			Toy_freeLiteralArray(&continueSites);
+			rc->breakSites = outerBreaks;
+			rc->continueSites = outerContinues;
+		}
+		break;
+
+		case TOY_AST_NODE_FOR: {
+			Toy_LiteralArray* outerBreaks = rc->breakSites;
+			Toy_LiteralArray* outerContinues = rc->continueSites;
+			Toy_LiteralArray breakSites;
+			Toy_LiteralArray continueSites;
+			Toy_initLiteralArray(&breakSites);
+			Toy_initLiteralArray(&continueSites);
+			rc->breakSites = &breakSites;
+			rc->continueSites = &continueSites;
+
+			//the clauses have their own scope, and so does the body
+			int localCount = rc->localCount;
+			int top = rc->next;
+			rc->depth++;
+
+			writeRegisterStatement(rc, node->pathFor.preClause);
+
+			int start = rc->count;
+			int jumpToEnd = writeRegisterConditionJump(rc, node->pathFor.condition);
+
+			writeRegisterScope(rc, node->pathFor.thenPath);
+
+			int increment = rc->count;
+			writeRegisterStatement(rc, node->pathFor.postClause);
+
+			emitRegisterByte(rc, TOY_REG_JUMP);
+			patchRegisterJump(rc, emitRegisterJump(rc), start);
+			patchRegisterJump(rc, jumpToEnd, rc->count);
+
+			rc->depth--;
+			rc->next = top;
+			rc->localCount = localCount;
+
+			patchRegisterJumps(rc, &breakSites, rc->count);
+			patchRegisterJumps(rc, &continueSites, increment);
+			writeRegisterLoopEnd(rc);
+
+			Toy_freeLiteralArray(&breakSites);
+			Toy_freeLiteralArray(&continueSites);
+			rc->breakSites = outerBreaks;
+			rc->continueSites = outerContinues;
+		}
+		break;
+
+		case TOY_AST_NODE_BREAK:
+		case TOY_AST_NODE_CONTINUE: {
+			Toy_LiteralArray* sites = node->type == TOY_AST_NODE_BREAK ? rc->breakSites : rc->continueSites;
+
+			if (sites == NULL) {
+				rc->failed = true;
+				break;
+			}
+
+			emitRegisterByte(rc, TOY_REG_JUMP);
+			Toy_Literal literal = TOY_TO_INTEGER_LITERAL(emitRegisterJump(rc));
+			Toy_pushLiteralArray(sites, literal);
+			Toy_freeLiteral(literal);
+		}
+		break;
+
+		case TOY_AST_NODE_FN_RETURN: {
+			int count = node->returns.returns->fnCollection.count;
+
+			if (count > 1) {
+				rc->failed = true;
 				break;
+			}
 
-				default:
-					fprintf(stderr, TOY_CC_ERROR "[internal] Unrecognized value node type in writeNodeCompoundToCache()\n" TOY_CC_RESET);
-					return -1;
+			int top = rc->next;
+			int src = REGISTER_RESULT;
+			Toy_ASTNode* result = count == 0 ? NULL : &node->returns.returns->fnCollection.nodes[0];
+
+			if (result != NULL && result->type == TOY_AST_NODE_BINARY && result->binary.opcode == TOY_OP_FN_CALL) {
+				src = pushRegister(rc);
+				writeRegisterCall(rc, result, src, true);
+			}
+			else if (result != NULL) {
+				src = writeRegisterOperand(rc, result);
 			}
+
+			emitRegisterByte(rc, TOY_REG_RETURN);
+			emitRegisterByte(rc, src);
+
+			rc->next = top;
 		}
+		break;
 
-		//push the store to the cache, with instructions about how pack it
-		Toy_Literal literal = TOY_TO_DICTIONARY_LITERAL((Toy_LiteralDictionary*)store); //cast from array to dict, because it's intermediate
-		literal.type = TOY_LITERAL_DICTIONARY_INTERMEDIATE; //god damn it - nested in a dictionary
-		index = Toy_pushLiteralArray(&compiler->literalCache, literal);
-		Toy_freeLiteral(literal);
-	}
+		case TOY_AST_NODE_PASS:
+		break;
 
-	else if (node->compound.literalType == TOY_LITERAL_ARRAY) {
-		//ensure each literal value is in the cache, individually
-		for (int i = 0; i < node->compound.count; i++) {
-			switch(node->compound.nodes[i].type) {
-				case TOY_AST_NODE_LITERAL: {
-					//values
-					int val = Toy_findLiteralIndex(&compiler->literalCache, node->compound.nodes[i].atomic.literal);
-					if (val < 0) {
-						val = Toy_pushLiteralArray(&compiler->literalCache, node->compound.nodes[i].atomic.literal);
-					}
+		//expression statements are left for the function to return, as the stack would leave them
+		default:
+			writeRegisterExpression(rc, node, REGISTER_RESULT);
+		break;
+	}
+}
 
-					Toy_Literal literal = TOY_TO_INTEGER_LITERAL(val);
-					Toy_pushLiteralArray(store, literal);
-					Toy_freeLiteral(literal);
-				}
-				break;
+static void writeRegisterPass(RegisterCompiler* rc, Toy_ASTNode* node) {
+	rc->count = 0;
+	rc->localCount = 0;
+	rc->depth = 0;
+	rc->next = REGISTER_RESULT + 1 + (rc->collecting ? REGISTER_CONSTANTS : rc->constantCount);
+	rc->frameSize = rc->next;
+	rc->breakSites = NULL;
+	rc->continueSites = NULL;
 
-				case TOY_AST_NODE_COMPOUND: {
-					int val = writeNodeCompoundToCache(compiler, &node->compound.nodes[i]);
+	//the parameters are already in the scope, so they're read from there when the function is called
+	Toy_ASTNode* parameters = node->fnDecl.arguments;
 
-					Toy_Literal literal = TOY_TO_INTEGER_LITERAL(val);
-					index = Toy_pushLiteralArray(store, literal);
-					Toy_freeLiteral(literal);
-				}
-				break;
+	for (int i = 0; i < parameters->fnCollection.count && !rc->failed; i++) {
+		Toy_ASTNode* parameter = &parameters->fnCollection.nodes[i];
+		Toy_Literal type = *parameter->varDecl.typeLiteral;
+		int reg = pushRegister(rc);
 
-				default:
-					fprintf(stderr, TOY_CC_ERROR "[internal] Unrecognized node type in writeNodeCompoundToCache()\n" TOY_CC_RESET);
-					return -1;
-			}
-		}
+		emitRegisterByte(rc, TOY_REG_GLOBAL);
+		emitRegisterByte(rc, reg);
+		emitRegisterShort(rc, writeRegisterLiteral(rc, *parameter->varDecl.identifier));
 
-		//push the store to the cache, with instructions about how pack it
-		Toy_Literal literal = TOY_TO_ARRAY_LITERAL(store);
-		literal.type = TOY_LITERAL_ARRAY_INTERMEDIATE; //god damn it - nested in an array
-		index = Toy_pushLiteralArray(&compiler->literalCache, literal);
-		Toy_freeLiteral(literal);
-	}
-	else {
-		fprintf(stderr, TOY_CC_ERROR "[internal] Unrecognized compound type in writeNodeCompoundToCache()\n" TOY_CC_RESET);
-		return -1;
+		declareRegisterLocal(rc, *parameter->varDecl.identifier, reg, TOY_AS_TYPE(type).typeOf == TOY_LITERAL_ANY && !TOY_AS_TYPE(type).constant);
 	}
 
-	return index;
-}
-
-static int writeNodeCollectionToCache(Toy_Compiler* compiler, Toy_ASTNode* node) {
-	Toy_LiteralArray* store = TOY_ALLOCATE(Toy_LiteralArray, 1);
-	Toy_initLiteralArray(store);
+	writeRegisterStatement(rc, node->fnDecl.block);
 
-	//ensure each literal value is in the cache, individually
-	for (int i = 0; i < node->fnCollection.count; i++) {
-		switch(node->fnCollection.nodes[i].type) {
-			case TOY_AST_NODE_VAR_DECL: {
-				//write each piece of the declaration to the cache
-				int identifierIndex = Toy_pushLiteralArray(&compiler->literalCache, node->fnCollection.nodes[i].varDecl.identifier); //store without duplication optimisation
-				int typeIndex = writeLiteralTypeToCache(&compiler->literalCache, node->fnCollection.nodes[i].varDecl.typeLiteral);
+	//falling off the end returns the latest result
+	emitRegisterByte(rc, TOY_REG_RETURN);
+	emitRegisterByte(rc, REGISTER_RESULT);
+}
 
-				Toy_Literal identifierLiteral =  TOY_TO_INTEGER_LITERAL(identifierIndex);
-				Toy_pushLiteralArray(store, identifierLiteral);
-				Toy_freeLiteral(identifierLiteral);
+//writes the body of a function as register code, or returns false if it can't be
+static bool writeRegisterFunction(Toy_Compiler* fnCompiler, Toy_ASTNode* node) {
+	RegisterCompiler rc;
+	rc.compiler = fnCompiler;
+	rc.code = NULL;
+	rc.capacity = 0;
+	rc.constantCount = 0;
+	rc.failed = false;
+
+	//find the constants first, so they have the registers before the parameters
+	rc.collecting = true;
+	writeRegisterPass(&rc, node);
+
+	rc.collecting = false;
+	if (!rc.failed) {
+		writeRegisterPass(&rc, node);
+	}
 
-				Toy_Literal typeLiteral = TOY_TO_INTEGER_LITERAL(typeIndex);
-				Toy_pushLiteralArray(store, typeLiteral);
-				Toy_freeLiteral(typeLiteral);
-			}
-			break;
+	bool success = !rc.failed && rc.count <= 0xFFFF;
 
-			case TOY_AST_NODE_LITERAL: {
-				//write each piece of the declaration to the cache
-				int typeIndex = writeLiteralTypeToCache(&compiler->literalCache, node->fnCollection.nodes[i].atomic.literal);
+	if (success) {
+		growCompiler(fnCompiler, 3 + rc.constantCount * 2 + rc.count);
+		while (fnCompiler->count + 3 + rc.constantCount * 2 + rc.count > fnCompiler->capacity) {
+			growCompiler(fnCompiler, fnCompiler->capacity);
+		}
 
-				Toy_Literal typeLiteral = TOY_TO_INTEGER_LITERAL(typeIndex);
-				Toy_pushLiteralArray(store, typeLiteral);
-				Toy_freeLiteral(typeLiteral);
-			}
-			break;
+		fnCompiler->bytecode[fnCompiler->count++] = TOY_OP_REGISTER_CODE; //1 byte
+		fnCompiler->bytecode[fnCompiler->count++] = (unsigned char)rc.frameSize; //1 byte
+		fnCompiler->bytecode[fnCompiler->count++] = (unsigned char)rc.constantCount; //1 byte
 
-			default:
-				fprintf(stderr, TOY_CC_ERROR "[internal] Unrecognized node type in writeNodeCollectionToCache()\n" TOY_CC_RESET);
-				return -1;
+		for (int i = 0; i < rc.constantCount; i++) {
+			writeIndexToCompiler(fnCompiler, rc.constants[i], 2); //2 bytes
 		}
+
+		memcpy(fnCompiler->bytecode + fnCompiler->count, rc.code, rc.count);
+		fnCompiler->count += rc.count;
 	}
 
-	//store the store
-	Toy_Literal literal = TOY_TO_ARRAY_LITERAL(store);
-	int storeIndex = Toy_pushLiteralArray(&compiler->literalCache, literal);
-	Toy_freeLiteral(literal);
+	TOY_FREE_ARRAY(unsigned char, rc.code, rc.capacity);
 
-	return storeIndex;
+	return success;
 }
 
-static int writeLiteralToCompiler(Toy_Compiler* compiler, Toy_Literal literal) {
-	//get the index
-	int index = Toy_findLiteralIndex(&compiler->literalCache, literal);
+static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode* node, void* breakAddressesPtr, void* continueAddressesPtr, int jumpOffsets, Toy_ASTNode* rootNode);
 
-	if (index < 0) {
-		if (TOY_IS_TYPE(literal)) {
-			//check for the type literal as value
-			index = writeLiteralTypeToCache(&compiler->literalCache, literal);
-		}
-		else {
-			index = Toy_pushLiteralArray(&compiler->literalCache, literal);
-		}
-	}
+//"a[i]" - indexing without any slicing
+static bool isSimpleIndexNode(Toy_ASTNode* node) {
+	return node->type == TOY_AST_NODE_BINARY && node->binary.opcode == TOY_OP_INDEX && node->binary.right->type == TOY_AST_NODE_INDEX && node->binary.right->index.first != NULL && node->binary.right->index.second == NULL && node->binary.right->index.third == NULL;
+}
 
-	//push the literal to the bytecode
-	if (index >= 256) {
-		//push a "long" index
-		compiler->bytecode[compiler->count++] = TOY_OP_LITERAL_LONG; //1 byte
-		memcpy(compiler->bytecode + compiler->count, &index, sizeof(unsigned short)); //2 bytes
+//write an expression that's read on it's own, leaving it's value on the stack
+static void writeValueToCompiler(Toy_Compiler* compiler, Toy_ASTNode* node, void* breakAddressesPtr, void* continueAddressesPtr, int jumpOffsets) {
+	Toy_Opcode override = Toy_writeCompilerWithJumps(compiler, node, breakAddressesPtr, continueAddressesPtr, jumpOffsets, node);
 
-		compiler->count += sizeof(unsigned short);
-	}
-	else {
-		//push the index
-		compiler->bytecode[compiler->count++] = TOY_OP_LITERAL; //1 byte
-		compiler->bytecode[compiler->count++] = (unsigned char)index; //1 byte
+	if (override != TOY_OP_EOF) {//compensate for indexing & dot notation being screwy
+		compiler->bytecode[compiler->count++] = (unsigned char)override; //1 byte
 	}
-
-	return index;
 }
 
-//NOTE: jumpOfsets are included, because function arg and return indexes are embedded in the code body i.e. need to include their sizes in the jump
-//NOTE: rootNode should NOT include groupings and blocks
 static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode* node, void* breakAddressesPtr, void* continueAddressesPtr, int jumpOffsets, Toy_ASTNode* rootNode) {
 	//grow if the bytecode space is too small
-	if (compiler->count + 32 > compiler->capacity) {
-		int oldCapacity = compiler->capacity;
-
-		compiler->capacity = TOY_GROW_CAPACITY_FAST(oldCapacity);
-		compiler->bytecode = TOY_GROW_ARRAY(unsigned char, compiler->bytecode, oldCapacity, compiler->capacity);
-	}
+	growCompiler(compiler, 32);
 
 	//determine node type
 	switch(node->type) {
@@ -297,16 +1397,72 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 
 		//all infixes come here
 		case TOY_AST_NODE_BINARY: {
+			//casts are wrapped in a dummy node by the parser - only the cast itself is needed
+			if (node->binary.opcode == TOY_OP_GROUPING_BEGIN) {
+				return Toy_writeCompilerWithJumps(compiler, node->binary.right, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
+			}
+
+			//"a[i] op= v" on a variable, changed in place
+			if (node->binary.opcode >= TOY_OP_VAR_ASSIGN && node->binary.opcode <= TOY_OP_VAR_MODULO_ASSIGN && isSimpleIndexNode(node->binary.left) && node->binary.left->binary.left->type == TOY_AST_NODE_LITERAL && TOY_IS_IDENTIFIER(node->binary.left->binary.left->atomic.literal)) {
+				writeLiteralToCompiler(compiler, node->binary.left->binary.left->atomic.literal);
+				writeValueToCompiler(compiler, node->binary.left->binary.right->index.first, breakAddressesPtr, continueAddressesPtr, jumpOffsets);
+				writeValueToCompiler(compiler, node->binary.right, breakAddressesPtr, continueAddressesPtr, jumpOffsets);
+
+				growCompiler(compiler, 2);
+				compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_INDEX_SET; //1 byte
+				compiler->bytecode[compiler->count++] = (unsigned char)node->binary.opcode; //1 byte
+				return TOY_OP_EOF;
+			}
+
+			//"a[i]" when it's read, rather than assigned to - the opcode is left to the caller, like the general form
+			if (isSimpleIndexNode(node) && !(rootNode->type == TOY_AST_NODE_BINARY && rootNode->binary.opcode >= TOY_OP_VAR_ASSIGN && rootNode->binary.opcode <= TOY_OP_VAR_MODULO_ASSIGN && rootNode->binary.right != node)) {
+				writeValueToCompiler(compiler, node->binary.left, breakAddressesPtr, continueAddressesPtr, jumpOffsets);
+				writeValueToCompiler(compiler, node->binary.right->index.first, breakAddressesPtr, continueAddressesPtr, jumpOffsets);
+				return TOY_OP_INDEX_GET;
+			}
+
+			//superinstructions, when both sides are plain literals
+			if (node->binary.left->type == TOY_AST_NODE_LITERAL) {
+				Toy_ASTNode* right = node->binary.right;
+
+				//a = b op c - which has it's own fast path for integers
+				if (node->binary.opcode == TOY_OP_VAR_ASSIGN && right->type == TOY_AST_NODE_BINARY && TOY_GENERIC_OPCODE(right->binary.opcode) >= TOY_OP_ADDITION && TOY_GENERIC_OPCODE(right->binary.opcode) <= TOY_OP_MODULO && right->binary.left->type == TOY_AST_NODE_LITERAL && right->binary.right->type == TOY_AST_NODE_LITERAL) {
+					if (writeVarArithmeticAssignToCompiler(compiler, TOY_GENERIC_OPCODE(right->binary.opcode), node->binary.left->atomic.literal, right->binary.left->atomic.literal, right->binary.right->atomic.literal)) {
+						return TOY_OP_EOF;
+					}
+				}
+
+				//a op= b, which is the same as a = a op b
+				if (node->binary.opcode >= TOY_OP_VAR_ADDITION_ASSIGN && node->binary.opcode <= TOY_OP_VAR_MODULO_ASSIGN && right->type == TOY_AST_NODE_LITERAL) {
+					Toy_Opcode opcode = TOY_OP_ADDITION + (node->binary.opcode - TOY_OP_VAR_ADDITION_ASSIGN); //WARNING: enum trickery
+					if (writeVarArithmeticAssignToCompiler(compiler, opcode, node->binary.left->atomic.literal, node->binary.left->atomic.literal, right->atomic.literal)) {
+						return TOY_OP_EOF;
+					}
+				}
+
+				//push both at once - indexing and dot notation need their own handling below
+				if (right->type == TOY_AST_NODE_LITERAL && node->binary.opcode != TOY_OP_INDEX && node->binary.opcode != TOY_OP_DOT) {
+					if (writeLiteralPairToCompiler(compiler, node->binary.left->atomic.literal, right->atomic.literal)) {
+						compiler->bytecode[compiler->count++] = (unsigned char)node->binary.opcode; //1 byte
+						return TOY_OP_EOF;
+					}
+				}
+			}
+
 			//pass to the child nodes, then embed the binary command (math, etc.)
-			Toy_Opcode override = Toy_writeCompilerWithJumps(compiler, node->binary.left, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
+			Toy_Opcode override = TOY_OP_EOF;
+
+			if (!writeBuiltinToCompiler(compiler, node)) {
+				override = Toy_writeCompilerWithJumps(compiler, node->binary.left, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
+			}
 
 			//special case for when indexing and assigning
 			if (override != TOY_OP_EOF && node->binary.opcode >= TOY_OP_VAR_ASSIGN && node->binary.opcode <= TOY_OP_VAR_MODULO_ASSIGN) {
-				Toy_writeCompilerWithJumps(compiler, node->binary.right, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
+				Toy_Opcode value = Toy_writeCompilerWithJumps(compiler, node->binary.right, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
 
 				//Special case if there's an index on both sides of the sign, just set it as indexing
 				if (node->binary.left->type == TOY_AST_NODE_BINARY && node->binary.right->type == TOY_AST_NODE_BINARY && node->binary.left->binary.opcode == TOY_OP_INDEX && node->binary.right->binary.opcode == TOY_OP_INDEX) {
-					compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_INDEX;
+					compiler->bytecode[compiler->count++] = (unsigned char)value; //TOY_OP_INDEX or TOY_OP_INDEX_GET
 				}
 
 				compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_INDEX_ASSIGN; //1 byte WARNING: enum trickery
@@ -355,6 +1511,19 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 					case TOY_OP_INVERT:
 					case TOY_OP_AND:
 					case TOY_OP_OR:
+					case TOY_OP_ADDITION_INT:
+					case TOY_OP_SUBTRACTION_INT:
+					case TOY_OP_MULTIPLICATION_INT:
+					case TOY_OP_DIVISION_INT:
+					case TOY_OP_MODULO_INT:
+					case TOY_OP_ADDITION_FLOAT:
+					case TOY_OP_SUBTRACTION_FLOAT:
+					case TOY_OP_MULTIPLICATION_FLOAT:
+					case TOY_OP_DIVISION_FLOAT:
+					case TOY_OP_COMPARE_LESS_INT:
+					case TOY_OP_COMPARE_LESS_EQUAL_INT:
+					case TOY_OP_COMPARE_GREATER_INT:
+					case TOY_OP_COMPARE_GREATER_EQUAL_INT:
 						//place the rhs result before the outer instruction
 						compiler->bytecode[compiler->count++] = (unsigned char)ret; //1 byte
 						ret = TOY_OP_EOF;
@@ -380,9 +1549,7 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			}
 
 			//cache the point to insert the jump distance at
-			compiler->bytecode[compiler->count++] = TOY_OP_IF_FALSE_JUMP; //1 byte
-			int jumpToElse = compiler->count;
-			compiler->count += sizeof(unsigned short); //2 bytes
+			int jumpToElse = writeJumpToCompiler(compiler, TOY_OP_IF_FALSE_JUMP_WIDE, 0);
 
 			//write the then path
 			override = Toy_writeCompilerWithJumps(compiler, node->pathIf.thenPath, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
@@ -393,13 +1560,10 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			int jumpToEnd = 0;
 
 			//insert jump to end
-			compiler->bytecode[compiler->count++] = TOY_OP_JUMP; //1 byte
-			jumpToEnd = compiler->count;
-			compiler->count += sizeof(unsigned short); //2 bytes
+			jumpToEnd = writeJumpToCompiler(compiler, TOY_OP_JUMP_WIDE, 0);
 
 			//update the jumpToElse to point here
-			unsigned short tmpVal = compiler->count + jumpOffsets;
-			memcpy(compiler->bytecode + jumpToElse, &tmpVal, sizeof(tmpVal)); //2 bytes
+			writeJumpTarget(compiler, jumpToElse, compiler->count + jumpOffsets);
 
 			//write the else path
 			Toy_Opcode override2 = Toy_writeCompilerWithJumps(compiler, node->pathIf.elsePath, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
@@ -408,8 +1572,7 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			}
 
 			//update the jumpToEnd to point here
-			tmpVal = compiler->count + jumpOffsets;
-			memcpy(compiler->bytecode + jumpToEnd, &tmpVal, sizeof(tmpVal)); //2 bytes
+			writeJumpTarget(compiler, jumpToEnd, compiler->count + jumpOffsets);
 		}
 		break;
 
@@ -446,18 +1609,7 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			}
 
 			//push the node opcode to the bytecode
-			if (index >= 256) {
-				//push a "long" index
-				compiler->bytecode[compiler->count++] = TOY_OP_LITERAL_LONG; //1 byte
-				memcpy(compiler->bytecode + compiler->count, &index, sizeof(unsigned short));
-
-				compiler->count += sizeof(unsigned short);
-			}
-			else {
-				//push the index
-				compiler->bytecode[compiler->count++] = TOY_OP_LITERAL; //1 byte
-				compiler->bytecode[compiler->count++] = (unsigned char)index; //1 byte
-			}
+			writeLiteralIndexToCompiler(compiler, index);
 		}
 		break;
 
@@ -474,42 +1626,43 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			}
 
 			//write each piece of the declaration to the bytecode
-			int identifierIndex = Toy_findLiteralIndex(&compiler->literalCache, node->varDecl.identifier);
+			int identifierIndex = findLiteralInCache(compiler, *node->varDecl.identifier);
 			if (identifierIndex < 0) {
-				identifierIndex = Toy_pushLiteralArray(&compiler->literalCache, node->varDecl.identifier);
+				identifierIndex = pushLiteralToCache(compiler, *node->varDecl.identifier);
 			}
 
-			int typeIndex = writeLiteralTypeToCache(&compiler->literalCache, node->varDecl.typeLiteral);
+			int typeIndex = writeLiteralTypeToCache(compiler, *node->varDecl.typeLiteral);
 
-			//embed the info into the bytecode
-			if (identifierIndex >= 256 || typeIndex >= 256) {
-				//push a "long" declaration
-				compiler->bytecode[compiler->count++] = TOY_OP_VAR_DECL_LONG; //1 byte
+			//embed the info into the bytecode, as a "long" or "wide" declaration if needed
+			int width = indexWidth(identifierIndex > typeIndex ? identifierIndex : typeIndex);
 
-				*((unsigned short*)(compiler->bytecode + compiler->count)) = (unsigned short)identifierIndex; //2 bytes
-				compiler->count += sizeof(unsigned short);
-
-				*((unsigned short*)(compiler->bytecode + compiler->count)) = (unsigned short)typeIndex; //2 bytes
-				compiler->count += sizeof(unsigned short);
-			}
-			else {
-				//push a declaration
-				compiler->bytecode[compiler->count++] = TOY_OP_VAR_DECL; //1 byte
-				compiler->bytecode[compiler->count++] = (unsigned char)identifierIndex; //1 byte
-				compiler->bytecode[compiler->count++] = (unsigned char)typeIndex; //1 byte
-			}
+			growCompiler(compiler, 1 + sizeof(int) * 2);
+			compiler->bytecode[compiler->count++] = width == 1 ? TOY_OP_VAR_DECL : width == 2 ? TOY_OP_VAR_DECL_LONG : TOY_OP_VAR_DECL_WIDE; //1 byte
+			writeIndexToCompiler(compiler, identifierIndex, width);
+			writeIndexToCompiler(compiler, typeIndex, width);
 		}
 		break;
 
 		case TOY_AST_NODE_FN_DECL: {
-			//run a compiler over the function
-			Toy_Compiler* fnCompiler = TOY_ALLOCATE(Toy_Compiler, 1);
-			Toy_initCompiler(fnCompiler);
-			Toy_writeCompiler(fnCompiler, node->fnDecl.arguments); //can be empty, but not NULL
-			Toy_writeCompiler(fnCompiler, node->fnDecl.returns); //can be empty, but not NULL
-			Toy_Opcode override = Toy_writeCompilerWithJumps(fnCompiler, node->fnDecl.block, NULL, NULL, -4, rootNode); //can be empty, but not NULL
-			if (override != TOY_OP_EOF) {//compensate for indexing & dot notation being screwy
-				compiler->bytecode[compiler->count++] = (unsigned char)override; //1 byte
+			//run a compiler over the function, for the register engine if possible
+			Toy_Compiler* fnCompiler = NULL;
+
+			if (compiler->registers) {
+				fnCompiler = createFunctionCompiler(compiler, node);
+
+				if (!writeRegisterFunction(fnCompiler, node)) {
+					Toy_freeCompiler(fnCompiler);
+					TOY_FREE(Toy_Compiler, fnCompiler);
+					fnCompiler = NULL;
+				}
+			}
+
+			if (fnCompiler == NULL) {
+				fnCompiler = createFunctionCompiler(compiler, node);
+				Toy_Opcode override = Toy_writeCompilerWithJumps(fnCompiler, node->fnDecl.block, NULL, NULL, -4, rootNode); //can be empty, but not NULL
+				if (override != TOY_OP_EOF) {//compensate for indexing & dot notation being screwy
+					compiler->bytecode[compiler->count++] = (unsigned char)override; //1 byte
+				}
 			}
 
 			//adopt the panic state if anything happened
@@ -518,47 +1671,47 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			}
 
 			//create the function in the literal cache (by storing the compiler object)
-			Toy_Literal fnLiteral = TOY_TO_FUNCTION_LITERAL(fnCompiler, 0);
+			Toy_Literal fnLiteral = TOY_TO_FUNCTION_LITERAL(NULL, 0);
+			fnLiteral.as.function.inner.bytecode = fnCompiler;
 			fnLiteral.type = TOY_LITERAL_FUNCTION_INTERMEDIATE; //NOTE: changing type
 
 			//push the name
-			int identifierIndex = Toy_findLiteralIndex(&compiler->literalCache, node->fnDecl.identifier);
+			int identifierIndex = findLiteralInCache(compiler, *node->fnDecl.identifier);
 			if (identifierIndex < 0) {
-				identifierIndex = Toy_pushLiteralArray(&compiler->literalCache, node->fnDecl.identifier);
+				identifierIndex = pushLiteralToCache(compiler, *node->fnDecl.identifier);
 			}
 
 			//push to function (functions are never equal)
-			int fnIndex = Toy_pushLiteralArray(&compiler->literalCache, fnLiteral);
+			int fnIndex = pushLiteralToCache(compiler, fnLiteral);
 
-			//embed the info into the bytecode
-			if (identifierIndex >= 256 || fnIndex >= 256) {
-				//push a "long" declaration
-				compiler->bytecode[compiler->count++] = TOY_OP_FN_DECL_LONG; //1 byte
+			//embed the info into the bytecode, as a "long" or "wide" declaration if needed
+			int width = indexWidth(identifierIndex > fnIndex ? identifierIndex : fnIndex);
 
-				*((unsigned short*)(compiler->bytecode + compiler->count)) = (unsigned short)identifierIndex; //2 bytes
-				compiler->count += sizeof(unsigned short);
-
-				*((unsigned short*)(compiler->bytecode + compiler->count)) = (unsigned short)fnIndex; //2 bytes
-				compiler->count += sizeof(unsigned short);
-			}
-			else {
-				//push a declaration
-				compiler->bytecode[compiler->count++] = TOY_OP_FN_DECL; //1 byte
-				compiler->bytecode[compiler->count++] = (unsigned char)identifierIndex; //1 byte
-				compiler->bytecode[compiler->count++] = (unsigned char)fnIndex; //1 byte
-			}
+			growCompiler(compiler, 1 + sizeof(int) * 2);
+			compiler->bytecode[compiler->count++] = width == 1 ? TOY_OP_FN_DECL : width == 2 ? TOY_OP_FN_DECL_LONG : TOY_OP_FN_DECL_WIDE; //1 byte
+			writeIndexToCompiler(compiler, identifierIndex, width);
+			writeIndexToCompiler(compiler, fnIndex, width);
 		}
 		break;
 
 		case TOY_AST_NODE_FN_COLLECTION: {
 			//embed these in the bytecode...
-			unsigned short index = (unsigned short)writeNodeCollectionToCache(compiler, node);
-			
-			if (index == (unsigned short)-1) {
+			int collectionIndex = writeNodeCollectionToCache(compiler, node);
+
+			if (collectionIndex < 0) {
+				compiler->panic = true;
+				return TOY_OP_EOF;
+			}
+
+			//the parameters & returns are among the first literals of a function, so a short is plenty
+			if (collectionIndex > 0xFFFF) {
+				fprintf(stderr, TOY_CC_ERROR "[internal] Function parameter or return list is too large\n" TOY_CC_RESET);
 				compiler->panic = true;
 				return TOY_OP_EOF;
 			}
 
+			unsigned short index = (unsigned short)collectionIndex;
+
 			memcpy(compiler->bytecode + compiler->count, &index, sizeof(index));
 			compiler->count += sizeof(unsigned short);
 		}
@@ -578,46 +1731,24 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 				}
 
 				//write each argument to the bytecode
-				int argumentsIndex = Toy_findLiteralIndex(&compiler->literalCache, node->fnCall.arguments->fnCollection.nodes[i].atomic.literal);
+				int argumentsIndex = findLiteralInCache(compiler, node->fnCall.arguments->fnCollection.nodes[i].atomic.literal);
 				if (argumentsIndex < 0) {
-					argumentsIndex = Toy_pushLiteralArray(&compiler->literalCache, node->fnCall.arguments->fnCollection.nodes[i].atomic.literal);
+					argumentsIndex = pushLiteralToCache(compiler, node->fnCall.arguments->fnCollection.nodes[i].atomic.literal);
 				}
 
 				//push the node opcode to the bytecode
-				if (argumentsIndex >= 256) {
-					//push a "long" index
-					compiler->bytecode[compiler->count++] = TOY_OP_LITERAL_LONG; //1 byte
-
-					*((unsigned short*)(compiler->bytecode + compiler->count)) = (unsigned short)argumentsIndex; //2 bytes
-					compiler->count += sizeof(unsigned short);
-				}
-				else {
-					//push the index
-					compiler->bytecode[compiler->count++] = TOY_OP_LITERAL; //1 byte
-					compiler->bytecode[compiler->count++] = (unsigned char)argumentsIndex; //1 byte
-				}
+				writeLiteralIndexToCompiler(compiler, argumentsIndex);
 			}
 
 			//push the argument COUNT to the top of the stack
 			Toy_Literal argumentsCountLiteral =  TOY_TO_INTEGER_LITERAL(node->fnCall.argumentCount); //argumentCount is set elsewhere to support dot operator
-			int argumentsCountIndex = Toy_findLiteralIndex(&compiler->literalCache, argumentsCountLiteral);
+			int argumentsCountIndex = findLiteralInCache(compiler, argumentsCountLiteral);
 			if (argumentsCountIndex < 0) {
-				argumentsCountIndex = Toy_pushLiteralArray(&compiler->literalCache, argumentsCountLiteral);
+				argumentsCountIndex = pushLiteralToCache(compiler, argumentsCountLiteral);
 			}
 			Toy_freeLiteral(argumentsCountLiteral);
 
-			if (argumentsCountIndex >= 256) {
-				//push a "long" index
-				compiler->bytecode[compiler->count++] = TOY_OP_LITERAL_LONG; //1 byte
-
-				*((unsigned short*)(compiler->bytecode + compiler->count)) = (unsigned short)argumentsCountIndex; //2 bytes
-				compiler->count += sizeof(unsigned short);
-			}
-			else {
-				//push the index
-				compiler->bytecode[compiler->count++] = TOY_OP_LITERAL; //1 byte
-				compiler->bytecode[compiler->count++] = (unsigned char)argumentsCountIndex; //1 byte
-			}
+			writeLiteralIndexToCompiler(compiler, argumentsCountIndex);
 
 			//call the function
 			//DO NOT call the collection, this is done in binary
@@ -632,9 +1763,7 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			}
 
 			//cache the point to insert the jump distance at
-			compiler->bytecode[compiler->count++] = TOY_OP_IF_FALSE_JUMP; //1 byte
-			int jumpToElse = compiler->count;
-			compiler->count += sizeof(unsigned short); //2 bytes
+			int jumpToElse = writeConditionJumpToCompiler(compiler, node->pathIf.condition);
 
 			//write the then path
 			override = Toy_writeCompilerWithJumps(compiler, node->pathIf.thenPath, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
@@ -646,14 +1775,11 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 
 			if (node->pathIf.elsePath) {
 				//insert jump to end
-				compiler->bytecode[compiler->count++] = TOY_OP_JUMP; //1 byte
-				jumpToEnd = compiler->count;
-				compiler->count += sizeof(unsigned short); //2 bytes
+				jumpToEnd = writeJumpToCompiler(compiler, TOY_OP_JUMP_WIDE, 0);
 			}
 
 			//update the jumpToElse to point here
-			unsigned short tmpVal = compiler->count + jumpOffsets;
-			memcpy(compiler->bytecode + jumpToElse, &tmpVal, sizeof(tmpVal)); //2 bytes
+			writeJumpTarget(compiler, jumpToElse, compiler->count + jumpOffsets);
 
 			if (node->pathIf.elsePath) {
 				//if there's an else path, write it and 
@@ -663,8 +1789,7 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 				}
 
 				//update the jumpToEnd to point here
-				tmpVal = compiler->count + jumpOffsets;
-				memcpy(compiler->bytecode + jumpToEnd, &tmpVal, sizeof(tmpVal)); //2 bytes
+				writeJumpTarget(compiler, jumpToEnd, compiler->count + jumpOffsets);
 			}
 		}
 		break;
@@ -678,7 +1803,7 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			Toy_initLiteralArray(&continueAddresses);
 
 			//cache the jump point
-			unsigned short jumpToStart = compiler->count;
+			int jumpToStart = compiler->count;
 
 			//process the condition
 			Toy_Opcode override = Toy_writeCompilerWithJumps(compiler, node->pathWhile.condition, &breakAddresses, &continueAddresses, jumpOffsets, rootNode);
@@ -687,9 +1812,7 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			}
 
 			//if false, jump to end
-			compiler->bytecode[compiler->count++] = TOY_OP_IF_FALSE_JUMP; //1 byte
-			unsigned short jumpToEnd = compiler->count;
-			compiler->count += sizeof(unsigned short); //2 bytes
+			int jumpToEnd = writeConditionJumpToCompiler(compiler, node->pathWhile.condition);
 
 			//write the body
 			override = Toy_writeCompilerWithJumps(compiler, node->pathWhile.thenPath, &breakAddresses, &continueAddresses, jumpOffsets, rootNode);
@@ -698,26 +1821,20 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			}
 
 			//jump to condition
-			compiler->bytecode[compiler->count++] = TOY_OP_JUMP; //1 byte
-			unsigned short tmpVal = jumpToStart + jumpOffsets;
-			memcpy(compiler->bytecode + compiler->count, &tmpVal, sizeof(tmpVal));
-			compiler->count += sizeof(unsigned short); //2 bytes
+			writeJumpToCompiler(compiler, TOY_OP_JUMP_WIDE, jumpToStart + jumpOffsets);
 
 			//jump from condition
-			tmpVal = compiler->count + jumpOffsets;
-			memcpy(compiler->bytecode + jumpToEnd, &tmpVal, sizeof(tmpVal));
+			writeJumpTarget(compiler, jumpToEnd, compiler->count + jumpOffsets);
 
 			//set the breaks and continues
 			for (int i = 0; i < breakAddresses.count; i++) {
 				int point = TOY_AS_INTEGER(breakAddresses.literals[i]);
-				tmpVal = compiler->count + jumpOffsets;
-				memcpy(compiler->bytecode + point, &tmpVal, sizeof(tmpVal));
+				writeJumpTarget(compiler, point, compiler->count + jumpOffsets);
 			}
 
 			for (int i = 0; i < continueAddresses.count; i++) {
 				int point = TOY_AS_INTEGER(continueAddresses.literals[i]);
-				tmpVal = jumpToStart + jumpOffsets;
-				memcpy(compiler->bytecode + point, &tmpVal, sizeof(tmpVal));
+				writeJumpTarget(compiler, point, jumpToStart + jumpOffsets);
 			}
 
 			//clear the stack after use
@@ -746,16 +1863,14 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			}
 
 			//conditional
-			unsigned short jumpToStart = compiler->count;
+			int jumpToStart = compiler->count;
 			override = Toy_writeCompilerWithJumps(compiler, node->pathFor.condition, &breakAddresses, &continueAddresses, jumpOffsets, rootNode);
 			if (override != TOY_OP_EOF) {//compensate for indexing & dot notation being screwy
 				compiler->bytecode[compiler->count++] = (unsigned char)override; //1 byte
 			}
 
 			//if false jump to end
-			compiler->bytecode[compiler->count++] = TOY_OP_IF_FALSE_JUMP; //1 byte
-			unsigned short jumpToEnd = compiler->count;
-			compiler->count += sizeof(unsigned short); //2 bytes
+			int jumpToEnd = writeConditionJumpToCompiler(compiler, node->pathFor.condition);
 
 			//write the body
 			compiler->bytecode[compiler->count++] = TOY_OP_SCOPE_BEGIN; //1 byte
@@ -774,27 +1889,21 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 				compiler->bytecode[compiler->count++] = (unsigned char)override; //1 byte
 			}
 
-			compiler->bytecode[compiler->count++] = TOY_OP_JUMP; //1 byte
-			unsigned short tmpVal = jumpToStart + jumpOffsets;
-			memcpy(compiler->bytecode + compiler->count, &tmpVal, sizeof(tmpVal));
-			compiler->count += sizeof(unsigned short); //2 bytes
+			writeJumpToCompiler(compiler, TOY_OP_JUMP_WIDE, jumpToStart + jumpOffsets);
 
-			tmpVal = compiler->count + jumpOffsets;
-			memcpy(compiler->bytecode + jumpToEnd, &tmpVal, sizeof(tmpVal));
+			writeJumpTarget(compiler, jumpToEnd, compiler->count + jumpOffsets);
 
 			compiler->bytecode[compiler->count++] = TOY_OP_SCOPE_END; //1 byte
 
 			//set the breaks and continues
 			for (int i = 0; i < breakAddresses.count; i++) {
 				int point = TOY_AS_INTEGER(breakAddresses.literals[i]);
-				tmpVal = compiler->count + jumpOffsets;
-				memcpy(compiler->bytecode + point, &tmpVal, sizeof(tmpVal));
+				writeJumpTarget(compiler, point, compiler->count + jumpOffsets);
 			}
 
 			for (int i = 0; i < continueAddresses.count; i++) {
 				int point = TOY_AS_INTEGER(continueAddresses.literals[i]);
-				tmpVal = jumpToIncrement + jumpOffsets;
-				memcpy(compiler->bytecode + point, &tmpVal, sizeof(tmpVal));
+				writeJumpTarget(compiler, point, jumpToIncrement + jumpOffsets);
 			}
 
 			//clear the stack after use
@@ -813,14 +1922,12 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			}
 
 			//insert into bytecode
-			compiler->bytecode[compiler->count++] = TOY_OP_JUMP; //1 byte
+			int point = writeJumpToCompiler(compiler, TOY_OP_JUMP_WIDE, 0);
 
 			//push to the breakAddresses array
-			Toy_Literal literal = TOY_TO_INTEGER_LITERAL(compiler->count);
+			Toy_Literal literal = TOY_TO_INTEGER_LITERAL(point);
 			Toy_pushLiteralArray((Toy_LiteralArray*)breakAddressesPtr, literal);
 			Toy_freeLiteral(literal);
-
-			compiler->count += sizeof(unsigned short); //2 bytes
 		}
 		break;
 
@@ -831,14 +1938,12 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			}
 
 			//insert into bytecode
-			compiler->bytecode[compiler->count++] = TOY_OP_JUMP; //1 byte
+			int point = writeJumpToCompiler(compiler, TOY_OP_JUMP_WIDE, 0);
 
 			//push to the continueAddresses array
-			Toy_Literal literal = TOY_TO_INTEGER_LITERAL(compiler->count);
+			Toy_Literal literal = TOY_TO_INTEGER_LITERAL(point);
 			Toy_pushLiteralArray((Toy_LiteralArray*)continueAddressesPtr, literal);
 			Toy_freeLiteral(literal);
-
-			compiler->count += sizeof(unsigned short); //2 bytes
 		}
 		break;
 
@@ -851,6 +1956,15 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 				}
 			}
 
+			//"return f(...)" - the caller makes the call once this function has returned
+			if (node->returns.returns->fnCollection.count == 1) {
+				Toy_ASTNode* result = &node->returns.returns->fnCollection.nodes[0];
+
+				if (result->type == TOY_AST_NODE_BINARY && result->binary.opcode == TOY_OP_FN_CALL && compiler->bytecode[compiler->count - 1] == TOY_OP_FN_CALL) {
+					compiler->bytecode[compiler->count - 1] = TOY_OP_TAIL_CALL;
+				}
+			}
+
 			//push the return, with the number of literals
 			compiler->bytecode[compiler->count++] = TOY_OP_FN_RETURN; //1 byte
 
@@ -860,19 +1974,7 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 		break;
 
 		case TOY_AST_NODE_PREFIX_INCREMENT: {
-			//push the literal to the stack (twice: add + assign)
-			writeLiteralToCompiler(compiler, node->prefixIncrement.identifier);
-			writeLiteralToCompiler(compiler, node->prefixIncrement.identifier);
-
-			//push the increment / decrement
-			Toy_Literal increment = TOY_TO_INTEGER_LITERAL(1);
-			writeLiteralToCompiler(compiler, increment);
-
-			//push the add opcode
-			compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_ADDITION; //1 byte
-
-			//push the assign
-			compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_VAR_ASSIGN; //1 byte
+			writeIncrementToCompiler(compiler, node->prefixIncrement.identifier, TOY_OP_ADDITION);
 
 			//leave the result on the stack
 			writeLiteralToCompiler(compiler, node->prefixIncrement.identifier);
@@ -881,19 +1983,7 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 		break;
 
 		case TOY_AST_NODE_PREFIX_DECREMENT: {
-			//push the literal to the stack (twice: add + assign)
-			writeLiteralToCompiler(compiler, node->prefixDecrement.identifier);
-			writeLiteralToCompiler(compiler, node->prefixDecrement.identifier);
-
-			//push the increment / decrement
-			Toy_Literal increment = TOY_TO_INTEGER_LITERAL(1);
-			writeLiteralToCompiler(compiler, increment);
-
-			//push the subtract opcode
-			compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_SUBTRACTION; //1 byte
-
-			//push the assign
-			compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_VAR_ASSIGN; //1 byte
+			writeIncrementToCompiler(compiler, node->prefixDecrement.identifier, TOY_OP_SUBTRACTION);
 
 			//leave the result on the stack
 			writeLiteralToCompiler(compiler, node->prefixDecrement.identifier);
@@ -906,19 +1996,8 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			writeLiteralToCompiler(compiler, node->postfixIncrement.identifier);
 			compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_LITERAL_RAW; //1 byte
 
-			//push the identifier (twice: add + assign)
-			writeLiteralToCompiler(compiler, node->postfixIncrement.identifier);
-			writeLiteralToCompiler(compiler, node->postfixIncrement.identifier);
-
-			//push the increment / decrement
-			Toy_Literal increment = TOY_TO_INTEGER_LITERAL(1);
-			writeLiteralToCompiler(compiler, increment);
-
-			//push the add opcode
-			compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_ADDITION; //1 byte
-
-			//push the assign
-			compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_VAR_ASSIGN; //1 byte
+			//then update the identifier
+			writeIncrementToCompiler(compiler, node->postfixIncrement.identifier, TOY_OP_ADDITION);
 		}
 		break;
 
@@ -927,26 +2006,15 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			writeLiteralToCompiler(compiler, node->postfixDecrement.identifier);
 			compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_LITERAL_RAW; //1 byte
 
-			//push the identifier (twice: add + assign)
-			writeLiteralToCompiler(compiler, node->postfixDecrement.identifier);
-			writeLiteralToCompiler(compiler, node->postfixDecrement.identifier);
-
-			//push the increment / decrement
-			Toy_Literal increment = TOY_TO_INTEGER_LITERAL(1);
-			writeLiteralToCompiler(compiler, increment);
-
-			//push the subtract opcode
-			compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_SUBTRACTION; //1 byte
-
-			//push the assign
-			compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_VAR_ASSIGN; //1 byte
+			//then update the identifier
+			writeIncrementToCompiler(compiler, node->postfixDecrement.identifier, TOY_OP_SUBTRACTION);
 		}
 		break;
 
 		case TOY_AST_NODE_IMPORT: {
 			//push the identifier, and the alias
-			writeLiteralToCompiler(compiler, node->import.identifier);
-			writeLiteralToCompiler(compiler, node->import.alias);
+			writeLiteralToCompiler(compiler, *node->import.identifier);
+			writeLiteralToCompiler(compiler, *node->import.alias);
 
 			//push the import opcode
 			compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_IMPORT; //1 byte
@@ -1016,6 +2084,10 @@ void Toy_writeCompiler(Toy_Compiler* compiler, Toy_ASTNode* node) {
 
 void Toy_freeCompiler(Toy_Compiler* compiler) {
 	Toy_freeLiteralArray(&compiler->literalCache);
+	Toy_freeLiteralArray(&compiler->jumpSites);
+	TOY_FREE_ARRAY(int, compiler->literalIndex, compiler->literalIndexCapacity);
+	compiler->literalIndex = NULL;
+	compiler->literalIndexCapacity = 0;
 	TOY_FREE_ARRAY(unsigned char, compiler->bytecode, compiler->capacity);
 	compiler->bytecode = NULL;
 	compiler->capacity = 0;
@@ -1067,6 +2139,83 @@ static void emitFloat(unsigned char** collationPtr, int* capacityPtr, int* count
 	emitByte(collationPtr, capacityPtr, countPtr, *ptr);
 }
 
+static void emitIndex(unsigned char** collationPtr, int* capacityPtr, int* countPtr, int index, int width) {
+	if (width == 2) {
+		Toy_emitShort(collationPtr, capacityPtr, countPtr, (unsigned short)index);
+	}
+	else {
+		emitInt(collationPtr, capacityPtr, countPtr, index);
+	}
+}
+
+//indexes within the literal section are shorts, unless there are too many literals (or elements) for that
+static int literalSectionWidth(Toy_Compiler* compiler) {
+	if (compiler->literalCache.count > 0xFFFF) {
+		return 4;
+	}
+
+	for (int i = 0; i < compiler->literalCache.count; i++) {
+		switch(compiler->literalCache.literals[i].type) {
+			case TOY_LITERAL_ARRAY:
+			case TOY_LITERAL_ARRAY_INTERMEDIATE:
+			case TOY_LITERAL_DICTIONARY:
+			case TOY_LITERAL_DICTIONARY_INTERMEDIATE:
+				if (TOY_AS_ARRAY(compiler->literalCache.literals[i])->count > 0xFFFF) {
+					return 4;
+				}
+			break;
+
+			default:
+			break;
+		}
+	}
+
+	return 2;
+}
+
+//how many jumps are written before this point
+static int countJumpSites(Toy_Compiler* compiler, int position) {
+	int low = 0;
+	int high = compiler->jumpSites.count;
+
+	while (low < high) {
+		int mid = (low + high) / 2;
+
+		if (TOY_AS_INTEGER(compiler->jumpSites.literals[mid]) < position) {
+			low = mid + 1;
+		}
+		else {
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
+static unsigned char narrowJumpOpcode(unsigned char opcode) {
+	switch(opcode) {
+		case TOY_OP_JUMP_WIDE:
+			return TOY_OP_JUMP;
+
+		case TOY_OP_COMPARE_JUMP_WIDE:
+			return TOY_OP_COMPARE_JUMP;
+
+		default:
+			return TOY_OP_IF_FALSE_JUMP;
+	}
+}
+
+static void alignCollation(unsigned char** collationPtr, int* capacityPtr, int* countPtr) {
+	//pad with zeroes until the next section boundary
+	while (*countPtr % TOY_SECTION_ALIGNMENT != 0) {
+		emitByte(collationPtr, capacityPtr, countPtr, 0);
+	}
+}
+
+static void writeInt(unsigned char* collation, int offset, int value) {
+	memcpy(collation + offset, &value, sizeof(int));
+}
+
 //return the result
 static unsigned char* collateCompilerHeaderOpt(Toy_Compiler* compiler, size_t* size, bool embedHeader) {
 	if (compiler->panic) {
@@ -1084,6 +2233,14 @@ static unsigned char* collateCompilerHeaderOpt(Toy_Compiler* compiler, size_t* s
 	int fnCount = 0;
 	unsigned char* fnCollation = TOY_ALLOCATE(unsigned char, fnCapacity);
 
+	//the offset & size of each function body, relative to the start of the function section for now
+	int indexCapacity = TOY_GROW_CAPACITY(0);
+	int indexCount = 0;
+	unsigned char* indexCollation = TOY_ALLOCATE(unsigned char, indexCapacity);
+
+	int sectionOffsets[TOY_SECTION_COUNT];
+	int sectionSizes[TOY_SECTION_COUNT];
+
 	if (embedHeader) {
 		//embed the header with version information
 		emitByte(&collation, &capacity, &count, TOY_VERSION_MAJOR);
@@ -1104,8 +2261,18 @@ static unsigned char* collateCompilerHeaderOpt(Toy_Compiler* compiler, size_t* s
 		emitByte(&collation, &capacity, &count, TOY_OP_SECTION_END); //terminate header
 	}
 
-	//embed the data section (first short is the number of literals)
-	Toy_emitShort(&collation, &capacity, &count, compiler->literalCache.count);
+	//reserve the section table, filled in once the sections are placed
+	alignCollation(&collation, &capacity, &count);
+	int tableOffset = count;
+	for (int i = 0; i < TOY_SECTION_COUNT * 2; i++) {
+		emitInt(&collation, &capacity, &count, 0);
+	}
+
+	//embed the data section (the width of the indexes, then the number of literals)
+	sectionOffsets[TOY_SECTION_LITERALS] = count;
+	int literalWidth = literalSectionWidth(compiler);
+	emitByte(&collation, &capacity, &count, (unsigned char)literalWidth);
+	emitIndex(&collation, &capacity, &count, compiler->literalCache.count, literalWidth);
 
 	//emit each literal by type
 	for (int i = 0; i < compiler->literalCache.count; i++) {
@@ -1153,11 +2320,11 @@ static unsigned char* collateCompilerHeaderOpt(Toy_Compiler* compiler, size_t* s
 				Toy_LiteralArray* ptr = TOY_AS_ARRAY(compiler->literalCache.literals[i]);
 
 				//length of the array, as a short
-				Toy_emitShort(&collation, &capacity, &count, ptr->count);
+				emitIndex(&collation, &capacity, &count, ptr->count, literalWidth);
 
 				//each element of the array
 				for (int i = 0; i < ptr->count; i++) {
-					Toy_emitShort(&collation, &capacity, &count, (unsigned short)TOY_AS_INTEGER(ptr->literals[i])); //shorts representing the indexes of the values
+					emitIndex(&collation, &capacity, &count, TOY_AS_INTEGER(ptr->literals[i]), literalWidth); //representing the indexes of the values
 				}
 			}
 			break;
@@ -1168,11 +2335,11 @@ static unsigned char* collateCompilerHeaderOpt(Toy_Compiler* compiler, size_t* s
 				Toy_LiteralArray* ptr = TOY_AS_ARRAY(compiler->literalCache.literals[i]);
 
 				//length of the array, as a short
-				Toy_emitShort(&collation, &capacity, &count, ptr->count);
+				emitIndex(&collation, &capacity, &count, ptr->count, literalWidth);
 
 				//each element of the array
 				for (int i = 0; i < ptr->count; i++) {
-					Toy_emitShort(&collation, &capacity, &count, (unsigned short)TOY_AS_INTEGER(ptr->literals[i])); //shorts representing the indexes of the values
+					emitIndex(&collation, &capacity, &count, TOY_AS_INTEGER(ptr->literals[i]), literalWidth); //representing the indexes of the values
 				}
 			}
 			break;
@@ -1183,11 +2350,11 @@ static unsigned char* collateCompilerHeaderOpt(Toy_Compiler* compiler, size_t* s
 				Toy_LiteralArray* ptr = TOY_AS_ARRAY(compiler->literalCache.literals[i]); //used an array for storage above
 
 				//length of the array, as a short
-				Toy_emitShort(&collation, &capacity, &count, ptr->count); //count is the array size, NOT the dictionary size
+				emitIndex(&collation, &capacity, &count, ptr->count, literalWidth); //count is the array size, NOT the dictionary size
 
 				//each element of the array
 				for (int i = 0; i < ptr->count; i++) {
-					Toy_emitShort(&collation, &capacity, &count, (unsigned short)TOY_AS_INTEGER(ptr->literals[i])); //shorts representing the indexes of the values
+					emitIndex(&collation, &capacity, &count, TOY_AS_INTEGER(ptr->literals[i]), literalWidth); //representing the indexes of the values
 				}
 			}
 			break;
@@ -1198,11 +2365,11 @@ static unsigned char* collateCompilerHeaderOpt(Toy_Compiler* compiler, size_t* s
 				Toy_LiteralArray* ptr = TOY_AS_ARRAY(compiler->literalCache.literals[i]); //used an array for storage above
 
 				//length of the array, as a short
-				Toy_emitShort(&collation, &capacity, &count, ptr->count); //count is the array size, NOT the dictionary size
+				emitIndex(&collation, &capacity, &count, ptr->count, literalWidth); //count is the array size, NOT the dictionary size
 
 				//each element of the array
 				for (int i = 0; i < ptr->count; i++) {
-					Toy_emitShort(&collation, &capacity, &count, (unsigned short)TOY_AS_INTEGER(ptr->literals[i])); //shorts representing the indexes of the values
+					emitIndex(&collation, &capacity, &count, TOY_AS_INTEGER(ptr->literals[i]), literalWidth); //representing the indexes of the values
 				}
 			}
 			break;
@@ -1216,8 +2383,12 @@ static unsigned char* collateCompilerHeaderOpt(Toy_Compiler* compiler, size_t* s
 				size_t size = 0;
 				unsigned char* bytes = collateCompilerHeaderOpt((Toy_Compiler*)fnCompiler, &size, false);
 
-				//emit how long this section is, +1 for ending mark
-				Toy_emitShort(&fnCollation, &fnCapacity, &fnCount, (unsigned short)size + 1);
+				//each body is aligned, so its own sections stay aligned
+				alignCollation(&fnCollation, &fnCapacity, &fnCount);
+
+				//record where the body is, and how long it is, +1 for ending mark
+				emitInt(&indexCollation, &indexCapacity, &indexCount, fnCount);
+				emitInt(&indexCollation, &indexCapacity, &indexCount, (int)size + 1);
 
 				//write the fn to the fn collation
 				for (size_t i = 0; i < size; i++) {
@@ -1228,7 +2399,7 @@ static unsigned char* collateCompilerHeaderOpt(Toy_Compiler* compiler, size_t* s
 
 				//embed the reference to the function implementation into the current collation (to be extracted later)
 				emitByte(&collation, &capacity, &count, TOY_LITERAL_FUNCTION);
-				Toy_emitShort(&collation, &capacity, &count, (unsigned short)(fnIndex++));
+				emitIndex(&collation, &capacity, &count, fnIndex++, literalWidth);
 
 				Toy_freeCompiler((Toy_Compiler*)fnCompiler);
 				TOY_FREE(compiler, fnCompiler);
@@ -1277,7 +2448,7 @@ static unsigned char* collateCompilerHeaderOpt(Toy_Compiler* compiler, size_t* s
 				if (TOY_AS_TYPE(typeLiteral).typeOf == TOY_LITERAL_ARRAY || TOY_AS_TYPE(typeLiteral).typeOf == TOY_LITERAL_DICTIONARY) {
 					//the type will represent how many to expect in the array
 					for (int i = 1; i < ptr->count; i++) {
-						Toy_emitShort(&collation, &capacity, &count, (unsigned short)TOY_AS_INTEGER(ptr->literals[i])); //shorts representing the indexes of the types
+						emitIndex(&collation, &capacity, &count, TOY_AS_INTEGER(ptr->literals[i]), literalWidth); //representing the indexes of the types
 					}
 				}
 
@@ -1297,27 +2468,79 @@ static unsigned char* collateCompilerHeaderOpt(Toy_Compiler* compiler, size_t* s
 	}
 
 	emitByte(&collation, &capacity, &count, TOY_OP_SECTION_END); //terminate data
+	sectionSizes[TOY_SECTION_LITERALS] = count - sectionOffsets[TOY_SECTION_LITERALS];
+
+	//embed the function index, pointing into the function section that follows it
+	alignCollation(&collation, &capacity, &count);
+	sectionOffsets[TOY_SECTION_FUNCTION_INDEX] = count;
+	sectionSizes[TOY_SECTION_FUNCTION_INDEX] = indexCount;
+
+	int functionsOffset = count + indexCount;
+	while (functionsOffset % TOY_SECTION_ALIGNMENT != 0) {
+		functionsOffset++;
+	}
 
-	//embed the function section (beginning with function count, size)
-	Toy_emitShort(&collation, &capacity, &count, fnIndex);
-	Toy_emitShort(&collation, &capacity, &count, fnCount);
+	for (int i = 0; i < fnIndex; i++) {
+		int offset = 0;
+		int fnSize = 0;
+		memcpy(&offset, indexCollation + i * 8, sizeof(int));
+		memcpy(&fnSize, indexCollation + i * 8 + 4, sizeof(int));
+
+		emitInt(&collation, &capacity, &count, functionsOffset + offset);
+		emitInt(&collation, &capacity, &count, fnSize);
+	}
+
+	//embed the function bodies
+	alignCollation(&collation, &capacity, &count);
+	sectionOffsets[TOY_SECTION_FUNCTIONS] = count;
 
 	for (int i = 0; i < fnCount; i++) {
 		emitByte(&collation, &capacity, &count, fnCollation[i]);
 	}
 
-	emitByte(&collation, &capacity, &count, TOY_OP_SECTION_END); //terminate function section
+	sectionSizes[TOY_SECTION_FUNCTIONS] = fnCount;
 
 	TOY_FREE_ARRAY(unsigned char, fnCollation, fnCapacity); //clear the function stuff
+	TOY_FREE_ARRAY(unsigned char, indexCollation, indexCapacity);
 
 	//code section
+	alignCollation(&collation, &capacity, &count);
+	sectionOffsets[TOY_SECTION_CODE] = count;
+
+	//jumps are narrowed when every target fits in a short, which it always does below 64KB of code
+	bool narrowJumps = compiler->count <= 0xFFFF;
+	int jumpOffsets = embedHeader ? 0 : -4; //function bodies jump relative to their code, after the parameter & return indexes
+	int site = 0;
+
 	for (int i = 0; i < compiler->count; i++) {
+		if (narrowJumps && site < compiler->jumpSites.count && i + 1 == TOY_AS_INTEGER(compiler->jumpSites.literals[site])) {
+			emitByte(&collation, &capacity, &count, narrowJumpOpcode(compiler->bytecode[i]));
+
+			//every narrowed jump before the target moves it back by 2 bytes
+			int target = 0;
+			memcpy(&target, compiler->bytecode + i + 1, sizeof(int));
+			target -= countJumpSites(compiler, target - jumpOffsets) * 2;
+
+			Toy_emitShort(&collation, &capacity, &count, (unsigned short)target);
+
+			i += sizeof(int);
+			site++;
+			continue;
+		}
+
 		emitByte(&collation, &capacity, &count, compiler->bytecode[i]);
 	}
 
 	emitByte(&collation, &capacity, &count, TOY_OP_SECTION_END); //terminate code
 
 	emitByte(&collation, &capacity, &count, TOY_OP_EOF); //terminate bytecode
+	sectionSizes[TOY_SECTION_CODE] = count - sectionOffsets[TOY_SECTION_CODE];
+
+	//fill in the section table
+	for (int i = 0; i < TOY_SECTION_COUNT; i++) {
+		writeInt(collation, tableOffset + i * 8, sectionOffsets[i]);
+		writeInt(collation, tableOffset + i * 8 + 4, sectionSizes[i]);
+	}
 
 	//finalize
 	collation = TOY_SHRINK_ARRAY(unsigned char, collation, capacity, count);
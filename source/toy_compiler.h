@@ -8,9 +8,13 @@
 //the compiler takes the nodes, and turns them into sequential chunks of bytecode, saving literals to an external array
 typedef struct Toy_Compiler {
 	Toy_LiteralArray literalCache;
+	int* literalIndex; //hash index into the literal cache, for deduplication
+	int literalIndexCapacity;
 	unsigned char* bytecode;
 	int capacity;
 	int count;
+	Toy_LiteralArray jumpSites; //where each jump's target is written, so they can be narrowed when collating
+	bool registers; //function bodies are compiled for the register engine where possible, and for the stack otherwise
 	bool panic;
 } Toy_Compiler;
 
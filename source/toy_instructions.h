@@ -0,0 +1,59 @@
+#pragma once
+
+#include "toy_common.h"
+#include "toy_interpreter.h"
+#include "toy_opcodes.h"
+
+//every instruction with a handler, as a named function with it's operands already decoded - for code generated ahead of time (see tools/toy2c)
+//literals are indexes into the literal cache, and jump targets are relative to the start of the code, exactly as they're written in the bytecode
+//each returns false when the instruction fails, and the jumps move count to the target when they're taken
+
+TOY_API bool Toy_instAssert(Toy_Interpreter* interpreter);
+TOY_API bool Toy_instPrint(Toy_Interpreter* interpreter);
+
+//literals
+TOY_API bool Toy_instPushLiteral(Toy_Interpreter* interpreter, int index);
+TOY_API bool Toy_instRawLiteral(Toy_Interpreter* interpreter);
+TOY_API bool Toy_instBuiltin(Toy_Interpreter* interpreter, int index, int identifierIndex);
+
+//arithmetic
+TOY_API bool Toy_instNegate(Toy_Interpreter* interpreter);
+TOY_API bool Toy_instArithmetic(Toy_Interpreter* interpreter, Toy_Opcode opcode);
+TOY_API bool Toy_instArithmeticInt(Toy_Interpreter* interpreter, Toy_Opcode opcode);
+TOY_API bool Toy_instArithmeticFloat(Toy_Interpreter* interpreter, Toy_Opcode opcode);
+TOY_API bool Toy_instCompoundAssign(Toy_Interpreter* interpreter, Toy_Opcode opcode);
+TOY_API bool Toy_instArithmeticAssignLiterals(Toy_Interpreter* interpreter, Toy_Opcode opcode, int lhsIndex, int firstIndex, int secondIndex);
+
+//variables & scopes
+TOY_API bool Toy_instPushScope(Toy_Interpreter* interpreter);
+TOY_API bool Toy_instPopScope(Toy_Interpreter* interpreter);
+TOY_API bool Toy_instVarDecl(Toy_Interpreter* interpreter, int identifierIndex, int typeIndex);
+TOY_API bool Toy_instFnDecl(Toy_Interpreter* interpreter, int identifierIndex, int functionIndex);
+TOY_API bool Toy_instVarAssign(Toy_Interpreter* interpreter);
+TOY_API bool Toy_instTypeCast(Toy_Interpreter* interpreter);
+TOY_API bool Toy_instTypeOf(Toy_Interpreter* interpreter);
+
+//comparisons & logic
+TOY_API bool Toy_instCompareEqual(Toy_Interpreter* interpreter, bool invert);
+TOY_API bool Toy_instCompareLess(Toy_Interpreter* interpreter, bool invert);
+TOY_API bool Toy_instCompareLessEqual(Toy_Interpreter* interpreter, bool invert);
+TOY_API bool Toy_instCompareInt(Toy_Interpreter* interpreter, Toy_Opcode opcode);
+TOY_API bool Toy_instInvert(Toy_Interpreter* interpreter);
+TOY_API bool Toy_instAnd(Toy_Interpreter* interpreter);
+TOY_API bool Toy_instOr(Toy_Interpreter* interpreter);
+
+//conditional jumps
+TOY_API bool Toy_instFalseJump(Toy_Interpreter* interpreter, int target);
+TOY_API bool Toy_instCompareJump(Toy_Interpreter* interpreter, int target, Toy_Opcode comparison);
+
+//functions
+TOY_API bool Toy_instFnCall(Toy_Interpreter* interpreter, bool looseFirstArgument);
+TOY_API bool Toy_instTailCall(Toy_Interpreter* interpreter);
+TOY_API bool Toy_instFnReturn(Toy_Interpreter* interpreter);
+
+//indexing
+TOY_API bool Toy_instIndex(Toy_Interpreter* interpreter);
+TOY_API bool Toy_instIndexGet(Toy_Interpreter* interpreter);
+TOY_API bool Toy_instIndexSet(Toy_Interpreter* interpreter, Toy_Opcode assignment);
+
+TOY_API bool Toy_instPopStack(Toy_Interpreter* interpreter);
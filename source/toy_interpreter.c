@@ -5,6 +5,7 @@
 #include "toy_memory.h"
 #include "toy_keyword_types.h"
 #include "toy_opcodes.h"
+#include "toy_instructions.h"
 
 #include "toy_builtin.h"
 
@@ -33,7 +34,7 @@ static void errorWrapper(const char* output) {
 	fprintf(stderr, TOY_CC_ERROR "%s" TOY_CC_RESET, output); //no newline
 }
 
-bool Toy_injectNativeFn(Toy_Interpreter* interpreter, const char* name, Toy_NativeFn func) {
+static bool injectNative(Toy_Interpreter* interpreter, const char* name, Toy_Literal fn) {
 	//reject reserved words
 	if (Toy_findTypeByKeyword(name) != TOY_TOKEN_EOF) {
 		interpreter->errorOutput("Can't override an existing keyword\n");
@@ -42,17 +43,18 @@ bool Toy_injectNativeFn(Toy_Interpreter* interpreter, const char* name, Toy_Nati
 
 	Toy_Literal identifier = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefString(name));
 
+	Toy_Literal type = TOY_TO_TYPE_LITERAL(fn.type, true);
+
 	//make sure the name isn't taken
-	if (Toy_existsLiteralDictionary(&interpreter->scope->variables, identifier)) {
+	if (!Toy_declareScopeVariable(interpreter->scope, identifier, type)) {
 		interpreter->errorOutput("Can't override an existing variable\n");
+		Toy_freeLiteral(identifier);
+		Toy_freeLiteral(type);
 		return false;
 	}
 
-	Toy_Literal fn = TOY_TO_FUNCTION_NATIVE_LITERAL(func);
-	Toy_Literal type = TOY_TO_TYPE_LITERAL(fn.type, true);
-
+	//set directly, as it's a constant
 	Toy_setLiteralDictionary(&interpreter->scope->variables, identifier, fn);
-	Toy_setLiteralDictionary(&interpreter->scope->types, identifier, type);
 
 	Toy_freeLiteral(identifier);
 	Toy_freeLiteral(type);
@@ -60,6 +62,14 @@ bool Toy_injectNativeFn(Toy_Interpreter* interpreter, const char* name, Toy_Nati
 	return true;
 }
 
+bool Toy_injectNativeFn(Toy_Interpreter* interpreter, const char* name, Toy_NativeFn func) {
+	return injectNative(interpreter, name, TOY_TO_FUNCTION_NATIVE_LITERAL(func));
+}
+
+bool Toy_injectNativeViewFn(Toy_Interpreter* interpreter, const char* name, Toy_NativeViewFn func) {
+	return injectNative(interpreter, name, TOY_TO_FUNCTION_NATIVE_VIEW_LITERAL(func));
+}
+
 bool Toy_injectNativeHook(Toy_Interpreter* interpreter, const char* name, Toy_HookFn hook) {
 	//reject reserved words
 	if (Toy_findTypeByKeyword(name) != TOY_TOKEN_EOF) {
@@ -146,7 +156,7 @@ void Toy_parseCompoundToPureValues(Toy_Interpreter* interpreter, Toy_Literal* li
 bool Toy_parseIdentifierToValue(Toy_Interpreter* interpreter, Toy_Literal* literalPtr) {
 	//this converts identifiers to values
 	if (TOY_IS_IDENTIFIER(*literalPtr)) {
-		if (!Toy_getScopeVariable(interpreter->scope, *literalPtr, literalPtr)) {
+		if (!Toy_getScopeVariableCached(interpreter->scope, &interpreter->scopeCache, *literalPtr, literalPtr)) {
 			interpreter->errorOutput("Undeclared variable ");
 			Toy_printLiteralCustom(*literalPtr, interpreter->errorOutput);
 			interpreter->errorOutput("\n");
@@ -195,6 +205,20 @@ static int readInt(const unsigned char* tb, int* count) {
 	return ret;
 }
 
+//indexes can be 1, 2 or 4 bytes wide
+static int readIndex(const unsigned char* tb, int* count, int width) {
+	switch(width) {
+		case 1:
+			return (int)readByte(tb, count);
+
+		case 2:
+			return (int)readShort(tb, count);
+
+		default:
+			return readInt(tb, count);
+	}
+}
+
 static float readFloat(const unsigned char* tb, int* count) {
 	float ret = 0;
 	memcpy(&ret, tb + *count, 4);
@@ -288,23 +312,39 @@ static bool execPrint(Toy_Interpreter* interpreter) {
 	return true;
 }
 
-static bool execPushLiteral(Toy_Interpreter* interpreter, bool lng) {
+static bool execPushLiteralAt(Toy_Interpreter* interpreter, int index) {
+	//push from cache to stack (DO NOT account for identifiers - will do that later)
+	Toy_pushLiteralArray(&interpreter->stack, interpreter->literalCache.literals[index]);
+
+	return true;
+}
+
+static bool execPushLiteral(Toy_Interpreter* interpreter, int width) {
 	//read the index in the cache
-	int index = 0;
+	return execPushLiteralAt(interpreter, readIndex(interpreter->bytecode, &interpreter->count, width));
+}
+
+//builtins are only in the outermost scope, so unless something closer declares the name, it can't be anything else
+static bool execBuiltinAt(Toy_Interpreter* interpreter, int index, int identifierIndex) {
+	Toy_Literal identifier = interpreter->literalCache.literals[identifierIndex];
 
-	if (lng) {
-		index = (int)readShort(interpreter->bytecode, &interpreter->count);
+	if (index >= TOY_BUILTIN_COUNT || Toy_isShadowedScopeVariable(interpreter->scope, identifier)) {
+		Toy_pushLiteralArray(&interpreter->stack, identifier);
 	}
 	else {
-		index = (int)readByte(interpreter->bytecode, &interpreter->count);
+		Toy_Literal fn = TOY_TO_FUNCTION_NATIVE_VIEW_LITERAL(Toy_private_builtins[index].fn);
+		Toy_pushLiteralArray(&interpreter->stack, fn);
 	}
 
-	//push from cache to stack (DO NOT account for identifiers - will do that later)
-	Toy_pushLiteralArray(&interpreter->stack, interpreter->literalCache.literals[index]);
-
 	return true;
 }
 
+static bool execBuiltin(Toy_Interpreter* interpreter) {
+	int index = readByte(interpreter->bytecode, &interpreter->count);
+	int identifierIndex = readShort(interpreter->bytecode, &interpreter->count);
+	return execBuiltinAt(interpreter, index, identifierIndex);
+}
+
 static bool rawLiteral(Toy_Interpreter* interpreter) {
 	Toy_Literal lit = Toy_popLiteralArray(&interpreter->stack);
 
@@ -567,20 +607,7 @@ static Toy_Literal parseTypeToValue(Toy_Interpreter* interpreter, Toy_Literal ty
 	return type;
 }
 
-static bool execVarDecl(Toy_Interpreter* interpreter, bool lng) {
-	//read the index in the cache
-	int identifierIndex = 0;
-	int typeIndex = 0;
-
-	if (lng) {
-		identifierIndex = (int)readShort(interpreter->bytecode, &interpreter->count);
-		typeIndex = (int)readShort(interpreter->bytecode, &interpreter->count);
-	}
-	else {
-		identifierIndex = (int)readByte(interpreter->bytecode, &interpreter->count);
-		typeIndex = (int)readByte(interpreter->bytecode, &interpreter->count);
-	}
-
+static bool execVarDeclAt(Toy_Interpreter* interpreter, int identifierIndex, int typeIndex) {
 	Toy_Literal identifier = interpreter->literalCache.literals[identifierIndex];
 	Toy_Literal type = Toy_copyLiteral(interpreter->literalCache.literals[typeIndex]);
 
@@ -647,18 +674,20 @@ static bool execVarDecl(Toy_Interpreter* interpreter, bool lng) {
 	return true;
 }
 
-static bool execFnDecl(Toy_Interpreter* interpreter, bool lng) {
+static bool execVarDecl(Toy_Interpreter* interpreter, int width) {
 	//read the index in the cache
-	int identifierIndex = 0;
-	int functionIndex = 0;
+	int identifierIndex = readIndex(interpreter->bytecode, &interpreter->count, width);
+	int typeIndex = readIndex(interpreter->bytecode, &interpreter->count, width);
 
-	if (lng) {
-		identifierIndex = (int)readShort(interpreter->bytecode, &interpreter->count);
-		functionIndex = (int)readShort(interpreter->bytecode, &interpreter->count);
-	}
-	else {
-		identifierIndex = (int)readByte(interpreter->bytecode, &interpreter->count);
-		functionIndex = (int)readByte(interpreter->bytecode, &interpreter->count);
+	return execVarDeclAt(interpreter, identifierIndex, typeIndex);
+}
+
+static bool readFunctionLiteral(Toy_Interpreter* interpreter, int literalIndex);
+
+static bool execFnDeclAt(Toy_Interpreter* interpreter, int identifierIndex, int functionIndex) {
+	//function bodies are read from the bytecode the first time they're declared
+	if (interpreter->literalCache.literals[functionIndex].type == TOY_LITERAL_FUNCTION_INTERMEDIATE && !readFunctionLiteral(interpreter, functionIndex)) {
+		return false;
 	}
 
 	Toy_Literal identifier = interpreter->literalCache.literals[identifierIndex];
@@ -690,6 +719,14 @@ static bool execFnDecl(Toy_Interpreter* interpreter, bool lng) {
 	return true;
 }
 
+static bool execFnDecl(Toy_Interpreter* interpreter, int width) {
+	//read the index in the cache
+	int identifierIndex = readIndex(interpreter->bytecode, &interpreter->count, width);
+	int functionIndex = readIndex(interpreter->bytecode, &interpreter->count, width);
+
+	return execFnDeclAt(interpreter, identifierIndex, functionIndex);
+}
+
 static bool execVarAssign(Toy_Interpreter* interpreter) {
 	Toy_Literal rhs = Toy_popLiteralArray(&interpreter->stack);
 	Toy_Literal lhs = Toy_popLiteralArray(&interpreter->stack);
@@ -732,7 +769,7 @@ static bool execVarAssign(Toy_Interpreter* interpreter) {
 		rhs = TOY_TO_FLOAT_LITERAL(TOY_AS_INTEGER(rhs));
 	}
 
-	if (!Toy_setScopeVariable(interpreter->scope, lhs, rhs, true)) {
+	if (!Toy_setScopeVariableCached(interpreter->scope, &interpreter->scopeCache, lhs, rhs, true)) {
 		interpreter->errorOutput("Incorrect type assigned to variable \"");
 		Toy_printLiteralCustom(lhs, interpreter->errorOutput);
 		interpreter->errorOutput("\"\n");
@@ -1135,8 +1172,8 @@ static bool execOr(Toy_Interpreter* interpreter) {
 	return true;
 }
 
-static bool execJump(Toy_Interpreter* interpreter) {
-	int target = (int)readShort(interpreter->bytecode, &interpreter->count);
+static bool execJump(Toy_Interpreter* interpreter, int width) {
+	int target = readIndex(interpreter->bytecode, &interpreter->count, width);
 
 	if (target + interpreter->codeStart > interpreter->length) {
 		interpreter->errorOutput("[internal] Jump out of range\n");
@@ -1149,14 +1186,20 @@ static bool execJump(Toy_Interpreter* interpreter) {
 	return true;
 }
 
-static bool execFalseJump(Toy_Interpreter* interpreter) {
-	int target = (int)readShort(interpreter->bytecode, &interpreter->count);
+static bool execFalseJumpTo(Toy_Interpreter* interpreter, int target);
+
+static bool execFalseJump(Toy_Interpreter* interpreter, int width) {
+	int target = readIndex(interpreter->bytecode, &interpreter->count, width);
 
 	if (target + interpreter->codeStart > interpreter->length) {
 		interpreter->errorOutput("[internal] Jump out of range (false jump)\n");
 		return false;
 	}
 
+	return execFalseJumpTo(interpreter, target);
+}
+
+static bool execFalseJumpTo(Toy_Interpreter* interpreter, int target) {
 	//actually jump
 	Toy_Literal lit = Toy_popLiteralArray(&interpreter->stack);
 
@@ -1185,748 +1228,2252 @@ static bool execFalseJump(Toy_Interpreter* interpreter) {
 	return true;
 }
 
-//forward declare
-static void execInterpreter(Toy_Interpreter*);
-static void readInterpreterSections(Toy_Interpreter* interpreter);
-
-//expect stack: identifier, arg1, arg2, arg3..., stackSize
-//also supports identifier & arg1 to be other way around (looseFirstArgument)
-static bool execFnCall(Toy_Interpreter* interpreter, bool looseFirstArgument) {
-	//BUGFIX: depth check - don't drown!
-	if (interpreter->depth >= 200) {
-		interpreter->errorOutput("Infinite recursion detected - panicking\n");
-		interpreter->panic = true;
-		return false;
-	}
+static bool execCompare(Toy_Interpreter* interpreter, Toy_Opcode comparison) {
+	switch(comparison) {
+		case TOY_OP_COMPARE_EQUAL:
+			return execCompareEqual(interpreter, false);
 
-	Toy_LiteralArray arguments;
-	Toy_initLiteralArray(&arguments);
+		case TOY_OP_COMPARE_NOT_EQUAL:
+			return execCompareEqual(interpreter, true);
 
-	Toy_Literal stackSize = Toy_popLiteralArray(&interpreter->stack);
+		case TOY_OP_COMPARE_LESS:
+			return execCompareLess(interpreter, false);
 
-	//unpack the stack of arguments
-	for (int i = 0; i < TOY_AS_INTEGER(stackSize) - 1; i++) {
-		Toy_Literal lit = Toy_popLiteralArray(&interpreter->stack);
-		Toy_pushLiteralArray(&arguments, lit); //NOTE: also reverses the order
-		Toy_freeLiteral(lit);
-	}
+		case TOY_OP_COMPARE_LESS_EQUAL:
+			return execCompareLessEqual(interpreter, false);
 
-	//collect one more argument
-	if (!looseFirstArgument && TOY_AS_INTEGER(stackSize) > 0) {
-		Toy_Literal lit = Toy_popLiteralArray(&interpreter->stack);
-		Toy_pushLiteralArray(&arguments, lit); //NOTE: also reverses the order
-		Toy_freeLiteral(lit);
-	}
+		case TOY_OP_COMPARE_GREATER:
+			return execCompareLess(interpreter, true);
 
-	Toy_Literal identifier = Toy_popLiteralArray(&interpreter->stack);
+		case TOY_OP_COMPARE_GREATER_EQUAL:
+			return execCompareLessEqual(interpreter, true);
 
-	//collect one more argument
-	if (looseFirstArgument) {
-		Toy_Literal lit = Toy_popLiteralArray(&interpreter->stack);
-		Toy_pushLiteralArray(&arguments, lit); //NOTE: also reverses the order
-		Toy_freeLiteral(lit);
+		default:
+			interpreter->errorOutput("[internal] Unknown comparison in compare jump\n");
+			return false;
 	}
+}
 
-	//get the function literal
-	Toy_Literal func = identifier;
-
-	if (!Toy_parseIdentifierToValue(interpreter, &func)) {
-		Toy_freeLiteralArray(&arguments);
-		Toy_freeLiteral(stackSize);
-		Toy_freeLiteral(identifier);
-		return false;
-	}
+//reads a copy of the value, without any errors
+static bool peekIntegerValue(Toy_Interpreter* interpreter, Toy_Literal literal, int* value) {
+	if (TOY_IS_IDENTIFIER(literal)) {
+		Toy_Literal result = TOY_TO_NULL_LITERAL;
+		if (!Toy_getScopeVariableCached(interpreter->scope, &interpreter->scopeCache, literal, &result)) {
+			return false;
+		}
 
-	if (!TOY_IS_FUNCTION(func) && !TOY_IS_FUNCTION_NATIVE(func)) {
-		interpreter->errorOutput("Function not found: ");
-		Toy_printLiteralCustom(identifier, interpreter->errorOutput);
-		interpreter->errorOutput("\n");
+		bool found = TOY_IS_INTEGER(result);
+		if (found) {
+			*value = TOY_AS_INTEGER(result);
+		}
 
-		Toy_freeLiteral(identifier);
-		Toy_freeLiteral(stackSize);
-		Toy_freeLiteralArray(&arguments);
-		return false;
+		Toy_freeLiteral(result);
+		return found;
 	}
 
-	//BUGFIX: correct the argument order
-	Toy_LiteralArray correct;
-	Toy_initLiteralArray(&correct);
-
-	while (arguments.count > 0) {
-		Toy_Literal lit = Toy_popLiteralArray(&arguments);
-		Toy_pushLiteralArray(&correct, lit);
-		Toy_freeLiteral(lit);
+	if (TOY_IS_INTEGER(literal)) {
+		*value = TOY_AS_INTEGER(literal);
+		return true;
 	}
 
-	//call the function literal
-	bool ret = Toy_callLiteralFn(interpreter, func, &correct, &interpreter->stack);
+	return false;
+}
 
-	if (!ret) {
-		interpreter->errorOutput("Error encountered in function \"");
-		Toy_printLiteralCustom(identifier, interpreter->errorOutput);
-		interpreter->errorOutput("\"\n");
-	}
+//superinstruction: a comparison and a false jump, without the boolean in between
+static bool execCompareJumpTo(Toy_Interpreter* interpreter, int target, Toy_Opcode comparison) {
+	//fast path for integers, with the same results as the separate instructions
+	int lhs = 0;
+	int rhs = 0;
 
-	Toy_freeLiteralArray(&correct);
-	Toy_freeLiteralArray(&arguments);
-	Toy_freeLiteral(func);
-	Toy_freeLiteral(stackSize);
-	Toy_freeLiteral(identifier);
+	if (interpreter->stack.count >= 2 && peekIntegerValue(interpreter, interpreter->stack.literals[interpreter->stack.count - 2], &lhs) && peekIntegerValue(interpreter, interpreter->stack.literals[interpreter->stack.count - 1], &rhs)) {
+		bool result;
 
-	return ret;
-}
+		//NOTE: the ordered comparisons are done as floats
+		switch(comparison) {
+			case TOY_OP_COMPARE_EQUAL:
+				result = lhs == rhs;
+			break;
 
-//expects arguments in correct order
-bool Toy_callLiteralFn(Toy_Interpreter* interpreter, Toy_Literal func, Toy_LiteralArray* arguments, Toy_LiteralArray* returns) {
-	//check for side-loaded native functions
-	if (TOY_IS_FUNCTION_NATIVE(func)) {
-		//TODO: parse out identifier values, see issue #64
+			case TOY_OP_COMPARE_NOT_EQUAL:
+				result = lhs != rhs;
+			break;
 
-		//call the native function
-		int returnsCount = TOY_AS_FUNCTION_NATIVE(func)(interpreter, arguments);
+			case TOY_OP_COMPARE_LESS:
+				result = (float)lhs < (float)rhs;
+			break;
 
-		if (returnsCount < 0) {
-			// interpreter->errorOutput("Unknown error from native function\n");
-			return false;
-		}
+			case TOY_OP_COMPARE_LESS_EQUAL:
+				result = (float)lhs <= (float)rhs;
+			break;
 
-		//get the results
-		Toy_LiteralArray returnsFromInner;
-		Toy_initLiteralArray(&returnsFromInner);
+			case TOY_OP_COMPARE_GREATER:
+				result = (float)lhs > (float)rhs;
+			break;
 
-		for (int i = 0; i < (returnsCount || 1); i++) {
-			Toy_Literal lit = Toy_popLiteralArray(&interpreter->stack);
-			Toy_pushLiteralArray(&returnsFromInner, lit); //NOTE: also reverses the order
-			Toy_freeLiteral(lit);
+			case TOY_OP_COMPARE_GREATER_EQUAL:
+				result = (float)lhs >= (float)rhs;
+			break;
+
+			default:
+				interpreter->errorOutput("[internal] Unknown comparison in compare jump\n");
+				return false;
 		}
 
-		//flip them around and pass to returns
-		while (returnsFromInner.count > 0) {
-			Toy_Literal lit = Toy_popLiteralArray(&returnsFromInner);
-			Toy_pushLiteralArray(returns, lit);
-			Toy_freeLiteral(lit);
+		Toy_freeLiteral(Toy_popLiteralArray(&interpreter->stack));
+		Toy_freeLiteral(Toy_popLiteralArray(&interpreter->stack));
+
+		if (!result) {
+			interpreter->count = target + interpreter->codeStart;
 		}
 
-		Toy_freeLiteralArray(&returnsFromInner);
 		return true;
 	}
 
-	//normal Toy function
-	if (!TOY_IS_FUNCTION(func)) {
-		interpreter->errorOutput("Function literal required in Toy_callLiteralFn()\n");
+	//otherwise, exactly as the separate instructions
+	if (!execCompare(interpreter, comparison)) {
 		return false;
 	}
 
-	//set up a new interpreter
-	Toy_Interpreter inner;
-
-	//init the inner interpreter manually
-	Toy_initLiteralArray(&inner.literalCache);
-	inner.scope = Toy_pushScope(func.as.function.scope);
-	inner.bytecode = TOY_AS_FUNCTION(func).inner.bytecode;
-	inner.length = TOY_AS_FUNCTION_BYTECODE_LENGTH(func);
-	inner.count = 0;
-	inner.codeStart = -1;
-	inner.depth = interpreter->depth + 1;
-	inner.panic = false;
-	Toy_initLiteralArray(&inner.stack);
-	inner.hooks = interpreter->hooks;
-	Toy_setInterpreterPrint(&inner, interpreter->printOutput);
-	Toy_setInterpreterAssert(&inner, interpreter->assertOutput);
-	Toy_setInterpreterError(&inner, interpreter->errorOutput);
-
-	//prep the sections
-	readInterpreterSections(&inner);
-
-	//prep the arguments
-	Toy_LiteralArray* paramArray = TOY_AS_ARRAY(inner.literalCache.literals[ readShort(inner.bytecode, &inner.count) ]);
-	Toy_LiteralArray* returnArray = TOY_AS_ARRAY(inner.literalCache.literals[ readShort(inner.bytecode, &inner.count) ]);
-
-	//get the rest param, if it exists
-	Toy_Literal restParam = TOY_TO_NULL_LITERAL;
-	if (paramArray->count >= 2 && TOY_AS_TYPE(paramArray->literals[ paramArray->count -1 ]).typeOf == TOY_LITERAL_FUNCTION_ARG_REST) {
-		restParam = paramArray->literals[ paramArray->count -2 ];
-	}
-
-	//check the param total is correct
-	if ((TOY_IS_NULL(restParam) && paramArray->count != arguments->count * 2) || (!TOY_IS_NULL(restParam) && paramArray->count -2 > arguments->count * 2)) {
-		interpreter->errorOutput("Incorrect number of arguments passed to a function\n");
-
-		//free, and skip out
-		Toy_popScope(inner.scope);
+	return execFalseJumpTo(interpreter, target);
+}
 
-		Toy_freeLiteralArray(&inner.stack);
-		Toy_freeLiteralArray(&inner.literalCache);
+static bool execCompareJump(Toy_Interpreter* interpreter, int width) {
+	int target = readIndex(interpreter->bytecode, &interpreter->count, width);
+	Toy_Opcode comparison = (Toy_Opcode)readByte(interpreter->bytecode, &interpreter->count);
 
+	if (target + interpreter->codeStart > interpreter->length) {
+		interpreter->errorOutput("[internal] Jump out of range (compare jump)\n");
 		return false;
 	}
 
-	//BUGFIX: access the arguments from the beginning
-	int argumentIndex = 0;
-
-	//contents is the indexes of identifier & type
-	for (int i = 0; i < paramArray->count - (TOY_IS_NULL(restParam) ? 0 : 2); i += 2) { //don't count the rest parameter, if present
-		//declare and define each entry in the scope
-		if (!Toy_declareScopeVariable(inner.scope, paramArray->literals[i], paramArray->literals[i + 1])) {
-			interpreter->errorOutput("[internal] Could not re-declare parameter\n");
-
-			//free, and skip out
-			Toy_popScope(inner.scope);
-
-			Toy_freeLiteralArray(&inner.stack);
-			Toy_freeLiteralArray(&inner.literalCache);
+	return execCompareJumpTo(interpreter, target, comparison);
+}
 
+//reads a copy of a number, without any errors
+static bool peekNumberValue(Toy_Interpreter* interpreter, Toy_Literal literal, Toy_Literal* value) {
+	if (TOY_IS_IDENTIFIER(literal)) {
+		if (!Toy_getScopeVariableCached(interpreter->scope, &interpreter->scopeCache, literal, value)) {
 			return false;
 		}
+	}
+	else {
+		*value = literal;
+	}
 
-		//access the arguments in order
-		Toy_Literal arg = TOY_TO_NULL_LITERAL;
-		if (argumentIndex < arguments->count) {
-			arg = Toy_copyLiteral(arguments->literals[argumentIndex++]);
-		}
-
-		Toy_Literal argIdn = arg;
-		if (TOY_IS_IDENTIFIER(arg) && Toy_parseIdentifierToValue(interpreter, &arg)) {
-			Toy_freeLiteral(argIdn);
+	if (!TOY_IS_INTEGER(*value) && !TOY_IS_FLOAT(*value)) {
+		if (TOY_IS_IDENTIFIER(literal)) {
+			Toy_freeLiteral(*value);
 		}
+		return false;
+	}
 
-		if (TOY_IS_IDENTIFIER(arg)) {
-			//free, and skip out
-			Toy_freeLiteral(arg);
-			Toy_popScope(inner.scope);
+	return true;
+}
 
-			Toy_freeLiteralArray(&inner.stack);
-			Toy_freeLiteralArray(&inner.literalCache);
+//the two operands on top of the stack are replaced by the result in place, skipping the pops & push
+static void replaceOperands(Toy_Interpreter* interpreter, Toy_Literal result) {
+	Toy_Literal* operands = &interpreter->stack.literals[interpreter->stack.count - 2];
 
-			return false;
-		}
+	Toy_freeLiteral(operands[0]);
+	Toy_freeLiteral(operands[1]);
+	operands[0] = result;
 
-		if (!Toy_setScopeVariable(inner.scope, paramArray->literals[i], arg, false)) {
-			interpreter->errorOutput("[internal] Could not define parameter (bad type?)\n");
+	interpreter->stack.count--;
+}
 
-			//free, and skip out
-			Toy_freeLiteral(arg);
-			Toy_popScope(inner.scope);
+//quickening: a function runs from its own copy of the body, so once the operand types are seen, a generic opcode is rewritten in place as its type-specialized form
+//if a guard fails later on, it's rewritten back - the opcode being executed is always the byte before count
+static void rewriteOpcode(Toy_Interpreter* interpreter, Toy_Opcode opcode) {
+	if (interpreter->function != NULL) {
+		interpreter->function->quickened[interpreter->count - 1] = (unsigned char)opcode;
+	}
+}
 
-			Toy_freeLiteralArray(&inner.stack);
-			Toy_freeLiteralArray(&inner.literalCache);
+//arithmetic is quickened after the generic opcode runs, from the type of the result - only two ints give an int, and any float gives a float
+static void quickenArithmetic(Toy_Interpreter* interpreter, Toy_Opcode opcode) {
+	Toy_Literal result = interpreter->stack.literals[interpreter->stack.count - 1];
 
-			return false;
-		}
-		Toy_freeLiteral(arg);
+	if (TOY_IS_INTEGER(result)) {
+		rewriteOpcode(interpreter, TOY_OP_ADDITION_INT + (opcode - TOY_OP_ADDITION));
 	}
+	else if (TOY_IS_FLOAT(result)) {
+		rewriteOpcode(interpreter, TOY_OP_ADDITION_FLOAT + (opcode - TOY_OP_ADDITION));
+	}
+}
 
-	//if using rest, pack the optional extra arguments into the rest parameter (array)
-	if (!TOY_IS_NULL(restParam)) {
-		Toy_LiteralArray rest;
-		Toy_initLiteralArray(&rest);
-
-		//access the arguments in order
-		while (argumentIndex < arguments->count) {
-			Toy_Literal lit = Toy_copyLiteral(arguments->literals[argumentIndex++]);
-			Toy_pushLiteralArray(&rest, lit);
-			Toy_freeLiteral(lit);
-		}
+//a boolean says nothing about the operands, so comparisons peek at them first - NOTE: floats are still compared by the generic opcodes
+static void quickenComparison(Toy_Interpreter* interpreter, Toy_Opcode opcode) {
+	int lhs = 0;
+	int rhs = 0;
 
-		Toy_Literal restType = TOY_TO_TYPE_LITERAL(TOY_LITERAL_ARRAY, true);
-		Toy_Literal any = TOY_TO_TYPE_LITERAL(TOY_LITERAL_ANY, false);
-		TOY_TYPE_PUSH_SUBTYPE(&restType, any);
+	if (interpreter->stack.count >= 2 && peekIntegerValue(interpreter, interpreter->stack.literals[interpreter->stack.count - 2], &lhs) && peekIntegerValue(interpreter, interpreter->stack.literals[interpreter->stack.count - 1], &rhs)) {
+		rewriteOpcode(interpreter, TOY_OP_COMPARE_LESS_INT + (opcode - TOY_OP_COMPARE_LESS));
+	}
+}
 
-		//declare & define the rest parameter
-		if (!Toy_declareScopeVariable(inner.scope, restParam, restType)) {
-			interpreter->errorOutput("[internal] Could not declare rest parameter\n");
+//type-specialized arithmetic - these are emitted for operands declared as ints, or quickened, but a null (or anything else) is handled by the generic opcode
+static bool execArithmeticInt(Toy_Interpreter* interpreter, Toy_Opcode opcode) {
+	int lhs = 0;
+	int rhs = 0;
 
-			//free, and skip out
-			Toy_freeLiteral(restType);
-			Toy_freeLiteralArray(&rest);
-			Toy_popScope(inner.scope);
+	if (interpreter->stack.count >= 2 && peekIntegerValue(interpreter, interpreter->stack.literals[interpreter->stack.count - 2], &lhs) && peekIntegerValue(interpreter, interpreter->stack.literals[interpreter->stack.count - 1], &rhs)) {
+		int result;
 
-			Toy_freeLiteralArray(&inner.stack);
-			Toy_freeLiteralArray(&inner.literalCache);
+		switch(opcode) {
+			case TOY_OP_ADDITION_INT:
+				result = lhs + rhs;
+			break;
 
-			return false;
-		}
+			case TOY_OP_SUBTRACTION_INT:
+				result = lhs - rhs;
+			break;
 
-		Toy_Literal lit = TOY_TO_ARRAY_LITERAL(&rest);
-		if (!Toy_setScopeVariable(inner.scope, restParam, lit, false)) {
-			interpreter->errorOutput("[internal] Could not define rest parameter\n");
+			case TOY_OP_MULTIPLICATION_INT:
+				result = lhs * rhs;
+			break;
 
-			//free, and skip out
-			Toy_freeLiteral(restType);
-			Toy_freeLiteral(lit);
-			Toy_popScope(inner.scope);
+			case TOY_OP_DIVISION_INT:
+				if (rhs == 0) {
+					return execArithmetic(interpreter, TOY_GENERIC_OPCODE(opcode)); //for the error
+				}
+				result = lhs / rhs;
+			break;
 
-			Toy_freeLiteralArray(&inner.stack);
-			Toy_freeLiteralArray(&inner.literalCache);
+			case TOY_OP_MODULO_INT:
+				if (rhs == 0) {
+					return execArithmetic(interpreter, TOY_GENERIC_OPCODE(opcode)); //for the error
+				}
+				result = lhs % rhs;
+			break;
 
-			return false;
+			default:
+				interpreter->errorOutput("[internal] bad opcode argument passed to execArithmeticInt()\n");
+				return false;
 		}
 
-		Toy_freeLiteral(restType);
-		Toy_freeLiteralArray(&rest);
+		replaceOperands(interpreter, TOY_TO_INTEGER_LITERAL(result));
+
+		return true;
 	}
 
-	//execute the interpreter
-	execInterpreter(&inner);
+	rewriteOpcode(interpreter, TOY_GENERIC_OPCODE(opcode));
+	return execArithmetic(interpreter, TOY_GENERIC_OPCODE(opcode));
+}
 
-	//adopt the panic state
-	interpreter->panic = inner.panic;
+//emitted when either side is declared as a float - the other is coerced, exactly as the generic opcode would
+static bool execArithmeticFloat(Toy_Interpreter* interpreter, Toy_Opcode opcode) {
+	Toy_Literal lhs = TOY_TO_NULL_LITERAL;
+	Toy_Literal rhs = TOY_TO_NULL_LITERAL;
 
-	//accept the stack as the results
-	Toy_LiteralArray returnsFromInner;
-	Toy_initLiteralArray(&returnsFromInner);
+	if (interpreter->stack.count >= 2 && peekNumberValue(interpreter, interpreter->stack.literals[interpreter->stack.count - 2], &lhs) && peekNumberValue(interpreter, interpreter->stack.literals[interpreter->stack.count - 1], &rhs) && (TOY_IS_FLOAT(lhs) || TOY_IS_FLOAT(rhs))) {
+		float a = TOY_IS_FLOAT(lhs) ? TOY_AS_FLOAT(lhs) : (float)TOY_AS_INTEGER(lhs);
+		float b = TOY_IS_FLOAT(rhs) ? TOY_AS_FLOAT(rhs) : (float)TOY_AS_INTEGER(rhs);
+		float result;
 
-	//unpack the results
-	for (int i = 0; i < (returnArray->count || 1); i++) {
-		Toy_Literal lit = Toy_popLiteralArray(&inner.stack);
-		Toy_pushLiteralArray(&returnsFromInner, lit); //NOTE: also reverses the order
-		Toy_freeLiteral(lit);
-	}
+		switch(opcode) {
+			case TOY_OP_ADDITION_FLOAT:
+				result = a + b;
+			break;
 
-	bool returnValue = true;
+			case TOY_OP_SUBTRACTION_FLOAT:
+				result = a - b;
+			break;
 
-	//TODO: remove this when multiple assignment is enabled - note the BUGFIX that balances the stack
-	if (returnsFromInner.count > 1) {
-		interpreter->errorOutput("Too many values returned (multiple returns not yet supported)\n");
+			case TOY_OP_MULTIPLICATION_FLOAT:
+				result = a * b;
+			break;
 
-		returnValue = false;
+			case TOY_OP_DIVISION_FLOAT:
+				if (b == 0) {
+					return execArithmetic(interpreter, TOY_GENERIC_OPCODE(opcode)); //for the error
+				}
+				result = a / b;
+			break;
+
+			default:
+				interpreter->errorOutput("[internal] bad opcode argument passed to execArithmeticFloat()\n");
+				return false;
+		}
+
+		replaceOperands(interpreter, TOY_TO_FLOAT_LITERAL(result));
+
+		return true;
 	}
 
-	for (int i = 0; i < returnsFromInner.count && returnValue; i++) {
-		Toy_Literal ret = Toy_popLiteralArray(&returnsFromInner);
+	rewriteOpcode(interpreter, TOY_GENERIC_OPCODE(opcode));
+	return execArithmetic(interpreter, TOY_GENERIC_OPCODE(opcode));
+}
 
-		//check the return types
-		if (returnArray->count > 0 && TOY_AS_TYPE(returnArray->literals[i]).typeOf != ret.type) {
-			interpreter->errorOutput("Bad type found in return value\n");
+//NOTE: the ordered comparisons are done as floats, like the generic opcodes
+static bool execCompareInt(Toy_Interpreter* interpreter, Toy_Opcode opcode) {
+	int lhs = 0;
+	int rhs = 0;
 
-			//free, and skip out
-			returnValue = false;
+	if (interpreter->stack.count >= 2 && peekIntegerValue(interpreter, interpreter->stack.literals[interpreter->stack.count - 2], &lhs) && peekIntegerValue(interpreter, interpreter->stack.literals[interpreter->stack.count - 1], &rhs)) {
+		bool result;
+
+		switch(opcode) {
+			case TOY_OP_COMPARE_LESS_INT:
+				result = (float)lhs < (float)rhs;
+			break;
+
+			case TOY_OP_COMPARE_LESS_EQUAL_INT:
+				result = (float)lhs <= (float)rhs;
+			break;
+
+			case TOY_OP_COMPARE_GREATER_INT:
+				result = (float)lhs > (float)rhs;
+			break;
+
+			case TOY_OP_COMPARE_GREATER_EQUAL_INT:
+				result = (float)lhs >= (float)rhs;
 			break;
+
+			default:
+				interpreter->errorOutput("[internal] bad opcode argument passed to execCompareInt()\n");
+				return false;
 		}
 
-		Toy_pushLiteralArray(returns, ret); //NOTE: reverses again
-		Toy_freeLiteral(ret);
+		replaceOperands(interpreter, TOY_TO_BOOLEAN_LITERAL(result));
+
+		return true;
 	}
 
-	//manual free
-	//BUGFIX: handle scopes of functions, which refer to the parent scope (leaking memory)
-	while(inner.scope != TOY_AS_FUNCTION(func).scope) {
-		for (int i = 0; i < inner.scope->variables.capacity; i++) {
-			//handle keys, just in case
-			if (TOY_IS_FUNCTION(inner.scope->variables.entries[i].key)) {
-				Toy_popScope(TOY_AS_FUNCTION(inner.scope->variables.entries[i].key).scope);
-				TOY_AS_FUNCTION(inner.scope->variables.entries[i].key).scope = NULL;
-			}
+	rewriteOpcode(interpreter, TOY_GENERIC_OPCODE(opcode));
+	return execCompare(interpreter, TOY_GENERIC_OPCODE(opcode));
+}
 
-			if (TOY_IS_FUNCTION(inner.scope->variables.entries[i].value)) {
-				Toy_popScope(TOY_AS_FUNCTION(inner.scope->variables.entries[i].value).scope);
-				TOY_AS_FUNCTION(inner.scope->variables.entries[i].value).scope = NULL;
-			}
+//superinstruction: "lhs = first op second", all from the literal cache
+static bool execVarArithmeticAssignLiteralsAt(Toy_Interpreter* interpreter, Toy_Opcode opcode, int lhsIndex, int firstIndex, int secondIndex) {
+	Toy_Literal lhs = interpreter->literalCache.literals[lhsIndex];
+	Toy_Literal first = interpreter->literalCache.literals[firstIndex];
+	Toy_Literal second = interpreter->literalCache.literals[secondIndex];
+
+	//fast path for integers, without touching the stack
+	int a = 0;
+	int b = 0;
+
+	if (TOY_IS_IDENTIFIER(lhs) && (opcode == TOY_OP_ADDITION || opcode == TOY_OP_SUBTRACTION || opcode == TOY_OP_MULTIPLICATION) && peekIntegerValue(interpreter, first, &a) && peekIntegerValue(interpreter, second, &b)) {
+		int result = opcode == TOY_OP_ADDITION ? a + b : opcode == TOY_OP_SUBTRACTION ? a - b : a * b;
+
+		//anything the assignment would reject (types, constants, undeclared) falls through to the slow path for the error
+		if (Toy_setScopeVariableCached(interpreter->scope, &interpreter->scopeCache, lhs, TOY_TO_INTEGER_LITERAL(result), true)) {
+			return true;
 		}
+	}
+
+	//otherwise, exactly as the separate instructions
+	Toy_pushLiteralArray(&interpreter->stack, lhs);
+	Toy_pushLiteralArray(&interpreter->stack, first);
+	Toy_pushLiteralArray(&interpreter->stack, second);
 
-		inner.scope = Toy_popScope(inner.scope);
+	if (!execArithmetic(interpreter, opcode)) {
+		Toy_freeLiteral(Toy_popLiteralArray(&interpreter->stack));
+		return false;
 	}
-	Toy_freeLiteralArray(&returnsFromInner);
-	Toy_freeLiteralArray(&inner.stack);
-	Toy_freeLiteralArray(&inner.literalCache);
 
-	//BUGFIX: this function needs to eat the arguments
-	Toy_freeLiteralArray(arguments);
+	return execVarAssign(interpreter);
+}
 
-	//actual bytecode persists until next call
-	return true;
+static bool execVarArithmeticAssignLiterals(Toy_Interpreter* interpreter) {
+	Toy_Opcode opcode = (Toy_Opcode)readByte(interpreter->bytecode, &interpreter->count);
+	int lhsIndex = readByte(interpreter->bytecode, &interpreter->count);
+	int firstIndex = readByte(interpreter->bytecode, &interpreter->count);
+	int secondIndex = readByte(interpreter->bytecode, &interpreter->count);
+
+	return execVarArithmeticAssignLiteralsAt(interpreter, opcode, lhsIndex, firstIndex, secondIndex);
 }
 
-bool Toy_callFn(Toy_Interpreter* interpreter, const char* name, Toy_LiteralArray* arguments, Toy_LiteralArray* returns) {
-	Toy_Literal key = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefStringLength(name, strlen(name)));
-	Toy_Literal val = TOY_TO_NULL_LITERAL;
-	
-	if (!Toy_isDelcaredScopeVariable(interpreter->scope, key)) {
-		interpreter->errorOutput("No function with that name\n");
+//forward declare
+//"a += b" and friends
+static bool execVarCompoundAssign(Toy_Interpreter* interpreter, Toy_Opcode opcode) {
+	execVarArithmeticAssign(interpreter);
+
+	if (!execArithmetic(interpreter, opcode)) {
+		Toy_freeLiteral(Toy_popLiteralArray(&interpreter->stack));
 		return false;
 	}
 
-	Toy_getScopeVariable(interpreter->scope, key, &val);
-
-	bool ret = Toy_callLiteralFn(interpreter, val, arguments, returns);
+	return execVarAssign(interpreter);
+}
 
-	Toy_freeLiteral(key);
-	Toy_freeLiteral(val);
+static void execInterpreter(Toy_Interpreter*);
+static void execFunctionBody(Toy_Interpreter*);
+static void runRegisterCode(Toy_Interpreter*);
+static void readInterpreterSections(Toy_Interpreter* interpreter);
 
-	return ret;
+//the frames are allocated as each depth is first reached, then kept for the next call
+static void initCallStack(Toy_CallStack* calls) {
+	calls->frames = NULL;
+	calls->capacity = 0;
+	calls->nesting = 0;
+	calls->tailPending = false;
+	calls->tailFunction = TOY_TO_NULL_LITERAL;
+	calls->tailName = TOY_TO_NULL_LITERAL;
+	Toy_initLiteralArray(&calls->tailArguments);
 }
 
-static bool execFnReturn(Toy_Interpreter* interpreter) {
-	Toy_LiteralArray returns;
-	Toy_initLiteralArray(&returns);
+//what a frame keeps between calls
+static void initFrameBuffers(Toy_Interpreter* interpreter) {
+	interpreter->assignDepths = NULL;
+	interpreter->assignCapacity = 0;
+	interpreter->registers = NULL;
+	interpreter->registerCount = 0;
+	interpreter->registerCapacity = 0;
+}
 
-	//get the values of everything on the stack
-	while (interpreter->stack.count > 0) {
-		Toy_Literal lit = Toy_popLiteralArray(&interpreter->stack);
+static void freeFrameBuffers(Toy_Interpreter* interpreter) {
+	TOY_FREE_ARRAY(int, interpreter->assignDepths, interpreter->assignCapacity);
+	TOY_FREE_ARRAY(Toy_Literal, interpreter->registers, interpreter->registerCapacity);
+	initFrameBuffers(interpreter);
+}
 
-		Toy_Literal litIdn = lit;
-		if (TOY_IS_IDENTIFIER(lit) && Toy_parseIdentifierToValue(interpreter, &lit)) {
-			Toy_freeLiteral(litIdn);
+static void freeCallStack(Toy_CallStack* calls) {
+	for (int i = 0; i < calls->capacity; i++) {
+		if (calls->frames[i] != NULL) {
+			freeFrameBuffers(calls->frames[i]);
+			TOY_FREE(Toy_Interpreter, calls->frames[i]);
 		}
+	}
 
-		if (TOY_IS_IDENTIFIER(lit)) {
-			Toy_freeLiteralArray(&returns);
-			Toy_freeLiteral(lit);
-			return false;
+	TOY_FREE_ARRAY(Toy_Interpreter*, calls->frames, calls->capacity);
+
+	Toy_freeLiteral(calls->tailFunction);
+	Toy_freeLiteral(calls->tailName);
+	Toy_freeLiteralArray(&calls->tailArguments);
+}
+
+static Toy_Interpreter* findCallFrame(Toy_CallStack* calls, int depth) {
+	if (depth >= calls->capacity) {
+		int oldCapacity = calls->capacity;
+		while (depth >= calls->capacity) {
+			calls->capacity = TOY_GROW_CAPACITY(calls->capacity);
 		}
+		calls->frames = TOY_GROW_ARRAY(Toy_Interpreter*, calls->frames, oldCapacity, calls->capacity);
 
-		if (TOY_IS_ARRAY(lit) || TOY_IS_DICTIONARY(lit)) {
-			Toy_parseCompoundToPureValues(interpreter, &lit);
+		for (int i = oldCapacity; i < calls->capacity; i++) {
+			calls->frames[i] = NULL;
 		}
+	}
 
-		Toy_pushLiteralArray(&returns, lit); //reverses the order
-		Toy_freeLiteral(lit);
+	if (calls->frames[depth] == NULL) {
+		calls->frames[depth] = TOY_ALLOCATE(Toy_Interpreter, 1);
+		initFrameBuffers(calls->frames[depth]);
 	}
 
-	//and back again
-	while (returns.count > 0) {
-		Toy_Literal lit =  Toy_popLiteralArray(&returns);
-		Toy_pushLiteralArray(&interpreter->stack, lit);
-		Toy_freeLiteral(lit);
+	return calls->frames[depth];
+}
+
+//groupings are counted rather than nested, and each keeps it's own intermediate index assignments
+static void beginGrouping(Toy_Interpreter* interpreter) {
+	if (interpreter->groupings + 1 > interpreter->assignCapacity) {
+		int oldCapacity = interpreter->assignCapacity;
+		interpreter->assignCapacity = TOY_GROW_CAPACITY(oldCapacity);
+		interpreter->assignDepths = TOY_GROW_ARRAY(int, interpreter->assignDepths, oldCapacity, interpreter->assignCapacity);
 	}
 
-	Toy_freeLiteralArray(&returns);
+	interpreter->assignDepths[interpreter->groupings++] = interpreter->assignDepth;
+	interpreter->assignDepth = 0;
 
-	//finally
-	return false;
+	if (interpreter->profile) {
+		Toy_breakOpcodeProfile(interpreter->profile);
+	}
 }
 
-static bool execImport(Toy_Interpreter* interpreter) {
-	Toy_Literal alias = Toy_popLiteralArray(&interpreter->stack);
-	Toy_Literal identifier = Toy_popLiteralArray(&interpreter->stack);
+//the code is stopped for good, and the register frame cleared for the next call at this depth
+static void finishFrame(Toy_Interpreter* interpreter) {
+	for (int i = 0; i < interpreter->registerCount; i++) {
+		Toy_freeLiteral(interpreter->registers[i]);
+	}
 
-	//access the hooks
-	if (!Toy_existsLiteralDictionary(interpreter->hooks, identifier)) {
-		interpreter->errorOutput("Unknown library name in import statement: ");
-		Toy_printLiteralCustom(identifier, interpreter->errorOutput);
-		interpreter->errorOutput("\n");
+	interpreter->registerCount = 0;
+	interpreter->engine = TOY_FRAME_FINISHED;
+}
 
-		Toy_freeLiteral(alias);
-		Toy_freeLiteral(identifier);
-		return false;
+//a grouping has ended, or an instruction within it failed - the outermost level is the code itself
+static void endGrouping(Toy_Interpreter* interpreter) {
+	if (interpreter->groupings == 0) {
+		finishFrame(interpreter);
+		return;
 	}
 
-	Toy_Literal func = Toy_getLiteralDictionary(interpreter->hooks, identifier);
+	interpreter->assignDepth = interpreter->assignDepths[--interpreter->groupings];
+}
 
-	if (!TOY_IS_FUNCTION_HOOK(func)) {
-		interpreter->errorOutput("Expected hook function, found: ");
-		Toy_printLiteralCustom(identifier, interpreter->errorOutput);
-		interpreter->errorOutput("\"\n");
+//the interpreter picks up within this many groupings, where no index assignments have begun
+static void resumeGroupings(Toy_Interpreter* interpreter, int groupings) {
+	interpreter->groupings = 0;
+	interpreter->assignDepth = 0;
 
-		Toy_freeLiteral(func);
-		Toy_freeLiteral(alias);
-		Toy_freeLiteral(identifier);
-		return false;
+	while (interpreter->groupings < groupings) {
+		beginGrouping(interpreter);
 	}
 
-	TOY_AS_FUNCTION_HOOK(func)(interpreter, identifier, alias);
-
-	Toy_freeLiteral(func);
-	Toy_freeLiteral(alias);
-	Toy_freeLiteral(identifier);
-	return true;
+	interpreter->engine = TOY_FRAME_INTERPRETER;
 }
 
-static bool execIndex(Toy_Interpreter* interpreter, bool assignIntermediate) {
-	//assume -> compound, first, second, third are all on the stack
+//the call is left for the caller to make, once the function making it has returned
+static void deferTailCall(Toy_Interpreter* interpreter, Toy_Literal func, Toy_Literal name, Toy_LiteralArray* arguments) {
+	Toy_CallStack* calls = interpreter->calls;
 
-	Toy_Literal third = Toy_popLiteralArray(&interpreter->stack);
-	Toy_Literal second = Toy_popLiteralArray(&interpreter->stack);
-	Toy_Literal first = Toy_popLiteralArray(&interpreter->stack);
-	Toy_Literal compound = Toy_popLiteralArray(&interpreter->stack);
+	calls->tailPending = true;
+	calls->tailFunction = Toy_copyLiteral(func);
+	calls->tailName = Toy_copyLiteral(name);
 
-	Toy_Literal compoundIdn = compound;
-	bool freeIdn = false;
-	if (TOY_IS_IDENTIFIER(compound) && Toy_parseIdentifierToValue(interpreter, &compound)) {
-		freeIdn = true;
+	for (int i = 0; i < arguments->count; i++) {
+		Toy_pushLiteralArray(&calls->tailArguments, arguments->literals[i]);
 	}
+}
 
-	if (TOY_IS_IDENTIFIER(compound)) {
-		Toy_freeLiteral(third);
-		Toy_freeLiteral(second);
-		Toy_freeLiteral(first);
-		Toy_freeLiteral(compound);
-		if (freeIdn) {
-			Toy_freeLiteral(compoundIdn);
-		}
-		return true;
-	}
+static void takeTailCall(Toy_CallStack* calls, Toy_Literal* func, Toy_Literal* name, Toy_LiteralArray* arguments) {
+	*func = calls->tailFunction;
+	*name = calls->tailName;
+	*arguments = calls->tailArguments;
 
-	if (!TOY_IS_ARRAY(compound) && !TOY_IS_DICTIONARY(compound) && !TOY_IS_STRING(compound)) {
-		interpreter->errorOutput("Unknown compound found in index notation: ");
-		Toy_printLiteralCustom(compound, interpreter->errorOutput);
-		interpreter->errorOutput("\n");
+	calls->tailPending = false;
+	calls->tailFunction = TOY_TO_NULL_LITERAL;
+	calls->tailName = TOY_TO_NULL_LITERAL;
+	Toy_initLiteralArray(&calls->tailArguments);
+}
 
-		Toy_freeLiteral(third);
-		Toy_freeLiteral(second);
-		Toy_freeLiteral(first);
-		Toy_freeLiteral(compound);
+//moves the top literals of one array onto another, keeping their order - ownership moves with them, so nothing is copied
+//missing literals are null, and come first (as if each had been popped and pushed twice)
+static void moveLiterals(Toy_LiteralArray* dest, Toy_LiteralArray* source, int count) {
+	int available = count < source->count ? count : source->count;
 
-		if (freeIdn) {
-			Toy_freeLiteral(compoundIdn);
-		}
+	if (dest->capacity < dest->count + count) {
+		int oldCapacity = dest->capacity;
 
-		return false;
+		while (dest->capacity < dest->count + count) {
+			dest->capacity = TOY_GROW_CAPACITY(dest->capacity);
+		}
+		dest->literals = TOY_GROW_ARRAY(Toy_Literal, dest->literals, oldCapacity, dest->capacity);
 	}
 
-	//build the argument list
-	Toy_LiteralArray arguments;
-	Toy_initLiteralArray(&arguments);
+	for (int i = available; i < count; i++) {
+		dest->literals[dest->count++] = TOY_TO_NULL_LITERAL;
+	}
 
-	Toy_pushLiteralArray(&arguments, compound);
-	Toy_pushLiteralArray(&arguments, first);
-	Toy_pushLiteralArray(&arguments, second);
-	Toy_pushLiteralArray(&arguments, third);
-	Toy_pushLiteralArray(&arguments, TOY_TO_NULL_LITERAL); //it expects an assignment command
-	Toy_pushLiteralArray(&arguments, TOY_TO_NULL_LITERAL); //it expects an assignment "opcode"
+	if (available > 0) {
+		source->count -= available;
+		memcpy(dest->literals + dest->count, source->literals + source->count, sizeof(Toy_Literal) * available);
+		dest->count += available;
+	}
+}
 
-	//leave the idn and compound on the stack
-	if (assignIntermediate) {
-		if (TOY_IS_IDENTIFIER(compoundIdn)) {
-			Toy_pushLiteralArray(&interpreter->stack, compoundIdn);
+//builtins are pushed as themselves (TOY_OP_BUILTIN), so their names are found again for errors
+static void printCallee(Toy_Interpreter* interpreter, Toy_Literal callee) {
+	for (int i = 0; TOY_IS_FUNCTION_NATIVE_VIEW(callee) && i < TOY_BUILTIN_COUNT; i++) {
+		if (TOY_AS_FUNCTION_NATIVE_VIEW(callee) == Toy_private_builtins[i].fn) {
+			interpreter->errorOutput(Toy_private_builtins[i].name);
+			return;
 		}
-		Toy_pushLiteralArray(&interpreter->stack, compound);
-		Toy_pushLiteralArray(&interpreter->stack, first);
-		Toy_pushLiteralArray(&interpreter->stack, second);
-		Toy_pushLiteralArray(&interpreter->stack, third);
 	}
 
-	//call the index function
-	if (Toy_private_index(interpreter, &arguments) < 0) {
-		interpreter->errorOutput("Something went wrong while indexing (simple index): ");
-		Toy_printLiteralCustom(compoundIdn, interpreter->errorOutput);
-		interpreter->errorOutput("\n");
+	Toy_printLiteralCustom(callee, interpreter->errorOutput);
+}
 
-		//clean up
-		Toy_freeLiteral(third);
-		Toy_freeLiteral(second);
-		Toy_freeLiteral(first);
-		Toy_freeLiteral(compound);
-		if (freeIdn) {
-			Toy_freeLiteral(compoundIdn);
+//the frame is left as it was found, but for the buffers it keeps
+static void releaseFrame(Toy_Interpreter* inner) {
+	//BUGFIX: handle scopes of functions, which refer to the parent scope (leaking memory)
+	while(inner->scope != TOY_AS_FUNCTION(inner->callee).scope) {
+		for (int i = 0; i < inner->scope->variables.capacity; i++) {
+			//handle keys, just in case
+			if (TOY_IS_FUNCTION(inner->scope->variables.entries[i].key)) {
+				Toy_popScope(TOY_AS_FUNCTION(inner->scope->variables.entries[i].key).scope);
+				TOY_AS_FUNCTION(inner->scope->variables.entries[i].key).scope = NULL;
+			}
+
+			if (TOY_IS_FUNCTION(inner->scope->variables.entries[i].value)) {
+				Toy_popScope(TOY_AS_FUNCTION(inner->scope->variables.entries[i].value).scope);
+				TOY_AS_FUNCTION(inner->scope->variables.entries[i].value).scope = NULL;
+			}
 		}
-		Toy_freeLiteralArray(&arguments);
-		return false;
-	}
 
-	//clean up
-	Toy_freeLiteral(third);
-	Toy_freeLiteral(second);
-	Toy_freeLiteral(first);
-	Toy_freeLiteral(compound);
-	if (freeIdn) {
-		Toy_freeLiteral(compoundIdn);
+		inner->scope = Toy_popScope(inner->scope);
 	}
-	Toy_freeLiteralArray(&arguments);
 
-	return true;
+	Toy_freeLiteralArray(&inner->stack);
+	Toy_freeLiteralArray(&inner->literalCache);
+	Toy_freeLiteralArray(&inner->tailTypes);
+	Toy_freeLiteral(inner->callee);
+	Toy_freeLiteral(inner->calleeName);
+	inner->callee = TOY_TO_NULL_LITERAL;
+	inner->calleeName = TOY_TO_NULL_LITERAL;
+	inner->returnTypes = NULL;
 }
 
-static bool execIndexAssign(Toy_Interpreter* interpreter, int assignDepth) {
-	//assume -> compound, first, second, third, assign are all on the stack
+//sets up a function in the frame for the next depth, ready to be run - returns NULL if it can't be called
+static Toy_Interpreter* enterFunction(Toy_Interpreter* interpreter, Toy_Literal func, Toy_LiteralArray* arguments) {
+	//BUGFIX: depth check - don't drown!
+	if ((size_t)(interpreter->depth + 1) * sizeof(Toy_Interpreter) > interpreter->callMemory) {
+		interpreter->errorOutput("Infinite recursion detected - panicking\n");
+		interpreter->panic = true;
+		return NULL;
+	}
+
+	//set up a new interpreter, in the frame for this depth
+	Toy_Interpreter* inner = findCallFrame(interpreter->calls, interpreter->depth + 1);
+
+	//init the inner interpreter manually - the frame keeps the function alive while it runs
+	inner->callee = Toy_copyLiteral(func);
+	Toy_initLiteralArray(&inner->literalCache);
+	inner->scope = Toy_pushScope(TOY_AS_FUNCTION(inner->callee).scope);
+	inner->bytecode = Toy_quickenRefFunction(TOY_AS_FUNCTION(func).inner.ref);
+	inner->length = TOY_AS_FUNCTION(func).inner.ref->length;
+	inner->source = TOY_AS_FUNCTION(func).inner.ref->owner; //borrowed, the function keeps it alive
+	inner->count = 0;
+	inner->codeStart = -1;
+	inner->functionIndex = 0;
+	inner->functionCount = 0;
+	inner->function = TOY_AS_FUNCTION(func).inner.ref;
+	Toy_initScopeCache(&inner->scopeCache);
+	inner->depth = interpreter->depth + 1;
+	inner->panic = false;
+	Toy_initLiteralArray(&inner->stack);
+	inner->hooks = interpreter->hooks;
+	inner->profile = interpreter->profile;
+	inner->calls = interpreter->calls;
+	inner->callMemory = interpreter->callMemory;
+	Toy_setInterpreterPrint(inner, interpreter->printOutput);
+	Toy_setInterpreterAssert(inner, interpreter->assertOutput);
+	Toy_setInterpreterError(inner, interpreter->errorOutput);
+
+	inner->engine = TOY_FRAME_START;
+	inner->suspended = false;
+	inner->groupings = 0;
+	inner->assignDepth = 0;
+	inner->registerCount = 0;
+	inner->pc = 0;
+	inner->caller = interpreter;
+	inner->returnRegister = -1;
+	inner->calleeName = TOY_TO_NULL_LITERAL;
+	inner->returnTypes = NULL;
+	Toy_initLiteralArray(&inner->tailTypes);
 
-	Toy_Literal assign = TOY_TO_NULL_LITERAL, third = TOY_TO_NULL_LITERAL, second = TOY_TO_NULL_LITERAL, first = TOY_TO_NULL_LITERAL, compound = TOY_TO_NULL_LITERAL, result = TOY_TO_NULL_LITERAL;
-	Toy_Literal compoundIdn = TOY_TO_NULL_LITERAL;
-	bool freeIdn = false;
+	//prep the sections
+	readInterpreterSections(inner);
 
-	//build the opcode
-	unsigned char opcode = readByte(interpreter->bytecode, &interpreter->count);
-	char* opStr = "";
-	switch (opcode) {
-	case TOY_OP_VAR_ASSIGN:
-		opStr = "=";
-		break;
-	case TOY_OP_VAR_ADDITION_ASSIGN:
-		opStr = "+=";
-		break;
-	case TOY_OP_VAR_SUBTRACTION_ASSIGN:
-		opStr = "-=";
-		break;
-	case TOY_OP_VAR_MULTIPLICATION_ASSIGN:
-		opStr = "*=";
-		break;
-	case TOY_OP_VAR_DIVISION_ASSIGN:
-		opStr = "/=";
-		break;
-	case TOY_OP_VAR_MODULO_ASSIGN:
-		opStr = "%=";
-		break;
+	if (inner->panic) {
+		Toy_popScope(inner->scope);
 
-	default:
-		interpreter->errorOutput("bad opcode in index assigning notation\n");
-		return false;
+		Toy_freeLiteralArray(&inner->stack);
+		Toy_freeLiteralArray(&inner->literalCache);
+		Toy_freeLiteral(inner->callee);
+
+		return NULL;
 	}
 
-	//iterate...
-	while(assignDepth-- >= 0) {
-		Toy_freeLiteral(assign);
-		Toy_freeLiteral(third);
-		Toy_freeLiteral(second);
-		Toy_freeLiteral(first);
-		Toy_freeLiteral(compound);
+	//prep the arguments
+	Toy_LiteralArray* paramArray = TOY_AS_ARRAY(inner->literalCache.literals[ readShort(inner->bytecode, &inner->count) ]);
+	Toy_LiteralArray* returnArray = TOY_AS_ARRAY(inner->literalCache.literals[ readShort(inner->bytecode, &inner->count) ]);
 
-		if (TOY_IS_NULL(result)) {
-			assign = Toy_popLiteralArray(&interpreter->stack);
+	//get the rest param, if it exists
+	Toy_Literal restParam = TOY_TO_NULL_LITERAL;
+	if (paramArray->count >= 2 && TOY_AS_TYPE(paramArray->literals[ paramArray->count -1 ]).typeOf == TOY_LITERAL_FUNCTION_ARG_REST) {
+		restParam = paramArray->literals[ paramArray->count -2 ];
+	}
+
+	//check the param total is correct
+	if ((TOY_IS_NULL(restParam) && paramArray->count != arguments->count * 2) || (!TOY_IS_NULL(restParam) && paramArray->count -2 > arguments->count * 2)) {
+		interpreter->errorOutput("Incorrect number of arguments passed to a function\n");
+
+		//free, and skip out
+		Toy_popScope(inner->scope);
+
+		Toy_freeLiteralArray(&inner->stack);
+		Toy_freeLiteralArray(&inner->literalCache);
+		Toy_freeLiteral(inner->callee);
+
+		return NULL;
+	}
+
+	//BUGFIX: access the arguments from the beginning
+	int argumentIndex = 0;
+
+	//contents is the indexes of identifier & type
+	for (int i = 0; i < paramArray->count - (TOY_IS_NULL(restParam) ? 0 : 2); i += 2) { //don't count the rest parameter, if present
+		//declare and define each entry in the scope
+		if (!Toy_declareScopeVariable(inner->scope, paramArray->literals[i], paramArray->literals[i + 1])) {
+			interpreter->errorOutput("[internal] Could not re-declare parameter\n");
+
+			//free, and skip out
+			Toy_popScope(inner->scope);
+
+			Toy_freeLiteralArray(&inner->stack);
+			Toy_freeLiteralArray(&inner->literalCache);
+			Toy_freeLiteral(inner->callee);
+
+			return NULL;
 		}
-		else {
-			assign = result;
+
+		//access the arguments in order
+		Toy_Literal arg = TOY_TO_NULL_LITERAL;
+		if (argumentIndex < arguments->count) {
+			arg = Toy_copyLiteral(arguments->literals[argumentIndex++]);
 		}
 
-		third = Toy_popLiteralArray(&interpreter->stack);
-		second = Toy_popLiteralArray(&interpreter->stack);
-		first = Toy_popLiteralArray(&interpreter->stack);
-		compound = Toy_popLiteralArray(&interpreter->stack);
+		Toy_Literal argIdn = arg;
+		if (TOY_IS_IDENTIFIER(arg) && Toy_parseIdentifierToValue(interpreter, &arg)) {
+			Toy_freeLiteral(argIdn);
+		}
 
-		if (TOY_IS_IDENTIFIER(compound)) {
-			if (freeIdn) {
-				Toy_freeLiteral(compoundIdn);
-			}
+		if (TOY_IS_IDENTIFIER(arg)) {
+			//free, and skip out
+			Toy_freeLiteral(arg);
+			Toy_popScope(inner->scope);
 
-			compoundIdn = compound;
-			Toy_parseIdentifierToValue(interpreter, &compound);
-			freeIdn = true;
-		}
+			Toy_freeLiteralArray(&inner->stack);
+			Toy_freeLiteralArray(&inner->literalCache);
+			Toy_freeLiteral(inner->callee);
 
-		if (TOY_IS_IDENTIFIER(compound)) {
-			Toy_freeLiteral(compound);
-			Toy_freeLiteral(first);
-			Toy_freeLiteral(second);
-			Toy_freeLiteral(third);
-			Toy_freeLiteral(assign);
-			if (freeIdn) {
-				Toy_freeLiteral(compoundIdn);
-			}
-			return false;
+			return NULL;
 		}
 
-		Toy_Literal assignIdn = assign;
-		if (TOY_IS_IDENTIFIER(assign) && Toy_parseIdentifierToValue(interpreter, &assign)) {
-			Toy_freeLiteral(assignIdn);
+		if (!Toy_setScopeVariable(inner->scope, paramArray->literals[i], arg, false)) {
+			interpreter->errorOutput("[internal] Could not define parameter (bad type?)\n");
+
+			//free, and skip out
+			Toy_freeLiteral(arg);
+			Toy_popScope(inner->scope);
+
+			Toy_freeLiteralArray(&inner->stack);
+			Toy_freeLiteralArray(&inner->literalCache);
+			Toy_freeLiteral(inner->callee);
+
+			return NULL;
 		}
+		Toy_freeLiteral(arg);
+	}
 
-		if (TOY_IS_IDENTIFIER(assign)) {
-			Toy_freeLiteral(compound);
-			Toy_freeLiteral(first);
-			Toy_freeLiteral(second);
-			Toy_freeLiteral(third);
-			Toy_freeLiteral(assign);
-			return false;
+	//if using rest, pack the optional extra arguments into the rest parameter (array)
+	if (!TOY_IS_NULL(restParam)) {
+		Toy_LiteralArray rest;
+		Toy_initLiteralArray(&rest);
+
+		//access the arguments in order
+		while (argumentIndex < arguments->count) {
+			Toy_Literal lit = Toy_copyLiteral(arguments->literals[argumentIndex++]);
+			Toy_pushLiteralArray(&rest, lit);
+			Toy_freeLiteral(lit);
 		}
 
-		if (!TOY_IS_ARRAY(compound) && !TOY_IS_DICTIONARY(compound) && !TOY_IS_STRING(compound)) {
-			interpreter->errorOutput("Unknown compound found in index assigning notation: ");
-			Toy_printLiteralCustom(compound, interpreter->errorOutput);
-			interpreter->errorOutput("\n");
-			Toy_freeLiteral(assign);
-			Toy_freeLiteral(third);
-			Toy_freeLiteral(second);
-			Toy_freeLiteral(first);
-			Toy_freeLiteral(compound);
-			if (freeIdn) {
-				Toy_freeLiteral(compoundIdn);
-			}
-			return false;
+		Toy_Literal restType = TOY_TO_TYPE_LITERAL(TOY_LITERAL_ARRAY, true);
+		Toy_Literal any = TOY_TO_TYPE_LITERAL(TOY_LITERAL_ANY, false);
+		TOY_TYPE_PUSH_SUBTYPE(&restType, any);
+
+		//declare & define the rest parameter
+		if (!Toy_declareScopeVariable(inner->scope, restParam, restType)) {
+			interpreter->errorOutput("[internal] Could not declare rest parameter\n");
+
+			//free, and skip out
+			Toy_freeLiteral(restType);
+			Toy_freeLiteralArray(&rest);
+			Toy_popScope(inner->scope);
+
+			Toy_freeLiteralArray(&inner->stack);
+			Toy_freeLiteralArray(&inner->literalCache);
+			Toy_freeLiteral(inner->callee);
+
+			return NULL;
 		}
 
-		int opLength = strlen(opStr);
-		Toy_Literal op = TOY_TO_STRING_LITERAL(Toy_createRefStringLength(opStr, opLength)); //TODO: static reference optimisation?
+		Toy_Literal lit = TOY_TO_ARRAY_LITERAL(&rest);
+		if (!Toy_setScopeVariable(inner->scope, restParam, lit, false)) {
+			interpreter->errorOutput("[internal] Could not define rest parameter\n");
 
-		//build the argument list
-		Toy_LiteralArray arguments;
-		Toy_initLiteralArray(&arguments);
+			//free, and skip out
+			Toy_freeLiteral(restType);
+			Toy_freeLiteral(lit);
+			Toy_popScope(inner->scope);
 
-		Toy_pushLiteralArray(&arguments, compound);
-		Toy_pushLiteralArray(&arguments, first);
-		Toy_pushLiteralArray(&arguments, second);
-		Toy_pushLiteralArray(&arguments, third);
-		Toy_pushLiteralArray(&arguments, assign); //it expects an assignment command
-		Toy_pushLiteralArray(&arguments, op); //it expects an assignment "opcode"
+			Toy_freeLiteralArray(&inner->stack);
+			Toy_freeLiteralArray(&inner->literalCache);
+			Toy_freeLiteral(inner->callee);
 
-		//call the index function
-		if (Toy_private_index(interpreter, &arguments) < 0) {
-			//clean up
-			Toy_freeLiteral(assign);
-			Toy_freeLiteral(third);
-			Toy_freeLiteral(second);
-			Toy_freeLiteral(first);
-			Toy_freeLiteral(compound);
-			if (freeIdn) {
-				Toy_freeLiteral(compoundIdn);
-			}
-			Toy_freeLiteral(op);
-			Toy_freeLiteralArray(&arguments);
+			return NULL;
+		}
+
+		Toy_freeLiteral(restType);
+		Toy_freeLiteralArray(&rest);
+	}
+
+	inner->returnTypes = returnArray;
+
+	return inner;
+}
 
+static bool checkReturnTypes(Toy_Interpreter* interpreter, Toy_LiteralArray* types, Toy_LiteralArray* results) {
+	for (int i = 0; i < results->count && i < types->count; i++) {
+		if (TOY_AS_TYPE(types->literals[i]).typeOf != results->literals[i].type) {
+			interpreter->errorOutput("Bad type found in return value\n");
 			return false;
 		}
+	}
 
-		//save the result (assume top of the interpreter stack is the new compound value)
-		result = Toy_popLiteralArray(&interpreter->stack);
+	return true;
+}
 
-		Toy_freeLiteral(op);
-		Toy_freeLiteralArray(&arguments);
+//hands the results of a finished function to the caller, then releases it's frame
+static void leaveFunction(Toy_Interpreter* interpreter, Toy_Interpreter* inner, Toy_LiteralArray* returns) {
+	//the caller's opcodes don't follow on from the function's
+	if (inner->profile) {
+		Toy_breakOpcodeProfile(inner->profile);
+	}
 
-		//if we loop, then we need to be assigning
-		opStr = "=";
+	//adopt the panic state
+	interpreter->panic = inner->panic;
+
+	//a call in tail position couldn't be made in it's place, so nothing was returned
+	if (inner->returnTypes == NULL) {
+		Toy_Literal nothing = TOY_TO_NULL_LITERAL;
+		Toy_pushLiteralArray(returns, nothing);
+		return;
 	}
 
-	//BUGFIX: make sure the compound name can be assigned
-	if (TOY_IS_NULL(compoundIdn)) {
-		compoundIdn = Toy_popLiteralArray(&interpreter->stack);
-		freeIdn = true;
+	//accept the stack as the results
+	Toy_LiteralArray returnsFromInner;
+	Toy_initLiteralArray(&returnsFromInner);
+
+	//unpack the results
+	moveLiterals(&returnsFromInner, &inner->stack, inner->returnTypes->count || 1);
+
+	bool returnValue = true;
+
+	//TODO: remove this when multiple assignment is enabled - note the BUGFIX that balances the stack
+	if (returnsFromInner.count > 1) {
+		interpreter->errorOutput("Too many values returned (multiple returns not yet supported)\n");
+
+		returnValue = false;
 	}
 
-	if (TOY_IS_IDENTIFIER(compoundIdn) && !Toy_setScopeVariable(interpreter->scope, compoundIdn, result, true)) {
-		interpreter->errorOutput("Incorrect type assigned to compound member ");
-		Toy_printLiteralCustom(compoundIdn, interpreter->errorOutput);
-		interpreter->errorOutput(", value: ");
-		Toy_printLiteralCustom(result, interpreter->errorOutput);
-		interpreter->errorOutput("\n");
+	//check the return types, including those of any typed functions this one replaced with a tail call
+	if (returnValue) {
+		returnValue = checkReturnTypes(interpreter, inner->returnTypes, &returnsFromInner);
+	}
 
-		//clean up
-		Toy_freeLiteral(assign);
-		Toy_freeLiteral(third);
-		Toy_freeLiteral(second);
-		Toy_freeLiteral(first);
-		Toy_freeLiteral(compound);
-		if (freeIdn) {
-			Toy_freeLiteral(compoundIdn);
+	for (int i = 0; i < inner->tailTypes.count && returnValue; i++) {
+		returnValue = checkReturnTypes(interpreter, TOY_AS_ARRAY(inner->tailTypes.literals[i]), &returnsFromInner);
+	}
+
+	if (returnValue) {
+		moveLiterals(returns, &returnsFromInner, returnsFromInner.count);
+	}
+
+	Toy_freeLiteralArray(&returnsFromInner);
+
+	//manual free
+	releaseFrame(inner);
+}
+
+//a call in tail position is made in the frame of the function making it, so the depth doesn't grow - if it can't be made, the frame is left released
+static bool replaceFrame(Toy_Interpreter* inner) {
+	Toy_Interpreter* interpreter = inner->caller;
+
+	Toy_Literal tailFunction;
+	Toy_Literal tailName;
+	Toy_LiteralArray tailArguments;
+	takeTailCall(inner->calls, &tailFunction, &tailName, &tailArguments);
+
+	//the result is still checked against the types of the function being replaced
+	Toy_LiteralArray tailTypes = inner->tailTypes;
+	Toy_initLiteralArray(&inner->tailTypes);
+
+	if (inner->returnTypes->count > 0) {
+		Toy_Literal types = TOY_TO_ARRAY_LITERAL(inner->returnTypes);
+
+		if (tailTypes.count == 0 || !Toy_literalsAreEqual(tailTypes.literals[tailTypes.count - 1], types)) {
+			Toy_pushLiteralArray(&tailTypes, types);
 		}
-		Toy_freeLiteral(result);
+	}
+
+	int returnRegister = inner->returnRegister;
+	Toy_Literal calleeName = Toy_copyLiteral(inner->calleeName);
+
+	releaseFrame(inner);
+
+	//errors are reported as if the call was made by the function, which then returned nothing
+	if (enterFunction(interpreter, tailFunction, &tailArguments) == NULL) {
+		if (!interpreter->panic) {
+			interpreter->errorOutput("Error encountered in function \"");
+			Toy_printLiteralCustom(tailName, interpreter->errorOutput);
+			interpreter->errorOutput("\"\n");
+		}
+
+		Toy_freeLiteralArray(&tailTypes);
+		Toy_freeLiteral(calleeName);
+		Toy_freeLiteralArray(&tailArguments);
+		Toy_freeLiteral(tailFunction);
+		Toy_freeLiteral(tailName);
 		return false;
 	}
 
-	//clean up
-	Toy_freeLiteral(assign);
-	Toy_freeLiteral(third);
-	Toy_freeLiteral(second);
-	Toy_freeLiteral(first);
-	Toy_freeLiteral(compound);
-	if (freeIdn) {
-		Toy_freeLiteral(compoundIdn);
+	inner->returnRegister = returnRegister;
+	inner->calleeName = calleeName;
+	inner->tailTypes = tailTypes;
+
+	Toy_freeLiteralArray(&tailArguments);
+	Toy_freeLiteral(tailFunction);
+	Toy_freeLiteral(tailName);
+
+	return true;
+}
+
+//a function called from bytecode, with it's results wanted on the stack or in a register
+static void returnToCaller(Toy_Interpreter* interpreter, Toy_Interpreter* inner) {
+	int reg = inner->returnRegister;
+
+	if (reg < 0) {
+		leaveFunction(interpreter, inner, &interpreter->stack);
+	}
+	else {
+		Toy_LiteralArray returns;
+		Toy_initLiteralArray(&returns);
+
+		leaveFunction(interpreter, inner, &returns);
+
+		Toy_freeLiteral(interpreter->registers[reg]);
+		interpreter->registers[reg] = returns.count > 0 ? Toy_popLiteralArray(&returns) : TOY_TO_NULL_LITERAL;
+
+		Toy_freeLiteralArray(&returns);
+	}
+
+	interpreter->suspended = false;
+
+	if (interpreter->panic) {
+		finishFrame(interpreter);
+	}
+}
+
+//runs the code in a frame, until it finishes or stops for a call
+static void runFrame(Toy_Interpreter* interpreter) {
+	switch(interpreter->engine) {
+		case TOY_FRAME_START:
+			execFunctionBody(interpreter);
+		break;
+
+		case TOY_FRAME_INTERPRETER:
+			execInterpreter(interpreter);
+
+			//it returned without stopping, so the grouping it was within has ended
+			if (!interpreter->suspended && interpreter->engine == TOY_FRAME_INTERPRETER) {
+				endGrouping(interpreter);
+			}
+		break;
+
+		case TOY_FRAME_REGISTERS:
+			runRegisterCode(interpreter);
+
+			if (!interpreter->suspended) {
+				finishFrame(interpreter);
+			}
+		break;
+
+		case TOY_FRAME_COMPILED:
+		case TOY_FRAME_FINISHED:
+			finishFrame(interpreter);
+		break;
+	}
+}
+
+//runs a frame until it's finished, along with every call it makes from bytecode - each call is run in the next frame, then the caller resumes
+static void runFrames(Toy_Interpreter* bottom) {
+	Toy_Interpreter* frame = bottom;
+
+	for (;;) {
+		runFrame(frame);
+
+		if (frame->suspended) {
+			frame = findCallFrame(frame->calls, frame->depth + 1);
+			continue;
+		}
+
+		if (frame->engine != TOY_FRAME_FINISHED) {
+			continue;
+		}
+
+		//a call in tail position replaces the function that made it
+		if (frame->calls != NULL && frame->calls->tailPending) {
+			Toy_Literal tailFunction;
+			Toy_Literal tailName;
+			Toy_LiteralArray tailArguments;
+
+			if (!frame->panic) {
+				if (replaceFrame(frame)) {
+					continue;
+				}
+			}
+			else {
+				takeTailCall(frame->calls, &tailFunction, &tailName, &tailArguments);
+
+				Toy_freeLiteralArray(&tailArguments);
+				Toy_freeLiteral(tailFunction);
+				Toy_freeLiteral(tailName);
+			}
+		}
+
+		if (frame == bottom) {
+			return;
+		}
+
+		Toy_Interpreter* caller = frame->caller;
+		returnToCaller(caller, frame);
+		frame = caller;
+	}
+}
+
+//the function is run in the next frame, once this one has stopped for it
+static bool pushCall(Toy_Interpreter* interpreter, Toy_Literal func, Toy_Literal name, Toy_LiteralArray* arguments, int returnRegister) {
+	//the outermost interpreter keeps the frames
+	if (interpreter->calls == NULL) {
+		interpreter->calls = TOY_ALLOCATE(Toy_CallStack, 1);
+		initCallStack(interpreter->calls);
+	}
+
+	Toy_Interpreter* inner = enterFunction(interpreter, func, arguments);
+
+	if (inner == NULL) {
+		return false;
+	}
+
+	inner->calleeName = Toy_copyLiteral(name);
+	inner->returnRegister = returnRegister;
+	interpreter->suspended = true;
+
+	return true;
+}
+
+//natives reading their arguments in place leave their results above them - then the arguments and the callee beneath are dropped
+static bool callNativeView(Toy_Interpreter* interpreter, Toy_Literal func, int base, int count) {
+	int top = interpreter->stack.count;
+
+	int returnsCount = TOY_AS_FUNCTION_NATIVE_VIEW(func)(interpreter, interpreter->stack.literals + base, count);
+
+	for (int i = base - 1; i < top; i++) {
+		Toy_freeLiteral(interpreter->stack.literals[i]);
+	}
+
+	int results = interpreter->stack.count - top;
+	memmove(interpreter->stack.literals + base - 1, interpreter->stack.literals + top, sizeof(Toy_Literal) * results);
+	interpreter->stack.count = base - 1 + results;
+
+	return returnsCount >= 0;
+}
+
+//expect stack: identifier, arg1, arg2, arg3..., stackSize
+//also supports identifier & arg1 to be other way around (looseFirstArgument)
+//a call in tail position is left for the caller, and stops the function (tail)
+static bool execFnCall(Toy_Interpreter* interpreter, bool looseFirstArgument, bool tail) {
+	Toy_Literal stackSize = Toy_popLiteralArray(&interpreter->stack);
+	int count = TOY_AS_INTEGER(stackSize);
+	int base = interpreter->stack.count - count;
+
+	//the first argument is beneath the identifier, so they're swapped into order
+	if (looseFirstArgument && count > 0) {
+		Toy_Literal first = interpreter->stack.literals[base - 1];
+		interpreter->stack.literals[base - 1] = interpreter->stack.literals[base];
+		interpreter->stack.literals[base] = first;
+	}
+
+	//get the function literal
+	Toy_Literal identifier = interpreter->stack.literals[base - 1];
+	Toy_Literal func = identifier;
+
+	bool found = Toy_parseIdentifierToValue(interpreter, &func);
+
+	//natives reading their arguments in place are called on the stack as it is
+	if (found && TOY_IS_FUNCTION_NATIVE_VIEW(func)) {
+		interpreter->stack.literals[base - 1] = TOY_TO_NULL_LITERAL; //kept for errors
+
+		bool ret = callNativeView(interpreter, func, base, count);
+
+		if (!ret && !interpreter->panic) {
+			interpreter->errorOutput("Error encountered in function \"");
+			printCallee(interpreter, identifier);
+			interpreter->errorOutput("\"\n");
+		}
+
+		Toy_freeLiteral(func);
+		Toy_freeLiteral(stackSize);
+		Toy_freeLiteral(identifier);
+
+		return ret;
+	}
+
+	//everything else takes the arguments off the stack, already in the correct order
+	Toy_LiteralArray correct;
+	Toy_initLiteralArray(&correct);
+
+	moveLiterals(&correct, &interpreter->stack, count);
+	identifier = Toy_popLiteralArray(&interpreter->stack);
+
+	if (!found) {
+		Toy_freeLiteralArray(&correct);
+		Toy_freeLiteral(stackSize);
+		Toy_freeLiteral(identifier);
+		return false;
+	}
+
+	if (!TOY_IS_FUNCTION(func) && !TOY_IS_FUNCTION_NATIVE(func)) {
+		interpreter->errorOutput("Function not found: ");
+		Toy_printLiteralCustom(identifier, interpreter->errorOutput);
+		interpreter->errorOutput("\n");
+
+		Toy_freeLiteral(identifier);
+		Toy_freeLiteral(stackSize);
+		Toy_freeLiteralArray(&correct);
+		return false;
+	}
+
+	//natives, and calls outside of functions, are made as usual
+	if (tail && TOY_IS_FUNCTION(func) && interpreter->function != NULL) {
+		//the caller can't see this scope, so the arguments are resolved here
+		for (int i = 0; i < correct.count; i++) {
+			Toy_Literal litIdn = correct.literals[i];
+			if (TOY_IS_IDENTIFIER(litIdn) && Toy_parseIdentifierToValue(interpreter, &correct.literals[i])) {
+				Toy_freeLiteral(litIdn);
+			}
+
+			if (TOY_IS_IDENTIFIER(correct.literals[i])) {
+				interpreter->errorOutput("Error encountered in function \"");
+				Toy_printLiteralCustom(identifier, interpreter->errorOutput);
+				interpreter->errorOutput("\"\n");
+
+				Toy_freeLiteralArray(&correct);
+				Toy_freeLiteral(func);
+				Toy_freeLiteral(stackSize);
+				Toy_freeLiteral(identifier);
+				return false;
+			}
+		}
+
+		deferTailCall(interpreter, func, identifier, &correct);
+
+		Toy_freeLiteralArray(&correct);
+		Toy_freeLiteral(func);
+		Toy_freeLiteral(stackSize);
+		Toy_freeLiteral(identifier);
+
+		return false;
+	}
+
+	//call the function literal - code compiled ahead of time can't be stopped for a call, so it's calls nest
+	bool ret;
+
+	if (TOY_IS_FUNCTION(func) && interpreter->engine != TOY_FRAME_COMPILED) {
+		ret = pushCall(interpreter, func, identifier, &correct, -1);
+	}
+	else {
+		ret = Toy_callLiteralFn(interpreter, func, &correct, &interpreter->stack);
+	}
+
+	//a panic has already been reported
+	if (!ret && !interpreter->panic) {
+		interpreter->errorOutput("Error encountered in function \"");
+		printCallee(interpreter, identifier);
+		interpreter->errorOutput("\"\n");
+	}
+
+	Toy_freeLiteralArray(&correct);
+	Toy_freeLiteral(func);
+	Toy_freeLiteral(stackSize);
+	Toy_freeLiteral(identifier);
+
+	return ret;
+}
+
+//runs a function in the frame for the next depth - calls made from C nest, so each runs it's own loop over the frames
+static bool callFunction(Toy_Interpreter* interpreter, Toy_Literal func, Toy_LiteralArray* arguments, Toy_LiteralArray* returns) {
+	Toy_CallStack* calls = interpreter->calls;
+
+	if (calls->nesting >= TOY_CALL_NESTING) {
+		interpreter->errorOutput("Infinite recursion detected - panicking\n");
+		interpreter->panic = true;
+		return false;
+	}
+
+	Toy_Interpreter* inner = enterFunction(interpreter, func, arguments);
+
+	if (inner == NULL) {
+		return false;
+	}
+
+	calls->nesting++;
+	runFrames(inner);
+	calls->nesting--;
+
+	leaveFunction(interpreter, inner, returns);
+
+	//BUGFIX: this function needs to eat the arguments
+	Toy_freeLiteralArray(arguments);
+
+	//actual bytecode persists until next call
+	return true;
+}
+
+//expects arguments in correct order
+bool Toy_callLiteralFn(Toy_Interpreter* interpreter, Toy_Literal func, Toy_LiteralArray* arguments, Toy_LiteralArray* returns) {
+	//check for side-loaded native functions
+	if (TOY_IS_FUNCTION_NATIVE(func)) {
+		//TODO: parse out identifier values, see issue #64
+
+		//call the native function - those reading their arguments in place are given the array's contents
+		int returnsCount;
+
+		if (TOY_IS_FUNCTION_NATIVE_VIEW(func)) {
+			returnsCount = TOY_AS_FUNCTION_NATIVE_VIEW(func)(interpreter, arguments->literals, arguments->count);
+		}
+		else {
+			returnsCount = TOY_AS_FUNCTION_NATIVE(func)(interpreter, arguments);
+		}
+
+		if (returnsCount < 0) {
+			// interpreter->errorOutput("Unknown error from native function\n");
+			return false;
+		}
+
+		//get the results - when they're wanted on the stack, they're already in place
+		if (returns != &interpreter->stack || interpreter->stack.count < (returnsCount || 1)) {
+			Toy_LiteralArray returnsFromInner;
+			Toy_initLiteralArray(&returnsFromInner);
+
+			moveLiterals(&returnsFromInner, &interpreter->stack, returnsCount || 1);
+			moveLiterals(returns, &returnsFromInner, returnsFromInner.count);
+
+			Toy_freeLiteralArray(&returnsFromInner);
+		}
+
+		return true;
+	}
+
+	//normal Toy function
+	if (!TOY_IS_FUNCTION(func)) {
+		interpreter->errorOutput("Function literal required in Toy_callLiteralFn()\n");
+		return false;
+	}
+
+	//the outermost interpreter keeps the frames
+	if (interpreter->calls == NULL) {
+		interpreter->calls = TOY_ALLOCATE(Toy_CallStack, 1);
+		initCallStack(interpreter->calls);
+	}
+
+	return callFunction(interpreter, func, arguments, returns);
+}
+
+bool Toy_callFn(Toy_Interpreter* interpreter, const char* name, Toy_LiteralArray* arguments, Toy_LiteralArray* returns) {
+	Toy_Literal key = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefStringLength(name, strlen(name)));
+	Toy_Literal val = TOY_TO_NULL_LITERAL;
+	
+	if (!Toy_isDelcaredScopeVariable(interpreter->scope, key)) {
+		interpreter->errorOutput("No function with that name\n");
+		return false;
+	}
+
+	Toy_getScopeVariable(interpreter->scope, key, &val);
+
+	bool ret = Toy_callLiteralFn(interpreter, val, arguments, returns);
+
+	Toy_freeLiteral(key);
+	Toy_freeLiteral(val);
+
+	return ret;
+}
+
+static bool execFnReturn(Toy_Interpreter* interpreter) {
+	//get the values of everything on the stack, in place
+	for (int i = interpreter->stack.count - 1; i >= 0; i--) {
+		Toy_Literal* lit = &interpreter->stack.literals[i];
+
+		Toy_Literal litIdn = *lit;
+		if (TOY_IS_IDENTIFIER(*lit) && Toy_parseIdentifierToValue(interpreter, lit)) {
+			Toy_freeLiteral(litIdn);
+		}
+
+		if (TOY_IS_IDENTIFIER(*lit)) {
+			return false;
+		}
+
+		if (TOY_IS_ARRAY(*lit) || TOY_IS_DICTIONARY(*lit)) {
+			Toy_parseCompoundToPureValues(interpreter, lit);
+		}
+	}
+
+	//finally
+	return false;
+}
+
+static bool execImport(Toy_Interpreter* interpreter) {
+	Toy_Literal alias = Toy_popLiteralArray(&interpreter->stack);
+	Toy_Literal identifier = Toy_popLiteralArray(&interpreter->stack);
+
+	//access the hooks
+	if (!Toy_existsLiteralDictionary(interpreter->hooks, identifier)) {
+		interpreter->errorOutput("Unknown library name in import statement: ");
+		Toy_printLiteralCustom(identifier, interpreter->errorOutput);
+		interpreter->errorOutput("\n");
+
+		Toy_freeLiteral(alias);
+		Toy_freeLiteral(identifier);
+		return false;
+	}
+
+	Toy_Literal func = Toy_getLiteralDictionary(interpreter->hooks, identifier);
+
+	if (!TOY_IS_FUNCTION_HOOK(func)) {
+		interpreter->errorOutput("Expected hook function, found: ");
+		Toy_printLiteralCustom(identifier, interpreter->errorOutput);
+		interpreter->errorOutput("\"\n");
+
+		Toy_freeLiteral(func);
+		Toy_freeLiteral(alias);
+		Toy_freeLiteral(identifier);
+		return false;
+	}
+
+	TOY_AS_FUNCTION_HOOK(func)(interpreter, identifier, alias);
+
+	Toy_freeLiteral(func);
+	Toy_freeLiteral(alias);
+	Toy_freeLiteral(identifier);
+	return true;
+}
+
+static bool execIndex(Toy_Interpreter* interpreter, bool assignIntermediate) {
+	//assume -> compound, first, second, third are all on the stack
+
+	Toy_Literal third = Toy_popLiteralArray(&interpreter->stack);
+	Toy_Literal second = Toy_popLiteralArray(&interpreter->stack);
+	Toy_Literal first = Toy_popLiteralArray(&interpreter->stack);
+	Toy_Literal compound = Toy_popLiteralArray(&interpreter->stack);
+
+	Toy_Literal compoundIdn = compound;
+	bool freeIdn = false;
+	if (TOY_IS_IDENTIFIER(compound) && Toy_parseIdentifierToValue(interpreter, &compound)) {
+		freeIdn = true;
+	}
+
+	if (TOY_IS_IDENTIFIER(compound)) {
+		Toy_freeLiteral(third);
+		Toy_freeLiteral(second);
+		Toy_freeLiteral(first);
+		Toy_freeLiteral(compound);
+		if (freeIdn) {
+			Toy_freeLiteral(compoundIdn);
+		}
+		return true;
+	}
+
+	if (!TOY_IS_ARRAY(compound) && !TOY_IS_DICTIONARY(compound) && !TOY_IS_STRING(compound)) {
+		interpreter->errorOutput("Unknown compound found in index notation: ");
+		Toy_printLiteralCustom(compound, interpreter->errorOutput);
+		interpreter->errorOutput("\n");
+
+		Toy_freeLiteral(third);
+		Toy_freeLiteral(second);
+		Toy_freeLiteral(first);
+		Toy_freeLiteral(compound);
+
+		if (freeIdn) {
+			Toy_freeLiteral(compoundIdn);
+		}
+
+		return false;
+	}
+
+	//build the argument list
+	Toy_LiteralArray arguments;
+	Toy_initLiteralArray(&arguments);
+
+	Toy_pushLiteralArray(&arguments, compound);
+	Toy_pushLiteralArray(&arguments, first);
+	Toy_pushLiteralArray(&arguments, second);
+	Toy_pushLiteralArray(&arguments, third);
+	Toy_pushLiteralArray(&arguments, TOY_TO_NULL_LITERAL); //it expects an assignment command
+	Toy_pushLiteralArray(&arguments, TOY_TO_NULL_LITERAL); //it expects an assignment "opcode"
+
+	//leave the idn and compound on the stack
+	if (assignIntermediate) {
+		if (TOY_IS_IDENTIFIER(compoundIdn)) {
+			Toy_pushLiteralArray(&interpreter->stack, compoundIdn);
+		}
+		Toy_pushLiteralArray(&interpreter->stack, compound);
+		Toy_pushLiteralArray(&interpreter->stack, first);
+		Toy_pushLiteralArray(&interpreter->stack, second);
+		Toy_pushLiteralArray(&interpreter->stack, third);
+	}
+
+	//call the index function
+	if (Toy_private_index(interpreter, &arguments) < 0) {
+		interpreter->errorOutput("Something went wrong while indexing (simple index): ");
+		Toy_printLiteralCustom(compoundIdn, interpreter->errorOutput);
+		interpreter->errorOutput("\n");
+
+		//clean up
+		Toy_freeLiteral(third);
+		Toy_freeLiteral(second);
+		Toy_freeLiteral(first);
+		Toy_freeLiteral(compound);
+		if (freeIdn) {
+			Toy_freeLiteral(compoundIdn);
+		}
+		Toy_freeLiteralArray(&arguments);
+		return false;
+	}
+
+	//clean up
+	Toy_freeLiteral(third);
+	Toy_freeLiteral(second);
+	Toy_freeLiteral(first);
+	Toy_freeLiteral(compound);
+	if (freeIdn) {
+		Toy_freeLiteral(compoundIdn);
+	}
+	Toy_freeLiteralArray(&arguments);
+
+	return true;
+}
+
+static bool execIndexAssign(Toy_Interpreter* interpreter, int assignDepth, unsigned char opcode) {
+	//assume -> compound, first, second, third, assign are all on the stack
+
+	Toy_Literal assign = TOY_TO_NULL_LITERAL, third = TOY_TO_NULL_LITERAL, second = TOY_TO_NULL_LITERAL, first = TOY_TO_NULL_LITERAL, compound = TOY_TO_NULL_LITERAL, result = TOY_TO_NULL_LITERAL;
+	Toy_Literal compoundIdn = TOY_TO_NULL_LITERAL;
+	bool freeIdn = false;
+
+	//build the opcode
+	char* opStr = "";
+	switch (opcode) {
+	case TOY_OP_VAR_ASSIGN:
+		opStr = "=";
+		break;
+	case TOY_OP_VAR_ADDITION_ASSIGN:
+		opStr = "+=";
+		break;
+	case TOY_OP_VAR_SUBTRACTION_ASSIGN:
+		opStr = "-=";
+		break;
+	case TOY_OP_VAR_MULTIPLICATION_ASSIGN:
+		opStr = "*=";
+		break;
+	case TOY_OP_VAR_DIVISION_ASSIGN:
+		opStr = "/=";
+		break;
+	case TOY_OP_VAR_MODULO_ASSIGN:
+		opStr = "%=";
+		break;
+
+	default:
+		interpreter->errorOutput("bad opcode in index assigning notation\n");
+		return false;
+	}
+
+	//iterate...
+	while(assignDepth-- >= 0) {
+		Toy_freeLiteral(assign);
+		Toy_freeLiteral(third);
+		Toy_freeLiteral(second);
+		Toy_freeLiteral(first);
+		Toy_freeLiteral(compound);
+
+		if (TOY_IS_NULL(result)) {
+			assign = Toy_popLiteralArray(&interpreter->stack);
+		}
+		else {
+			assign = result;
+		}
+
+		third = Toy_popLiteralArray(&interpreter->stack);
+		second = Toy_popLiteralArray(&interpreter->stack);
+		first = Toy_popLiteralArray(&interpreter->stack);
+		compound = Toy_popLiteralArray(&interpreter->stack);
+
+		if (TOY_IS_IDENTIFIER(compound)) {
+			if (freeIdn) {
+				Toy_freeLiteral(compoundIdn);
+			}
+
+			compoundIdn = compound;
+			Toy_parseIdentifierToValue(interpreter, &compound);
+			freeIdn = true;
+		}
+
+		if (TOY_IS_IDENTIFIER(compound)) {
+			Toy_freeLiteral(compound);
+			Toy_freeLiteral(first);
+			Toy_freeLiteral(second);
+			Toy_freeLiteral(third);
+			Toy_freeLiteral(assign);
+			if (freeIdn) {
+				Toy_freeLiteral(compoundIdn);
+			}
+			return false;
+		}
+
+		Toy_Literal assignIdn = assign;
+		if (TOY_IS_IDENTIFIER(assign) && Toy_parseIdentifierToValue(interpreter, &assign)) {
+			Toy_freeLiteral(assignIdn);
+		}
+
+		if (TOY_IS_IDENTIFIER(assign)) {
+			Toy_freeLiteral(compound);
+			Toy_freeLiteral(first);
+			Toy_freeLiteral(second);
+			Toy_freeLiteral(third);
+			Toy_freeLiteral(assign);
+			return false;
+		}
+
+		if (!TOY_IS_ARRAY(compound) && !TOY_IS_DICTIONARY(compound) && !TOY_IS_STRING(compound)) {
+			interpreter->errorOutput("Unknown compound found in index assigning notation: ");
+			Toy_printLiteralCustom(compound, interpreter->errorOutput);
+			interpreter->errorOutput("\n");
+			Toy_freeLiteral(assign);
+			Toy_freeLiteral(third);
+			Toy_freeLiteral(second);
+			Toy_freeLiteral(first);
+			Toy_freeLiteral(compound);
+			if (freeIdn) {
+				Toy_freeLiteral(compoundIdn);
+			}
+			return false;
+		}
+
+		int opLength = strlen(opStr);
+		Toy_Literal op = TOY_TO_STRING_LITERAL(Toy_createRefStringLength(opStr, opLength)); //TODO: static reference optimisation?
+
+		//build the argument list
+		Toy_LiteralArray arguments;
+		Toy_initLiteralArray(&arguments);
+
+		Toy_pushLiteralArray(&arguments, compound);
+		Toy_pushLiteralArray(&arguments, first);
+		Toy_pushLiteralArray(&arguments, second);
+		Toy_pushLiteralArray(&arguments, third);
+		Toy_pushLiteralArray(&arguments, assign); //it expects an assignment command
+		Toy_pushLiteralArray(&arguments, op); //it expects an assignment "opcode"
+
+		//call the index function
+		if (Toy_private_index(interpreter, &arguments) < 0) {
+			//clean up
+			Toy_freeLiteral(assign);
+			Toy_freeLiteral(third);
+			Toy_freeLiteral(second);
+			Toy_freeLiteral(first);
+			Toy_freeLiteral(compound);
+			if (freeIdn) {
+				Toy_freeLiteral(compoundIdn);
+			}
+			Toy_freeLiteral(op);
+			Toy_freeLiteralArray(&arguments);
+
+			return false;
+		}
+
+		//save the result (assume top of the interpreter stack is the new compound value)
+		result = Toy_popLiteralArray(&interpreter->stack);
+
+		Toy_freeLiteral(op);
+		Toy_freeLiteralArray(&arguments);
+
+		//if we loop, then we need to be assigning
+		opStr = "=";
+	}
+
+	//BUGFIX: make sure the compound name can be assigned
+	if (TOY_IS_NULL(compoundIdn)) {
+		compoundIdn = Toy_popLiteralArray(&interpreter->stack);
+		freeIdn = true;
+	}
+
+	if (TOY_IS_IDENTIFIER(compoundIdn) && !Toy_setScopeVariableCached(interpreter->scope, &interpreter->scopeCache, compoundIdn, result, true)) {
+		interpreter->errorOutput("Incorrect type assigned to compound member ");
+		Toy_printLiteralCustom(compoundIdn, interpreter->errorOutput);
+		interpreter->errorOutput(", value: ");
+		Toy_printLiteralCustom(result, interpreter->errorOutput);
+		interpreter->errorOutput("\n");
+
+		//clean up
+		Toy_freeLiteral(assign);
+		Toy_freeLiteral(third);
+		Toy_freeLiteral(second);
+		Toy_freeLiteral(first);
+		Toy_freeLiteral(compound);
+		if (freeIdn) {
+			Toy_freeLiteral(compoundIdn);
+		}
+		Toy_freeLiteral(result);
+		return false;
+	}
+
+	//clean up
+	Toy_freeLiteral(assign);
+	Toy_freeLiteral(third);
+	Toy_freeLiteral(second);
+	Toy_freeLiteral(first);
+	Toy_freeLiteral(compound);
+	if (freeIdn) {
+		Toy_freeLiteral(compoundIdn);
+	}
+	Toy_freeLiteral(result);
+
+	return true;
+}
+
+//peek at an element of an array or dictionary, without copying it - false if there isn't one to read
+static bool peekElement(Toy_Literal compound, Toy_Literal index, Toy_Literal* element) {
+	if (TOY_IS_ARRAY(compound) && TOY_IS_INTEGER(index) && TOY_AS_INTEGER(index) >= 0 && TOY_AS_INTEGER(index) < TOY_AS_ARRAY(compound)->count) {
+		*element = TOY_AS_ARRAY(compound)->literals[TOY_AS_INTEGER(index)];
+		return true;
+	}
+
+	//missing keys are read as null, but keys the dictionary would reject are left for the error
+	if (TOY_IS_DICTIONARY(compound) && !TOY_IS_NULL(index) && !TOY_IS_FUNCTION(index) && !TOY_IS_FUNCTION_NATIVE(index) && !TOY_IS_FUNCTION_HOOK(index) && !TOY_IS_OPAQUE(index)) {
+		int entry = Toy_findLiteralDictionary(TOY_AS_DICTIONARY(compound), index);
+		*element = entry >= 0 ? TOY_AS_DICTIONARY(compound)->entries[entry].value : TOY_TO_NULL_LITERAL;
+		return true;
+	}
+
+	return false;
+}
+
+//"a[i]" - the element is read straight out of the compound, or the variable holding it, instead of a copy
+static bool execIndexGet(Toy_Interpreter* interpreter) {
+	Toy_Literal first = Toy_popLiteralArray(&interpreter->stack);
+	Toy_Literal compound = Toy_popLiteralArray(&interpreter->stack);
+
+	const Toy_Literal* compoundPtr = TOY_IS_IDENTIFIER(compound) ? Toy_findScopeVariableCached(interpreter->scope, &interpreter->scopeCache, compound) : &compound;
+	const Toy_Literal* firstPtr = TOY_IS_IDENTIFIER(first) ? Toy_findScopeVariableCached(interpreter->scope, &interpreter->scopeCache, first) : &first;
+
+	Toy_Literal element = TOY_TO_NULL_LITERAL;
+
+	if (compoundPtr != NULL && firstPtr != NULL && peekElement(*compoundPtr, *firstPtr, &element) && !TOY_IS_IDENTIFIER(element)) {
+		Toy_pushLiteralArray(&interpreter->stack, element);
+
+		Toy_freeLiteral(first);
+		Toy_freeLiteral(compound);
+		return true;
+	}
+
+	//otherwise, exactly as the general form - including strings, and every error
+	Toy_pushLiteralArray(&interpreter->stack, compound);
+	Toy_pushLiteralArray(&interpreter->stack, first);
+	Toy_pushLiteralArray(&interpreter->stack, TOY_TO_NULL_LITERAL);
+	Toy_pushLiteralArray(&interpreter->stack, TOY_TO_NULL_LITERAL);
+
+	Toy_freeLiteral(first);
+	Toy_freeLiteral(compound);
+
+	return execIndex(interpreter, false);
+}
+
+//"a[i] op= v" - the element is changed within the variable in place, instead of assigning a changed copy of the whole compound
+static bool execIndexSetAs(Toy_Interpreter* interpreter, unsigned char opcode) {
+	Toy_Literal assign = Toy_popLiteralArray(&interpreter->stack);
+	Toy_Literal first = Toy_popLiteralArray(&interpreter->stack);
+	Toy_Literal compound = Toy_popLiteralArray(&interpreter->stack);
+
+	Toy_Literal assignIdn = assign;
+	if (TOY_IS_IDENTIFIER(assign) && Toy_parseIdentifierToValue(interpreter, &assign)) {
+		Toy_freeLiteral(assignIdn);
+	}
+
+	Toy_Literal firstIdn = first;
+	if (TOY_IS_IDENTIFIER(first) && Toy_parseIdentifierToValue(interpreter, &first)) {
+		Toy_freeLiteral(firstIdn);
+	}
+
+	if (TOY_IS_IDENTIFIER(assign) || TOY_IS_IDENTIFIER(first)) {
+		Toy_freeLiteral(assign);
+		Toy_freeLiteral(first);
+		Toy_freeLiteral(compound);
+		return false;
+	}
+
+	Toy_Literal result = TOY_TO_NULL_LITERAL;
+	bool ready = true;
+
+	//compound assignments do the arithmetic on the element where it is, for numbers and strings
+	if (opcode != TOY_OP_VAR_ASSIGN) {
+		const Toy_Literal* compoundPtr = Toy_findScopeVariableCached(interpreter->scope, &interpreter->scopeCache, compound);
+		Toy_Literal element = TOY_TO_NULL_LITERAL;
+
+		ready = compoundPtr != NULL && peekElement(*compoundPtr, first, &element);
+
+		bool numbers = (TOY_IS_INTEGER(element) || TOY_IS_FLOAT(element)) && (TOY_IS_INTEGER(assign) || TOY_IS_FLOAT(assign));
+		bool strings = TOY_IS_STRING(element) && TOY_IS_STRING(assign);
+		ready = ready && (numbers || strings);
+
+		if (ready) {
+			Toy_pushLiteralArray(&interpreter->stack, element);
+			Toy_pushLiteralArray(&interpreter->stack, assign);
+
+			if (!execArithmetic(interpreter, (Toy_Opcode)opcode)) {
+				Toy_freeLiteral(assign);
+				Toy_freeLiteral(first);
+				Toy_freeLiteral(compound);
+				return false;
+			}
+
+			result = Toy_popLiteralArray(&interpreter->stack);
+		}
+	}
+
+	//anything the assignment would reject (types, constants, bounds) falls through to the general form for the error
+	if (ready && Toy_setScopeVariableElementCached(interpreter->scope, &interpreter->scopeCache, compound, first, opcode == TOY_OP_VAR_ASSIGN ? assign : result)) {
+		Toy_freeLiteral(result);
+		Toy_freeLiteral(assign);
+		Toy_freeLiteral(first);
+		Toy_freeLiteral(compound);
+		return true;
+	}
+
+	Toy_pushLiteralArray(&interpreter->stack, compound);
+	Toy_pushLiteralArray(&interpreter->stack, first);
+	Toy_pushLiteralArray(&interpreter->stack, TOY_TO_NULL_LITERAL);
+	Toy_pushLiteralArray(&interpreter->stack, TOY_TO_NULL_LITERAL);
+	Toy_pushLiteralArray(&interpreter->stack, assign);
+
+	Toy_freeLiteral(result);
+	Toy_freeLiteral(assign);
+	Toy_freeLiteral(first);
+	Toy_freeLiteral(compound);
+
+	return execIndexAssign(interpreter, 0, opcode);
+}
+
+static bool execIndexSet(Toy_Interpreter* interpreter) {
+	return execIndexSetAs(interpreter, readByte(interpreter->bytecode, &interpreter->count));
+}
+
+//the heart of toy
+//the register engine - function bodies compiled with "--registers" run here, without touching the stack
+
+//the stack's own handlers are reused for anything without a fast path, so the errors are identical
+static bool execRegisterSlowPath(Toy_Interpreter* interpreter, Toy_Opcode opcode, Toy_Literal* dst, Toy_Literal* lhs, Toy_Literal* rhs) {
+	Toy_pushLiteralArray(&interpreter->stack, *lhs);
+	if (rhs != NULL) {
+		Toy_pushLiteralArray(&interpreter->stack, *rhs);
+	}
+
+	bool result;
+
+	switch(opcode) {
+		case TOY_OP_NEGATE:
+			result = execNegate(interpreter);
+		break;
+
+		case TOY_OP_INVERT:
+			result = execInvert(interpreter);
+		break;
+
+		case TOY_OP_ADDITION:
+		case TOY_OP_SUBTRACTION:
+		case TOY_OP_MULTIPLICATION:
+		case TOY_OP_DIVISION:
+		case TOY_OP_MODULO:
+			result = execArithmetic(interpreter, opcode);
+		break;
+
+		case TOY_OP_AND:
+			result = execAnd(interpreter);
+		break;
+
+		case TOY_OP_OR:
+			result = execOr(interpreter);
+		break;
+
+		default:
+			result = execCompare(interpreter, opcode);
+		break;
+	}
+
+	if (result) {
+		Toy_Literal value = Toy_popLiteralArray(&interpreter->stack);
+		Toy_freeLiteral(*dst);
+		*dst = value;
+	}
+
+	while (interpreter->stack.count > 0) {
+		Toy_Literal lit = Toy_popLiteralArray(&interpreter->stack);
+		Toy_freeLiteral(lit);
+	}
+
+	return result;
+}
+
+//returns the result, or -1 if there's no fast path for these operands
+static int compareRegisters(Toy_Opcode opcode, Toy_Literal lhs, Toy_Literal rhs) {
+	float a;
+	float b;
+
+	if (TOY_IS_INTEGER(lhs) && TOY_IS_INTEGER(rhs)) {
+		if (opcode == TOY_OP_COMPARE_EQUAL || opcode == TOY_OP_COMPARE_NOT_EQUAL) {
+			return (TOY_AS_INTEGER(lhs) == TOY_AS_INTEGER(rhs)) == (opcode == TOY_OP_COMPARE_EQUAL);
+		}
+
+		//NOTE: the ordered comparisons are done as floats, like the generic opcodes
+		a = (float)TOY_AS_INTEGER(lhs);
+		b = (float)TOY_AS_INTEGER(rhs);
+	}
+	else if (TOY_IS_FLOAT(lhs) && TOY_IS_FLOAT(rhs)) {
+		a = TOY_AS_FLOAT(lhs);
+		b = TOY_AS_FLOAT(rhs);
+	}
+	else {
+		return -1;
+	}
+
+	switch(opcode) {
+		case TOY_OP_COMPARE_EQUAL:
+			return a == b;
+
+		case TOY_OP_COMPARE_NOT_EQUAL:
+			return a != b;
+
+		case TOY_OP_COMPARE_LESS:
+			return a < b;
+
+		case TOY_OP_COMPARE_LESS_EQUAL:
+			return a <= b;
+
+		case TOY_OP_COMPARE_GREATER:
+			return a > b;
+
+		case TOY_OP_COMPARE_GREATER_EQUAL:
+			return a >= b;
+
+		default:
+			return -1;
+	}
+}
+
+static bool execRegisterBinary(Toy_Interpreter* interpreter, Toy_Opcode opcode, Toy_Literal* dst, Toy_Literal* lhs, Toy_Literal* rhs) {
+	Toy_Literal result = TOY_TO_NULL_LITERAL;
+
+	if (TOY_IS_INTEGER(*lhs) && TOY_IS_INTEGER(*rhs)) {
+		int a = TOY_AS_INTEGER(*lhs);
+		int b = TOY_AS_INTEGER(*rhs);
+
+		switch(opcode) {
+			case TOY_OP_ADDITION:
+				result = TOY_TO_INTEGER_LITERAL(a + b);
+			break;
+
+			case TOY_OP_SUBTRACTION:
+				result = TOY_TO_INTEGER_LITERAL(a - b);
+			break;
+
+			case TOY_OP_MULTIPLICATION:
+				result = TOY_TO_INTEGER_LITERAL(a * b);
+			break;
+
+			case TOY_OP_DIVISION:
+				if (b != 0) {
+					result = TOY_TO_INTEGER_LITERAL(a / b);
+				}
+			break;
+
+			case TOY_OP_MODULO:
+				if (b != 0) {
+					result = TOY_TO_INTEGER_LITERAL(a % b);
+				}
+			break;
+
+			default:
+			break;
+		}
+	}
+	else if ((TOY_IS_FLOAT(*lhs) || TOY_IS_INTEGER(*lhs)) && (TOY_IS_FLOAT(*rhs) || TOY_IS_INTEGER(*rhs))) {
+		//coerced to floats, exactly as the generic opcode would
+		float a = TOY_IS_FLOAT(*lhs) ? TOY_AS_FLOAT(*lhs) : (float)TOY_AS_INTEGER(*lhs);
+		float b = TOY_IS_FLOAT(*rhs) ? TOY_AS_FLOAT(*rhs) : (float)TOY_AS_INTEGER(*rhs);
+
+		switch(opcode) {
+			case TOY_OP_ADDITION:
+				result = TOY_TO_FLOAT_LITERAL(a + b);
+			break;
+
+			case TOY_OP_SUBTRACTION:
+				result = TOY_TO_FLOAT_LITERAL(a - b);
+			break;
+
+			case TOY_OP_MULTIPLICATION:
+				result = TOY_TO_FLOAT_LITERAL(a * b);
+			break;
+
+			case TOY_OP_DIVISION:
+				if (b != 0) {
+					result = TOY_TO_FLOAT_LITERAL(a / b);
+				}
+			break;
+
+			default:
+			break;
+		}
+	}
+
+	if (TOY_IS_NULL(result)) {
+		int comparison = compareRegisters(opcode, *lhs, *rhs);
+
+		if (comparison < 0) {
+			return execRegisterSlowPath(interpreter, opcode, dst, lhs, rhs);
+		}
+
+		result = TOY_TO_BOOLEAN_LITERAL(comparison);
+	}
+
+	//numbers & booleans don't need copying
+	Toy_freeLiteral(*dst);
+	*dst = result;
+	return true;
+}
+
+//returns the truthiness of a condition, or -1 on error
+static int testRegisterCondition(Toy_Interpreter* interpreter, Toy_Literal literal) {
+	if (TOY_IS_NULL(literal)) {
+		interpreter->errorOutput("Null detected in comparison\n");
+		return -1;
+	}
+
+	return TOY_IS_TRUTHY(literal);
+}
+
+//arguments in registers are given names in a temporary scope, so natives can assign to them
+//a call in tail position is left for the caller, and stops the function (tail) - other functions are run in the next frame, which returns into dst
+static bool execRegisterCall(Toy_Interpreter* interpreter, const unsigned char* code, int* pc, Toy_Literal* registers, bool tail) {
+	int dst = code[(*pc)++];
+	int callee = code[(*pc)++];
+	Toy_Literal identifier = interpreter->literalCache.literals[readShort(code, pc)];
+	int count = code[(*pc)++];
+	int start = *pc;
+	*pc += count * 3;
+
+	Toy_Literal func = registers[callee];
+
+	if (!TOY_IS_FUNCTION(func) && !TOY_IS_FUNCTION_NATIVE(func)) {
+		interpreter->errorOutput("Function not found: ");
+		Toy_printLiteralCustom(identifier, interpreter->errorOutput);
+		interpreter->errorOutput("\n");
+		return false;
+	}
+
+	func = Toy_copyLiteral(func); //the callee could overwrite it's own register
+
+	bool native = TOY_IS_FUNCTION_NATIVE(func);
+	bool named = false;
+
+	Toy_LiteralArray arguments;
+	Toy_initLiteralArray(&arguments);
+
+	for (int i = 0, at = start; i < count; i++) {
+		int reg = code[at++];
+		unsigned short name = readShort(code, &at);
+
+		if (native && name != TOY_REGISTER_NO_NAME) {
+			if (!named) {
+				interpreter->scope = Toy_pushScope(interpreter->scope);
+				named = true;
+			}
+
+			Toy_Literal key = interpreter->literalCache.literals[name];
+			Toy_Literal type = TOY_TO_TYPE_LITERAL(TOY_LITERAL_ANY, false);
+
+			Toy_declareScopeVariable(interpreter->scope, key, type);
+			Toy_setScopeVariable(interpreter->scope, key, registers[reg], false);
+			Toy_pushLiteralArray(&arguments, key);
+
+			Toy_freeLiteral(type);
+			continue;
+		}
+
+		Toy_pushLiteralArray(&arguments, registers[reg]);
+	}
+
+	if (tail && !native) {
+		deferTailCall(interpreter, func, identifier, &arguments);
+
+		Toy_freeLiteralArray(&arguments);
+		Toy_freeLiteral(func);
+		return false;
+	}
+
+	if (!native) {
+		bool ret = pushCall(interpreter, func, identifier, &arguments, dst);
+
+		//a panic has already been reported
+		if (!ret && !interpreter->panic) {
+			interpreter->errorOutput("Error encountered in function \"");
+			Toy_printLiteralCustom(identifier, interpreter->errorOutput);
+			interpreter->errorOutput("\"\n");
+		}
+
+		Toy_freeLiteralArray(&arguments);
+		Toy_freeLiteral(func);
+
+		return ret;
+	}
+
+	//natives returning nothing take the top of the stack instead, which is the old value here
+	if (native) {
+		Toy_pushLiteralArray(&interpreter->stack, registers[dst]);
+	}
+
+	Toy_LiteralArray returns;
+	Toy_initLiteralArray(&returns);
+
+	bool ret = Toy_callLiteralFn(interpreter, func, &arguments, &returns);
+
+	//read back anything the native changed
+	if (named) {
+		for (int i = 0, at = start; i < count; i++) {
+			int reg = code[at++];
+			unsigned short name = readShort(code, &at);
+
+			if (name != TOY_REGISTER_NO_NAME) {
+				Toy_freeLiteral(registers[reg]);
+				registers[reg] = TOY_TO_NULL_LITERAL;
+				Toy_getScopeVariable(interpreter->scope, interpreter->literalCache.literals[name], &registers[reg]);
+			}
+		}
+
+		interpreter->scope = Toy_popScope(interpreter->scope);
+	}
+
+	if (!ret && !interpreter->panic) {
+		interpreter->errorOutput("Error encountered in function \"");
+		Toy_printLiteralCustom(identifier, interpreter->errorOutput);
+		interpreter->errorOutput("\"\n");
+	}
+	else if (ret) {
+		Toy_freeLiteral(registers[dst]);
+		registers[dst] = returns.count > 0 ? Toy_popLiteralArray(&returns) : TOY_TO_NULL_LITERAL;
+	}
+
+	while (interpreter->stack.count > 0) {
+		Toy_Literal lit = Toy_popLiteralArray(&interpreter->stack);
+		Toy_freeLiteral(lit);
+	}
+
+	Toy_freeLiteralArray(&returns);
+	Toy_freeLiteralArray(&arguments);
+	Toy_freeLiteral(func);
+
+	return ret && !interpreter->panic;
+}
+
+//runs until a return or an error, or stops for a call - the code follows count, and resumes at pc
+static void runRegisterCode(Toy_Interpreter* interpreter) {
+	const unsigned char* code = interpreter->bytecode + interpreter->count;
+	Toy_Literal* registers = interpreter->registers;
+	int pc = interpreter->pc;
+
+	for (;;) {
+		switch(code[pc++]) {
+			case TOY_REG_RETURN:
+				Toy_pushLiteralArray(&interpreter->stack, registers[code[pc]]);
+				return;
+
+			case TOY_REG_LITERAL: {
+				int dst = code[pc++];
+				Toy_freeLiteral(registers[dst]);
+				registers[dst] = Toy_copyLiteral(interpreter->literalCache.literals[readShort(code, &pc)]);
+			}
+			break;
+
+			case TOY_REG_GLOBAL: {
+				int dst = code[pc++];
+				Toy_Literal value = interpreter->literalCache.literals[readShort(code, &pc)];
+
+				if (!Toy_parseIdentifierToValue(interpreter, &value)) {
+					return;
+				}
+
+				Toy_freeLiteral(registers[dst]);
+				registers[dst] = value;
+			}
+			break;
+
+			case TOY_REG_SET_GLOBAL: {
+				Toy_Literal identifier = interpreter->literalCache.literals[readShort(code, &pc)];
+				int src = code[pc++];
+
+				Toy_pushLiteralArray(&interpreter->stack, identifier);
+				Toy_pushLiteralArray(&interpreter->stack, registers[src]);
+
+				if (!execVarAssign(interpreter)) {
+					return;
+				}
+			}
+			break;
+
+			case TOY_REG_MOVE: {
+				int dst = code[pc++];
+				int src = code[pc++];
+				Toy_Literal value = Toy_copyLiteral(registers[src]);
+				Toy_freeLiteral(registers[dst]);
+				registers[dst] = value;
+			}
+			break;
+
+			case TOY_REG_UNARY: {
+				Toy_Opcode opcode = code[pc++];
+				Toy_Literal* dst = &registers[code[pc++]];
+				Toy_Literal* src = &registers[code[pc++]];
+
+				Toy_Literal result = TOY_TO_NULL_LITERAL;
+
+				if (opcode == TOY_OP_NEGATE && TOY_IS_INTEGER(*src)) {
+					result = TOY_TO_INTEGER_LITERAL(-TOY_AS_INTEGER(*src));
+				}
+				else if (opcode == TOY_OP_NEGATE && TOY_IS_FLOAT(*src)) {
+					result = TOY_TO_FLOAT_LITERAL(-TOY_AS_FLOAT(*src));
+				}
+				else if (opcode == TOY_OP_INVERT && TOY_IS_BOOLEAN(*src)) {
+					result = TOY_TO_BOOLEAN_LITERAL(!TOY_AS_BOOLEAN(*src));
+				}
+				else {
+					if (!execRegisterSlowPath(interpreter, opcode, dst, src, NULL)) {
+						return;
+					}
+					break;
+				}
+
+				Toy_freeLiteral(*dst);
+				*dst = result;
+			}
+			break;
+
+			case TOY_REG_BINARY: {
+				Toy_Opcode opcode = code[pc++];
+				Toy_Literal* dst = &registers[code[pc++]];
+				Toy_Literal* lhs = &registers[code[pc++]];
+				Toy_Literal* rhs = &registers[code[pc++]];
+
+				if (!execRegisterBinary(interpreter, opcode, dst, lhs, rhs)) {
+					return;
+				}
+			}
+			break;
+
+			case TOY_REG_JUMP:
+				pc = readShort(code, &pc);
+			break;
+
+			case TOY_REG_JUMP_IF_FALSE: {
+				int truthy = testRegisterCondition(interpreter, registers[code[pc++]]);
+				int target = readShort(code, &pc);
+
+				if (truthy < 0) {
+					return;
+				}
+
+				if (!truthy) {
+					pc = target;
+				}
+			}
+			break;
+
+			case TOY_REG_COMPARE_JUMP: {
+				Toy_Opcode opcode = code[pc++];
+				Toy_Literal lhs = registers[code[pc++]];
+				Toy_Literal rhs = registers[code[pc++]];
+				int target = readShort(code, &pc);
+				int truthy = compareRegisters(opcode, lhs, rhs);
+
+				if (truthy < 0) {
+					Toy_Literal result = TOY_TO_NULL_LITERAL;
+
+					if (!execRegisterSlowPath(interpreter, opcode, &result, &lhs, &rhs)) {
+						return;
+					}
+
+					truthy = testRegisterCondition(interpreter, result);
+					Toy_freeLiteral(result);
+
+					if (truthy < 0) {
+						return;
+					}
+				}
+
+				if (!truthy) {
+					pc = target;
+				}
+			}
+			break;
+
+			case TOY_REG_CALL:
+			case TOY_REG_TAIL_CALL:
+				if (!execRegisterCall(interpreter, code, &pc, registers, code[pc - 1] == TOY_REG_TAIL_CALL)) {
+					return;
+				}
+
+				//resumed once the call returns
+				if (interpreter->suspended) {
+					interpreter->pc = pc;
+					return;
+				}
+			break;
+
+			case TOY_REG_PRINT:
+				Toy_printLiteralCustom(registers[code[pc++]], interpreter->printOutput);
+			break;
+
+			case TOY_REG_ASSERT: {
+				Toy_pushLiteralArray(&interpreter->stack, registers[code[pc++]]);
+				Toy_pushLiteralArray(&interpreter->stack, registers[code[pc++]]);
+
+				if (!execAssert(interpreter)) {
+					return;
+				}
+			}
+			break;
+
+			default:
+				interpreter->errorOutput("[internal] Unknown register opcode\n");
+				return;
+		}
+	}
+}
+
+//the registers are kept with the frame, and reused by the next call at this depth
+static void execRegisterCode(Toy_Interpreter* interpreter) {
+	int frameSize = readByte(interpreter->bytecode, &interpreter->count);
+	int constantCount = readByte(interpreter->bytecode, &interpreter->count);
+
+	if (interpreter->registerCapacity < frameSize) {
+		interpreter->registers = TOY_GROW_ARRAY(Toy_Literal, interpreter->registers, interpreter->registerCapacity, frameSize);
+		interpreter->registerCapacity = frameSize;
+	}
+
+	for (int i = 0; i < frameSize; i++) {
+		interpreter->registers[i] = TOY_TO_NULL_LITERAL;
+	}
+
+	interpreter->registerCount = frameSize;
+
+	for (int i = 0; i < constantCount; i++) {
+		interpreter->registers[1 + i] = Toy_copyLiteral(interpreter->literalCache.literals[readShort(interpreter->bytecode, &interpreter->count)]);
 	}
-	Toy_freeLiteral(result);
 
-	return true;
+	interpreter->pc = 0;
+	interpreter->engine = TOY_FRAME_REGISTERS;
 }
 
-//the heart of toy
+//runs until the code finishes or stops for a call - returning otherwise ends the grouping it's within, as a failure does
 static void execInterpreter(Toy_Interpreter* interpreter) {
 	//set the starting point for the interpreter
 	if (interpreter->codeStart == -1) {
 		interpreter->codeStart = interpreter->count;
 	}
 
-	//BUGFIX
-	int intermediateAssignDepth = 0;
-
 	unsigned char opcode = readByte(interpreter->bytecode, &interpreter->count);
 
 	while(opcode != TOY_OP_EOF && opcode != TOY_OP_SECTION_END && !interpreter->panic) {
+		if (interpreter->profile) {
+			Toy_recordOpcodeProfile(interpreter->profile, opcode);
+		}
+
 		switch(opcode) {
 			case TOY_OP_PASS:
 				//DO NOTHING
@@ -1945,8 +3492,25 @@ static void execInterpreter(Toy_Interpreter* interpreter) {
 			break;
 
 			case TOY_OP_LITERAL:
+				if (!execPushLiteral(interpreter, 1)) {
+					return;
+				}
+			break;
+
 			case TOY_OP_LITERAL_LONG:
-				if (!execPushLiteral(interpreter, opcode == TOY_OP_LITERAL_LONG)) {
+				if (!execPushLiteral(interpreter, 2)) {
+					return;
+				}
+			break;
+
+			case TOY_OP_LITERAL_WIDE:
+				if (!execPushLiteral(interpreter, 4)) {
+					return;
+				}
+			break;
+
+			case TOY_OP_LITERAL_PAIR:
+				if (!execPushLiteral(interpreter, 1) || !execPushLiteral(interpreter, 1)) {
 					return;
 				}
 			break;
@@ -1971,6 +3535,9 @@ static void execInterpreter(Toy_Interpreter* interpreter) {
 				if (!execArithmetic(interpreter, opcode)) {
 					return;
 				}
+				if (interpreter->function != NULL) {
+					quickenArithmetic(interpreter, opcode);
+				}
 			break;
 
 			case TOY_OP_VAR_ADDITION_ASSIGN:
@@ -1978,18 +3545,47 @@ static void execInterpreter(Toy_Interpreter* interpreter) {
 			case TOY_OP_VAR_MULTIPLICATION_ASSIGN:
 			case TOY_OP_VAR_DIVISION_ASSIGN:
 			case TOY_OP_VAR_MODULO_ASSIGN:
-				execVarArithmeticAssign(interpreter);
-				if (!execArithmetic(interpreter, opcode)) {
-					Toy_freeLiteral(Toy_popLiteralArray(&interpreter->stack));
+				if (!execVarCompoundAssign(interpreter, opcode)) {
 					return;
 				}
-				if (!execVarAssign(interpreter)) {
+			break;
+
+			case TOY_OP_VAR_ARITHMETIC_ASSIGN:
+				if (!execVarArithmeticAssignLiterals(interpreter)) {
+					return;
+				}
+			break;
+
+			case TOY_OP_ADDITION_INT:
+			case TOY_OP_SUBTRACTION_INT:
+			case TOY_OP_MULTIPLICATION_INT:
+			case TOY_OP_DIVISION_INT:
+			case TOY_OP_MODULO_INT:
+				if (!execArithmeticInt(interpreter, opcode)) {
+					return;
+				}
+			break;
+
+			case TOY_OP_ADDITION_FLOAT:
+			case TOY_OP_SUBTRACTION_FLOAT:
+			case TOY_OP_MULTIPLICATION_FLOAT:
+			case TOY_OP_DIVISION_FLOAT:
+				if (!execArithmeticFloat(interpreter, opcode)) {
+					return;
+				}
+			break;
+
+			case TOY_OP_COMPARE_LESS_INT:
+			case TOY_OP_COMPARE_LESS_EQUAL_INT:
+			case TOY_OP_COMPARE_GREATER_INT:
+			case TOY_OP_COMPARE_GREATER_EQUAL_INT:
+				if (!execCompareInt(interpreter, opcode)) {
 					return;
 				}
 			break;
 
 			case TOY_OP_GROUPING_BEGIN:
-				execInterpreter(interpreter);
+				beginGrouping(interpreter);
 			break;
 
 			case TOY_OP_GROUPING_END:
@@ -2007,15 +3603,37 @@ static void execInterpreter(Toy_Interpreter* interpreter) {
 			//TODO: custom type declarations?
 
 			case TOY_OP_VAR_DECL:
+				if (!execVarDecl(interpreter, 1)) {
+					return;
+				}
+			break;
+
 			case TOY_OP_VAR_DECL_LONG:
-				if (!execVarDecl(interpreter, opcode == TOY_OP_VAR_DECL_LONG)) {
+				if (!execVarDecl(interpreter, 2)) {
+					return;
+				}
+			break;
+
+			case TOY_OP_VAR_DECL_WIDE:
+				if (!execVarDecl(interpreter, 4)) {
 					return;
 				}
 			break;
 
 			case TOY_OP_FN_DECL:
+				if (!execFnDecl(interpreter, 1)) {
+					return;
+				}
+			break;
+
 			case TOY_OP_FN_DECL_LONG:
-				if (!execFnDecl(interpreter, opcode == TOY_OP_FN_DECL_LONG)) {
+				if (!execFnDecl(interpreter, 2)) {
+					return;
+				}
+			break;
+
+			case TOY_OP_FN_DECL_WIDE:
+				if (!execFnDecl(interpreter, 4)) {
 					return;
 				}
 			break;
@@ -2051,24 +3669,36 @@ static void execInterpreter(Toy_Interpreter* interpreter) {
 			break;
 
 			case TOY_OP_COMPARE_LESS:
+				if (interpreter->function != NULL) {
+					quickenComparison(interpreter, opcode);
+				}
 				if (!execCompareLess(interpreter, false)) {
 					return;
 				}
 			break;
 
 			case TOY_OP_COMPARE_LESS_EQUAL:
+				if (interpreter->function != NULL) {
+					quickenComparison(interpreter, opcode);
+				}
 				if (!execCompareLessEqual(interpreter, false)) {
 					return;
 				}
 			break;
 
 			case TOY_OP_COMPARE_GREATER:
+				if (interpreter->function != NULL) {
+					quickenComparison(interpreter, opcode);
+				}
 				if (!execCompareLess(interpreter, true)) {
 					return;
 				}
 			break;
 
 			case TOY_OP_COMPARE_GREATER_EQUAL:
+				if (interpreter->function != NULL) {
+					quickenComparison(interpreter, opcode);
+				}
 				if (!execCompareLessEqual(interpreter, true)) {
 					return;
 				}
@@ -2093,25 +3723,73 @@ static void execInterpreter(Toy_Interpreter* interpreter) {
 			break;
 
 			case TOY_OP_JUMP:
-				if (!execJump(interpreter)) {
+				if (!execJump(interpreter, 2)) {
 					return;
 				}
 			break;
 
 			case TOY_OP_IF_FALSE_JUMP:
-				if (!execFalseJump(interpreter)) {
+				if (!execFalseJump(interpreter, 2)) {
+					return;
+				}
+			break;
+
+			case TOY_OP_JUMP_WIDE:
+				if (!execJump(interpreter, 4)) {
+					return;
+				}
+			break;
+
+			case TOY_OP_IF_FALSE_JUMP_WIDE:
+				if (!execFalseJump(interpreter, 4)) {
+					return;
+				}
+			break;
+
+			case TOY_OP_COMPARE_JUMP:
+				if (!execCompareJump(interpreter, 2)) {
+					return;
+				}
+			break;
+
+			case TOY_OP_COMPARE_JUMP_WIDE:
+				if (!execCompareJump(interpreter, 4)) {
 					return;
 				}
 			break;
 
 			case TOY_OP_FN_CALL:
-				if (!execFnCall(interpreter, false)) {
+				if (!execFnCall(interpreter, false, false)) {
+					return;
+				}
+
+				if (interpreter->suspended) {
 					return;
 				}
 			break;
 
 			case TOY_OP_DOT:
-				if (!execFnCall(interpreter, true)) { //compensate for the out-of-order arguments
+				if (!execFnCall(interpreter, true, false)) { //compensate for the out-of-order arguments
+					return;
+				}
+
+				if (interpreter->suspended) {
+					return;
+				}
+			break;
+
+			case TOY_OP_TAIL_CALL:
+				if (!execFnCall(interpreter, false, true)) {
+					return;
+				}
+
+				if (interpreter->suspended) {
+					return;
+				}
+			break;
+
+			case TOY_OP_BUILTIN:
+				if (!execBuiltin(interpreter)) {
 					return;
 				}
 			break;
@@ -2122,6 +3800,11 @@ static void execInterpreter(Toy_Interpreter* interpreter) {
 				}
 			break;
 
+			case TOY_OP_REGISTER_CODE:
+				//the rest of the function is register code
+				execRegisterCode(interpreter);
+			return;
+
 			case TOY_OP_IMPORT:
 				if (!execImport(interpreter)) {
 					return;
@@ -2138,14 +3821,26 @@ static void execInterpreter(Toy_Interpreter* interpreter) {
 				if (!execIndex(interpreter, true)) {
 					return;
 				}
-				intermediateAssignDepth++;
+				interpreter->assignDepth++;
 			break;
 
 			case TOY_OP_INDEX_ASSIGN:
-				if (!execIndexAssign(interpreter, intermediateAssignDepth)) {
+				if (!execIndexAssign(interpreter, interpreter->assignDepth, readByte(interpreter->bytecode, &interpreter->count))) {
+					return;
+				}
+				interpreter->assignDepth = 0;
+			break;
+
+			case TOY_OP_INDEX_GET:
+				if (!execIndexGet(interpreter)) {
+					return;
+				}
+			break;
+
+			case TOY_OP_INDEX_SET:
+				if (!execIndexSet(interpreter)) {
 					return;
 				}
-				intermediateAssignDepth = 0;
 			break;
 
 			case TOY_OP_POP_STACK:
@@ -2161,11 +3856,488 @@ static void execInterpreter(Toy_Interpreter* interpreter) {
 
 		opcode = readByte(interpreter->bytecode, &interpreter->count);
 	}
+
+	//the end of the code, or a panic, ends every grouping at once
+	finishFrame(interpreter);
+}
+
+//every instruction with a handler as a named function, with it's operands decoded - see toy_instructions.h
+bool Toy_instAssert(Toy_Interpreter* interpreter) {
+	return execAssert(interpreter);
+}
+
+bool Toy_instPrint(Toy_Interpreter* interpreter) {
+	return execPrint(interpreter);
+}
+
+bool Toy_instPushLiteral(Toy_Interpreter* interpreter, int index) {
+	return execPushLiteralAt(interpreter, index);
+}
+
+bool Toy_instRawLiteral(Toy_Interpreter* interpreter) {
+	return rawLiteral(interpreter);
+}
+
+bool Toy_instBuiltin(Toy_Interpreter* interpreter, int index, int identifierIndex) {
+	return execBuiltinAt(interpreter, index, identifierIndex);
+}
+
+bool Toy_instNegate(Toy_Interpreter* interpreter) {
+	return execNegate(interpreter);
+}
+
+bool Toy_instArithmetic(Toy_Interpreter* interpreter, Toy_Opcode opcode) {
+	return execArithmetic(interpreter, opcode);
+}
+
+bool Toy_instArithmeticInt(Toy_Interpreter* interpreter, Toy_Opcode opcode) {
+	return execArithmeticInt(interpreter, opcode);
+}
+
+bool Toy_instArithmeticFloat(Toy_Interpreter* interpreter, Toy_Opcode opcode) {
+	return execArithmeticFloat(interpreter, opcode);
+}
+
+bool Toy_instCompoundAssign(Toy_Interpreter* interpreter, Toy_Opcode opcode) {
+	return execVarCompoundAssign(interpreter, opcode);
+}
+
+bool Toy_instArithmeticAssignLiterals(Toy_Interpreter* interpreter, Toy_Opcode opcode, int lhsIndex, int firstIndex, int secondIndex) {
+	return execVarArithmeticAssignLiteralsAt(interpreter, opcode, lhsIndex, firstIndex, secondIndex);
+}
+
+bool Toy_instPushScope(Toy_Interpreter* interpreter) {
+	interpreter->scope = Toy_pushScope(interpreter->scope);
+	return true;
+}
+
+bool Toy_instPopScope(Toy_Interpreter* interpreter) {
+	interpreter->scope = Toy_popScope(interpreter->scope);
+	return true;
+}
+
+bool Toy_instVarDecl(Toy_Interpreter* interpreter, int identifierIndex, int typeIndex) {
+	return execVarDeclAt(interpreter, identifierIndex, typeIndex);
+}
+
+bool Toy_instFnDecl(Toy_Interpreter* interpreter, int identifierIndex, int functionIndex) {
+	return execFnDeclAt(interpreter, identifierIndex, functionIndex);
+}
+
+bool Toy_instVarAssign(Toy_Interpreter* interpreter) {
+	return execVarAssign(interpreter);
+}
+
+bool Toy_instTypeCast(Toy_Interpreter* interpreter) {
+	return execValCast(interpreter);
+}
+
+bool Toy_instTypeOf(Toy_Interpreter* interpreter) {
+	return execTypeOf(interpreter);
+}
+
+bool Toy_instCompareEqual(Toy_Interpreter* interpreter, bool invert) {
+	return execCompareEqual(interpreter, invert);
+}
+
+bool Toy_instCompareLess(Toy_Interpreter* interpreter, bool invert) {
+	return execCompareLess(interpreter, invert);
+}
+
+bool Toy_instCompareLessEqual(Toy_Interpreter* interpreter, bool invert) {
+	return execCompareLessEqual(interpreter, invert);
+}
+
+bool Toy_instCompareInt(Toy_Interpreter* interpreter, Toy_Opcode opcode) {
+	return execCompareInt(interpreter, opcode);
+}
+
+bool Toy_instInvert(Toy_Interpreter* interpreter) {
+	return execInvert(interpreter);
+}
+
+bool Toy_instAnd(Toy_Interpreter* interpreter) {
+	return execAnd(interpreter);
+}
+
+bool Toy_instOr(Toy_Interpreter* interpreter) {
+	return execOr(interpreter);
+}
+
+bool Toy_instFalseJump(Toy_Interpreter* interpreter, int target) {
+	return execFalseJumpTo(interpreter, target);
+}
+
+bool Toy_instCompareJump(Toy_Interpreter* interpreter, int target, Toy_Opcode comparison) {
+	return execCompareJumpTo(interpreter, target, comparison);
+}
+
+bool Toy_instFnCall(Toy_Interpreter* interpreter, bool looseFirstArgument) {
+	return execFnCall(interpreter, looseFirstArgument, false);
+}
+
+bool Toy_instTailCall(Toy_Interpreter* interpreter) {
+	return execFnCall(interpreter, false, true);
+}
+
+bool Toy_instFnReturn(Toy_Interpreter* interpreter) {
+	return execFnReturn(interpreter);
+}
+
+bool Toy_instIndex(Toy_Interpreter* interpreter) {
+	return execIndex(interpreter, false);
+}
+
+bool Toy_instIndexGet(Toy_Interpreter* interpreter) {
+	return execIndexGet(interpreter);
+}
+
+bool Toy_instIndexSet(Toy_Interpreter* interpreter, Toy_Opcode assignment) {
+	return execIndexSetAs(interpreter, (unsigned char)assignment);
+}
+
+bool Toy_instPopStack(Toy_Interpreter* interpreter) {
+	while (interpreter->stack.count > 0) {
+		Toy_freeLiteral(Toy_popLiteralArray(&interpreter->stack));
+	}
+	return true;
+}
+
+//every instruction with a handler, as (interpreter, argument) - for tools walking the bytecode, with count pointing at the operands
+#define INSTRUCTION(name, call) static bool name(Toy_Interpreter* interpreter, int argument) { return call; }
+
+INSTRUCTION(instAssert, Toy_instAssert(interpreter))
+INSTRUCTION(instPrint, Toy_instPrint(interpreter))
+INSTRUCTION(instPushLiteral, execPushLiteral(interpreter, argument))
+INSTRUCTION(instPushLiteralPair, execPushLiteral(interpreter, 1) && execPushLiteral(interpreter, 1))
+INSTRUCTION(instRawLiteral, Toy_instRawLiteral(interpreter))
+INSTRUCTION(instNegate, Toy_instNegate(interpreter))
+INSTRUCTION(instArithmetic, Toy_instArithmetic(interpreter, (Toy_Opcode)argument))
+INSTRUCTION(instCompoundAssign, Toy_instCompoundAssign(interpreter, (Toy_Opcode)argument))
+INSTRUCTION(instArithmeticAssignLiterals, execVarArithmeticAssignLiterals(interpreter))
+INSTRUCTION(instArithmeticInt, Toy_instArithmeticInt(interpreter, (Toy_Opcode)argument))
+INSTRUCTION(instArithmeticFloat, Toy_instArithmeticFloat(interpreter, (Toy_Opcode)argument))
+INSTRUCTION(instCompareInt, Toy_instCompareInt(interpreter, (Toy_Opcode)argument))
+INSTRUCTION(instPushScope, Toy_instPushScope(interpreter))
+INSTRUCTION(instPopScope, Toy_instPopScope(interpreter))
+INSTRUCTION(instVarDecl, execVarDecl(interpreter, argument))
+INSTRUCTION(instFnDecl, execFnDecl(interpreter, argument))
+INSTRUCTION(instVarAssign, Toy_instVarAssign(interpreter))
+INSTRUCTION(instValCast, Toy_instTypeCast(interpreter))
+INSTRUCTION(instTypeOf, Toy_instTypeOf(interpreter))
+INSTRUCTION(instCompareEqual, Toy_instCompareEqual(interpreter, argument))
+INSTRUCTION(instCompareLess, Toy_instCompareLess(interpreter, argument))
+INSTRUCTION(instCompareLessEqual, Toy_instCompareLessEqual(interpreter, argument))
+INSTRUCTION(instInvert, Toy_instInvert(interpreter))
+INSTRUCTION(instAnd, Toy_instAnd(interpreter))
+INSTRUCTION(instOr, Toy_instOr(interpreter))
+INSTRUCTION(instFalseJump, execFalseJump(interpreter, argument))
+INSTRUCTION(instCompareJump, execCompareJump(interpreter, argument))
+INSTRUCTION(instFnCall, Toy_instFnCall(interpreter, argument))
+INSTRUCTION(instTailCall, Toy_instTailCall(interpreter))
+INSTRUCTION(instBuiltin, execBuiltin(interpreter))
+INSTRUCTION(instFnReturn, Toy_instFnReturn(interpreter))
+INSTRUCTION(instIndex, Toy_instIndex(interpreter))
+INSTRUCTION(instIndexGet, Toy_instIndexGet(interpreter))
+INSTRUCTION(instIndexSet, execIndexSet(interpreter))
+INSTRUCTION(instPopStack, Toy_instPopStack(interpreter))
+
+#undef INSTRUCTION
+
+int Toy_lookupInstruction(unsigned char opcode, Toy_InstructionFn* handler, int* argument) {
+	*handler = NULL;
+	*argument = 0;
+
+	switch(opcode) {
+		//the caller handles these itself
+		case TOY_OP_EOF:
+		case TOY_OP_SECTION_END:
+		case TOY_OP_PASS:
+		case TOY_OP_GROUPING_BEGIN:
+		case TOY_OP_GROUPING_END:
+			return 0;
+
+		case TOY_OP_JUMP:
+			return 2;
+
+		case TOY_OP_JUMP_WIDE:
+			return 4;
+
+		//these can't be compiled - assignments through indexes carry state between instructions
+		case TOY_OP_IMPORT:
+		case TOY_OP_INDEX_ASSIGN_INTERMEDIATE:
+			return 0;
+
+		case TOY_OP_INDEX_ASSIGN:
+			return 1;
+
+		case TOY_OP_ASSERT:
+			*handler = instAssert;
+			return 0;
+
+		case TOY_OP_PRINT:
+			*handler = instPrint;
+			return 0;
+
+		case TOY_OP_LITERAL:
+			*handler = instPushLiteral;
+			*argument = 1;
+			return 1;
+
+		case TOY_OP_LITERAL_LONG:
+			*handler = instPushLiteral;
+			*argument = 2;
+			return 2;
+
+		case TOY_OP_LITERAL_WIDE:
+			*handler = instPushLiteral;
+			*argument = 4;
+			return 4;
+
+		case TOY_OP_LITERAL_PAIR:
+			*handler = instPushLiteralPair;
+			return 2;
+
+		case TOY_OP_LITERAL_RAW:
+			*handler = instRawLiteral;
+			return 0;
+
+		case TOY_OP_NEGATE:
+			*handler = instNegate;
+			return 0;
+
+		case TOY_OP_ADDITION:
+		case TOY_OP_SUBTRACTION:
+		case TOY_OP_MULTIPLICATION:
+		case TOY_OP_DIVISION:
+		case TOY_OP_MODULO:
+			*handler = instArithmetic;
+			*argument = opcode;
+			return 0;
+
+		case TOY_OP_VAR_ADDITION_ASSIGN:
+		case TOY_OP_VAR_SUBTRACTION_ASSIGN:
+		case TOY_OP_VAR_MULTIPLICATION_ASSIGN:
+		case TOY_OP_VAR_DIVISION_ASSIGN:
+		case TOY_OP_VAR_MODULO_ASSIGN:
+			*handler = instCompoundAssign;
+			*argument = opcode;
+			return 0;
+
+		case TOY_OP_VAR_ARITHMETIC_ASSIGN:
+			*handler = instArithmeticAssignLiterals;
+			return 4;
+
+		//quickened opcodes keep their guards, so the types seen so far can be compiled in
+		case TOY_OP_ADDITION_INT:
+		case TOY_OP_SUBTRACTION_INT:
+		case TOY_OP_MULTIPLICATION_INT:
+		case TOY_OP_DIVISION_INT:
+		case TOY_OP_MODULO_INT:
+			*handler = instArithmeticInt;
+			*argument = opcode;
+			return 0;
+
+		case TOY_OP_ADDITION_FLOAT:
+		case TOY_OP_SUBTRACTION_FLOAT:
+		case TOY_OP_MULTIPLICATION_FLOAT:
+		case TOY_OP_DIVISION_FLOAT:
+			*handler = instArithmeticFloat;
+			*argument = opcode;
+			return 0;
+
+		case TOY_OP_COMPARE_LESS_INT:
+		case TOY_OP_COMPARE_LESS_EQUAL_INT:
+		case TOY_OP_COMPARE_GREATER_INT:
+		case TOY_OP_COMPARE_GREATER_EQUAL_INT:
+			*handler = instCompareInt;
+			*argument = opcode;
+			return 0;
+
+		case TOY_OP_SCOPE_BEGIN:
+			*handler = instPushScope;
+			return 0;
+
+		case TOY_OP_SCOPE_END:
+			*handler = instPopScope;
+			return 0;
+
+		case TOY_OP_VAR_DECL:
+		case TOY_OP_VAR_DECL_LONG:
+		case TOY_OP_VAR_DECL_WIDE:
+			*handler = instVarDecl;
+			*argument = opcode == TOY_OP_VAR_DECL ? 1 : opcode == TOY_OP_VAR_DECL_LONG ? 2 : 4;
+			return *argument * 2;
+
+		case TOY_OP_FN_DECL:
+		case TOY_OP_FN_DECL_LONG:
+		case TOY_OP_FN_DECL_WIDE:
+			*handler = instFnDecl;
+			*argument = opcode == TOY_OP_FN_DECL ? 1 : opcode == TOY_OP_FN_DECL_LONG ? 2 : 4;
+			return *argument * 2;
+
+		case TOY_OP_VAR_ASSIGN:
+			*handler = instVarAssign;
+			return 0;
+
+		case TOY_OP_TYPE_CAST:
+			*handler = instValCast;
+			return 0;
+
+		case TOY_OP_TYPE_OF:
+			*handler = instTypeOf;
+			return 0;
+
+		case TOY_OP_COMPARE_EQUAL:
+		case TOY_OP_COMPARE_NOT_EQUAL:
+			*handler = instCompareEqual;
+			*argument = opcode == TOY_OP_COMPARE_NOT_EQUAL;
+			return 0;
+
+		case TOY_OP_COMPARE_LESS:
+		case TOY_OP_COMPARE_GREATER:
+			*handler = instCompareLess;
+			*argument = opcode == TOY_OP_COMPARE_GREATER;
+			return 0;
+
+		case TOY_OP_COMPARE_LESS_EQUAL:
+		case TOY_OP_COMPARE_GREATER_EQUAL:
+			*handler = instCompareLessEqual;
+			*argument = opcode == TOY_OP_COMPARE_GREATER_EQUAL;
+			return 0;
+
+		case TOY_OP_INVERT:
+			*handler = instInvert;
+			return 0;
+
+		case TOY_OP_AND:
+			*handler = instAnd;
+			return 0;
+
+		case TOY_OP_OR:
+			*handler = instOr;
+			return 0;
+
+		//these move count to the target when they jump
+		case TOY_OP_IF_FALSE_JUMP:
+		case TOY_OP_IF_FALSE_JUMP_WIDE:
+			*handler = instFalseJump;
+			*argument = opcode == TOY_OP_IF_FALSE_JUMP ? 2 : 4;
+			return *argument;
+
+		case TOY_OP_COMPARE_JUMP:
+		case TOY_OP_COMPARE_JUMP_WIDE:
+			*handler = instCompareJump;
+			*argument = opcode == TOY_OP_COMPARE_JUMP ? 2 : 4;
+			return *argument + 1;
+
+		case TOY_OP_FN_CALL:
+		case TOY_OP_DOT:
+			*handler = instFnCall;
+			*argument = opcode == TOY_OP_DOT; //compensate for the out-of-order arguments
+			return 0;
+
+		case TOY_OP_TAIL_CALL:
+			*handler = instTailCall;
+			return 0;
+
+		case TOY_OP_BUILTIN:
+			*handler = instBuiltin;
+			return 3;
+
+		//the count of returned values is unused, but still has to be skipped over
+		case TOY_OP_FN_RETURN:
+			*handler = instFnReturn;
+			return 2;
+
+		case TOY_OP_INDEX:
+			*handler = instIndex;
+			return 0;
+
+		case TOY_OP_INDEX_GET:
+			*handler = instIndexGet;
+			return 0;
+
+		case TOY_OP_INDEX_SET:
+			*handler = instIndexSet;
+			return 1;
+
+		case TOY_OP_POP_STACK:
+			*handler = instPopStack;
+			return 0;
+
+		default:
+			return -1;
+	}
+}
+
+void Toy_resumeInterpreter(Toy_Interpreter* interpreter, int levels) {
+	if (levels <= 0 || interpreter->panic) {
+		return;
+	}
+
+	//each level is a grouping the compiled code was within, unwound exactly as if it had been interpreted all along
+	resumeGroupings(interpreter, levels - 1);
+
+	if (interpreter->profile) {
+		Toy_breakOpcodeProfile(interpreter->profile);
+	}
+
+	runFrames(interpreter);
+}
+
+//start the body of a function - compiled ahead of time, compiled once it's hot, or interpreted - profiles only count what's interpreted
+static void execFunctionBody(Toy_Interpreter* interpreter) {
+	Toy_RefFunction* function = interpreter->function;
+
+	interpreter->codeStart = interpreter->count;
+
+	if (function->compiled != NULL) {
+		interpreter->engine = TOY_FRAME_COMPILED;
+		function->compiled(interpreter);
+		finishFrame(interpreter);
+		return;
+	}
+
+	interpreter->engine = TOY_FRAME_INTERPRETER;
+
+	if (interpreter->profile) {
+		Toy_breakOpcodeProfile(interpreter->profile);
+	}
 }
 
 static void readInterpreterSections(Toy_Interpreter* interpreter) {
+	//section table
+	while (interpreter->count % TOY_SECTION_ALIGNMENT != 0) {
+		interpreter->count++;
+	}
+
+	int sectionOffsets[TOY_SECTION_COUNT];
+	int sectionSizes[TOY_SECTION_COUNT];
+
+	//each entry is an offset and a size
+	if (interpreter->count > interpreter->length - TOY_SECTION_COUNT * 8) {
+		interpreter->errorOutput("[internal] Malformed bytecode section table\n");
+		interpreter->panic = true;
+		return;
+	}
+
+	for (int i = 0; i < TOY_SECTION_COUNT; i++) {
+		sectionOffsets[i] = readInt(interpreter->bytecode, &interpreter->count);
+		sectionSizes[i] = readInt(interpreter->bytecode, &interpreter->count);
+
+		//compared against what's left, so a large offset or size can't overflow
+		if (sectionOffsets[i] < interpreter->count || sectionOffsets[i] > interpreter->length || sectionSizes[i] < 0 || sectionSizes[i] > interpreter->length - sectionOffsets[i]) {
+			interpreter->errorOutput("[internal] Malformed bytecode section table\n");
+			interpreter->panic = true;
+			return;
+		}
+	}
+
 	//data section
-	const unsigned short literalCount = readShort(interpreter->bytecode, &interpreter->count);
+	interpreter->count = sectionOffsets[TOY_SECTION_LITERALS];
+	const int width = readByte(interpreter->bytecode, &interpreter->count);
+	const int literalCount = readIndex(interpreter->bytecode, &interpreter->count, width);
 
 #ifndef TOY_EXPORT
 	if (Toy_commandLine.verbose) {
@@ -2251,11 +4423,11 @@ static void readInterpreterSections(Toy_Interpreter* interpreter) {
 				Toy_LiteralArray* array = TOY_ALLOCATE(Toy_LiteralArray, 1);
 				Toy_initLiteralArray(array);
 
-				unsigned short length = readShort(interpreter->bytecode, &interpreter->count);
+				int length = readIndex(interpreter->bytecode, &interpreter->count, width);
 
 				//read each index, then unpack the value from the existing literal cache
 				for (int i = 0; i < length; i++) {
-					int index = readShort(interpreter->bytecode, &interpreter->count);
+					int index = readIndex(interpreter->bytecode, &interpreter->count, width);
 					Toy_pushLiteralArray(array, interpreter->literalCache.literals[index]);
 				}
 
@@ -2282,12 +4454,12 @@ static void readInterpreterSections(Toy_Interpreter* interpreter) {
 				Toy_LiteralDictionary* dictionary = TOY_ALLOCATE(Toy_LiteralDictionary, 1);
 				Toy_initLiteralDictionary(dictionary);
 
-				unsigned short length = readShort(interpreter->bytecode, &interpreter->count);
+				int length = readIndex(interpreter->bytecode, &interpreter->count, width);
 
 				//read each index, then unpack the value from the existing literal cache
 				for (int i = 0; i < length / 2; i++) {
-					int key = readShort(interpreter->bytecode, &interpreter->count);
-					int val = readShort(interpreter->bytecode, &interpreter->count);
+					int key = readIndex(interpreter->bytecode, &interpreter->count, width);
+					int val = readIndex(interpreter->bytecode, &interpreter->count, width);
 					Toy_setLiteralDictionary(dictionary, interpreter->literalCache.literals[key], interpreter->literalCache.literals[val]);
 				}
 
@@ -2311,7 +4483,7 @@ static void readInterpreterSections(Toy_Interpreter* interpreter) {
 
 			case TOY_LITERAL_FUNCTION: {
 				//read the index
-				unsigned short index = readShort(interpreter->bytecode, &interpreter->count);
+				int index = readIndex(interpreter->bytecode, &interpreter->count, width);
 				Toy_Literal literal = TOY_TO_INTEGER_LITERAL(index);
 
 				//change the type, to read it PROPERLY below
@@ -2375,14 +4547,14 @@ static void readInterpreterSections(Toy_Interpreter* interpreter) {
 
 				//if it's an array type
 				if (TOY_AS_TYPE(typeLiteral).typeOf == TOY_LITERAL_ARRAY) {
-					unsigned short vt = readShort(interpreter->bytecode, &interpreter->count);
+					int vt = readIndex(interpreter->bytecode, &interpreter->count, width);
 
 					TOY_TYPE_PUSH_SUBTYPE(&typeLiteral, Toy_copyLiteral(interpreter->literalCache.literals[vt]));
 				}
 
 				if (TOY_AS_TYPE(typeLiteral).typeOf == TOY_LITERAL_DICTIONARY) {
-					unsigned short kt = readShort(interpreter->bytecode, &interpreter->count);
-					unsigned short vt = readShort(interpreter->bytecode, &interpreter->count);
+					int kt = readIndex(interpreter->bytecode, &interpreter->count, width);
+					int vt = readIndex(interpreter->bytecode, &interpreter->count, width);
 
 					TOY_TYPE_PUSH_SUBTYPE(&typeLiteral, Toy_copyLiteral(interpreter->literalCache.literals[kt]));
 					TOY_TYPE_PUSH_SUBTYPE(&typeLiteral, Toy_copyLiteral(interpreter->literalCache.literals[vt]));
@@ -2418,34 +4590,45 @@ static void readInterpreterSections(Toy_Interpreter* interpreter) {
 
 	consumeByte(interpreter, TOY_OP_SECTION_END, interpreter->bytecode, &interpreter->count); //terminate the literal section
 
-	//read the function metadata
-	int functionCount = readShort(interpreter->bytecode, &interpreter->count);
-	int functionSize = readShort(interpreter->bytecode, &interpreter->count); //might not be needed
-
-	//read in the functions
-	for (int i = 0; i < interpreter->literalCache.count; i++) {
-		if (interpreter->literalCache.literals[i].type == TOY_LITERAL_FUNCTION_INTERMEDIATE) {
-			//get the size of the function
-			size_t size = (size_t)readShort(interpreter->bytecode, &interpreter->count);
-
-			//read the function code (literal cache and all)
-			unsigned char* bytes = TOY_ALLOCATE(unsigned char, size);
-			memcpy(bytes, interpreter->bytecode + interpreter->count, size); //TODO: -1 for the ending mark
-			interpreter->count += size;
-
-			//assert that the last memory slot is function end
-			if (bytes[size - 1] != TOY_OP_FN_END) {
-				interpreter->errorOutput("[internal] Failed to find function end");
-				TOY_FREE_ARRAY(unsigned char, bytes, size);
-				return;
-			}
+	//the functions are left intermediate, and only read when they're declared
+	interpreter->functionIndex = sectionOffsets[TOY_SECTION_FUNCTION_INDEX];
+	interpreter->functionCount = sectionSizes[TOY_SECTION_FUNCTION_INDEX] / 8;
 
-			//change the type to normal
-			interpreter->literalCache.literals[i] = TOY_TO_FUNCTION_LITERAL(bytes, size);
-		}
+	//jump to the code section
+	interpreter->count = sectionOffsets[TOY_SECTION_CODE];
+}
+
+static bool readFunctionLiteral(Toy_Interpreter* interpreter, int literalIndex) {
+	int fnIndex = TOY_AS_INTEGER(interpreter->literalCache.literals[literalIndex]);
+
+	if (fnIndex < 0 || fnIndex >= interpreter->functionCount) {
+		interpreter->errorOutput("[internal] Function index out of range\n");
+		return false;
+	}
+
+	//look up the function body in the index
+	int indexCount = interpreter->functionIndex + fnIndex * 8;
+	int offset = readInt(interpreter->bytecode, &indexCount);
+	int size = readInt(interpreter->bytecode, &indexCount);
+
+	if (offset < 0 || size <= 0 || offset + size > interpreter->length) {
+		interpreter->errorOutput("[internal] Function body out of range\n");
+		return false;
+	}
+
+	//the function code (literal cache and all) is read in place - from the original, as a quickened copy only lives as long as its own function
+	const unsigned char* bytes = (interpreter->function != NULL ? interpreter->function->data : interpreter->bytecode) + offset;
+
+	//assert that the last memory slot is function end
+	if (bytes[size - 1] != TOY_OP_FN_END) {
+		interpreter->errorOutput("[internal] Failed to find function end\n");
+		return false;
 	}
 
-	consumeByte(interpreter, TOY_OP_SECTION_END, interpreter->bytecode, &interpreter->count); //terminate the function section
+	//change the type to normal
+	interpreter->literalCache.literals[literalIndex] = TOY_TO_FUNCTION_LITERAL(Toy_createRefFunction(interpreter->source, bytes, size), size);
+
+	return true;
 }
 
 //exposed functions
@@ -2459,32 +4642,70 @@ void Toy_initInterpreter(Toy_Interpreter* interpreter) {
 	Toy_setInterpreterError(interpreter, errorWrapper);
 
 	interpreter->scope = NULL;
+	interpreter->source = NULL;
+	interpreter->profile = NULL;
+	interpreter->calls = NULL;
+	interpreter->callMemory = TOY_CALL_MEMORY;
+	interpreter->depth = 0;
+	interpreter->engine = TOY_FRAME_FINISHED;
+	Toy_initLiteralArray(&interpreter->stack); //natives called by the host leave their results here
+	Toy_initScopeCache(&interpreter->scopeCache);
 	Toy_resetInterpreter(interpreter);
 }
 
 void Toy_runInterpreter(Toy_Interpreter* interpreter, const unsigned char* bytecode, size_t length) {
+	if (!bytecode) {
+		interpreter->errorOutput("No valid bytecode given\n");
+		return;
+	}
+
+	//the buffer is released once neither the interpreter nor any function read from it need it
+	Toy_RefBytecode* source = Toy_createRefBytecode(bytecode, length, Toy_releaseOwnedBytecode);
+	Toy_runInterpreterShared(interpreter, source);
+	Toy_deleteRefBytecode(source);
+}
+
+void Toy_runInterpreterShared(Toy_Interpreter* interpreter, Toy_RefBytecode* source) {
 	//initialize here instead of initInterpreter()
 	Toy_initLiteralArray(&interpreter->literalCache);
 	interpreter->bytecode = NULL;
 	interpreter->length = 0;
 	interpreter->count = 0;
 	interpreter->codeStart = -1;
+	interpreter->functionIndex = 0;
+	interpreter->functionCount = 0;
+	interpreter->function = NULL;
 
 	Toy_initLiteralArray(&interpreter->stack);
+	Toy_initScopeCache(&interpreter->scopeCache);
 
 	interpreter->depth = 0;
 	interpreter->panic = false;
 
-	//prep the bytecode
-	interpreter->bytecode = bytecode;
-	interpreter->length = length;
-	interpreter->count = 0;
-
-	if (!interpreter->bytecode) {
+	//the outermost frame, which calls return to
+	interpreter->engine = TOY_FRAME_INTERPRETER;
+	interpreter->suspended = false;
+	interpreter->groupings = 0;
+	interpreter->assignDepth = 0;
+	interpreter->caller = NULL;
+	interpreter->returnRegister = -1;
+	interpreter->callee = TOY_TO_NULL_LITERAL;
+	interpreter->calleeName = TOY_TO_NULL_LITERAL;
+	interpreter->returnTypes = NULL;
+	Toy_initLiteralArray(&interpreter->tailTypes);
+	initFrameBuffers(interpreter);
+
+	if (!source || !source->data) {
 		interpreter->errorOutput("No valid bytecode given\n");
 		return;
 	}
 
+	//prep the bytecode
+	interpreter->source = Toy_copyRefBytecode(source);
+	interpreter->bytecode = source->data;
+	interpreter->length = source->length;
+	interpreter->count = 0;
+
 	//prep the literal cache
 	if (interpreter->literalCache.count > 0) {
 		Toy_freeLiteralArray(&interpreter->literalCache); //automatically inits
@@ -2495,10 +4716,12 @@ void Toy_runInterpreter(Toy_Interpreter* interpreter, const unsigned char* bytec
 	const unsigned char minor = readByte(interpreter->bytecode, &interpreter->count);
 	const unsigned char patch = readByte(interpreter->bytecode, &interpreter->count);
 
-	if (major != TOY_VERSION_MAJOR || minor > TOY_VERSION_MINOR) {
+	if (major != TOY_VERSION_MAJOR || minor > TOY_VERSION_MINOR || minor < TOY_VERSION_MINOR_MINIMUM) {
 		char buffer[TOY_MAX_STRING_LENGTH];
-		snprintf(buffer, TOY_MAX_STRING_LENGTH, "Interpreter/bytecode version mismatch (expected %d.%d.%d or earlier, given %d.%d.%d)\n", TOY_VERSION_MAJOR, TOY_VERSION_MINOR, TOY_VERSION_PATCH, major, minor, patch);
+		snprintf(buffer, TOY_MAX_STRING_LENGTH, "Interpreter/bytecode version mismatch (expected %d.%d.0 to %d.%d.%d, given %d.%d.%d)\n", TOY_VERSION_MAJOR, TOY_VERSION_MINOR_MINIMUM, TOY_VERSION_MAJOR, TOY_VERSION_MINOR, TOY_VERSION_PATCH, major, minor, patch);
 		interpreter->errorOutput(buffer);
+		Toy_deleteRefBytecode(interpreter->source);
+		interpreter->source = NULL;
 		return;
 	}
 
@@ -2517,6 +4740,14 @@ void Toy_runInterpreter(Toy_Interpreter* interpreter, const unsigned char* bytec
 	//read the sections of the bytecode
 	readInterpreterSections(interpreter);
 
+	if (interpreter->panic) {
+		Toy_freeLiteralArray(&interpreter->literalCache);
+		Toy_freeLiteralArray(&interpreter->stack);
+		Toy_deleteRefBytecode(interpreter->source);
+		interpreter->source = NULL;
+		return;
+	}
+
 	//code section
 #ifndef TOY_EXPORT
 	if (Toy_commandLine.verbose) {
@@ -2524,8 +4755,23 @@ void Toy_runInterpreter(Toy_Interpreter* interpreter, const unsigned char* bytec
 	}
 #endif
 
-	//execute the interpreter
-	execInterpreter(interpreter);
+	//execute the code, unless it was compiled ahead of time
+	Toy_CompiledFn compiled = Toy_findCompiledBody(interpreter->source, interpreter->bytecode + interpreter->count);
+
+	if (compiled != NULL) {
+		interpreter->codeStart = interpreter->count;
+		interpreter->engine = TOY_FRAME_COMPILED;
+		compiled(interpreter);
+	}
+	else {
+		if (interpreter->profile) {
+			Toy_breakOpcodeProfile(interpreter->profile);
+		}
+
+		runFrames(interpreter);
+	}
+
+	interpreter->engine = TOY_FRAME_FINISHED;
 
 	//BUGFIX: clear the stack (for repl - stack must be balanced)
 	while(interpreter->stack.count > 0) {
@@ -2533,12 +4779,15 @@ void Toy_runInterpreter(Toy_Interpreter* interpreter, const unsigned char* bytec
 		Toy_freeLiteral(lit);
 	}
 
-	//free the bytecode immediately after use TODO: because why?
-	TOY_FREE_ARRAY(unsigned char, interpreter->bytecode, interpreter->length);
-
 	//free the associated data
 	Toy_freeLiteralArray(&interpreter->literalCache);
 	Toy_freeLiteralArray(&interpreter->stack);
+	freeFrameBuffers(interpreter);
+
+	//drop this interpreter's reference to the bytecode - any functions still alive hold their own
+	Toy_deleteRefBytecode(interpreter->source);
+	interpreter->source = NULL;
+	interpreter->bytecode = NULL;
 }
 
 void Toy_resetInterpreter(Toy_Interpreter* interpreter) {
@@ -2551,12 +4800,9 @@ void Toy_resetInterpreter(Toy_Interpreter* interpreter) {
 	interpreter->scope = Toy_pushScope(NULL);
 
 	//globally available functions
-	Toy_injectNativeFn(interpreter, "set", Toy_private_set);
-	Toy_injectNativeFn(interpreter, "get", Toy_private_get);
-	Toy_injectNativeFn(interpreter, "push", Toy_private_push);
-	Toy_injectNativeFn(interpreter, "pop", Toy_private_pop);
-	Toy_injectNativeFn(interpreter, "length", Toy_private_length);
-	Toy_injectNativeFn(interpreter, "clear", Toy_private_clear);
+	for (int i = 0; i < TOY_BUILTIN_COUNT; i++) {
+		Toy_injectNativeViewFn(interpreter, Toy_private_builtins[i].name, Toy_private_builtins[i].fn);
+	}
 }
 
 void Toy_freeInterpreter(Toy_Interpreter* interpreter) {
@@ -2570,5 +4816,13 @@ void Toy_freeInterpreter(Toy_Interpreter* interpreter) {
 		TOY_FREE(Toy_LiteralDictionary, interpreter->hooks);
 	}
 
+	if (interpreter->calls) {
+		freeCallStack(interpreter->calls);
+		TOY_FREE(Toy_CallStack, interpreter->calls);
+	}
+
+	Toy_freeLiteralArray(&interpreter->stack);
+
 	interpreter->hooks = NULL;
+	interpreter->calls = NULL;
 }
@@ -5,6 +5,41 @@
 #include "toy_literal_array.h"
 #include "toy_literal_dictionary.h"
 #include "toy_scope.h"
+#include "toy_opcode_profile.h"
+
+#include <stdint.h>
+
+//calls made by bytecode don't nest on the C stack - each is a frame in an array, run by a loop, so the memory set aside for the frames limits how deep they can go
+#define TOY_CALL_MEMORY (8 * 1024 * 1024)
+
+//calls made from C (natives calling back, the host program, and code compiled ahead of time) still nest on the C stack, so they're limited separately
+#if defined(_WIN32)
+#define TOY_CALL_NESTING 256
+#else
+#define TOY_CALL_NESTING 1024
+#endif
+
+//the frames of every call made from an interpreter, kept between calls so each depth is only allocated once
+typedef struct Toy_CallStack {
+	struct Toy_Interpreter** frames; //indexed by depth
+	int capacity;
+	int nesting; //how many loops over the frames are running on the C stack
+
+	//a call in tail position, made in place of the function making it once that has returned
+	bool tailPending;
+	Toy_Literal tailFunction;
+	Toy_Literal tailName;
+	Toy_LiteralArray tailArguments;
+} Toy_CallStack;
+
+//what runs the code of a frame, and so how it's resumed once a call it made has returned
+typedef enum Toy_FrameEngine {
+	TOY_FRAME_START, //a function that hasn't begun
+	TOY_FRAME_INTERPRETER,
+	TOY_FRAME_REGISTERS,
+	TOY_FRAME_COMPILED, //compiled ahead of time, so calls from it nest on the C stack
+	TOY_FRAME_FINISHED,
+} Toy_FrameEngine;
 
 //the interpreter acts depending on the bytecode instructions
 typedef struct Toy_Interpreter {
@@ -14,9 +49,14 @@ typedef struct Toy_Interpreter {
 	int count;
 	int codeStart; //BUGFIX: for jumps, must be initialized to -1
 	Toy_LiteralArray literalCache; //read-only - built from the bytecode, refreshed each time new bytecode is provided
+	Toy_RefBytecode* source; //the shared buffer that bytecode points into - functions read from it keep it alive
+	int functionIndex; //where the function index section begins - bodies are read on declaration
+	int functionCount;
+	Toy_RefFunction* function; //the function being run, if any - its bytecode is a private copy, so opcodes can be quickened in place
 
 	//operation
 	Toy_Scope* scope;
+	Toy_ScopeCache scopeCache; //where recent lookups were resolved
 	Toy_LiteralArray stack;
 
 	//Library APIs
@@ -27,17 +67,48 @@ typedef struct Toy_Interpreter {
 	Toy_PrintFn assertOutput;
 	Toy_PrintFn errorOutput;
 
+	Toy_OpcodeProfile* profile; //optional, counts the opcodes executed
+
+	Toy_CallStack* calls; //shared by every call made from here, and owned by the outermost interpreter
+	size_t callMemory; //how much memory the frames of calls may use, which limits how deep they can go
 	int depth; //don't overflow
 	bool panic;
+
+	//the state of a frame, kept while a call it made is run in the next one
+	Toy_FrameEngine engine;
+	bool suspended; //stopped for a call
+	int groupings; //how many groupings the interpreter is within
+	int assignDepth; //intermediate index assignments within the current grouping
+	int* assignDepths; //and within each grouping outside of it
+	int assignCapacity;
+	Toy_Literal* registers; //the register engine's frame, kept for the next call at this depth
+	int registerCount;
+	int registerCapacity;
+	int pc; //where the register code resumes
+
+	//the call being run in this frame
+	struct Toy_Interpreter* caller;
+	int returnRegister; //where the caller wants the result, or -1 for it's stack
+	Toy_Literal callee;
+	Toy_Literal calleeName;
+	Toy_LiteralArray* returnTypes; //read from the function, or NULL
+	Toy_LiteralArray tailTypes; //those of any typed functions this call replaced, as the result is checked against them too
 } Toy_Interpreter;
 
 //native API
 TOY_API bool Toy_injectNativeFn(Toy_Interpreter* interpreter, const char* name, Toy_NativeFn func);
+TOY_API bool Toy_injectNativeViewFn(Toy_Interpreter* interpreter, const char* name, Toy_NativeViewFn func); //called with the arguments where they are on the stack
 TOY_API bool Toy_injectNativeHook(Toy_Interpreter* interpreter, const char* name, Toy_HookFn hook);
 
 TOY_API bool Toy_callLiteralFn(Toy_Interpreter* interpreter, Toy_Literal func, Toy_LiteralArray* arguments, Toy_LiteralArray* returns);
 TOY_API bool Toy_callFn(Toy_Interpreter* interpreter, const char* name, Toy_LiteralArray* arguments, Toy_LiteralArray* returns);
 
+//instructions, for tools walking the bytecode - count must point at the operands when a handler is called (see toy_instructions.h for code generated ahead of time)
+typedef bool (*Toy_InstructionFn)(Toy_Interpreter* interpreter, int argument);
+
+TOY_API int Toy_lookupInstruction(unsigned char opcode, Toy_InstructionFn* handler, int* argument); //returns the operand length, or -1 if unknown - handler is NULL if the caller must handle it
+TOY_API void Toy_resumeInterpreter(Toy_Interpreter* interpreter, int levels); //interpret the rest of the code, unwinding this many groupings
+
 //utilities for the host program
 TOY_API bool Toy_parseIdentifierToValue(Toy_Interpreter* interpreter, Toy_Literal* literalPtr);
 TOY_API void Toy_setInterpreterPrint(Toy_Interpreter* interpreter, Toy_PrintFn printOutput);
@@ -46,6 +117,7 @@ TOY_API void Toy_setInterpreterError(Toy_Interpreter* interpreter, Toy_PrintFn e
 
 //main access
 TOY_API void Toy_initInterpreter(Toy_Interpreter* interpreter); //start of program
-TOY_API void Toy_runInterpreter(Toy_Interpreter* interpreter, const unsigned char* bytecode, size_t length); //run the code
+TOY_API void Toy_runInterpreter(Toy_Interpreter* interpreter, const unsigned char* bytecode, size_t length); //run the code, taking ownership of the bytecode
+TOY_API void Toy_runInterpreterShared(Toy_Interpreter* interpreter, Toy_RefBytecode* source); //run the code in place, without taking ownership of the buffer
 TOY_API void Toy_resetInterpreter(Toy_Interpreter* interpreter); //use this to reset the interpreter's environment between runs
 TOY_API void Toy_freeInterpreter(Toy_Interpreter* interpreter); //end of program
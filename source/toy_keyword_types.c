@@ -64,14 +64,103 @@ char* Toy_findKeywordByType(Toy_TokenType type) {
 	return NULL;
 }
 
-Toy_TokenType Toy_findTypeByKeyword(const char* keyword) {
-	const int length = strlen(keyword);
+//compare the rest of a candidate keyword, once the length & first character are known
+static Toy_TokenType checkKeyword(const char* keyword, int length, const char* rest, Toy_TokenType type) {
+	return memcmp(keyword + 1, rest, length - 1) == 0 ? type : TOY_TOKEN_EOF;
+}
 
-	for (int i = 0; Toy_keywordTypes[i].keyword; i++) {
-		if (!strncmp(keyword, Toy_keywordTypes[i].keyword, length)) {
-			return Toy_keywordTypes[i].type;
-		}
+//this switch mirrors Toy_keywordTypes above - update both together
+Toy_TokenType Toy_findTypeByKeywordLength(const char* keyword, int length) {
+	switch(length) {
+		case 2:
+			switch(keyword[0]) {
+				case 'a': return checkKeyword(keyword, length, "s", TOY_TOKEN_AS);
+				case 'd': return checkKeyword(keyword, length, "o", TOY_TOKEN_DO);
+				case 'f': return checkKeyword(keyword, length, "n", TOY_TOKEN_FUNCTION);
+				case 'i':
+					switch(keyword[1]) {
+						case 'f': return TOY_TOKEN_IF;
+						case 'n': return TOY_TOKEN_IN;
+					}
+					break;
+				case 'o': return checkKeyword(keyword, length, "f", TOY_TOKEN_OF);
+			}
+			break;
+
+		case 3:
+			switch(keyword[0]) {
+				case 'a': return checkKeyword(keyword, length, "ny", TOY_TOKEN_ANY);
+				case 'f': return checkKeyword(keyword, length, "or", TOY_TOKEN_FOR);
+				case 'i': return checkKeyword(keyword, length, "nt", TOY_TOKEN_INTEGER);
+				case 'v': return checkKeyword(keyword, length, "ar", TOY_TOKEN_VAR);
+			}
+			break;
+
+		case 4:
+			switch(keyword[0]) {
+				case 'b': return checkKeyword(keyword, length, "ool", TOY_TOKEN_BOOLEAN);
+				case 'e': return checkKeyword(keyword, length, "lse", TOY_TOKEN_ELSE);
+				case 'n': return checkKeyword(keyword, length, "ull", TOY_TOKEN_NULL);
+				case 't':
+					switch(keyword[1]) {
+						case 'r': return checkKeyword(keyword, length, "rue", TOY_TOKEN_LITERAL_TRUE);
+						case 'y': return checkKeyword(keyword, length, "ype", TOY_TOKEN_TYPE);
+					}
+					break;
+			}
+			break;
+
+		case 5:
+			switch(keyword[0]) {
+				case 'b': return checkKeyword(keyword, length, "reak", TOY_TOKEN_BREAK);
+				case 'c':
+					switch(keyword[1]) {
+						case 'l': return checkKeyword(keyword, length, "lass", TOY_TOKEN_CLASS);
+						case 'o': return checkKeyword(keyword, length, "onst", TOY_TOKEN_CONST);
+					}
+					break;
+				case 'f':
+					switch(keyword[1]) {
+						case 'a': return checkKeyword(keyword, length, "alse", TOY_TOKEN_LITERAL_FALSE);
+						case 'l': return checkKeyword(keyword, length, "loat", TOY_TOKEN_FLOAT);
+					}
+					break;
+				case 'p': return checkKeyword(keyword, length, "rint", TOY_TOKEN_PRINT);
+				case 'w': return checkKeyword(keyword, length, "hile", TOY_TOKEN_WHILE);
+			}
+			break;
+
+		case 6:
+			switch(keyword[0]) {
+				case 'a':
+					switch(keyword[1]) {
+						case 's':
+							switch(keyword[2]) {
+								case 's': return checkKeyword(keyword, length, "ssert", TOY_TOKEN_ASSERT);
+								case 't': return checkKeyword(keyword, length, "stype", TOY_TOKEN_ASTYPE);
+							}
+							break;
+					}
+					break;
+				case 'e': return checkKeyword(keyword, length, "xport", TOY_TOKEN_EXPORT);
+				case 'i': return checkKeyword(keyword, length, "mport", TOY_TOKEN_IMPORT);
+				case 'o': return checkKeyword(keyword, length, "paque", TOY_TOKEN_OPAQUE);
+				case 'r': return checkKeyword(keyword, length, "eturn", TOY_TOKEN_RETURN);
+				case 's': return checkKeyword(keyword, length, "tring", TOY_TOKEN_STRING);
+				case 't': return checkKeyword(keyword, length, "ypeof", TOY_TOKEN_TYPEOF);
+			}
+			break;
+
+		case 7:
+			return keyword[0] == 'f' ? checkKeyword(keyword, length, "oreach", TOY_TOKEN_FOREACH) : TOY_TOKEN_EOF;
+
+		case 8:
+			return keyword[0] == 'c' ? checkKeyword(keyword, length, "ontinue", TOY_TOKEN_CONTINUE) : TOY_TOKEN_EOF;
 	}
 
 	return TOY_TOKEN_EOF;
 }
+
+Toy_TokenType Toy_findTypeByKeyword(const char* keyword) {
+	return Toy_findTypeByKeywordLength(keyword, strlen(keyword));
+}
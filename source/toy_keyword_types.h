@@ -12,3 +12,6 @@ extern Toy_KeywordType Toy_keywordTypes[];
 char* Toy_findKeywordByType(Toy_TokenType type);
 
 Toy_TokenType Toy_findTypeByKeyword(const char* keyword);
+
+//for unterminated lexemes; returns TOY_TOKEN_EOF if it isn't a keyword
+Toy_TokenType Toy_findTypeByKeywordLength(const char* keyword, int length);
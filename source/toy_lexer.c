@@ -6,6 +6,42 @@
 #include <string.h>
 #include <ctype.h>
 
+enum {
+	CHAR_SPACE = 1,
+	CHAR_DIGIT = 2,
+	CHAR_ALPHA = 4,
+};
+
+//character classes, indexed by the character itself
+#define S CHAR_SPACE
+#define D CHAR_DIGIT
+#define A CHAR_ALPHA
+
+static const unsigned char charClasses[256] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, S, S, 0, 0, S, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	S, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	D, D, D, D, D, D, D, D, D, D, 0, 0, 0, 0, 0, 0,
+	0, A, A, A, A, A, A, A, A, A, A, A, A, A, A, A,
+	A, A, A, A, A, A, A, A, A, A, A, 0, 0, 0, 0, A,
+	0, A, A, A, A, A, A, A, A, A, A, A, A, A, A, A,
+	A, A, A, A, A, A, A, A, A, A, A, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+#undef S
+#undef D
+#undef A
+
+#define CHAR_CLASS(c) charClasses[(unsigned char)(c)]
+
 //static generic utility functions
 static void cleanLexer(Toy_Lexer* lexer) {
 	lexer->source = NULL;
@@ -42,58 +78,66 @@ static char advance(Toy_Lexer* lexer) {
 	return lexer->source[lexer->current - 1];
 }
 
-static void eatWhitespace(Toy_Lexer* lexer) {
-	const char c = peek(lexer);
+//count the lines in a span that's being skipped over
+static int countLines(const char* start, const char* end) {
+	int lines = 0;
 
-	switch(c) {
-		case ' ':
-		case '\r':
-		case '\n':
-		case '\t':
+	while ((start = memchr(start, '\n', end - start)) != NULL) {
+		lines++;
+		start++;
+	}
+
+	return lines;
+}
+
+static void eatWhitespace(Toy_Lexer* lexer) {
+	for (;;) {
+		//runs of whitespace
+		while (CHAR_CLASS(peek(lexer)) & CHAR_SPACE) {
 			advance(lexer);
-			break;
+		}
 
 		//comments
-		case '/':
-			if (!lexer->commentsEnabled) {
+		if (peek(lexer) != '/' || !lexer->commentsEnabled) {
+			return;
+		}
+
+		const char* cursor = &lexer->source[lexer->current];
+
+		//eat the line, newline included
+		if (peekNext(lexer) == '/') {
+			const char* newline = strchr(cursor, '\n');
+
+			if (newline == NULL) {
+				lexer->current += strlen(cursor);
 				return;
 			}
 
-			//eat the line
-			if (peekNext(lexer) == '/') {
-				while (!isAtEnd(lexer) && advance(lexer) != '\n');
-				break;
-			}
+			lexer->current += newline - cursor + 1;
+			lexer->line++;
+			continue;
+		}
 
-			//eat the block
-			if (peekNext(lexer) == '*') {
-				advance(lexer);
-				advance(lexer);
-				while(!isAtEnd(lexer) && !(peek(lexer) == '*' && peekNext(lexer) == '/')) advance(lexer);
-				advance(lexer);
-				advance(lexer);
-				break;
-			}
-		return;
+		//eat the block
+		if (peekNext(lexer) == '*') {
+			const char* close = strstr(cursor + 2, "*/");
+			const char* end = close != NULL ? close + 2 : cursor + strlen(cursor);
 
-		default:
-			return;
-	}
+			lexer->line += countLines(cursor, end);
+			lexer->current += end - cursor;
+			continue;
+		}
 
-	//tail recursion
-	eatWhitespace(lexer);
+		return;
+	}
 }
 
 static bool isDigit(Toy_Lexer* lexer) {
-	return peek(lexer) >= '0' && peek(lexer) <= '9';
+	return CHAR_CLASS(peek(lexer)) & CHAR_DIGIT;
 }
 
 static bool isAlpha(Toy_Lexer* lexer) {
-	return
-		(peek(lexer) >= 'A' && peek(lexer) <= 'Z') ||
-		(peek(lexer) >= 'a' && peek(lexer) <= 'z') ||
-		peek(lexer) == '_'
-	;
+	return CHAR_CLASS(peek(lexer)) & CHAR_ALPHA;
 }
 
 static bool match(Toy_Lexer* lexer, char c) {
@@ -231,29 +275,30 @@ static Toy_Token makeString(Toy_Lexer* lexer, char terminator) {
 static Toy_Token makeKeywordOrIdentifier(Toy_Lexer* lexer) {
 	advance(lexer); //first letter can only be alpha
 
-	while(isDigit(lexer) || isAlpha(lexer)) {
-		advance(lexer);
+	//identifiers never span lines, so skip the line counting in advance()
+	while (CHAR_CLASS(peek(lexer)) & (CHAR_ALPHA | CHAR_DIGIT)) {
+		lexer->current++;
 	}
 
 	//scan for a keyword
-	for (int i = 0; Toy_keywordTypes[i].keyword; i++) {
-		if (strlen(Toy_keywordTypes[i].keyword) == (long unsigned int)(lexer->current - lexer->start) && !strncmp(Toy_keywordTypes[i].keyword, &lexer->source[lexer->start], lexer->current - lexer->start)) {
-			Toy_Token token;
+	Toy_TokenType type = Toy_findTypeByKeywordLength(&lexer->source[lexer->start], lexer->current - lexer->start);
 
-			token.type = Toy_keywordTypes[i].type;
-			token.lexeme = &lexer->source[lexer->start];
-			token.length = lexer->current - lexer->start;
-			token.line = lexer->line;
+	if (type != TOY_TOKEN_EOF) {
+		Toy_Token token;
+
+		token.type = type;
+		token.lexeme = &lexer->source[lexer->start];
+		token.length = lexer->current - lexer->start;
+		token.line = lexer->line;
 
 #ifndef TOY_EXPORT
-			if (Toy_commandLine.verbose) {
-				printf("kwd:");
-				Toy_private_printToken(&token);
-			}
+		if (Toy_commandLine.verbose) {
+			printf("kwd:");
+			Toy_private_printToken(&token);
+		}
 #endif
 
-			return token;
-		}
+		return token;
 	}
 
 	//return an identifier
@@ -338,11 +383,9 @@ Toy_Token Toy_private_scanLexer(Toy_Lexer* lexer) {
 			return makeString(lexer, c);
 			//TODO: possibly support interpolated strings
 
-		default: {
-			char buffer[128];
-			snprintf(buffer, 128, "Unexpected token: %c", c);
-			return makeErrorToken(lexer, buffer);
-		}
+		default:
+			//the lexeme is the offending character, as a formatted message would outlive its buffer
+			return makeToken(lexer, TOY_TOKEN_ERROR);
 	}
 }
 
@@ -59,7 +59,7 @@ void Toy_freeLiteral(Toy_Literal literal) {
 	if (TOY_IS_FUNCTION(literal)) {
 		Toy_popScope(TOY_AS_FUNCTION(literal).scope);
 		TOY_AS_FUNCTION(literal).scope = NULL;
-		TOY_FREE_ARRAY(unsigned char, TOY_AS_FUNCTION(literal).inner.bytecode, TOY_AS_FUNCTION_BYTECODE_LENGTH(literal));
+		Toy_deleteRefFunction(TOY_AS_FUNCTION(literal).inner.ref);
 	}
 
 	if (TOY_IS_TYPE(literal) && TOY_AS_TYPE(literal).capacity > 0) {
@@ -146,18 +146,19 @@ Toy_Literal Toy_copyLiteral(Toy_Literal original) {
 		}
 
 		case TOY_LITERAL_FUNCTION: {
-			unsigned char* buffer = TOY_ALLOCATE(unsigned char, TOY_AS_FUNCTION_BYTECODE_LENGTH(original));
-			memcpy(buffer, TOY_AS_FUNCTION(original).inner.bytecode, TOY_AS_FUNCTION_BYTECODE_LENGTH(original));
-
-			Toy_Literal literal = TOY_TO_FUNCTION_LITERAL(buffer, TOY_AS_FUNCTION_BYTECODE_LENGTH(original));
+			//the body is read-only, so copies can share it
+			Toy_Literal literal = TOY_TO_FUNCTION_LITERAL(Toy_copyRefFunction(TOY_AS_FUNCTION(original).inner.ref), TOY_AS_FUNCTION_BYTECODE_LENGTH(original));
 			TOY_AS_FUNCTION(literal).scope = Toy_copyScope(TOY_AS_FUNCTION(original).scope);
 
 			return literal;
 		}
 
 		case TOY_LITERAL_IDENTIFIER: {
-			//NOTE: could optimise this by copying the hash manually, but it's a very small increase in performance
-			return TOY_TO_IDENTIFIER_LITERAL(Toy_copyRefString(TOY_AS_IDENTIFIER(original)));
+			//the hash is copied rather than recomputed, as identifiers are copied onto the stack constantly
+			Toy_Literal literal = original;
+			literal.as.identifier.ptr = Toy_copyRefString(TOY_AS_IDENTIFIER(original));
+
+			return literal;
 		}
 
 		case TOY_LITERAL_TYPE: {
@@ -384,7 +385,10 @@ int Toy_hashLiteral(Toy_Literal lit) {
 		case TOY_LITERAL_STRING:
 			return hashString(Toy_toCString(TOY_AS_STRING(lit)), Toy_lengthRefString(TOY_AS_STRING(lit)));
 
-		case TOY_LITERAL_ARRAY: {
+		case TOY_LITERAL_ARRAY:
+		case TOY_LITERAL_ARRAY_INTERMEDIATE:
+		case TOY_LITERAL_DICTIONARY_INTERMEDIATE:
+		case TOY_LITERAL_TYPE_INTERMEDIATE: { //intermediates are stored as arrays in the compiler
 			unsigned int res = 0;
 			for (int i = 0; i < TOY_AS_ARRAY(lit)->count; i++) {
 				res += Toy_hashLiteral(TOY_AS_ARRAY(lit)->literals[i]);
@@ -411,8 +415,15 @@ int Toy_hashLiteral(Toy_Literal lit) {
 		case TOY_LITERAL_IDENTIFIER:
 			return TOY_HASH_I(lit); //pre-computed
 
-		case TOY_LITERAL_TYPE:
-			return -1; //not much i can really do
+		case TOY_LITERAL_TYPE: {
+			unsigned int res = TOY_AS_TYPE(lit).typeOf * 2 + (TOY_AS_TYPE(lit).constant ? 1 : 0);
+			if (TOY_AS_TYPE(lit).typeOf == TOY_LITERAL_ARRAY || TOY_AS_TYPE(lit).typeOf == TOY_LITERAL_DICTIONARY) {
+				for (int i = 0; i < TOY_AS_TYPE(lit).count; i++) {
+					res = res * 31 + Toy_hashLiteral(((Toy_Literal*)(TOY_AS_TYPE(lit).subtypes))[i]);
+				}
+			}
+			return hashUInt(res);
+		}
 
 		case TOY_LITERAL_OPAQUE:
 		case TOY_LITERAL_ANY:
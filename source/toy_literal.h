@@ -3,6 +3,7 @@
 #include "toy_common.h"
 
 #include "toy_refstring.h"
+#include "toy_refbytecode.h"
 
 //forward delcare stuff
 struct Toy_Literal;
@@ -11,6 +12,7 @@ struct Toy_LiteralArray;
 struct Toy_LiteralDictionary;
 struct Toy_Scope;
 typedef int (*Toy_NativeFn)(struct Toy_Interpreter* interpreter, struct Toy_LiteralArray* arguments);
+typedef int (*Toy_NativeViewFn)(struct Toy_Interpreter* interpreter, struct Toy_Literal* arguments, int count); //the arguments are borrowed in place - read them before pushing to the stack, which can move them
 typedef int (*Toy_HookFn)(struct Toy_Interpreter* interpreter, struct Toy_Literal identifier, struct Toy_Literal alias);
 typedef void (*Toy_PrintFn)(const char*);
 
@@ -56,7 +58,9 @@ typedef struct Toy_Literal {
 		struct {
 			union {
 				void* bytecode;  //8
+				Toy_RefFunction* ref; //8 - the body, shared between copies
 				Toy_NativeFn native; //8
+				Toy_NativeViewFn view; //8
 				Toy_HookFn hook; //8
 			} inner;  //8
 			struct Toy_Scope* scope; //8
@@ -107,6 +111,7 @@ typedef struct Toy_Literal {
 #define TOY_AS_DICTIONARY(value)				((Toy_LiteralDictionary*)((value).as.dictionary))
 #define TOY_AS_FUNCTION(value)					((value).as.function)
 #define TOY_AS_FUNCTION_NATIVE(value)			((value).as.function.inner.native)
+#define TOY_AS_FUNCTION_NATIVE_VIEW(value)		((value).as.function.inner.view)
 #define TOY_AS_FUNCTION_HOOK(value)				((value).as.function.inner.hook)
 #define TOY_AS_IDENTIFIER(value)				((value).as.identifier.ptr)
 #define TOY_AS_TYPE(value)						((value).as.type)
@@ -119,8 +124,9 @@ typedef struct Toy_Literal {
 #define TOY_TO_STRING_LITERAL(value)			Toy_private_toStringLiteral(value)
 #define TOY_TO_ARRAY_LITERAL(value)				((Toy_Literal){{ .array = value }, TOY_LITERAL_ARRAY, 0})
 #define TOY_TO_DICTIONARY_LITERAL(value)		((Toy_Literal){{ .dictionary = value }, TOY_LITERAL_DICTIONARY, 0})
-#define TOY_TO_FUNCTION_LITERAL(value, l)		((Toy_Literal){{ .function = { .inner = { .bytecode = value }, .scope = NULL }}, TOY_LITERAL_FUNCTION, l})
+#define TOY_TO_FUNCTION_LITERAL(value, l)		((Toy_Literal){{ .function = { .inner = { .ref = value }, .scope = NULL }}, TOY_LITERAL_FUNCTION, l})
 #define TOY_TO_FUNCTION_NATIVE_LITERAL(value)	((Toy_Literal){{ .function = { .inner = { .native = value }, .scope = NULL }}, TOY_LITERAL_FUNCTION_NATIVE, 0})
+#define TOY_TO_FUNCTION_NATIVE_VIEW_LITERAL(value)	((Toy_Literal){{ .function = { .inner = { .view = value }, .scope = NULL }}, TOY_LITERAL_FUNCTION_NATIVE, TOY_NATIVE_VIEW})
 #define TOY_TO_FUNCTION_HOOK_LITERAL(value)		((Toy_Literal){{ .function = { .inner = { .hook = value }, .scope = NULL }}, TOY_LITERAL_FUNCTION_HOOK, 0})
 #define TOY_TO_IDENTIFIER_LITERAL(value)		Toy_private_toIdentifierLiteral(value)
 #define TOY_TO_TYPE_LITERAL(value, c)			((Toy_Literal){{ .type = { .typeOf = value, .constant = c, .subtypes = NULL, .capacity = 0, .count = 0 }}, TOY_LITERAL_TYPE, 0})
@@ -136,6 +142,10 @@ TOY_API void Toy_freeLiteral(Toy_Literal literal);
 
 #define TOY_AS_FUNCTION_BYTECODE_LENGTH(lit)	((lit).bytecodeLength)
 
+//natives share a type, so the calling convention of each is marked where functions keep their length
+#define TOY_NATIVE_VIEW							1
+#define TOY_IS_FUNCTION_NATIVE_VIEW(value)		(TOY_IS_FUNCTION_NATIVE(value) && (value).bytecodeLength == TOY_NATIVE_VIEW)
+
 #define TOY_MAX_STRING_LENGTH					4096
 #define TOY_HASH_I(lit)							((lit).as.identifier.hash)
 #define TOY_TYPE_PUSH_SUBTYPE(lit, subtype)		Toy_private_typePushSubtype(lit, subtype)
@@ -230,3 +230,9 @@ bool Toy_existsLiteralDictionary(Toy_LiteralDictionary* dictionary, Toy_Literal
 	Toy_private_dictionary_entry* entry = getEntryArray(dictionary->entries, dictionary->capacity, key, Toy_hashLiteral(key), false);
 	return entry != NULL && !(TOY_IS_NULL(entry->key) && TOY_IS_NULL(entry->value));
 }
+
+int Toy_findLiteralDictionary(Toy_LiteralDictionary* dictionary, Toy_Literal key) {
+	//an empty bucket ends the search
+	Toy_private_dictionary_entry* entry = getEntryArray(dictionary->entries, dictionary->capacity, key, Toy_hashLiteral(key), false);
+	return entry != NULL && !TOY_IS_NULL(entry->key) ? (int)(entry - dictionary->entries) : -1;
+}
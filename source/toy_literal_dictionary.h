@@ -27,3 +27,4 @@ TOY_API Toy_Literal Toy_getLiteralDictionary(Toy_LiteralDictionary* dictionary,
 TOY_API void Toy_removeLiteralDictionary(Toy_LiteralDictionary* dictionary, Toy_Literal key);
 
 TOY_API bool Toy_existsLiteralDictionary(Toy_LiteralDictionary* dictionary, Toy_Literal key);
+TOY_API int Toy_findLiteralDictionary(Toy_LiteralDictionary* dictionary, Toy_Literal key); //the index of key within entries, or -1 - entries can move when anything is added
@@ -0,0 +1,268 @@
+#include "toy_opcode_profile.h"
+
+#include "toy_memory.h"
+#include "toy_opcodes.h"
+
+#include <stdio.h>
+#include <string.h>
+
+//utils
+static unsigned int hashSequence(const unsigned char* opcodes, int length) {
+	//FNV-1a
+	unsigned int hash = 2166136261u;
+
+	for (int i = 0; i < length; i++) {
+		hash ^= opcodes[i];
+		hash *= 16777619u;
+	}
+
+	return hash ^ (unsigned int)length;
+}
+
+static Toy_OpcodeSequence* findSequence(Toy_OpcodeSequence* sequences, int capacity, const unsigned char* opcodes, int length) {
+	unsigned int index = hashSequence(opcodes, length) & (capacity - 1);
+
+	//capacity is always a power of 2, and never full
+	for (;;) {
+		Toy_OpcodeSequence* entry = &sequences[index];
+
+		if (entry->length == 0 || (entry->length == length && memcmp(entry->opcodes, opcodes, length) == 0)) {
+			return entry;
+		}
+
+		index = (index + 1) & (capacity - 1);
+	}
+}
+
+static void growProfile(Toy_OpcodeProfile* profile) {
+	int capacity = TOY_GROW_CAPACITY_FAST(profile->capacity);
+	Toy_OpcodeSequence* sequences = TOY_ALLOCATE(Toy_OpcodeSequence, capacity);
+	memset(sequences, 0, sizeof(Toy_OpcodeSequence) * capacity);
+
+	//rehash the existing entries
+	for (int i = 0; i < profile->capacity; i++) {
+		if (profile->sequences[i].length > 0) {
+			*findSequence(sequences, capacity, profile->sequences[i].opcodes, profile->sequences[i].length) = profile->sequences[i];
+		}
+	}
+
+	TOY_FREE_ARRAY(Toy_OpcodeSequence, profile->sequences, profile->capacity);
+	profile->sequences = sequences;
+	profile->capacity = capacity;
+}
+
+static void countSequence(Toy_OpcodeProfile* profile, const unsigned char* opcodes, int length) {
+	//keep the load under 75%
+	if ((profile->count + 1) * 4 > profile->capacity * 3) {
+		growProfile(profile);
+	}
+
+	Toy_OpcodeSequence* entry = findSequence(profile->sequences, profile->capacity, opcodes, length);
+
+	if (entry->length == 0) {
+		memcpy(entry->opcodes, opcodes, length);
+		entry->length = length;
+		entry->hits = 0;
+		profile->count++;
+	}
+
+	entry->hits++;
+}
+
+static bool endsSequence(unsigned char opcode) {
+	switch(opcode) {
+		case TOY_OP_GROUPING_BEGIN:
+		case TOY_OP_GROUPING_END:
+		case TOY_OP_JUMP:
+		case TOY_OP_IF_FALSE_JUMP:
+		case TOY_OP_JUMP_WIDE:
+		case TOY_OP_IF_FALSE_JUMP_WIDE:
+		case TOY_OP_COMPARE_JUMP:
+		case TOY_OP_COMPARE_JUMP_WIDE:
+		case TOY_OP_FN_CALL:
+		case TOY_OP_DOT:
+		case TOY_OP_FN_RETURN:
+		case TOY_OP_TAIL_CALL:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+//exposed functions
+void Toy_initOpcodeProfile(Toy_OpcodeProfile* profile) {
+	profile->sequences = NULL;
+	profile->capacity = 0;
+	profile->count = 0;
+	profile->windowLength = 0;
+}
+
+void Toy_freeOpcodeProfile(Toy_OpcodeProfile* profile) {
+	TOY_FREE_ARRAY(Toy_OpcodeSequence, profile->sequences, profile->capacity);
+	Toy_initOpcodeProfile(profile);
+}
+
+void Toy_recordOpcodeProfile(Toy_OpcodeProfile* profile, unsigned char opcode) {
+	//slide the window along
+	if (profile->windowLength == TOY_OPCODE_PROFILE_WINDOW) {
+		memmove(profile->window, profile->window + 1, TOY_OPCODE_PROFILE_WINDOW - 1);
+		profile->windowLength--;
+	}
+
+	profile->window[profile->windowLength++] = opcode;
+
+	//count each sequence that ends here, including the opcode alone
+	for (int length = 1; length <= profile->windowLength; length++) {
+		countSequence(profile, profile->window + profile->windowLength - length, length);
+	}
+
+	//anything after a change in control flow can't be fused with what came before
+	if (endsSequence(opcode)) {
+		Toy_breakOpcodeProfile(profile);
+	}
+}
+
+void Toy_breakOpcodeProfile(Toy_OpcodeProfile* profile) {
+	profile->windowLength = 0;
+}
+
+int Toy_rankOpcodeProfile(Toy_OpcodeProfile* profile, int length, Toy_OpcodeSequence* results, int limit) {
+	int found = 0;
+
+	//insertion sort into the results, most frequent first
+	for (int i = 0; i < profile->capacity; i++) {
+		Toy_OpcodeSequence* entry = &profile->sequences[i];
+
+		if (entry->length != length) {
+			continue;
+		}
+
+		int position = found < limit ? found++ : limit;
+
+		while (position > 0 && results[position - 1].hits < entry->hits) {
+			if (position < limit) {
+				results[position] = results[position - 1];
+			}
+			position--;
+		}
+
+		if (position < limit) {
+			results[position] = *entry;
+		}
+	}
+
+	return found;
+}
+
+void Toy_printOpcodeProfile(Toy_OpcodeProfile* profile, int limit, Toy_PrintFn printFn) {
+	Toy_OpcodeSequence* results = TOY_ALLOCATE(Toy_OpcodeSequence, limit);
+
+	for (int length = 2; length <= TOY_OPCODE_PROFILE_WINDOW; length++) {
+		char buffer[256];
+		snprintf(buffer, 256, "Most frequent sequences of %d opcodes:\n", length);
+		printFn(buffer);
+
+		int found = Toy_rankOpcodeProfile(profile, length, results, limit);
+
+		for (int i = 0; i < found; i++) {
+			int written = snprintf(buffer, 256, "%10d ", results[i].hits);
+
+			for (int j = 0; j < results[i].length && written < 256; j++) {
+				written += snprintf(buffer + written, 256 - written, " %s", Toy_getOpcodeName(results[i].opcodes[j]));
+			}
+
+			printFn(buffer);
+			printFn("\n");
+		}
+	}
+
+	TOY_FREE_ARRAY(Toy_OpcodeSequence, results, limit);
+}
+
+const char* Toy_getOpcodeName(unsigned char opcode) {
+	switch(opcode) {
+		case TOY_OP_EOF: return "EOF";
+		case TOY_OP_PASS: return "PASS";
+		case TOY_OP_ASSERT: return "ASSERT";
+		case TOY_OP_PRINT: return "PRINT";
+		case TOY_OP_LITERAL: return "LITERAL";
+		case TOY_OP_LITERAL_LONG: return "LITERAL_LONG";
+		case TOY_OP_LITERAL_WIDE: return "LITERAL_WIDE";
+		case TOY_OP_LITERAL_RAW: return "LITERAL_RAW";
+		case TOY_OP_NEGATE: return "NEGATE";
+		case TOY_OP_ADDITION: return "ADDITION";
+		case TOY_OP_SUBTRACTION: return "SUBTRACTION";
+		case TOY_OP_MULTIPLICATION: return "MULTIPLICATION";
+		case TOY_OP_DIVISION: return "DIVISION";
+		case TOY_OP_MODULO: return "MODULO";
+		case TOY_OP_GROUPING_BEGIN: return "GROUPING_BEGIN";
+		case TOY_OP_GROUPING_END: return "GROUPING_END";
+		case TOY_OP_SCOPE_BEGIN: return "SCOPE_BEGIN";
+		case TOY_OP_SCOPE_END: return "SCOPE_END";
+		case TOY_OP_TYPE_DECL: return "TYPE_DECL";
+		case TOY_OP_TYPE_DECL_LONG: return "TYPE_DECL_LONG";
+		case TOY_OP_VAR_DECL: return "VAR_DECL";
+		case TOY_OP_VAR_DECL_LONG: return "VAR_DECL_LONG";
+		case TOY_OP_VAR_DECL_WIDE: return "VAR_DECL_WIDE";
+		case TOY_OP_FN_DECL: return "FN_DECL";
+		case TOY_OP_FN_DECL_LONG: return "FN_DECL_LONG";
+		case TOY_OP_FN_DECL_WIDE: return "FN_DECL_WIDE";
+		case TOY_OP_VAR_ASSIGN: return "VAR_ASSIGN";
+		case TOY_OP_VAR_ADDITION_ASSIGN: return "VAR_ADDITION_ASSIGN";
+		case TOY_OP_VAR_SUBTRACTION_ASSIGN: return "VAR_SUBTRACTION_ASSIGN";
+		case TOY_OP_VAR_MULTIPLICATION_ASSIGN: return "VAR_MULTIPLICATION_ASSIGN";
+		case TOY_OP_VAR_DIVISION_ASSIGN: return "VAR_DIVISION_ASSIGN";
+		case TOY_OP_VAR_MODULO_ASSIGN: return "VAR_MODULO_ASSIGN";
+		case TOY_OP_TYPE_CAST: return "TYPE_CAST";
+		case TOY_OP_TYPE_OF: return "TYPE_OF";
+		case TOY_OP_IMPORT: return "IMPORT";
+		case TOY_OP_EXPORT_removed: return "EXPORT_removed";
+		case TOY_OP_INDEX: return "INDEX";
+		case TOY_OP_INDEX_ASSIGN: return "INDEX_ASSIGN";
+		case TOY_OP_INDEX_ASSIGN_INTERMEDIATE: return "INDEX_ASSIGN_INTERMEDIATE";
+		case TOY_OP_DOT: return "DOT";
+		case TOY_OP_COMPARE_EQUAL: return "COMPARE_EQUAL";
+		case TOY_OP_COMPARE_NOT_EQUAL: return "COMPARE_NOT_EQUAL";
+		case TOY_OP_COMPARE_LESS: return "COMPARE_LESS";
+		case TOY_OP_COMPARE_LESS_EQUAL: return "COMPARE_LESS_EQUAL";
+		case TOY_OP_COMPARE_GREATER: return "COMPARE_GREATER";
+		case TOY_OP_COMPARE_GREATER_EQUAL: return "COMPARE_GREATER_EQUAL";
+		case TOY_OP_INVERT: return "INVERT";
+		case TOY_OP_AND: return "AND";
+		case TOY_OP_OR: return "OR";
+		case TOY_OP_JUMP: return "JUMP";
+		case TOY_OP_IF_FALSE_JUMP: return "IF_FALSE_JUMP";
+		case TOY_OP_JUMP_WIDE: return "JUMP_WIDE";
+		case TOY_OP_IF_FALSE_JUMP_WIDE: return "IF_FALSE_JUMP_WIDE";
+		case TOY_OP_FN_CALL: return "FN_CALL";
+		case TOY_OP_FN_RETURN: return "FN_RETURN";
+		case TOY_OP_POP_STACK: return "POP_STACK";
+		case TOY_OP_TERNARY: return "TERNARY";
+		case TOY_OP_FN_END: return "FN_END";
+		case TOY_OP_LITERAL_PAIR: return "LITERAL_PAIR";
+		case TOY_OP_VAR_ARITHMETIC_ASSIGN: return "VAR_ARITHMETIC_ASSIGN";
+		case TOY_OP_COMPARE_JUMP: return "COMPARE_JUMP";
+		case TOY_OP_COMPARE_JUMP_WIDE: return "COMPARE_JUMP_WIDE";
+		case TOY_OP_ADDITION_INT: return "ADDITION_INT";
+		case TOY_OP_SUBTRACTION_INT: return "SUBTRACTION_INT";
+		case TOY_OP_MULTIPLICATION_INT: return "MULTIPLICATION_INT";
+		case TOY_OP_DIVISION_INT: return "DIVISION_INT";
+		case TOY_OP_MODULO_INT: return "MODULO_INT";
+		case TOY_OP_ADDITION_FLOAT: return "ADDITION_FLOAT";
+		case TOY_OP_SUBTRACTION_FLOAT: return "SUBTRACTION_FLOAT";
+		case TOY_OP_MULTIPLICATION_FLOAT: return "MULTIPLICATION_FLOAT";
+		case TOY_OP_DIVISION_FLOAT: return "DIVISION_FLOAT";
+		case TOY_OP_COMPARE_LESS_INT: return "COMPARE_LESS_INT";
+		case TOY_OP_COMPARE_LESS_EQUAL_INT: return "COMPARE_LESS_EQUAL_INT";
+		case TOY_OP_COMPARE_GREATER_INT: return "COMPARE_GREATER_INT";
+		case TOY_OP_COMPARE_GREATER_EQUAL_INT: return "COMPARE_GREATER_EQUAL_INT";
+		case TOY_OP_REGISTER_CODE: return "REGISTER_CODE";
+		case TOY_OP_TAIL_CALL: return "TAIL_CALL";
+		case TOY_OP_BUILTIN: return "BUILTIN";
+		case TOY_OP_INDEX_GET: return "INDEX_GET";
+		case TOY_OP_INDEX_SET: return "INDEX_SET";
+		case TOY_OP_SECTION_END: return "SECTION_END";
+		default: return "UNKNOWN";
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "toy_common.h"
+#include "toy_literal.h"
+
+//the longest run of opcodes that is counted
+#define TOY_OPCODE_PROFILE_WINDOW 4
+
+//a run of consecutive opcodes, and how often it was executed
+typedef struct Toy_OpcodeSequence {
+	unsigned char opcodes[TOY_OPCODE_PROFILE_WINDOW];
+	int length; //0 for an empty slot
+	int hits;
+} Toy_OpcodeSequence;
+
+//counts the opcode n-grams executed by any number of interpreters, to find candidates for superinstructions
+typedef struct Toy_OpcodeProfile {
+	Toy_OpcodeSequence* sequences; //open addressing
+	int capacity;
+	int count;
+	unsigned char window[TOY_OPCODE_PROFILE_WINDOW]; //the most recent opcodes, in order
+	int windowLength;
+} Toy_OpcodeProfile;
+
+TOY_API void Toy_initOpcodeProfile(Toy_OpcodeProfile* profile);
+TOY_API void Toy_freeOpcodeProfile(Toy_OpcodeProfile* profile);
+
+//counts every sequence ending with this opcode - sequences never continue past a jump, call or return
+TOY_API void Toy_recordOpcodeProfile(Toy_OpcodeProfile* profile, unsigned char opcode);
+TOY_API void Toy_breakOpcodeProfile(Toy_OpcodeProfile* profile);
+
+//fills results with the most frequent sequences of the given length, and returns how many were found
+TOY_API int Toy_rankOpcodeProfile(Toy_OpcodeProfile* profile, int length, Toy_OpcodeSequence* results, int limit);
+TOY_API void Toy_printOpcodeProfile(Toy_OpcodeProfile* profile, int limit, Toy_PrintFn printFn);
+
+TOY_API const char* Toy_getOpcodeName(unsigned char opcode);
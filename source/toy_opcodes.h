@@ -13,6 +13,7 @@ typedef enum Toy_Opcode {
 	//data
 	TOY_OP_LITERAL,
 	TOY_OP_LITERAL_LONG, //for more than 256 literals in a chunk
+	TOY_OP_LITERAL_WIDE, //for more than 65536 literals in a chunk
 	TOY_OP_LITERAL_RAW, //forcibly get the raw value of the literal
 
 	//arithmetic operators
@@ -34,9 +35,11 @@ typedef enum Toy_Opcode {
 
 	TOY_OP_VAR_DECL,		//declare a variable to be used (as a literal)
 	TOY_OP_VAR_DECL_LONG,	//declare a variable to be used (as a long literal)
+	TOY_OP_VAR_DECL_WIDE,	//declare a variable to be used (as a wide literal)
 
 	TOY_OP_FN_DECL,			//declare a function to be used (as a literal)
 	TOY_OP_FN_DECL_LONG,	//declare a function to be used (as a long literal)
+	TOY_OP_FN_DECL_WIDE,	//declare a function to be used (as a wide literal)
 
 	TOY_OP_VAR_ASSIGN,		//assign to a literal
 	TOY_OP_VAR_ADDITION_ASSIGN,
@@ -73,6 +76,8 @@ typedef enum Toy_Opcode {
 	//jumps, and conditional jumps (absolute)
 	TOY_OP_JUMP,
 	TOY_OP_IF_FALSE_JUMP,
+	TOY_OP_JUMP_WIDE, //for code beyond 64KB
+	TOY_OP_IF_FALSE_JUMP_WIDE,
 	TOY_OP_FN_CALL,
 	TOY_OP_FN_RETURN,
 
@@ -84,7 +89,85 @@ typedef enum Toy_Opcode {
 
 	//meta
 	TOY_OP_FN_END, //different from SECTION_END
+
+	//superinstructions, fused from the most frequent sequences (since 1.4, after FN_END so 1.3 bytecode still runs)
+	TOY_OP_LITERAL_PAIR, //push two literals, followed by two 1-byte indexes
+	TOY_OP_VAR_ARITHMETIC_ASSIGN, //"a = b op c" - followed by the arithmetic opcode, then three 1-byte indexes
+	TOY_OP_COMPARE_JUMP, //compare the top two values, jump if false - followed by the target, then the comparison opcode
+	TOY_OP_COMPARE_JUMP_WIDE,
+
+	//type-specialized forms, for operands declared as numbers - anything else (including null) falls back to the generic opcode
+	TOY_OP_ADDITION_INT, //same order as TOY_OP_ADDITION to TOY_OP_MODULO
+	TOY_OP_SUBTRACTION_INT,
+	TOY_OP_MULTIPLICATION_INT,
+	TOY_OP_DIVISION_INT,
+	TOY_OP_MODULO_INT,
+	TOY_OP_ADDITION_FLOAT, //same order as TOY_OP_ADDITION to TOY_OP_DIVISION
+	TOY_OP_SUBTRACTION_FLOAT,
+	TOY_OP_MULTIPLICATION_FLOAT,
+	TOY_OP_DIVISION_FLOAT,
+	TOY_OP_COMPARE_LESS_INT, //same order as TOY_OP_COMPARE_LESS to TOY_OP_COMPARE_GREATER_EQUAL
+	TOY_OP_COMPARE_LESS_EQUAL_INT,
+	TOY_OP_COMPARE_GREATER_INT,
+	TOY_OP_COMPARE_GREATER_EQUAL_INT,
+
+	//a function body compiled for the register engine - followed by the frame size, the constants to load, then the register code
+	TOY_OP_REGISTER_CODE,
+
+	//a call in "return f(...)" - the caller makes it once this function has returned, so the depth doesn't grow
+	TOY_OP_TAIL_CALL,
+
+	//push a builtin native to be called, unless a variable shadows it - followed by it's index, then the 2-byte index of it's name
+	TOY_OP_BUILTIN,
+
+	//indexing without slices, in place - anything else falls back to TOY_OP_INDEX and TOY_OP_INDEX_ASSIGN
+	TOY_OP_INDEX_GET, //"a[i]" - the compound, then the index
+	TOY_OP_INDEX_SET, //"a[i] op= v" - the variable, the index, then the value, followed by the assignment opcode
+
 	TOY_OP_SECTION_END = 255,
 	//TODO: add more
 } Toy_Opcode;
 
+//the generic opcode that a type-specialized one falls back to, or the opcode itself - WARNING: enum trickery
+#define TOY_GENERIC_OPCODE(opcode) ((Toy_Opcode)( \
+	(opcode) >= TOY_OP_ADDITION_INT && (opcode) <= TOY_OP_MODULO_INT ? TOY_OP_ADDITION + ((opcode) - TOY_OP_ADDITION_INT) : \
+	(opcode) >= TOY_OP_ADDITION_FLOAT && (opcode) <= TOY_OP_DIVISION_FLOAT ? TOY_OP_ADDITION + ((opcode) - TOY_OP_ADDITION_FLOAT) : \
+	(opcode) >= TOY_OP_COMPARE_LESS_INT && (opcode) <= TOY_OP_COMPARE_GREATER_EQUAL_INT ? TOY_OP_COMPARE_LESS + ((opcode) - TOY_OP_COMPARE_LESS_INT) : \
+	(opcode) ))
+
+//the instructions within register code - three-address, over a frame of registers holding the function's values
+//operands are 1-byte registers, 2-byte literal indexes, and 2-byte targets relative to the start of the register code
+//register 0 holds the result of the latest expression statement, then come the constants, the parameters and the locals
+typedef enum Toy_RegisterOpcode {
+	TOY_REG_RETURN, //src - end the function, returning the value
+	TOY_REG_LITERAL, //dst, literal
+	TOY_REG_GLOBAL, //dst, identifier - read a variable from the scope
+	TOY_REG_SET_GLOBAL, //identifier, src - assign to a variable in the scope
+	TOY_REG_MOVE, //dst, src
+	TOY_REG_UNARY, //opcode, dst, src - negate & invert
+	TOY_REG_BINARY, //opcode, dst, lhs, rhs - arithmetic, comparisons, and & or
+	TOY_REG_JUMP, //target
+	TOY_REG_JUMP_IF_FALSE, //src, target
+	TOY_REG_COMPARE_JUMP, //opcode, lhs, rhs, target - jump if the comparison is false
+	TOY_REG_CALL, //dst, callee, name, count, then a register & name for each argument (TOY_REGISTER_NO_NAME unless it's a local)
+	TOY_REG_PRINT, //src
+	TOY_REG_ASSERT, //src, message
+	TOY_REG_TAIL_CALL, //same as TOY_REG_CALL, always followed by the return of dst
+} Toy_RegisterOpcode;
+
+#define TOY_REGISTER_COUNT 256
+#define TOY_REGISTER_NO_NAME 0xFFFF
+
+//the bytecode layout (since 1.2): after the header comes a table of section offsets & sizes, then each section
+//offsets are relative to the start of the bytecode (or function body), and every section is aligned
+//the literal section begins with the width of the indexes within it (2 or 4 bytes)
+typedef enum Toy_BytecodeSection {
+	TOY_SECTION_LITERALS,
+	TOY_SECTION_FUNCTION_INDEX, //an offset & size for each function body
+	TOY_SECTION_FUNCTIONS, //the function bodies, each in this same layout without a header
+	TOY_SECTION_CODE,
+	TOY_SECTION_COUNT,
+} Toy_BytecodeSection;
+
+#define TOY_SECTION_ALIGNMENT 4
+
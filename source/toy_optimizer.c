@@ -0,0 +1,347 @@
+#include "toy_optimizer.h"
+
+#include "toy_memory.h"
+#include "toy_literal.h"
+#include "toy_opcodes.h"
+
+#include <string.h>
+
+//a decoded instruction within the compiler's bytecode
+typedef struct Toy_Instruction {
+	int position;
+	int length;
+	unsigned char opcode;
+	bool keep;
+	bool dirty; //for groupings & scopes - can't be removed
+} Toy_Instruction;
+
+//the size of each instruction, including it's operands (-1 for anything not seen before collation)
+static int instructionLength(unsigned char opcode) {
+	switch(opcode) {
+		case TOY_OP_LITERAL:
+		case TOY_OP_INDEX_ASSIGN: //followed by the assignment opcode
+		case TOY_OP_INDEX_SET:
+			return 2;
+
+		case TOY_OP_LITERAL_LONG:
+		case TOY_OP_LITERAL_PAIR:
+		case TOY_OP_VAR_DECL:
+		case TOY_OP_FN_DECL:
+		case TOY_OP_FN_RETURN:
+			return 3;
+
+		case TOY_OP_LITERAL_WIDE:
+		case TOY_OP_BUILTIN:
+		case TOY_OP_VAR_DECL_LONG:
+		case TOY_OP_FN_DECL_LONG:
+		case TOY_OP_VAR_ARITHMETIC_ASSIGN:
+		case TOY_OP_JUMP_WIDE:
+		case TOY_OP_IF_FALSE_JUMP_WIDE:
+			return 5;
+
+		case TOY_OP_COMPARE_JUMP_WIDE: //followed by the comparison
+			return 6;
+
+		case TOY_OP_VAR_DECL_WIDE:
+		case TOY_OP_FN_DECL_WIDE:
+			return 9;
+
+		case TOY_OP_EOF:
+		case TOY_OP_TYPE_DECL:
+		case TOY_OP_TYPE_DECL_LONG:
+		case TOY_OP_EXPORT_removed:
+		case TOY_OP_JUMP:
+		case TOY_OP_IF_FALSE_JUMP:
+		case TOY_OP_COMPARE_JUMP:
+		case TOY_OP_FN_END:
+		case TOY_OP_SECTION_END:
+		case TOY_OP_REGISTER_CODE: //the rest is register code
+			return -1;
+
+		default:
+			return 1;
+	}
+}
+
+static bool isJump(unsigned char opcode) {
+	return opcode == TOY_OP_JUMP_WIDE || opcode == TOY_OP_IF_FALSE_JUMP_WIDE || opcode == TOY_OP_COMPARE_JUMP_WIDE;
+}
+
+static bool isDeclaration(unsigned char opcode) {
+	switch(opcode) {
+		case TOY_OP_VAR_DECL:
+		case TOY_OP_VAR_DECL_LONG:
+		case TOY_OP_VAR_DECL_WIDE:
+		case TOY_OP_FN_DECL:
+		case TOY_OP_FN_DECL_LONG:
+		case TOY_OP_FN_DECL_WIDE:
+		case TOY_OP_IMPORT: //declares the library's alias
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+static int readTarget(Toy_Compiler* compiler, Toy_Instruction* instruction) {
+	int target = 0;
+	memcpy(&target, compiler->bytecode + instruction->position + 1, sizeof(int));
+	return target;
+}
+
+//the first instruction that will actually run, at or after this one
+static int resolveInstruction(Toy_Instruction* instructions, int count, int index) {
+	while (index < count && !instructions[index].keep) {
+		index++;
+	}
+	return index;
+}
+
+//returns true if the bytecode changed
+static bool optimizeChunk(Toy_Compiler* compiler, int start, Toy_OptimizerStats* stats) {
+	const int oldCount = compiler->count;
+
+	//decode each instruction, and where they are
+	int capacity = TOY_GROW_CAPACITY(0);
+	int count = 0;
+	Toy_Instruction* instructions = TOY_ALLOCATE(Toy_Instruction, capacity);
+
+	int* lookup = TOY_ALLOCATE(int, oldCount + 1); //instruction index at each position, or -1
+	for (int i = 0; i <= oldCount; i++) {
+		lookup[i] = -1;
+	}
+
+	bool valid = true;
+	for (int position = start; position < compiler->count; ) {
+		int length = instructionLength(compiler->bytecode[position]);
+
+		if (length < 0 || position + length > compiler->count) {
+			valid = false;
+			break;
+		}
+
+		if (count + 1 > capacity) {
+			int oldCapacity = capacity;
+			capacity = TOY_GROW_CAPACITY(capacity);
+			instructions = TOY_GROW_ARRAY(Toy_Instruction, instructions, oldCapacity, capacity);
+		}
+
+		instructions[count] = (Toy_Instruction){ .position = position, .length = length, .opcode = compiler->bytecode[position], .keep = true, .dirty = false };
+		lookup[position] = count++;
+		position += length;
+	}
+
+	lookup[compiler->count] = count; //jumps to the end of the code
+
+	//every jump must land on an instruction, or the optimizer leaves this chunk alone
+	for (int i = 0; valid && i < count; i++) {
+		if (isJump(instructions[i].opcode)) {
+			int target = readTarget(compiler, &instructions[i]) + start;
+			valid = target >= start && target <= compiler->count && lookup[target] >= 0;
+		}
+	}
+
+	//find the instructions that do nothing
+	int* groupings = TOY_ALLOCATE(int, count + 1);
+	int* scopes = TOY_ALLOCATE(int, count + 1);
+	int groupingDepth = 0;
+	int scopeDepth = 0;
+
+	for (int i = 0; valid && i < count; i++) {
+		switch(instructions[i].opcode) {
+			case TOY_OP_PASS:
+				instructions[i].keep = false;
+			break;
+
+			case TOY_OP_GROUPING_BEGIN:
+				groupings[groupingDepth++] = i;
+			break;
+
+			case TOY_OP_GROUPING_END: {
+				if (groupingDepth == 0) {
+					valid = false;
+					break;
+				}
+
+				//groupings are only needed to isolate index assignments
+				int begin = groupings[--groupingDepth];
+				if (!instructions[begin].dirty) {
+					instructions[begin].keep = false;
+					instructions[i].keep = false;
+				}
+			}
+			break;
+
+			case TOY_OP_INDEX_ASSIGN:
+			case TOY_OP_INDEX_ASSIGN_INTERMEDIATE:
+				for (int g = 0; g < groupingDepth; g++) {
+					instructions[groupings[g]].dirty = true;
+				}
+			break;
+
+			case TOY_OP_SCOPE_BEGIN:
+				scopes[scopeDepth++] = i;
+			break;
+
+			case TOY_OP_SCOPE_END: {
+				if (scopeDepth == 0) {
+					valid = false;
+					break;
+				}
+
+				//scopes are only needed when something is declared directly within them
+				int begin = scopes[--scopeDepth];
+				if (!instructions[begin].dirty) {
+					instructions[begin].keep = false;
+					instructions[i].keep = false;
+				}
+			}
+			break;
+
+			default:
+				if (isDeclaration(instructions[i].opcode) && scopeDepth > 0) {
+					instructions[scopes[scopeDepth - 1]].dirty = true;
+				}
+			break;
+		}
+	}
+
+	if (groupingDepth != 0 || scopeDepth != 0) {
+		valid = false;
+	}
+
+	TOY_FREE_ARRAY(int, groupings, count + 1);
+	TOY_FREE_ARRAY(int, scopes, count + 1);
+
+	if (!valid) {
+		TOY_FREE_ARRAY(Toy_Instruction, instructions, capacity);
+		TOY_FREE_ARRAY(int, lookup, oldCount + 1);
+		return false;
+	}
+
+	bool changed = false;
+
+	//thread jumps that land on unconditional jumps, then drop jumps to the next instruction
+	int* targets = TOY_ALLOCATE(int, count + 1); //the instruction index each jump lands on
+
+	for (int i = 0; i < count; i++) {
+		if (!isJump(instructions[i].opcode)) {
+			continue;
+		}
+
+		int target = lookup[readTarget(compiler, &instructions[i]) + start];
+		int hops = 0;
+
+		for (int next = resolveInstruction(instructions, count, target); next < count && instructions[next].opcode == TOY_OP_JUMP_WIDE && hops < count; hops++) {
+			int further = lookup[readTarget(compiler, &instructions[next]) + start];
+
+			if (further == target) {
+				break; //infinite loop
+			}
+
+			target = further;
+			next = resolveInstruction(instructions, count, target);
+		}
+
+		if (hops > 0) {
+			stats->jumpsThreaded++;
+			changed = true;
+		}
+
+		targets[i] = target;
+	}
+
+	for (int i = 0; i < count; i++) {
+		if (instructions[i].opcode == TOY_OP_JUMP_WIDE && instructions[i].keep && resolveInstruction(instructions, count, targets[i]) == resolveInstruction(instructions, count, i + 1)) {
+			instructions[i].keep = false;
+		}
+	}
+
+	int removed = 0;
+	for (int i = 0; i < count; i++) {
+		if (!instructions[i].keep) {
+			removed++;
+		}
+	}
+
+	if (!changed && removed == 0) {
+		TOY_FREE_ARRAY(int, targets, count + 1);
+		TOY_FREE_ARRAY(Toy_Instruction, instructions, capacity);
+		TOY_FREE_ARRAY(int, lookup, oldCount + 1);
+		return false;
+	}
+
+	//rebuild the bytecode without the removed instructions
+	int* remap = TOY_ALLOCATE(int, count + 1); //new position of each instruction, or of the one after it if removed
+	unsigned char* bytecode = TOY_ALLOCATE(unsigned char, compiler->capacity);
+	memcpy(bytecode, compiler->bytecode, start);
+
+	int newCount = start;
+	for (int i = 0; i < count; i++) {
+		remap[i] = newCount;
+
+		if (instructions[i].keep) {
+			memcpy(bytecode + newCount, compiler->bytecode + instructions[i].position, instructions[i].length);
+			newCount += instructions[i].length;
+		}
+	}
+	remap[count] = newCount;
+
+	//point the jumps at their new targets, and record where they are now
+	Toy_freeLiteralArray(&compiler->jumpSites);
+
+	for (int i = 0; i < count; i++) {
+		if (instructions[i].keep && isJump(instructions[i].opcode)) {
+			int site = remap[i] + 1;
+			int target = remap[targets[i]] - start;
+			memcpy(bytecode + site, &target, sizeof(int));
+
+			Toy_Literal literal = TOY_TO_INTEGER_LITERAL(site);
+			Toy_pushLiteralArray(&compiler->jumpSites, literal);
+			Toy_freeLiteral(literal);
+		}
+	}
+
+	stats->bytesRemoved += oldCount - newCount;
+	stats->instructionsRemoved += removed;
+
+	TOY_FREE_ARRAY(unsigned char, compiler->bytecode, compiler->capacity);
+	compiler->bytecode = bytecode;
+	compiler->count = newCount;
+
+	//cleanup
+	TOY_FREE_ARRAY(int, remap, count + 1);
+	TOY_FREE_ARRAY(int, targets, count + 1);
+	TOY_FREE_ARRAY(Toy_Instruction, instructions, capacity);
+	TOY_FREE_ARRAY(int, lookup, oldCount + 1);
+
+	return true;
+}
+
+static void optimizeCompiler(Toy_Compiler* compiler, int start, Toy_OptimizerStats* stats) {
+	if (compiler->panic) {
+		return;
+	}
+
+	//the functions are stored as compilers until collation
+	for (int i = 0; i < compiler->literalCache.count; i++) {
+		if (compiler->literalCache.literals[i].type == TOY_LITERAL_FUNCTION_INTERMEDIATE) {
+			//function bodies begin with the indexes of their parameters & returns
+			optimizeCompiler((Toy_Compiler*)TOY_AS_FUNCTION(compiler->literalCache.literals[i]).inner.bytecode, 4, stats);
+		}
+	}
+
+	//each pass can expose more to remove
+	for (int pass = 0; pass < 4 && optimizeChunk(compiler, start, stats); pass++);
+}
+
+//exposed functions
+void Toy_initOptimizerStats(Toy_OptimizerStats* stats) {
+	stats->bytesRemoved = 0;
+	stats->instructionsRemoved = 0;
+	stats->jumpsThreaded = 0;
+}
+
+void Toy_optimizeCompiler(Toy_Compiler* compiler, Toy_OptimizerStats* stats) {
+	optimizeCompiler(compiler, 0, stats);
+}
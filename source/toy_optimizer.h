@@ -0,0 +1,15 @@
+#pragma once
+
+#include "toy_common.h"
+#include "toy_compiler.h"
+
+//what the optimizer managed to remove
+typedef struct Toy_OptimizerStats {
+	int bytesRemoved;
+	int instructionsRemoved;
+	int jumpsThreaded;
+} Toy_OptimizerStats;
+
+//rewrites the compiler's bytecode (and that of it's functions) in place - run after writing, before collating
+TOY_API void Toy_initOptimizerStats(Toy_OptimizerStats* stats);
+TOY_API void Toy_optimizeCompiler(Toy_Compiler* compiler, Toy_OptimizerStats* stats);
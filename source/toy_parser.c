@@ -32,7 +32,7 @@ static void error(Toy_Parser* parser, Toy_Token token, const char* message) {
 
 static void advance(Toy_Parser* parser) {
 	parser->previous = parser->current;
-	parser->current = Toy_private_scanLexer(parser->lexer);
+	parser->current = Toy_getTokenBuffer(parser->tokens, parser->position++);
 
 	if (parser->current.type == TOY_TOKEN_ERROR) {
 		error(parser, parser->current, "Toy_Lexer error");
@@ -131,7 +131,7 @@ static Toy_Opcode asType(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		return TOY_OP_EOF;
 	}
 
-	Toy_emitASTNodeLiteral(nodeHandle, literal);
+	Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, literal);
 
 	Toy_freeLiteral(literal);
 
@@ -141,7 +141,7 @@ static Toy_Opcode asType(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 static Toy_Opcode typeOf(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	Toy_ASTNode* rhs = NULL;
 	parsePrecedence(parser, &rhs, PREC_CALL);
-	Toy_emitASTNodeUnary(nodeHandle, TOY_OP_TYPE_OF, rhs);
+	Toy_emitASTNodeUnary(&parser->arena, nodeHandle, TOY_OP_TYPE_OF, rhs);
 	return TOY_OP_EOF;
 }
 
@@ -159,7 +159,7 @@ static Toy_Opcode compound(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		if (iterations == 0 && match(parser, TOY_TOKEN_COLON)) {
 			consume(parser, TOY_TOKEN_BRACKET_RIGHT, "Expected ']' at the end of empty dictionary definition");
 			//emit an empty dictionary and finish
-			Toy_emitASTNodeCompound(&dictionary, TOY_LITERAL_DICTIONARY);
+			Toy_emitASTNodeCompound(&parser->arena, &dictionary, TOY_LITERAL_DICTIONARY);
 			break;
 		}
 
@@ -197,7 +197,7 @@ static Toy_Opcode compound(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 
 			//init the dictionary
 			if (!dictionary) {
-				Toy_emitASTNodeCompound(&dictionary, TOY_LITERAL_DICTIONARY);
+				Toy_emitASTNodeCompound(&parser->arena, &dictionary, TOY_LITERAL_DICTIONARY);
 			}
 
 			//grow the node if needed
@@ -205,7 +205,7 @@ static Toy_Opcode compound(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 				int oldCapacity = dictionary->compound.capacity;
 
 				dictionary->compound.capacity = TOY_GROW_CAPACITY(oldCapacity);
-				dictionary->compound.nodes = TOY_GROW_ARRAY(Toy_ASTNode, dictionary->compound.nodes, oldCapacity, dictionary->compound.capacity);
+				dictionary->compound.nodes = TOY_ARENA_GROW_ARRAY(&parser->arena, Toy_ASTNode, dictionary->compound.nodes, oldCapacity, dictionary->compound.capacity);
 			}
 
 			//store the left and right in the node
@@ -222,7 +222,7 @@ static Toy_Opcode compound(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 
 			//init the array
 			if (!array) {
-				Toy_emitASTNodeCompound(&array, TOY_LITERAL_ARRAY);
+				Toy_emitASTNodeCompound(&parser->arena, &array, TOY_LITERAL_ARRAY);
 			}
 
 			//grow the node if needed
@@ -230,12 +230,11 @@ static Toy_Opcode compound(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 				int oldCapacity = array->compound.capacity;
 
 				array->compound.capacity = TOY_GROW_CAPACITY(oldCapacity);
-				array->compound.nodes = TOY_GROW_ARRAY(Toy_ASTNode, array->compound.nodes, oldCapacity, array->compound.capacity);
+				array->compound.nodes = TOY_ARENA_GROW_ARRAY(&parser->arena, Toy_ASTNode, array->compound.nodes, oldCapacity, array->compound.capacity);
 			}
 
-			//copy into the array, and manually free the temp node
+			//copy into the array
 			array->compound.nodes[array->compound.count++] = *left;
-			TOY_FREE(Toy_ASTNode, left);
 		}
 	}
 
@@ -248,7 +247,7 @@ static Toy_Opcode compound(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	}
 	else {
 		//both are null, must be an array (because reasons)
-		Toy_emitASTNodeCompound(&array, TOY_LITERAL_ARRAY);
+		Toy_emitASTNodeCompound(&parser->arena, &array, TOY_LITERAL_ARRAY);
 		(*nodeHandle) = array;
 	}
 
@@ -263,7 +262,7 @@ static Toy_Opcode string(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		case TOY_TOKEN_LITERAL_STRING: {
 			//unescape valid escaped characters
 			int strLength = 0;
-			char* buffer = TOY_ALLOCATE(char, parser->previous.length);
+			char* buffer = TOY_ARENA_ALLOCATE(&parser->arena, char, parser->previous.length);
 
 			for (int i = 0; i < parser->previous.length; i++) {
 				if (parser->previous.lexeme[i] != '\\') { //copy normally
@@ -302,8 +301,7 @@ static Toy_Opcode string(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 			}
 
 			Toy_Literal literal = TOY_TO_STRING_LITERAL(Toy_createRefStringLength(buffer, strLength));
-			TOY_FREE_ARRAY(char, buffer, parser->previous.length);
-			Toy_emitASTNodeLiteral(nodeHandle, literal);
+			Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, literal);
 			Toy_freeLiteral(literal);
 			return TOY_OP_EOF;
 		}
@@ -324,7 +322,7 @@ static Toy_Opcode grouping(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 			consume(parser, TOY_TOKEN_PAREN_RIGHT, "Expected ')' at end of grouping");
 
 			//process the result without optimisations
-			Toy_emitASTNodeGrouping(nodeHandle);
+			Toy_emitASTNodeGrouping(&parser->arena, nodeHandle);
 			return TOY_OP_EOF;
 		}
 
@@ -476,7 +474,7 @@ static Toy_Opcode unary(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		}
 
 		//actually emit the negation node
-		Toy_emitASTNodeUnary(nodeHandle, TOY_OP_NEGATE, tmpNode);
+		Toy_emitASTNodeUnary(&parser->arena, nodeHandle, TOY_OP_NEGATE, tmpNode);
 	}
 
 	else if (parser->previous.type == TOY_TOKEN_NOT) {
@@ -497,7 +495,7 @@ static Toy_Opcode unary(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		}
 
 		//actually emit the negation
-		Toy_emitASTNodeUnary(nodeHandle, TOY_OP_INVERT, tmpNode);
+		Toy_emitASTNodeUnary(&parser->arena, nodeHandle, TOY_OP_INVERT, tmpNode);
 	}
 
 	else {
@@ -508,9 +506,9 @@ static Toy_Opcode unary(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	return TOY_OP_EOF;
 }
 
-static char* removeChar(const char* lexeme, int length, char c) {
+static char* removeChar(Toy_Arena* arena, const char* lexeme, int length, char c) {
 	int resPos = 0;
-	char* result = TOY_ALLOCATE(char, length + 1);
+	char* result = TOY_ARENA_ALLOCATE(arena, char, length + 1);
 
 	for (int i = 0; i < length; i++) {
 		if (lexeme[i] == c) {
@@ -527,41 +525,39 @@ static char* removeChar(const char* lexeme, int length, char c) {
 static Toy_Opcode atomic(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	switch(parser->previous.type) {
 		case TOY_TOKEN_NULL:
-			Toy_emitASTNodeLiteral(nodeHandle, TOY_TO_NULL_LITERAL);
+			Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, TOY_TO_NULL_LITERAL);
 			return TOY_OP_EOF;
 
 		case TOY_TOKEN_LITERAL_TRUE:
-			Toy_emitASTNodeLiteral(nodeHandle, TOY_TO_BOOLEAN_LITERAL(true));
+			Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, TOY_TO_BOOLEAN_LITERAL(true));
 			return TOY_OP_EOF;
 
 		case TOY_TOKEN_LITERAL_FALSE:
-			Toy_emitASTNodeLiteral(nodeHandle, TOY_TO_BOOLEAN_LITERAL(false));
+			Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, TOY_TO_BOOLEAN_LITERAL(false));
 			return TOY_OP_EOF;
 
 		case TOY_TOKEN_LITERAL_INTEGER: {
 			int value = 0;
-			const char* lexeme = removeChar(parser->previous.lexeme, parser->previous.length, '_');
+			const char* lexeme = removeChar(&parser->arena, parser->previous.lexeme, parser->previous.length, '_');
 			sscanf(lexeme, "%d", &value);
-			TOY_FREE_ARRAY(char, lexeme, parser->previous.length + 1);
-			Toy_emitASTNodeLiteral(nodeHandle, TOY_TO_INTEGER_LITERAL(value));
+			Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, TOY_TO_INTEGER_LITERAL(value));
 			return TOY_OP_EOF;
 		}
 
 		case TOY_TOKEN_LITERAL_FLOAT: {
 			float value = 0;
-			const char* lexeme = removeChar(parser->previous.lexeme, parser->previous.length, '_');
+			const char* lexeme = removeChar(&parser->arena, parser->previous.lexeme, parser->previous.length, '_');
 			sscanf(lexeme, "%f", &value);
-			TOY_FREE_ARRAY(char, lexeme, parser->previous.length + 1);
-			Toy_emitASTNodeLiteral(nodeHandle, TOY_TO_FLOAT_LITERAL(value));
+			Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, TOY_TO_FLOAT_LITERAL(value));
 			return TOY_OP_EOF;
 		}
 
 		case TOY_TOKEN_TYPE: {
 			if (match(parser, TOY_TOKEN_CONST)) {
-				Toy_emitASTNodeLiteral(nodeHandle, TOY_TO_TYPE_LITERAL(TOY_LITERAL_TYPE, true));
+				Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, TOY_TO_TYPE_LITERAL(TOY_LITERAL_TYPE, true));
 			}
 			else {
-				Toy_emitASTNodeLiteral(nodeHandle, TOY_TO_TYPE_LITERAL(TOY_LITERAL_TYPE, false));
+				Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, TOY_TO_TYPE_LITERAL(TOY_LITERAL_TYPE, false));
 			}
 
 			return TOY_OP_EOF;
@@ -591,7 +587,7 @@ static Toy_Opcode identifier(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	}
 
 	Toy_Literal identifier = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefStringLength(identifierToken.lexeme, length));
-	Toy_emitASTNodeLiteral(nodeHandle, identifier);
+	Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, identifier);
 	Toy_freeLiteral(identifier);
 
 	return TOY_OP_EOF;
@@ -601,28 +597,28 @@ static Toy_Opcode castingPrefix(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	switch(parser->previous.type) {
 		case TOY_TOKEN_BOOLEAN: {
 			Toy_Literal literal = TOY_TO_TYPE_LITERAL(TOY_LITERAL_BOOLEAN, false);
-			Toy_emitASTNodeLiteral(nodeHandle, literal);
+			Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, literal);
 			Toy_freeLiteral(literal);
 		}
 		break;
 
 		case TOY_TOKEN_INTEGER: {
 			Toy_Literal literal = TOY_TO_TYPE_LITERAL(TOY_LITERAL_INTEGER, false);
-			Toy_emitASTNodeLiteral(nodeHandle, literal);
+			Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, literal);
 			Toy_freeLiteral(literal);
 		}
 		break;
 
 		case TOY_TOKEN_FLOAT: {
 			Toy_Literal literal = TOY_TO_TYPE_LITERAL(TOY_LITERAL_FLOAT, false);
-			Toy_emitASTNodeLiteral(nodeHandle, literal);
+			Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, literal);
 			Toy_freeLiteral(literal);
 		}
 		break;
 
 		case TOY_TOKEN_STRING: {
 			Toy_Literal literal = TOY_TO_TYPE_LITERAL(TOY_LITERAL_STRING, false);
-			Toy_emitASTNodeLiteral(nodeHandle, literal);
+			Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, literal);
 			Toy_freeLiteral(literal);
 		}
 		break;
@@ -680,7 +676,7 @@ static Toy_Opcode incrementPrefix(Toy_Parser* parser, Toy_ASTNode** nodeHandle)
 		return TOY_OP_EOF;
 	}
 
-	Toy_emitASTNodePrefixIncrement(nodeHandle, tmpNode->atomic.literal);
+	Toy_emitASTNodePrefixIncrement(&parser->arena, nodeHandle, tmpNode->atomic.literal);
 
 	Toy_freeASTNode(tmpNode);
 
@@ -697,7 +693,7 @@ static Toy_Opcode incrementInfix(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		return TOY_OP_EOF;
 	}
 
-	Toy_emitASTNodePostfixIncrement(nodeHandle, tmpNode->atomic.literal);
+	Toy_emitASTNodePostfixIncrement(&parser->arena, nodeHandle, tmpNode->atomic.literal);
 
 	Toy_freeASTNode(tmpNode);
 
@@ -714,7 +710,7 @@ static Toy_Opcode decrementPrefix(Toy_Parser* parser, Toy_ASTNode** nodeHandle)
 		return TOY_OP_EOF;
 	}
 
-	Toy_emitASTNodePrefixDecrement(nodeHandle, tmpNode->atomic.literal);
+	Toy_emitASTNodePrefixDecrement(&parser->arena, nodeHandle, tmpNode->atomic.literal);
 
 	Toy_freeASTNode(tmpNode);
 
@@ -731,7 +727,7 @@ static Toy_Opcode decrementInfix(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		return TOY_OP_EOF;
 	}
 
-	Toy_emitASTNodePostfixDecrement(nodeHandle, tmpNode->atomic.literal);
+	Toy_emitASTNodePostfixDecrement(&parser->arena, nodeHandle, tmpNode->atomic.literal);
 
 	Toy_freeASTNode(tmpNode);
 
@@ -752,7 +748,7 @@ static Toy_Opcode fnCall(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 
 		//emit the cast node
 
-		Toy_emitASTNodeBinary(&lhsNode, rhsNode, TOY_OP_TYPE_CAST);
+		Toy_emitASTNodeBinary(&parser->arena, &lhsNode, rhsNode, TOY_OP_TYPE_CAST);
 
 		//pass it off to the caller
 		*nodeHandle = lhsNode;
@@ -767,7 +763,7 @@ static Toy_Opcode fnCall(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		//arithmetic
 		case TOY_TOKEN_PAREN_LEFT: {
 			Toy_ASTNode* arguments = NULL;
-			Toy_emitASTNodeFnCollection(&arguments);
+			Toy_emitASTNodeFnCollection(&parser->arena, &arguments);
 
 			//if there's arguments
 			if (!match(parser, TOY_TOKEN_PAREN_RIGHT)) {
@@ -778,7 +774,7 @@ static Toy_Opcode fnCall(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 						int oldCapacity = arguments->fnCollection.capacity;
 
 						arguments->fnCollection.capacity = TOY_GROW_CAPACITY(oldCapacity);
-						arguments->fnCollection.nodes = TOY_GROW_ARRAY(Toy_ASTNode, arguments->fnCollection.nodes, oldCapacity, arguments->fnCollection.capacity);
+						arguments->fnCollection.nodes = TOY_ARENA_GROW_ARRAY(&parser->arena, Toy_ASTNode, arguments->fnCollection.nodes, oldCapacity, arguments->fnCollection.capacity);
 					}
 
 					Toy_ASTNode* tmpNode = NULL;
@@ -791,14 +787,13 @@ static Toy_Opcode fnCall(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 					}
 
 					arguments->fnCollection.nodes[arguments->fnCollection.count++] = *tmpNode;
-					TOY_FREE(Toy_ASTNode, tmpNode); //simply free the tmpNode, so you don't free the children
 				} while(match(parser, TOY_TOKEN_COMMA));
 
 				consume(parser, TOY_TOKEN_PAREN_RIGHT, "Expected ')' at end of argument list");
 			}
 
 			//emit the call
-			Toy_emitASTNodeFnCall(nodeHandle, arguments);
+			Toy_emitASTNodeFnCall(&parser->arena, nodeHandle, arguments);
 
 			return TOY_OP_FN_CALL;
 		}
@@ -822,9 +817,9 @@ static Toy_Opcode indexAccess(Toy_Parser* parser, Toy_ASTNode** nodeHandle) { //
 	Toy_ASTNode* third = NULL;
 
 	//booleans indicate blank slice indexing
-	Toy_emitASTNodeLiteral(&first, TOY_TO_INDEX_BLANK_LITERAL);
-	Toy_emitASTNodeLiteral(&second, TOY_TO_INDEX_BLANK_LITERAL);
-	Toy_emitASTNodeLiteral(&third, TOY_TO_INDEX_BLANK_LITERAL);
+	Toy_emitASTNodeLiteral(&parser->arena, &first, TOY_TO_INDEX_BLANK_LITERAL);
+	Toy_emitASTNodeLiteral(&parser->arena, &second, TOY_TO_INDEX_BLANK_LITERAL);
+	Toy_emitASTNodeLiteral(&parser->arena, &third, TOY_TO_INDEX_BLANK_LITERAL);
 
 	bool readFirst = false; //pattern matching is bullcrap
 
@@ -853,7 +848,7 @@ static Toy_Opcode indexAccess(Toy_Parser* parser, Toy_ASTNode** nodeHandle) { //
 		Toy_freeASTNode(third);
 		third = NULL;
 
-		Toy_emitASTNodeIndex(nodeHandle, first, second, third);
+		Toy_emitASTNodeIndex(&parser->arena, nodeHandle, first, second, third);
 		return TOY_OP_INDEX;
 	}
 
@@ -875,7 +870,7 @@ static Toy_Opcode indexAccess(Toy_Parser* parser, Toy_ASTNode** nodeHandle) { //
 	if (match(parser, TOY_TOKEN_BRACKET_RIGHT)) {
 		Toy_freeASTNode(third);
 		third = NULL;
-		Toy_emitASTNodeIndex(nodeHandle, first, second, third);
+		Toy_emitASTNodeIndex(&parser->arena, nodeHandle, first, second, third);
 		return TOY_OP_INDEX;
 	}
 
@@ -891,7 +886,7 @@ static Toy_Opcode indexAccess(Toy_Parser* parser, Toy_ASTNode** nodeHandle) { //
 		return TOY_OP_EOF;
 	}
 
-	Toy_emitASTNodeIndex(nodeHandle, first, second, third);
+	Toy_emitASTNodeIndex(&parser->arena, nodeHandle, first, second, third);
 
 	consume(parser, TOY_TOKEN_BRACKET_RIGHT, "Expected ']' in index notation");
 
@@ -908,7 +903,7 @@ static Toy_Opcode question(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	consume(parser, TOY_TOKEN_COLON, "Expected ':' in ternary expression");
 	parsePrecedence(parser, &elsePath, PREC_TERNARY);
 
-	Toy_emitASTNodeTernary(nodeHandle, NULL, thenPath, elsePath);
+	Toy_emitASTNodeTernary(&parser->arena, nodeHandle, NULL, thenPath, elsePath);
 
 	return TOY_OP_TERNARY;
 }
@@ -1278,7 +1273,7 @@ static void parsePrecedence(Toy_Parser* parser, Toy_ASTNode** nodeHandle, Preced
 			continue;
 		}
 
-		Toy_emitASTNodeBinary(nodeHandle, rhsNode, opcode);
+		Toy_emitASTNodeBinary(&parser->arena, nodeHandle, rhsNode, opcode);
 
 		//optimise away the constants
 		if (!parser->panic && !calcStaticBinaryArithmetic(parser, nodeHandle)) {
@@ -1301,7 +1296,7 @@ static void expression(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 //statements
 static void blockStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	//init
-	Toy_emitASTNodeBlock(nodeHandle);
+	Toy_emitASTNodeBlock(&parser->arena, nodeHandle);
 
 	//sub-scope, compile it and push it up in a node
 	while (!match(parser, TOY_TOKEN_BRACE_RIGHT)) {
@@ -1309,7 +1304,7 @@ static void blockStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 			int oldCapacity = (*nodeHandle)->block.capacity;
 
 			(*nodeHandle)->block.capacity = TOY_GROW_CAPACITY(oldCapacity);
-			(*nodeHandle)->block.nodes = TOY_GROW_ARRAY(Toy_ASTNode, (*nodeHandle)->block.nodes, oldCapacity, (*nodeHandle)->block.capacity);
+			(*nodeHandle)->block.nodes = TOY_ARENA_GROW_ARRAY(&parser->arena, Toy_ASTNode, (*nodeHandle)->block.nodes, oldCapacity, (*nodeHandle)->block.capacity);
 		}
 
 		Toy_ASTNode* tmpNode = NULL;
@@ -1324,7 +1319,6 @@ static void blockStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 
 		//BUGFIX: statements no longer require the existing node
 		((*nodeHandle)->block.nodes[(*nodeHandle)->block.count++]) = *tmpNode;
-		TOY_FREE(Toy_ASTNode, tmpNode); //simply free the tmpNode, so you don't free the children
 	}
 }
 
@@ -1332,14 +1326,14 @@ static void printStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	//set the node info
 	Toy_ASTNode* node = NULL;
 	expression(parser, &node);
-	Toy_emitASTNodeUnary(nodeHandle, TOY_OP_PRINT, node);
+	Toy_emitASTNodeUnary(&parser->arena, nodeHandle, TOY_OP_PRINT, node);
 
 	consume(parser, TOY_TOKEN_SEMICOLON, "Expected ';' at end of print statement");
 }
 
 static void assertStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	//set the node info
-	(*nodeHandle) = TOY_ALLOCATE(Toy_ASTNode, 1); //special case, because I'm lazy
+	(*nodeHandle) = TOY_ARENA_ALLOCATE(&parser->arena, Toy_ASTNode, 1); //special case, because I'm lazy
 	(*nodeHandle)->type = TOY_AST_NODE_BINARY;
 	(*nodeHandle)->binary.opcode = TOY_OP_ASSERT;
 
@@ -1368,7 +1362,7 @@ static void ifStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		declaration(parser, &elsePath);
 	}
 
-	Toy_emitASTNodeIf(nodeHandle, condition, thenPath, elsePath);
+	Toy_emitASTNodeIf(&parser->arena, nodeHandle, condition, thenPath, elsePath);
 }
 
 static void whileStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
@@ -1383,7 +1377,7 @@ static void whileStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	consume(parser, TOY_TOKEN_PAREN_RIGHT, "Expected ')' at end of while clause");
 	declaration(parser, &thenPath);
 
-	Toy_emitASTNodeWhile(nodeHandle, condition, thenPath);
+	Toy_emitASTNodeWhile(&parser->arena, nodeHandle, condition, thenPath);
 }
 
 static void forStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
@@ -1401,7 +1395,7 @@ static void forStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	}
 	else {
 		consume(parser, TOY_TOKEN_SEMICOLON, "Expected ';' after empty declaration of for clause");
-		Toy_emitASTNodePass(&preClause);
+		Toy_emitASTNodePass(&parser->arena, &preClause);
 	}
 
 	//check the condition clause
@@ -1413,7 +1407,7 @@ static void forStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		consume(parser, TOY_TOKEN_SEMICOLON, "Expected ';' after empty condition of for clause");
 		//empty clause defaults to forever
 		Toy_Literal f = TOY_TO_BOOLEAN_LITERAL(true);
-		Toy_emitASTNodeLiteral(&condition, f);
+		Toy_emitASTNodeLiteral(&parser->arena, &condition, f);
 	}
 
 	//check the postfix clause
@@ -1423,30 +1417,30 @@ static void forStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	}
 	else {
 		consume(parser, TOY_TOKEN_PAREN_RIGHT, "Expected ')' after empty increment of for clause");
-		Toy_emitASTNodePass(&postClause);
+		Toy_emitASTNodePass(&parser->arena, &postClause);
 	}
 
 	//read the path
 	declaration(parser, &thenPath);
 
-	Toy_emitASTNodeFor(nodeHandle, preClause, condition, postClause, thenPath);
+	Toy_emitASTNodeFor(&parser->arena, nodeHandle, preClause, condition, postClause, thenPath);
 }
 
 static void breakStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
-	Toy_emitASTNodeBreak(nodeHandle);
+	Toy_emitASTNodeBreak(&parser->arena, nodeHandle);
 
 	consume(parser, TOY_TOKEN_SEMICOLON, "Expected ';' at end of break statement");
 }
 
 static void continueStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
-	Toy_emitASTNodeContinue(nodeHandle);
+	Toy_emitASTNodeContinue(&parser->arena, nodeHandle);
 
 	consume(parser, TOY_TOKEN_SEMICOLON, "Expected ';' at end of continue statement");
 }
 
 static void returnStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	Toy_ASTNode* returnValues = NULL;
-	Toy_emitASTNodeFnCollection(&returnValues);
+	Toy_emitASTNodeFnCollection(&parser->arena, &returnValues);
 
 	if (!match(parser, TOY_TOKEN_SEMICOLON)) {
 		do { //loop for multiple returns (disabled later in the pipeline)
@@ -1455,7 +1449,7 @@ static void returnStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 				int oldCapacity = returnValues->fnCollection.capacity;
 
 				returnValues->fnCollection.capacity = TOY_GROW_CAPACITY(oldCapacity);
-				returnValues->fnCollection.nodes = TOY_GROW_ARRAY(Toy_ASTNode, returnValues->fnCollection.nodes, oldCapacity, returnValues->fnCollection.capacity);
+				returnValues->fnCollection.nodes = TOY_ARENA_GROW_ARRAY(&parser->arena, Toy_ASTNode, returnValues->fnCollection.nodes, oldCapacity, returnValues->fnCollection.capacity);
 			}
 
 			Toy_ASTNode* node = NULL;
@@ -1468,13 +1462,12 @@ static void returnStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 			}
 
 			returnValues->fnCollection.nodes[returnValues->fnCollection.count++] = *node;
-			TOY_FREE(Toy_ASTNode, node); //free manually
 		} while(match(parser, TOY_TOKEN_COMMA));
 
 		consume(parser, TOY_TOKEN_SEMICOLON, "Expected ';' at end of return statement");
 	}
 
-	Toy_emitASTNodeFnReturn(nodeHandle, returnValues);
+	Toy_emitASTNodeFnReturn(&parser->arena, nodeHandle, returnValues);
 }
 
 static void importStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
@@ -1500,7 +1493,7 @@ static void importStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		Toy_freeASTNode(node);
 	}
 
-	Toy_emitASTNodeImport(nodeHandle, idn, alias);
+	Toy_emitASTNodeImport(&parser->arena, nodeHandle, idn, alias);
 
 	consume(parser, TOY_TOKEN_SEMICOLON, "Expected ';' at end of import statement");
 
@@ -1512,7 +1505,7 @@ static void importStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 static void expressionStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	//BUGFIX: check for empty statements
 	if (match(parser, TOY_TOKEN_SEMICOLON)) {
-		Toy_emitASTNodeLiteral(nodeHandle, TOY_TO_NULL_LITERAL);
+		Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, TOY_TO_NULL_LITERAL);
 		return;
 	}
 
@@ -1716,13 +1709,13 @@ static void varDecl(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	}
 	else {
 		//values are null by default
-		Toy_emitASTNodeLiteral(&expressionNode, TOY_TO_NULL_LITERAL);
+		Toy_emitASTNodeLiteral(&parser->arena, &expressionNode, TOY_TO_NULL_LITERAL);
 	}
 
 	//TODO: static type checking?
 
 	//declare it
-	Toy_emitASTNodeVarDecl(nodeHandle, identifier, typeLiteral, expressionNode);
+	Toy_emitASTNodeVarDecl(&parser->arena, nodeHandle, identifier, typeLiteral, expressionNode);
 
 	consume(parser, TOY_TOKEN_SEMICOLON, "Expected ';' at end of var declaration");
 }
@@ -1747,7 +1740,7 @@ static void fnDecl(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 
 	//for holding the array of arguments
 	Toy_ASTNode* argumentNode = NULL;
-	Toy_emitASTNodeFnCollection(&argumentNode);
+	Toy_emitASTNodeFnCollection(&parser->arena, &argumentNode);
 
 	//read args
 	if (!match(parser, TOY_TOKEN_PAREN_RIGHT)) {
@@ -1776,15 +1769,14 @@ static void fnDecl(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 					int oldCapacity = argumentNode->fnCollection.capacity;
 
 					argumentNode->fnCollection.capacity = TOY_GROW_CAPACITY(oldCapacity);
-					argumentNode->fnCollection.nodes = TOY_GROW_ARRAY(Toy_ASTNode, argumentNode->fnCollection.nodes, oldCapacity, argumentNode->fnCollection.capacity);
+					argumentNode->fnCollection.nodes = TOY_ARENA_GROW_ARRAY(&parser->arena, Toy_ASTNode, argumentNode->fnCollection.nodes, oldCapacity, argumentNode->fnCollection.capacity);
 				}
 
 				//store the arg in the array
 				Toy_ASTNode* literalNode = NULL;
-				Toy_emitASTNodeVarDecl(&literalNode, argIdentifier, argTypeLiteral, NULL);
+				Toy_emitASTNodeVarDecl(&parser->arena, &literalNode, argIdentifier, argTypeLiteral, NULL);
 
 				argumentNode->fnCollection.nodes[argumentNode->fnCollection.count++] = *literalNode;
-				TOY_FREE(Toy_ASTNode, literalNode);
 
 				break;
 			}
@@ -1818,15 +1810,14 @@ static void fnDecl(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 				int oldCapacity = argumentNode->fnCollection.capacity;
 
 				argumentNode->fnCollection.capacity = TOY_GROW_CAPACITY(oldCapacity);
-				argumentNode->fnCollection.nodes = TOY_GROW_ARRAY(Toy_ASTNode, argumentNode->fnCollection.nodes, oldCapacity, argumentNode->fnCollection.capacity);
+				argumentNode->fnCollection.nodes = TOY_ARENA_GROW_ARRAY(&parser->arena, Toy_ASTNode, argumentNode->fnCollection.nodes, oldCapacity, argumentNode->fnCollection.capacity);
 			}
 
 			//store the arg in the array
 			Toy_ASTNode* literalNode = NULL;
-			Toy_emitASTNodeVarDecl(&literalNode, argIdentifier, argTypeLiteral, NULL);
+			Toy_emitASTNodeVarDecl(&parser->arena, &literalNode, argIdentifier, argTypeLiteral, NULL);
 
 			argumentNode->fnCollection.nodes[argumentNode->fnCollection.count++] = *literalNode;
-			TOY_FREE(Toy_ASTNode, literalNode);
 
 		} while (match(parser, TOY_TOKEN_COMMA)); //if comma is read, continue
 
@@ -1835,7 +1826,7 @@ static void fnDecl(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 
 	//read the return types, if present
 	Toy_ASTNode* returnNode = NULL;
-	Toy_emitASTNodeFnCollection(&returnNode);
+	Toy_emitASTNodeFnCollection(&parser->arena, &returnNode);
 
 	if (match(parser, TOY_TOKEN_COLON)) {
 		do {
@@ -1844,14 +1835,13 @@ static void fnDecl(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 				int oldCapacity = returnNode->fnCollection.capacity;
 
 				returnNode->fnCollection.capacity = TOY_GROW_CAPACITY(oldCapacity);
-				returnNode->fnCollection.nodes = TOY_GROW_ARRAY(Toy_ASTNode, returnNode->fnCollection.nodes, oldCapacity, returnNode->fnCollection.capacity);
+				returnNode->fnCollection.nodes = TOY_ARENA_GROW_ARRAY(&parser->arena, Toy_ASTNode, returnNode->fnCollection.nodes, oldCapacity, returnNode->fnCollection.capacity);
 			}
 
 			Toy_ASTNode* literalNode = NULL;
-			Toy_emitASTNodeLiteral(&literalNode, readTypeToLiteral(parser));
+			Toy_emitASTNodeLiteral(&parser->arena, &literalNode, readTypeToLiteral(parser));
 
 			returnNode->fnCollection.nodes[returnNode->fnCollection.count++] = *literalNode;
-			TOY_FREE(Toy_ASTNode, literalNode);
 		} while(match(parser, TOY_TOKEN_COMMA));
 	}
 
@@ -1862,7 +1852,7 @@ static void fnDecl(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	blockStmt(parser, &blockNode);
 
 	//declare it
-	Toy_emitASTNodeFnDecl(nodeHandle, identifier, argumentNode, returnNode, blockNode);
+	Toy_emitASTNodeFnDecl(&parser->arena, nodeHandle, identifier, argumentNode, returnNode, blockNode);
 }
 
 static void declaration(Toy_Parser* parser, Toy_ASTNode** nodeHandle) { //assume nodeHandle holds a blank node
@@ -1880,13 +1870,30 @@ static void declaration(Toy_Parser* parser, Toy_ASTNode** nodeHandle) { //assume
 
 //exposed functions
 void Toy_initParser(Toy_Parser* parser, Toy_Lexer* lexer) {
+	Toy_initTokenBuffer(&parser->ownTokens, lexer->source);
+	Toy_tokenizeLexer(&parser->ownTokens, lexer);
+
+	Toy_initParserWithTokens(parser, &parser->ownTokens);
 	parser->lexer = lexer;
+}
+
+void Toy_initParserWithTokens(Toy_Parser* parser, Toy_TokenBuffer* tokens) {
+	parser->lexer = NULL;
 	parser->error = false;
 	parser->panic = false;
 
+	if (tokens != &parser->ownTokens) {
+		Toy_initTokenBuffer(&parser->ownTokens, NULL);
+	}
+
+	parser->tokens = tokens;
+	parser->position = 0;
+
 	parser->previous.type = TOY_TOKEN_NULL;
 	parser->current.type = TOY_TOKEN_NULL;
 	advance(parser);
+
+	Toy_initArena(&parser->arena, 1024 * 16);
 }
 
 void Toy_freeParser(Toy_Parser* parser) {
@@ -1896,6 +1903,12 @@ void Toy_freeParser(Toy_Parser* parser) {
 
 	parser->previous.type = TOY_TOKEN_NULL;
 	parser->current.type = TOY_TOKEN_NULL;
+
+	Toy_freeTokenBuffer(&parser->ownTokens);
+	parser->tokens = NULL;
+
+	//every node this parser produced is released here
+	Toy_freeArena(&parser->arena);
 }
 
 Toy_ASTNode* Toy_scanParser(Toy_Parser* parser) {
@@ -1904,7 +1917,7 @@ Toy_ASTNode* Toy_scanParser(Toy_Parser* parser) {
 		return NULL;
 	}
 
-	//returns nodes on the heap
+	//returns nodes in the arena, which live until the parser is freed
 	Toy_ASTNode* node = NULL;
 
 	//process the grammar rule for this line
@@ -1914,10 +1927,14 @@ Toy_ASTNode* Toy_scanParser(Toy_Parser* parser) {
 		synchronize(parser);
 		//return an error node for this iteration
 		Toy_freeASTNode(node);
-		node = TOY_ALLOCATE(Toy_ASTNode, 1);
+		node = TOY_ARENA_ALLOCATE(&parser->arena, Toy_ASTNode, 1);
 		node->type = TOY_AST_NODE_ERROR;
 	}
 
 	return node;
 }
 
+Toy_TokenType Toy_private_peekParser(Toy_Parser* parser, int distance) {
+	//position already points past the current token
+	return Toy_getTokenBuffer(parser->tokens, parser->position + distance - 1).type;
+}
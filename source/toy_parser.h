@@ -2,6 +2,7 @@
 
 #include "toy_common.h"
 #include "toy_lexer.h"
+#include "toy_token_buffer.h"
 #include "toy_ast_node.h"
 
 //DOCS: parsers are bound to a lexer, and turn the outputted tokens into AST nodes
@@ -10,11 +11,22 @@ typedef struct {
 	bool error; //I've had an error
 	bool panic; //I am processing an error
 
-	//track the last two outputs from the lexer
+	//the lexer's output is buffered in full before parsing begins
+	Toy_TokenBuffer ownTokens;
+	Toy_TokenBuffer* tokens; //either ownTokens, or a buffer prepared elsewhere
+	int position; //the index of the next token to read
+
+	//track the last two tokens read
 	Toy_Token current;
 	Toy_Token previous;
+
+	Toy_Arena arena; //every node, child array & lexeme copy is allocated here
 } Toy_Parser;
 
 TOY_API void Toy_initParser(Toy_Parser* parser, Toy_Lexer* lexer);
+TOY_API void Toy_initParserWithTokens(Toy_Parser* parser, Toy_TokenBuffer* tokens); //the buffer must outlive the parser
 TOY_API void Toy_freeParser(Toy_Parser* parser);
 TOY_API Toy_ASTNode* Toy_scanParser(Toy_Parser* parser);
+
+//the type of the token "distance" places after the current one
+TOY_API Toy_TokenType Toy_private_peekParser(Toy_Parser* parser, int distance);
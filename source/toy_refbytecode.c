@@ -0,0 +1,101 @@
+#include "toy_refbytecode.h"
+
+#include "toy_memory.h"
+
+#include <string.h>
+
+//API
+Toy_RefBytecode* Toy_createRefBytecode(const unsigned char* data, size_t length, Toy_ReleaseBytecodeFn release) {
+	Toy_RefBytecode* refBytecode = TOY_ALLOCATE(Toy_RefBytecode, 1);
+
+	refBytecode->data = data;
+	refBytecode->length = length;
+	refBytecode->refCount = 1;
+	refBytecode->release = release;
+	refBytecode->compiled = NULL;
+	refBytecode->compiledCount = 0;
+
+	return refBytecode;
+}
+
+Toy_RefBytecode* Toy_copyRefBytecode(Toy_RefBytecode* refBytecode) {
+	refBytecode->refCount++;
+	return refBytecode;
+}
+
+void Toy_deleteRefBytecode(Toy_RefBytecode* refBytecode) {
+	//decrement, then check
+	refBytecode->refCount--;
+	if (refBytecode->refCount <= 0) {
+		if (refBytecode->release) {
+			refBytecode->release(refBytecode->data, refBytecode->length);
+		}
+		TOY_FREE(Toy_RefBytecode, refBytecode);
+	}
+}
+
+Toy_CompiledFn Toy_findCompiledBody(Toy_RefBytecode* refBytecode, const unsigned char* body) {
+	int offset = (int)(body - refBytecode->data);
+	int low = 0;
+	int high = refBytecode->compiledCount - 1;
+
+	while (low <= high) {
+		int mid = (low + high) / 2;
+
+		if (refBytecode->compiled[mid].offset == offset) {
+			return refBytecode->compiled[mid].fn;
+		}
+		else if (refBytecode->compiled[mid].offset < offset) {
+			low = mid + 1;
+		}
+		else {
+			high = mid - 1;
+		}
+	}
+
+	return NULL;
+}
+
+void Toy_releaseOwnedBytecode(const unsigned char* bytecode, size_t length) {
+	TOY_FREE_ARRAY(unsigned char, bytecode, length);
+}
+
+Toy_RefFunction* Toy_createRefFunction(Toy_RefBytecode* owner, const unsigned char* data, size_t length) {
+	Toy_RefFunction* refFunction = TOY_ALLOCATE(Toy_RefFunction, 1);
+
+	//the body stays in the owner's buffer, so keep the owner alive
+	refFunction->owner = Toy_copyRefBytecode(owner);
+	refFunction->data = data;
+	refFunction->quickened = NULL;
+	refFunction->compiled = Toy_findCompiledBody(owner, data);
+	refFunction->length = length;
+	refFunction->refCount = 1;
+
+	return refFunction;
+}
+
+Toy_RefFunction* Toy_copyRefFunction(Toy_RefFunction* refFunction) {
+	refFunction->refCount++;
+	return refFunction;
+}
+
+unsigned char* Toy_quickenRefFunction(Toy_RefFunction* refFunction) {
+	if (refFunction->quickened == NULL) {
+		refFunction->quickened = TOY_ALLOCATE(unsigned char, refFunction->length);
+		memcpy(refFunction->quickened, refFunction->data, refFunction->length);
+	}
+
+	return refFunction->quickened;
+}
+
+void Toy_deleteRefFunction(Toy_RefFunction* refFunction) {
+	//decrement, then check
+	refFunction->refCount--;
+	if (refFunction->refCount <= 0) {
+		if (refFunction->quickened) {
+			TOY_FREE_ARRAY(unsigned char, refFunction->quickened, refFunction->length);
+		}
+		Toy_deleteRefBytecode(refFunction->owner);
+		TOY_FREE(Toy_RefFunction, refFunction);
+	}
+}
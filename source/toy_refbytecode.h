@@ -0,0 +1,50 @@
+#pragma once
+
+#include "toy_common.h"
+
+struct Toy_Interpreter;
+
+//a body compiled ahead of time by toy2c, found by where it begins in the bytecode
+typedef void (*Toy_CompiledFn)(struct Toy_Interpreter* interpreter);
+
+typedef struct Toy_CompiledBody {
+	int offset;
+	Toy_CompiledFn fn;
+} Toy_CompiledBody;
+
+//called when the last reference to a bytecode buffer is dropped - NULL means the buffer is borrowed, and is never released
+typedef void (*Toy_ReleaseBytecodeFn)(const unsigned char* bytecode, size_t length);
+
+//a read-only bytecode buffer, shared between interpreters and the functions read from it
+typedef struct Toy_RefBytecode {
+	const unsigned char* data;
+	size_t length;
+	int refCount;
+	Toy_ReleaseBytecodeFn release;
+	const Toy_CompiledBody* compiled; //sorted by offset, and run instead of the bytecode - NULL for none
+	int compiledCount;
+} Toy_RefBytecode;
+
+//a function body within a shared bytecode buffer
+typedef struct Toy_RefFunction {
+	Toy_RefBytecode* owner;
+	const unsigned char* data;
+	unsigned char* quickened; //a private copy of the body, made on the first call - it's executed instead, and rewritten as operand types are seen
+	Toy_CompiledFn compiled; //the body compiled ahead of time, if any
+	size_t length;
+	int refCount;
+} Toy_RefFunction;
+
+//API
+TOY_API Toy_RefBytecode* Toy_createRefBytecode(const unsigned char* data, size_t length, Toy_ReleaseBytecodeFn release);
+TOY_API Toy_RefBytecode* Toy_copyRefBytecode(Toy_RefBytecode* refBytecode);
+TOY_API void Toy_deleteRefBytecode(Toy_RefBytecode* refBytecode);
+
+TOY_API Toy_CompiledFn Toy_findCompiledBody(Toy_RefBytecode* refBytecode, const unsigned char* body);
+
+TOY_API void Toy_releaseOwnedBytecode(const unsigned char* bytecode, size_t length); //for buffers allocated with TOY_ALLOCATE
+
+TOY_API Toy_RefFunction* Toy_createRefFunction(Toy_RefBytecode* owner, const unsigned char* data, size_t length);
+TOY_API Toy_RefFunction* Toy_copyRefFunction(Toy_RefFunction* refFunction);
+TOY_API unsigned char* Toy_quickenRefFunction(Toy_RefFunction* refFunction); //the writable copy of the body, shared by every call
+TOY_API void Toy_deleteRefFunction(Toy_RefFunction* refFunction);
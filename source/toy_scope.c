@@ -2,6 +2,11 @@
 
 #include "toy_memory.h"
 
+#include <string.h>
+
+//only identifiers are declared, so their hashes are already at hand
+#define DECLARED_BIT(key) ((uint64_t)1 << (TOY_HASH_I(key) & 63))
+
 //run up the ancestor chain, freeing anything with 0 references left
 static void freeAncestorChain(Toy_Scope* scope) {
 	while (scope != NULL) {
@@ -170,6 +175,7 @@ Toy_Scope* Toy_pushScope(Toy_Scope* ancestor) {
 	scope->ancestor = ancestor;
 	Toy_initLiteralDictionary(&scope->variables);
 	Toy_initLiteralDictionary(&scope->types);
+	scope->declared = 0;
 
 	//tick up all scope reference counts
 	scope->references = 0;
@@ -215,6 +221,7 @@ Toy_Scope* Toy_copyScope(Toy_Scope* original) {
 	scope->ancestor = original->ancestor;
 	Toy_initLiteralDictionary(&scope->variables);
 	Toy_initLiteralDictionary(&scope->types);
+	scope->declared = original->declared;
 
 	//tick up all scope reference counts
 	scope->references = 0;
@@ -253,74 +260,233 @@ bool Toy_declareScopeVariable(Toy_Scope* scope, Toy_Literal key, Toy_Literal typ
 	Toy_setLiteralDictionary(&scope->types, key, type);
 
 	Toy_setLiteralDictionary(&scope->variables, key, TOY_TO_NULL_LITERAL);
+	scope->declared |= DECLARED_BIT(key);
 	return true;
 }
 
-bool Toy_isDelcaredScopeVariable(Toy_Scope* scope, Toy_Literal key) {
-	while (scope != NULL) {
-		if (Toy_existsLiteralDictionary(&scope->variables, key)) {
-			return true;
+//finds the scope declaring "key", how far up the chain it is, and the slot it's in
+static Toy_Scope* findVariable(Toy_Scope* scope, Toy_Literal key, int* hops, int* slot) {
+	const uint64_t bit = DECLARED_BIT(key);
+
+	for (int i = 0; scope != NULL; i++, scope = scope->ancestor) {
+		if (!(scope->declared & bit)) {
+			continue;
 		}
 
-		scope = scope->ancestor;
+		int index = Toy_findLiteralDictionary(&scope->variables, key);
+		if (index >= 0) {
+			*hops = i;
+			*slot = index;
+			return scope;
+		}
 	}
 
-	return false;
+	return NULL;
 }
 
-//return false if undefined, or can't be assigned
-bool Toy_setScopeVariable(Toy_Scope* scope, Toy_Literal key, Toy_Literal value, bool constCheck) {
-	while (scope != NULL) {
-		//if it's not in this scope, keep searching up the chain
-		if (!Toy_existsLiteralDictionary(&scope->variables, key)) {
-			scope = scope->ancestor;
-			continue;
-		}
+static Toy_Scope* findVariableCached(Toy_Scope* scope, Toy_ScopeCache* cache, Toy_Literal key, int* slot) {
+	Toy_ScopeCacheEntry* entry = &cache->entries[TOY_HASH_I(key) & (TOY_SCOPE_CACHE_SIZE - 1)];
 
-		//type checking
-		Toy_Literal typeLiteral = Toy_getLiteralDictionary(&scope->types, key);
-		Toy_Literal original = Toy_getLiteralDictionary(&scope->variables, key);
+	if (entry->name == TOY_AS_IDENTIFIER(key)) {
+		//nothing passed over can have declared it since
+		const uint64_t bit = DECLARED_BIT(key);
+		Toy_Scope* ptr = scope;
+		int i = 0;
 
-		if (!checkType(typeLiteral, original, value, constCheck)) {
-			Toy_freeLiteral(typeLiteral);
-			Toy_freeLiteral(original);
-			return false;
+		while (ptr != NULL && i < entry->hops && !(ptr->declared & bit)) {
+			ptr = ptr->ancestor;
+			i++;
+		}
+
+		//and it's still in the same slot
+		if (ptr != NULL && i == entry->hops && entry->slot < ptr->variables.capacity && Toy_literalsAreEqual(ptr->variables.entries[entry->slot].key, key)) {
+			*slot = entry->slot;
+			return ptr;
 		}
+	}
+
+	int hops = 0;
+	Toy_Scope* found = findVariable(scope, key, &hops, slot);
+
+	if (found != NULL) {
+		entry->name = TOY_AS_IDENTIFIER(key);
+		entry->hops = hops;
+		entry->slot = *slot;
+	}
 
-		//actually assign
-		Toy_setLiteralDictionary(&scope->variables, key, value); //key & value are copied here
+	return found;
+}
+
+static bool assignVariable(Toy_Scope* scope, int slot, Toy_Literal key, Toy_Literal value, bool constCheck) {
+	Toy_private_dictionary_entry* entry = &scope->variables.entries[slot];
+
+	//type checking, against the stored type & value
+	int typeIndex = Toy_findLiteralDictionary(&scope->types, key);
+	Toy_Literal typeLiteral = typeIndex >= 0 ? scope->types.entries[typeIndex].value : TOY_TO_NULL_LITERAL;
+
+	if (!checkType(typeLiteral, entry->value, value, constCheck)) {
+		return false;
+	}
 
-		Toy_freeLiteral(typeLiteral);
-		Toy_freeLiteral(original);
+	//actually assign, in place
+	Toy_Literal copy = Toy_copyLiteral(value);
+	Toy_freeLiteral(entry->value);
+	entry->value = copy;
 
+	return true;
+}
+
+//the same checks as checkType, for the whole compound with just this one element changed
+static bool checkElementType(Toy_Literal typeLiteral, Toy_Literal compound, Toy_Literal key, Toy_Literal original, Toy_Literal value, bool exists) {
+	if (TOY_AS_TYPE(typeLiteral).constant && (!exists || !Toy_literalsAreEqual(original, value))) {
+		return false;
+	}
+
+	if (TOY_AS_TYPE(typeLiteral).typeOf == TOY_LITERAL_ANY) {
 		return true;
 	}
 
-	return false;
+	Toy_Literal* subtypes = (Toy_Literal*)(TOY_AS_TYPE(typeLiteral).subtypes);
+
+	if (TOY_IS_ARRAY(compound)) {
+		return TOY_AS_TYPE(typeLiteral).typeOf == TOY_LITERAL_ARRAY && checkType(subtypes[0], original, value, true);
+	}
+
+	//new entries in dictionaries aren't checked
+	return TOY_AS_TYPE(typeLiteral).typeOf == TOY_LITERAL_DICTIONARY && (!exists || (checkType(subtypes[0], key, key, true) && checkType(subtypes[1], original, value, true)));
+}
+
+bool Toy_isDelcaredScopeVariable(Toy_Scope* scope, Toy_Literal key) {
+	int hops = 0;
+	int slot = 0;
+	return findVariable(scope, key, &hops, &slot) != NULL;
+}
+
+//return false if undefined, or can't be assigned
+bool Toy_setScopeVariable(Toy_Scope* scope, Toy_Literal key, Toy_Literal value, bool constCheck) {
+	int hops = 0;
+	int slot = 0;
+	scope = findVariable(scope, key, &hops, &slot);
+
+	return scope != NULL && assignVariable(scope, slot, key, value, constCheck);
 }
 
 bool Toy_getScopeVariable(Toy_Scope* scope, Toy_Literal key, Toy_Literal* valueHandle) {
-	//optimized to reduce call stack
-	while (scope != NULL) {
-		if (Toy_existsLiteralDictionary(&scope->variables, key)) {
-			*valueHandle = Toy_getLiteralDictionary(&scope->variables, key);
+	int hops = 0;
+	int slot = 0;
+	scope = findVariable(scope, key, &hops, &slot);
+
+	if (scope == NULL) {
+		return false;
+	}
+
+	*valueHandle = Toy_copyLiteral(scope->variables.entries[slot].value);
+	return true;
+}
+
+Toy_Literal Toy_getScopeType(Toy_Scope* scope, Toy_Literal key) {
+	int hops = 0;
+	int slot = 0;
+	scope = findVariable(scope, key, &hops, &slot);
+
+	if (scope == NULL) {
+		return TOY_TO_NULL_LITERAL;
+	}
+
+	return Toy_getLiteralDictionary(&scope->types, key);
+}
+
+bool Toy_isShadowedScopeVariable(Toy_Scope* scope, Toy_Literal key) {
+	uint64_t bit = DECLARED_BIT(key);
+
+	for (; scope != NULL && scope->ancestor != NULL; scope = scope->ancestor) {
+		if ((scope->declared & bit) && Toy_existsLiteralDictionary(&scope->variables, key)) {
 			return true;
 		}
-
-		scope = scope->ancestor;
 	}
 
 	return false;
 }
 
-Toy_Literal Toy_getScopeType(Toy_Scope* scope, Toy_Literal key) {
-	while (scope != NULL) {
-		if (Toy_existsLiteralDictionary(&scope->types, key)) {
-			return Toy_getLiteralDictionary(&scope->types, key);
+void Toy_initScopeCache(Toy_ScopeCache* cache) {
+	memset(cache, 0, sizeof(Toy_ScopeCache));
+}
+
+bool Toy_setScopeVariableCached(Toy_Scope* scope, Toy_ScopeCache* cache, Toy_Literal key, Toy_Literal value, bool constCheck) {
+	int slot = 0;
+	scope = findVariableCached(scope, cache, key, &slot);
+
+	return scope != NULL && assignVariable(scope, slot, key, value, constCheck);
+}
+
+bool Toy_getScopeVariableCached(Toy_Scope* scope, Toy_ScopeCache* cache, Toy_Literal key, Toy_Literal* valueHandle) {
+	int slot = 0;
+	scope = findVariableCached(scope, cache, key, &slot);
+
+	if (scope == NULL) {
+		return false;
+	}
+
+	*valueHandle = Toy_copyLiteral(scope->variables.entries[slot].value);
+	return true;
+}
+
+const Toy_Literal* Toy_findScopeVariableCached(Toy_Scope* scope, Toy_ScopeCache* cache, Toy_Literal key) {
+	int slot = 0;
+	scope = findVariableCached(scope, cache, key, &slot);
+
+	if (scope == NULL) {
+		return NULL;
+	}
+
+	return &scope->variables.entries[slot].value;
+}
+
+bool Toy_setScopeVariableElementCached(Toy_Scope* scope, Toy_ScopeCache* cache, Toy_Literal key, Toy_Literal index, Toy_Literal value) {
+	int slot = 0;
+	scope = findVariableCached(scope, cache, key, &slot);
+
+	if (scope == NULL) {
+		return false;
+	}
+
+	Toy_Literal compound = scope->variables.entries[slot].value;
+
+	int typeIndex = Toy_findLiteralDictionary(&scope->types, key);
+	if (typeIndex < 0) {
+		return false;
+	}
+
+	Toy_Literal typeLiteral = scope->types.entries[typeIndex].value;
+
+	if (TOY_IS_ARRAY(compound)) {
+		if (!TOY_IS_INTEGER(index) || TOY_AS_INTEGER(index) < 0 || TOY_AS_INTEGER(index) >= TOY_AS_ARRAY(compound)->count) {
+			return false;
+		}
+
+		if (!checkElementType(typeLiteral, compound, index, TOY_AS_ARRAY(compound)->literals[TOY_AS_INTEGER(index)], value, true)) {
+			return false;
 		}
 
-		scope = scope->ancestor;
+		return Toy_setLiteralArray(TOY_AS_ARRAY(compound), index, value);
 	}
 
-	return TOY_TO_NULL_LITERAL;
+	if (TOY_IS_DICTIONARY(compound)) {
+		//keys the dictionary would reject
+		if (TOY_IS_NULL(index) || TOY_IS_FUNCTION(index) || TOY_IS_FUNCTION_NATIVE(index) || TOY_IS_FUNCTION_HOOK(index) || TOY_IS_OPAQUE(index)) {
+			return false;
+		}
+
+		int entry = Toy_findLiteralDictionary(TOY_AS_DICTIONARY(compound), index);
+		Toy_Literal original = entry >= 0 ? TOY_AS_DICTIONARY(compound)->entries[entry].value : TOY_TO_NULL_LITERAL;
+
+		if (!checkElementType(typeLiteral, compound, index, original, value, entry >= 0)) {
+			return false;
+		}
+
+		Toy_setLiteralDictionary(TOY_AS_DICTIONARY(compound), index, value);
+		return true;
+	}
+
+	return false;
 }
@@ -9,8 +9,23 @@ typedef struct Toy_Scope {
 	Toy_LiteralDictionary types; //the types, indexed by identifiers
 	struct Toy_Scope* ancestor;
 	int references; //how many scopes point here
+	uint64_t declared; //a bit for each name declared here, by hash - lookups skip any scope where it's clear, without probing
 } Toy_Scope;
 
+//an inline cache, remembering how far up the chain a name was found, and the slot it's in
+//a hit is checked against the key in that slot, and the declarations in each scope passed over, so it never needs invalidating
+#define TOY_SCOPE_CACHE_SIZE 32
+
+typedef struct Toy_ScopeCacheEntry {
+	const Toy_RefString* name; //NOTE: never dereferenced, so it may dangle
+	int hops;
+	int slot;
+} Toy_ScopeCacheEntry;
+
+typedef struct Toy_ScopeCache {
+	Toy_ScopeCacheEntry entries[TOY_SCOPE_CACHE_SIZE];
+} Toy_ScopeCache;
+
 TOY_API Toy_Scope* Toy_pushScope(Toy_Scope* scope);
 TOY_API Toy_Scope* Toy_popScope(Toy_Scope* scope);
 TOY_API Toy_Scope* Toy_copyScope(Toy_Scope* original);
@@ -24,3 +39,17 @@ TOY_API bool Toy_setScopeVariable(Toy_Scope* scope, Toy_Literal key, Toy_Literal
 TOY_API bool Toy_getScopeVariable(Toy_Scope* scope, Toy_Literal key, Toy_Literal* value);
 
 TOY_API Toy_Literal Toy_getScopeType(Toy_Scope* scope, Toy_Literal key);
+
+//true if any scope but the outermost declares the key - most are passed over by their declarations, without probing
+TOY_API bool Toy_isShadowedScopeVariable(Toy_Scope* scope, Toy_Literal key);
+
+//the same lookups, through a cache kept by the caller
+TOY_API void Toy_initScopeCache(Toy_ScopeCache* cache);
+TOY_API bool Toy_setScopeVariableCached(Toy_Scope* scope, Toy_ScopeCache* cache, Toy_Literal key, Toy_Literal value, bool constCheck);
+TOY_API bool Toy_getScopeVariableCached(Toy_Scope* scope, Toy_ScopeCache* cache, Toy_Literal key, Toy_Literal* value);
+
+//the stored value itself, to be read in place without copying - NULL if undefined
+TOY_API const Toy_Literal* Toy_findScopeVariableCached(Toy_Scope* scope, Toy_ScopeCache* cache, Toy_Literal key);
+
+//assign to one element of an array or dictionary variable, in place - returns false if undefined, out of bounds, or the element can't be assigned
+TOY_API bool Toy_setScopeVariableElementCached(Toy_Scope* scope, Toy_ScopeCache* cache, Toy_Literal key, Toy_Literal index, Toy_Literal value);
@@ -0,0 +1,170 @@
+#include "toy_string_kernels.h"
+
+#include <string.h>
+
+//the vector paths process 16 bytes at a time, and the scalar loops handle the tails
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//utils
+static void caseUtil(char* dest, const char* src, size_t length, char first, char last, int delta) {
+	size_t i = 0;
+#if defined(__SSE2__)
+	//bytes above 127 compare as negative, so they're never in range
+	__m128i lower = _mm_set1_epi8(first - 1);
+	__m128i upper = _mm_set1_epi8(last + 1);
+	__m128i offset = _mm_set1_epi8((char)delta);
+
+	for (; i + 16 <= length; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128i mask = _mm_and_si128(_mm_cmpgt_epi8(v, lower), _mm_cmplt_epi8(v, upper));
+		_mm_storeu_si128((__m128i*)(dest + i), _mm_add_epi8(v, _mm_and_si128(mask, offset)));
+	}
+#endif
+	for (; i < length; i++) {
+		dest[i] = src[i] >= first && src[i] <= last ? (char)(src[i] + delta) : src[i];
+	}
+}
+
+#if defined(__SSE2__)
+//one bit for each byte of v found within set
+static int matchSetUtil(__m128i v, const char* set, size_t setLength) {
+	__m128i mask = _mm_setzero_si128();
+
+	for (size_t s = 0; s < setLength; s++) {
+		mask = _mm_or_si128(mask, _mm_cmpeq_epi8(v, _mm_set1_epi8(set[s])));
+	}
+
+	return _mm_movemask_epi8(mask);
+}
+#endif
+
+static void buildSetUtil(bool table[256], const char* set, size_t setLength) {
+	memset(table, 0, sizeof(bool) * 256);
+
+	for (size_t s = 0; s < setLength; s++) {
+		table[(unsigned char)set[s]] = true;
+	}
+}
+
+//large sets are cheaper through a lookup table than through one comparison per set member
+#define TOY_KERNEL_SMALL_SET 8
+
+//API
+void Toy_kernelToLower(char* dest, const char* src, size_t length) {
+	caseUtil(dest, src, length, 'A', 'Z', 'a' - 'A');
+}
+
+void Toy_kernelToUpper(char* dest, const char* src, size_t length) {
+	caseUtil(dest, src, length, 'a', 'z', 'A' - 'a');
+}
+
+size_t Toy_kernelSpanBegin(const char* str, size_t length, const char* set, size_t setLength) {
+	size_t i = 0;
+#if defined(__SSE2__)
+	if (setLength <= TOY_KERNEL_SMALL_SET) {
+		for (; i + 16 <= length; i += 16) {
+			int bits = matchSetUtil(_mm_loadu_si128((const __m128i*)(str + i)), set, setLength);
+
+			if (bits != 0xFFFF) {
+				return i + __builtin_ctz(~bits);
+			}
+		}
+	}
+#endif
+	bool table[256];
+	buildSetUtil(table, set, setLength);
+
+	while (i < length && table[(unsigned char)str[i]]) {
+		i++;
+	}
+
+	return i;
+}
+
+size_t Toy_kernelSpanEnd(const char* str, size_t length, const char* set, size_t setLength) {
+	size_t i = 0; //counted from the back
+#if defined(__SSE2__)
+	if (setLength <= TOY_KERNEL_SMALL_SET) {
+		for (; i + 16 <= length; i += 16) {
+			int bits = matchSetUtil(_mm_loadu_si128((const __m128i*)(str + length - i - 16)), set, setLength);
+
+			if (bits != 0xFFFF) {
+				//the highest unmatched byte is the last one kept
+				return i + 15 - (31 - __builtin_clz(~bits & 0xFFFF));
+			}
+		}
+	}
+#endif
+	bool table[256];
+	buildSetUtil(table, set, setLength);
+
+	while (i < length && table[(unsigned char)str[length - i - 1]]) {
+		i++;
+	}
+
+	return i;
+}
+
+int Toy_kernelFind(const char* haystack, size_t haystackLength, const char* needle, size_t needleLength) {
+	if (needleLength == 0) {
+		return 0;
+	}
+
+	if (needleLength > haystackLength) {
+		return -1;
+	}
+
+	size_t i = 0;
+#if defined(__SSE2__)
+	//compare the first and last bytes of each candidate at once, then confirm the rest
+	__m128i first = _mm_set1_epi8(needle[0]);
+	__m128i last = _mm_set1_epi8(needle[needleLength - 1]);
+
+	for (; i + needleLength - 1 + 16 <= haystackLength; i += 16) {
+		__m128i blockFirst = _mm_loadu_si128((const __m128i*)(haystack + i));
+		__m128i blockLast = _mm_loadu_si128((const __m128i*)(haystack + i + needleLength - 1));
+		int bits = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last)));
+
+		while (bits != 0) {
+			int offset = __builtin_ctz(bits);
+
+			if (memcmp(haystack + i + offset, needle, needleLength) == 0) {
+				return (int)(i + offset);
+			}
+
+			bits &= bits - 1;
+		}
+	}
+#endif
+	for (; i + needleLength <= haystackLength; i++) {
+		if (haystack[i] == needle[0] && memcmp(haystack + i, needle, needleLength) == 0) {
+			return (int)i;
+		}
+	}
+
+	return -1;
+}
+
+int Toy_kernelCount(const char* haystack, size_t haystackLength, const char* needle, size_t needleLength) {
+	if (needleLength == 0) {
+		return 0;
+	}
+
+	int count = 0;
+	size_t offset = 0;
+
+	for (;;) {
+		int found = Toy_kernelFind(haystack + offset, haystackLength - offset, needle, needleLength);
+
+		if (found < 0) {
+			break;
+		}
+
+		count++;
+		offset += found + needleLength;
+	}
+
+	return count;
+}
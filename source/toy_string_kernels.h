@@ -0,0 +1,17 @@
+#pragma once
+
+#include "toy_common.h"
+
+//bulk byte-wise operations shared by the string natives - these work on explicit lengths, and never allocate
+TOY_API void Toy_kernelToLower(char* dest, const char* src, size_t length);
+TOY_API void Toy_kernelToUpper(char* dest, const char* src, size_t length);
+
+//count the leading/trailing bytes of str found within set
+TOY_API size_t Toy_kernelSpanBegin(const char* str, size_t length, const char* set, size_t setLength);
+TOY_API size_t Toy_kernelSpanEnd(const char* str, size_t length, const char* set, size_t setLength);
+
+//returns the offset of the first needle within haystack, or -1 if there is none
+TOY_API int Toy_kernelFind(const char* haystack, size_t haystackLength, const char* needle, size_t needleLength);
+
+//counts the non-overlapping occurrences of needle within haystack
+TOY_API int Toy_kernelCount(const char* haystack, size_t haystackLength, const char* needle, size_t needleLength);
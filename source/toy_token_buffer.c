@@ -0,0 +1,229 @@
+#include "toy_token_buffer.h"
+
+#include "toy_memory.h"
+
+#include <string.h>
+
+void Toy_initTokenBuffer(Toy_TokenBuffer* buffer, const char* source) {
+	buffer->source = source;
+
+	buffer->types = NULL;
+	buffer->offsets = NULL;
+	buffer->lengths = NULL;
+	buffer->lines = NULL;
+	buffer->capacity = 0;
+	buffer->count = 0;
+
+	buffer->messages = NULL;
+	buffer->messageCapacity = 0;
+	buffer->messageCount = 0;
+}
+
+void Toy_freeTokenBuffer(Toy_TokenBuffer* buffer) {
+	TOY_FREE_ARRAY(unsigned char, buffer->types, buffer->capacity);
+	TOY_FREE_ARRAY(int, buffer->offsets, buffer->capacity);
+	TOY_FREE_ARRAY(int, buffer->lengths, buffer->capacity);
+	TOY_FREE_ARRAY(int, buffer->lines, buffer->capacity);
+	TOY_FREE_ARRAY(const char*, buffer->messages, buffer->messageCapacity);
+
+	Toy_initTokenBuffer(buffer, NULL);
+}
+
+static void reserveTokens(Toy_TokenBuffer* buffer, int count) {
+	if (buffer->count + count <= buffer->capacity) {
+		return;
+	}
+
+	int oldCapacity = buffer->capacity;
+
+	while (buffer->count + count > buffer->capacity) {
+		buffer->capacity = TOY_GROW_CAPACITY_FAST(buffer->capacity);
+	}
+
+	buffer->types = TOY_GROW_ARRAY(unsigned char, buffer->types, oldCapacity, buffer->capacity);
+	buffer->offsets = TOY_GROW_ARRAY(int, buffer->offsets, oldCapacity, buffer->capacity);
+	buffer->lengths = TOY_GROW_ARRAY(int, buffer->lengths, oldCapacity, buffer->capacity);
+	buffer->lines = TOY_GROW_ARRAY(int, buffer->lines, oldCapacity, buffer->capacity);
+}
+
+static int pushMessage(Toy_TokenBuffer* buffer, const char* message) {
+	if (buffer->messageCount + 1 > buffer->messageCapacity) {
+		int oldCapacity = buffer->messageCapacity;
+		buffer->messageCapacity = TOY_GROW_CAPACITY(oldCapacity);
+		buffer->messages = TOY_GROW_ARRAY(const char*, buffer->messages, oldCapacity, buffer->messageCapacity);
+	}
+
+	buffer->messages[buffer->messageCount] = message;
+	return buffer->messageCount++;
+}
+
+void Toy_pushTokenBuffer(Toy_TokenBuffer* buffer, Toy_Token token) {
+	reserveTokens(buffer, 1);
+
+	buffer->types[buffer->count] = (unsigned char)token.type;
+	buffer->offsets[buffer->count] = token.type == TOY_TOKEN_ERROR ? pushMessage(buffer, token.lexeme) : (int)(token.lexeme - buffer->source);
+	buffer->lengths[buffer->count] = token.length;
+	buffer->lines[buffer->count] = token.line;
+	buffer->count++;
+}
+
+Toy_Token Toy_getTokenBuffer(Toy_TokenBuffer* buffer, int index) {
+	Toy_Token token;
+
+	if (index >= buffer->count) {
+		//keep returning the EOF token, if there is one
+		if (buffer->count > 0 && buffer->types[buffer->count - 1] == TOY_TOKEN_EOF) {
+			return Toy_getTokenBuffer(buffer, buffer->count - 1);
+		}
+
+		token.type = TOY_TOKEN_EOF;
+		token.lexeme = "";
+		token.length = 0;
+		token.line = buffer->count > 0 ? buffer->lines[buffer->count - 1] : 1;
+		return token;
+	}
+
+	token.type = (Toy_TokenType)buffer->types[index];
+	token.lexeme = token.type == TOY_TOKEN_ERROR ? buffer->messages[buffer->offsets[index]] : buffer->source + buffer->offsets[index];
+	token.length = buffer->lengths[index];
+	token.line = buffer->lines[index];
+
+	return token;
+}
+
+void Toy_tokenizeLexer(Toy_TokenBuffer* buffer, Toy_Lexer* lexer) {
+	Toy_Token token;
+
+	do {
+		token = Toy_private_scanLexer(lexer);
+		Toy_pushTokenBuffer(buffer, token);
+	} while (token.type != TOY_TOKEN_EOF);
+}
+
+//chunks end after a semicolon or closing brace at the top level, outside of strings & comments - the lexer is context-free, so any of these is a safe place to restart it
+int Toy_splitTokenSource(const char* source, bool commentsEnabled, int chunks, int* starts, int* lines) {
+	const int length = (int)strlen(source);
+	const int target = length / (chunks > 0 ? chunks : 1);
+
+	int count = 0;
+	int depth = 0;
+	int line = 1;
+
+	starts[count] = 0;
+	lines[count] = 1;
+	count++;
+
+	for (int i = 0; i < length; i++) {
+		switch(source[i]) {
+			case '\n':
+				line++;
+				break;
+
+			case '"':
+				//mirrors the lexer's escapes
+				for (i++; i < length && source[i] != '"'; i++) {
+					if (source[i] == '\\' && (source[i + 1] == 'n' || source[i + 1] == 't' || source[i + 1] == '\\' || source[i + 1] == '"')) {
+						i++;
+					}
+					else if (source[i] == '\n') {
+						line++;
+					}
+				}
+				break;
+
+			case '/':
+				if (!commentsEnabled) {
+					break;
+				}
+
+				if (source[i + 1] == '/') {
+					const char* newline = strchr(source + i, '\n');
+					i = newline != NULL ? (int)(newline - source) - 1 : length; //the newline itself is counted above
+				}
+				else if (source[i + 1] == '*') {
+					for (i += 2; i < length && !(source[i] == '*' && source[i + 1] == '/'); i++) {
+						if (source[i] == '\n') {
+							line++;
+						}
+					}
+					i++;
+				}
+				break;
+
+			case '(':
+			case '[':
+			case '{':
+				depth++;
+				break;
+
+			case ')':
+			case ']':
+				depth--;
+				break;
+
+			case '}':
+				depth--;
+				//fallthrough
+
+			case ';':
+				if (depth == 0 && count < chunks && i + 1 - starts[count - 1] >= target && i + 1 < length) {
+					starts[count] = i + 1;
+					lines[count] = line;
+					count++;
+				}
+				break;
+		}
+	}
+
+	//the final entry marks the end
+	starts[count] = length;
+	lines[count] = line;
+
+	return count;
+}
+
+void Toy_tokenizeRange(Toy_TokenBuffer* buffer, int start, int end, int line, bool commentsEnabled) {
+	Toy_Lexer lexer;
+	Toy_initLexer(&lexer, buffer->source);
+	Toy_private_setComments(&lexer, commentsEnabled);
+
+	lexer.current = start;
+	lexer.line = line;
+
+	for (;;) {
+		Toy_Token token = Toy_private_scanLexer(&lexer);
+
+		//only the last chunk keeps the EOF token
+		if (token.type == TOY_TOKEN_EOF) {
+			if (buffer->source[end] == '\0') {
+				Toy_pushTokenBuffer(buffer, token);
+			}
+			return;
+		}
+
+		//anything from the end onwards belongs to the next chunk
+		if (lexer.start >= end) {
+			return;
+		}
+
+		Toy_pushTokenBuffer(buffer, token);
+	}
+}
+
+void Toy_appendTokenBuffer(Toy_TokenBuffer* buffer, Toy_TokenBuffer* other) {
+	reserveTokens(buffer, other->count);
+
+	memcpy(buffer->types + buffer->count, other->types, sizeof(unsigned char) * other->count);
+	memcpy(buffer->offsets + buffer->count, other->offsets, sizeof(int) * other->count);
+	memcpy(buffer->lengths + buffer->count, other->lengths, sizeof(int) * other->count);
+	memcpy(buffer->lines + buffer->count, other->lines, sizeof(int) * other->count);
+
+	//error tokens are renumbered into this buffer's messages
+	for (int i = 0; i < other->count; i++) {
+		if (other->types[i] == TOY_TOKEN_ERROR) {
+			buffer->offsets[buffer->count + i] = pushMessage(buffer, other->messages[other->offsets[i]]);
+		}
+	}
+
+	buffer->count += other->count;
+}
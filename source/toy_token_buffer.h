@@ -0,0 +1,36 @@
+#pragma once
+
+#include "toy_common.h"
+#include "toy_lexer.h"
+
+//DOCS: token buffers hold every token of a source at once, as parallel arrays - the parser reads from one, which gives it arbitrary lookahead
+typedef struct Toy_TokenBuffer {
+	const char* source;
+
+	unsigned char* types; //Toy_TokenType
+	int* offsets; //into the source, or into messages for error tokens
+	int* lengths;
+	int* lines;
+	int capacity;
+	int count;
+
+	//error tokens don't point into the source
+	const char** messages;
+	int messageCapacity;
+	int messageCount;
+} Toy_TokenBuffer;
+
+TOY_API void Toy_initTokenBuffer(Toy_TokenBuffer* buffer, const char* source);
+TOY_API void Toy_freeTokenBuffer(Toy_TokenBuffer* buffer);
+
+TOY_API void Toy_pushTokenBuffer(Toy_TokenBuffer* buffer, Toy_Token token);
+TOY_API Toy_Token Toy_getTokenBuffer(Toy_TokenBuffer* buffer, int index); //anything past the end is EOF
+
+//reads tokens from the lexer, up to and including EOF
+TOY_API void Toy_tokenizeLexer(Toy_TokenBuffer* buffer, Toy_Lexer* lexer);
+
+//for splitting the lexing across threads - each thread tokenizes one chunk of the same source into its own buffer, then they're appended in order
+//starts & lines need room for "chunks + 1" entries; returns the number of chunks found, and starts[count] is the end of the source
+TOY_API int Toy_splitTokenSource(const char* source, bool commentsEnabled, int chunks, int* starts, int* lines);
+TOY_API void Toy_tokenizeRange(Toy_TokenBuffer* buffer, int start, int end, int line, bool commentsEnabled);
+TOY_API void Toy_appendTokenBuffer(Toy_TokenBuffer* buffer, Toy_TokenBuffer* other);
@@ -0,0 +1,76 @@
+#include "toy_arena.h"
+
+#include "toy_console_colors.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main() {
+	{
+		//test init & free
+		Toy_Arena arena;
+		Toy_initArena(&arena, 256);
+		Toy_freeArena(&arena);
+	}
+
+	{
+		//test allocations are aligned, and spill into new blocks
+		Toy_Arena arena;
+		Toy_initArena(&arena, 256);
+
+		char* first = TOY_ARENA_ALLOCATE(&arena, char, 3);
+		int* second = TOY_ARENA_ALLOCATE(&arena, int, 2);
+
+		if ((size_t)second % 8 != 0 || (char*)second - first != 8) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Arena allocations are misaligned\n" TOY_CC_RESET);
+			Toy_freeArena(&arena);
+			return -1;
+		}
+
+		for (int i = 0; i < 100; i++) {
+			int* values = TOY_ARENA_ALLOCATE(&arena, int, 8);
+			memset(values, 0, sizeof(int) * 8);
+		}
+
+		//oversized requests get their own block, leaving the current one in use
+		Toy_ArenaBlock* current = arena.blocks;
+		char* large = TOY_ARENA_ALLOCATE(&arena, char, 1024);
+		memset(large, 0, 1024);
+
+		if (arena.blocks != current || arena.blocks->next->capacity != 1024) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Arena didn't place an oversized allocation correctly\n" TOY_CC_RESET);
+			Toy_freeArena(&arena);
+			return -1;
+		}
+
+		Toy_freeArena(&arena);
+	}
+
+	{
+		//test growing the last allocation happens in place, and anything else is moved
+		Toy_Arena arena;
+		Toy_initArena(&arena, 256);
+
+		int* array = TOY_ARENA_GROW_ARRAY(&arena, int, NULL, 0, 4);
+		for (int i = 0; i < 4; i++) {
+			array[i] = i;
+		}
+
+		int* grown = TOY_ARENA_GROW_ARRAY(&arena, int, array, 4, 8);
+
+		int* other = TOY_ARENA_ALLOCATE(&arena, int, 1);
+		int* moved = TOY_ARENA_GROW_ARRAY(&arena, int, grown, 8, 16);
+
+		if (grown != array || moved == grown || moved[3] != 3 || other == NULL) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Arena didn't grow an allocation correctly\n" TOY_CC_RESET);
+			Toy_freeArena(&arena);
+			return -1;
+		}
+
+		Toy_freeArena(&arena);
+	}
+
+	printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
+	return 0;
+}
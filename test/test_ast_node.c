@@ -16,12 +16,15 @@ int main() {
 	//test literals
 	{
 		//test literals
+		Toy_Arena arena;
+		Toy_initArena(&arena, 1024);
+
 		char* str = "foobar";
 		Toy_Literal literal = TOY_TO_STRING_LITERAL(Toy_createRefString(str));
 
 		//generate the node
 		Toy_ASTNode* node = NULL;
-		Toy_emitASTNodeLiteral(&node, literal);
+		Toy_emitASTNodeLiteral(&arena, &node, literal);
 
 		//check node type
 		ASSERT(node->type == TOY_AST_NODE_LITERAL);
@@ -29,19 +32,23 @@ int main() {
 		//cleanup
 		Toy_freeLiteral(literal);
 		Toy_freeASTNode(node);
+		Toy_freeArena(&arena);
 	}
 
 	//test unary
 	{
 		//generate the child node
+		Toy_Arena arena;
+		Toy_initArena(&arena, 1024);
+
 		char* str = "foobar";
 		Toy_Literal literal = TOY_TO_STRING_LITERAL(Toy_createRefString(str));
 		Toy_ASTNode* childNode = NULL;
-		Toy_emitASTNodeLiteral(&childNode, literal);
+		Toy_emitASTNodeLiteral(&arena, &childNode, literal);
 
 		//generate the unary node
 		Toy_ASTNode* unary = NULL;
-		Toy_emitASTNodeUnary(&unary, TOY_OP_PRINT, childNode);
+		Toy_emitASTNodeUnary(&arena, &unary, TOY_OP_PRINT, childNode);
 
 		//check node type
 		ASSERT(unary->type == TOY_AST_NODE_UNARY);
@@ -49,21 +56,25 @@ int main() {
 		//cleanup
 		Toy_freeLiteral(literal);
 		Toy_freeASTNode(unary);
+		Toy_freeArena(&arena);
 	}
 
 	//test binary
 	{
 		//generate the child node
+		Toy_Arena arena;
+		Toy_initArena(&arena, 1024);
+
 		char* str = "foobar";
 		Toy_Literal literal = TOY_TO_STRING_LITERAL(Toy_createRefString(str));
 		Toy_ASTNode* nodeHandle = NULL;
-		Toy_emitASTNodeLiteral(&nodeHandle, literal);
+		Toy_emitASTNodeLiteral(&arena, &nodeHandle, literal);
 
 		Toy_ASTNode* rhsChildNode = NULL;
-		Toy_emitASTNodeLiteral(&rhsChildNode, literal);
+		Toy_emitASTNodeLiteral(&arena, &rhsChildNode, literal);
 
 		//generate the unary node
-		Toy_emitASTNodeBinary(&nodeHandle, rhsChildNode, TOY_OP_PRINT);
+		Toy_emitASTNodeBinary(&arena, &nodeHandle, rhsChildNode, TOY_OP_PRINT);
 
 		//check node type
 		ASSERT(nodeHandle->type == TOY_AST_NODE_BINARY);
@@ -72,6 +83,7 @@ int main() {
 		//cleanup
 		Toy_freeLiteral(literal);
 		Toy_freeASTNode(nodeHandle);
+		Toy_freeArena(&arena);
 	}
 
 	//TODO: more tests for other AST node types
@@ -79,6 +91,9 @@ int main() {
 	//test compounds
 	{
 		//test compound (dictionary)
+		Toy_Arena arena;
+		Toy_initArena(&arena, 1024);
+
 		char* idn = "foobar";
 		char* str = "hello world";
 
@@ -89,16 +104,16 @@ int main() {
 		Toy_Literal identifier = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefString(idn));
 		Toy_Literal string = TOY_TO_STRING_LITERAL(Toy_createRefString(str));
 
-		Toy_emitASTNodeCompound(&dictionary, TOY_LITERAL_DICTIONARY);
-		Toy_emitASTNodeLiteral(&left, identifier);
-		Toy_emitASTNodeLiteral(&right, string);
+		Toy_emitASTNodeCompound(&arena, &dictionary, TOY_LITERAL_DICTIONARY);
+		Toy_emitASTNodeLiteral(&arena, &left, identifier);
+		Toy_emitASTNodeLiteral(&arena, &right, string);
 
 		//grow the node if needed
 		if (dictionary->compound.capacity < dictionary->compound.count + 1) {
 			int oldCapacity = dictionary->compound.capacity;
 
 			dictionary->compound.capacity = TOY_GROW_CAPACITY(oldCapacity);
-			dictionary->compound.nodes = TOY_GROW_ARRAY(Toy_ASTNode, dictionary->compound.nodes, oldCapacity, dictionary->compound.capacity);
+			dictionary->compound.nodes = TOY_ARENA_GROW_ARRAY(&arena, Toy_ASTNode, dictionary->compound.nodes, oldCapacity, dictionary->compound.capacity);
 		}
 
 		//store the left and right in the node
@@ -108,6 +123,30 @@ int main() {
 		Toy_freeASTNode(dictionary);
 		Toy_freeLiteral(identifier);
 		Toy_freeLiteral(string);
+		Toy_freeArena(&arena);
+	}
+
+	//test declarations keep the nodes compact
+	{
+		ASSERT(sizeof(Toy_ASTNode) <= 40);
+
+		Toy_Arena arena;
+		Toy_initArena(&arena, 1024);
+
+		Toy_Literal identifier = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefString("foobar"));
+		Toy_Literal typeLiteral = TOY_TO_TYPE_LITERAL(TOY_LITERAL_INTEGER, true);
+
+		Toy_ASTNode* node = NULL;
+		Toy_emitASTNodeVarDecl(&arena, &node, Toy_copyLiteral(identifier), typeLiteral, NULL);
+
+		ASSERT(node->type == TOY_AST_NODE_VAR_DECL);
+		ASSERT(Toy_literalsAreEqual(*node->varDecl.identifier, identifier));
+		ASSERT(TOY_AS_TYPE(*node->varDecl.typeLiteral).constant);
+
+		//cleanup
+		Toy_freeLiteral(identifier);
+		Toy_freeASTNode(node);
+		Toy_freeArena(&arena);
 	}
 
 	printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
@@ -0,0 +1,317 @@
+#include "toy_lexer.h"
+#include "toy_parser.h"
+#include "toy_ast_optimizer.h"
+#include "toy_compiler.h"
+#include "toy_interpreter.h"
+
+#include "toy_console_colors.h"
+
+#include "toy_memory.h"
+
+#include "../repl/repl_tools.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//suppress the print output
+static void noPrintFn(const char* output) {
+	//NO OP
+}
+
+//keep the last line printed
+static char lastPrint[256] = "";
+static void lastPrintFn(const char* output) {
+	snprintf(lastPrint, sizeof(lastPrint), "%s", output);
+}
+
+int failedAssertions = 0;
+static void noAssertFn(const char* output) {
+	if (strncmp(output, "!ignore", 7) == 0) {
+		return;
+	}
+
+	failedAssertions++;
+	fprintf(stderr, TOY_CC_ERROR "Assertion failure: ");
+	fprintf(stderr, "%s", output);
+	fprintf(stderr, "\n" TOY_CC_RESET); //default new line
+}
+
+//fold each node, then compile it and return the collated bytecode
+static unsigned char* compileFolded(const char* source, size_t* size, Toy_ASTOptimizer* optimizer) {
+	Toy_Lexer lexer;
+	Toy_Parser parser;
+	Toy_Compiler compiler;
+
+	Toy_initLexer(&lexer, source);
+	Toy_initParser(&parser, &lexer);
+	Toy_initCompiler(&compiler);
+
+	Toy_ASTNode* node = Toy_scanParser(&parser);
+	while (node != NULL) {
+		if (node->type == TOY_AST_NODE_ERROR) {
+			Toy_freeASTNode(node);
+			Toy_freeParser(&parser);
+			Toy_freeCompiler(&compiler);
+			return NULL;
+		}
+
+		Toy_optimizeASTNode(optimizer, node);
+		Toy_writeCompiler(&compiler, node);
+		Toy_freeASTNode(node);
+
+		node = Toy_scanParser(&parser);
+	}
+
+	unsigned char* bytecode = Toy_collateCompiler(&compiler, size);
+
+	Toy_freeParser(&parser);
+	Toy_freeCompiler(&compiler);
+
+	return bytecode;
+}
+
+static void runBinaryCustom(unsigned char* tb, size_t size) {
+	Toy_Interpreter interpreter;
+	Toy_initInterpreter(&interpreter);
+
+	//NOTE: suppress print output for testing
+	Toy_setInterpreterPrint(&interpreter, noPrintFn);
+	Toy_setInterpreterAssert(&interpreter, noAssertFn);
+
+	Toy_runInterpreter(&interpreter, tb, size);
+	Toy_freeInterpreter(&interpreter);
+}
+
+int main() {
+	{
+		//test init & free
+		Toy_ASTOptimizer optimizer;
+		Toy_initASTOptimizer(&optimizer);
+		Toy_freeASTOptimizer(&optimizer);
+	}
+
+	{
+		//test constants are propagated into the expressions that follow
+		const char* source = "var x: int const = 4; print -(x * 2 + 1);";
+
+		Toy_Lexer lexer;
+		Toy_Parser parser;
+		Toy_ASTOptimizer optimizer;
+
+		Toy_initLexer(&lexer, source);
+		Toy_initParser(&parser, &lexer);
+		Toy_initASTOptimizer(&optimizer);
+
+		Toy_ASTNode* decl = Toy_scanParser(&parser);
+		Toy_optimizeASTNode(&optimizer, decl);
+
+		Toy_ASTNode* print = Toy_scanParser(&parser);
+		Toy_optimizeASTNode(&optimizer, print);
+
+		if (print->type != TOY_AST_NODE_UNARY || print->unary.child->type != TOY_AST_NODE_LITERAL || !TOY_IS_INTEGER(print->unary.child->atomic.literal) || TOY_AS_INTEGER(print->unary.child->atomic.literal) != -9) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: The AST optimizer failed to propagate a constant\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		Toy_freeASTNode(decl);
+		Toy_freeASTNode(print);
+		Toy_freeASTOptimizer(&optimizer);
+		Toy_freeParser(&parser);
+	}
+
+	{
+		//test dead branches are removed, but a variable that isn't constant is left alone
+		const char* source = "var x = 1; var debug: bool const = false; if (debug) { x = 2; } while (!true) { x = 3; } print debug ? x : 0; x;";
+
+		Toy_ASTOptimizer optimizer;
+		Toy_initASTOptimizer(&optimizer);
+
+		size_t size = 0;
+		unsigned char* tb = compileFolded(source, &size, &optimizer);
+
+		if (!tb || optimizer.branchesRemoved != 3) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: The AST optimizer removed the wrong number of branches (%d)\n" TOY_CC_RESET, optimizer.branchesRemoved);
+			return -1;
+		}
+
+		runBinaryCustom(tb, size);
+		Toy_freeASTOptimizer(&optimizer);
+	}
+
+	{
+		//test small functions are inlined, unless the arguments or the result may not type check, or the arithmetic may be given null
+		const char* source = "fn add(a: int, b: int): int { return a + b; } fn id(x: int): int { return x; } var x: int = 1; var y = 1; print add(1, 2); print add(x, x); print add(y, 1); print id(4); print id(x);";
+
+		Toy_ASTOptimizer optimizer;
+		Toy_initASTOptimizer(&optimizer);
+
+		size_t size = 0;
+		unsigned char* tb = compileFolded(source, &size, &optimizer);
+
+		if (!tb || optimizer.callsInlined != 2) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: The AST optimizer inlined the wrong number of calls (%d)\n" TOY_CC_RESET, optimizer.callsInlined);
+			return -1;
+		}
+
+		runBinaryCustom(tb, size);
+		Toy_freeASTOptimizer(&optimizer);
+
+		//test inlining can be disabled
+		Toy_initASTOptimizer(&optimizer);
+		optimizer.inlining = false;
+
+		tb = compileFolded(source, &size, &optimizer);
+
+		if (!tb || optimizer.callsInlined != 0) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: The AST optimizer inlined calls while disabled\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		runBinaryCustom(tb, size);
+		Toy_freeASTOptimizer(&optimizer);
+	}
+
+	{
+		//test calls that may raise an error aren't inlined, as the error would stop the script instead of the call
+		const char* source = "fn d(a: int, b: int) { return a / b; } fn inc(a) { return a + 1; } var x: int = null; print d(1, 0); print inc(x); print inc(\"a\"); print d(6, 2); print \"after\";";
+
+		Toy_ASTOptimizer optimizer;
+		Toy_initASTOptimizer(&optimizer);
+
+		size_t size = 0;
+		unsigned char* tb = compileFolded(source, &size, &optimizer);
+
+		if (!tb || optimizer.callsInlined != 1) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: The AST optimizer inlined calls that may raise an error (%d)\n" TOY_CC_RESET, optimizer.callsInlined);
+			return -1;
+		}
+
+		Toy_Interpreter interpreter;
+		Toy_initInterpreter(&interpreter);
+		Toy_setInterpreterPrint(&interpreter, lastPrintFn);
+		Toy_setInterpreterError(&interpreter, noPrintFn);
+
+		Toy_runInterpreter(&interpreter, tb, size);
+		Toy_freeInterpreter(&interpreter);
+		Toy_freeASTOptimizer(&optimizer);
+
+		if (strcmp(lastPrint, "after") != 0) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: The script stopped at an inlined error\n" TOY_CC_RESET);
+			return -1;
+		}
+	}
+
+	{
+		//test arithmetic on declared types is specialized, but untyped operands are left alone
+		const char* source = "var a: int = 1; var b: float = 2.0; var c = 3; print a + a < b * a; print a + c;";
+
+		Toy_Lexer lexer;
+		Toy_Parser parser;
+		Toy_ASTOptimizer optimizer;
+
+		Toy_initLexer(&lexer, source);
+		Toy_initParser(&parser, &lexer);
+		Toy_initASTOptimizer(&optimizer);
+
+		Toy_ASTNode* nodes[5];
+		for (int i = 0; i < 5; i++) {
+			nodes[i] = Toy_scanParser(&parser);
+			Toy_optimizeASTNode(&optimizer, nodes[i]);
+		}
+
+		Toy_ASTNode* compare = nodes[3]->unary.child;
+		Toy_ASTNode* untyped = nodes[4]->unary.child;
+
+		if (compare->binary.opcode != TOY_OP_COMPARE_LESS || compare->binary.left->binary.opcode != TOY_OP_ADDITION_INT || compare->binary.right->binary.opcode != TOY_OP_MULTIPLICATION_FLOAT || untyped->binary.opcode != TOY_OP_ADDITION) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: The AST optimizer specialized the wrong opcodes\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		for (int i = 0; i < 5; i++) {
+			Toy_freeASTNode(nodes[i]);
+		}
+		Toy_freeASTOptimizer(&optimizer);
+		Toy_freeParser(&parser);
+	}
+
+	{
+		//run each file in tests/scripts/ with the AST optimizer
+		const char* filenames[] = {
+			"arithmetic.toy",
+			"builtin-shadowing.toy",
+			"casting-parentheses-bugfix.toy",
+			"casting.toy",
+			"coercions.toy",
+			"comparisons.toy",
+			"constant-folding.toy",
+			"dot-and-matrix.toy",
+			"dot-assignments-bugfix.toy",
+			"dot-chaining.toy",
+			"dot-modulo-bugfix.toy",
+			"dottify-bugfix.toy",
+			"functions.toy",
+			"index-arrays.toy",
+			"index-assignment-both-bugfix.toy",
+			"index-assignment-left-bugfix.toy",
+			"index-dictionaries.toy",
+			"index-in-place.toy",
+			"index-strings.toy",
+			"inlining.toy",
+			"jumps.toy",
+			"jumps-in-functions.toy",
+			"logicals.toy",
+			"long-array.toy",
+			"long-dictionary.toy",
+			"long-literals.toy",
+			"native-functions.toy",
+			"or-chaining-bugfix.toy",
+			"panic-within-functions.toy",
+			"polyfill-insert.toy",
+			"polyfill-remove.toy",
+			"quickening.toy",
+			"registers.toy",
+			"scope-caching.toy",
+			"short-circuiting-support.toy",
+			"superinstructions.toy",
+			"tail-calls.toy",
+			"ternary-expressions.toy",
+			"typed-arithmetic.toy",
+			"types.toy",
+			NULL
+		};
+
+		for (int i = 0; filenames[i]; i++) {
+			printf("Running %s\n", filenames[i]);
+
+			char buffer[128];
+			snprintf(buffer, 128, "scripts/%s", filenames[i]);
+
+			size_t sourceLength = 0;
+			const char* source = (const char*)Toy_readFile(buffer, &sourceLength);
+
+			Toy_ASTOptimizer optimizer;
+			Toy_initASTOptimizer(&optimizer);
+
+			size_t size = 0;
+			unsigned char* tb = compileFolded(source, &size, &optimizer);
+			free((void*)source);
+			Toy_freeASTOptimizer(&optimizer);
+
+			if (!tb) {
+				fprintf(stderr, TOY_CC_ERROR "ERROR: Failed to compile %s\n" TOY_CC_RESET, filenames[i]);
+				return -1;
+			}
+
+			runBinaryCustom(tb, size);
+		}
+	}
+
+	if (failedAssertions > 0) {
+		fprintf(stderr, TOY_CC_ERROR "Assertions failed: %d\n" TOY_CC_RESET, failedAssertions);
+		return -1;
+	}
+
+	printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
+	return 0;
+}
@@ -24,6 +24,31 @@ void error(char* msg) {
 	exit(-1);
 }
 
+//a native reading it's arguments in place
+static int nativeSum(Toy_Interpreter* interpreter, Toy_Literal* arguments, int count) {
+	int total = 0;
+
+	for (int i = 0; i < count; i++) {
+		Toy_Literal argIdn = arguments[i];
+		if (TOY_IS_IDENTIFIER(argIdn) && Toy_parseIdentifierToValue(interpreter, &arguments[i])) {
+			Toy_freeLiteral(argIdn);
+		}
+
+		if (!TOY_IS_INTEGER(arguments[i])) {
+			interpreter->errorOutput("Expected integers in sum\n");
+			return -1;
+		}
+
+		total += TOY_AS_INTEGER(arguments[i]);
+	}
+
+	Toy_Literal result = TOY_TO_INTEGER_LITERAL(total);
+	Toy_pushLiteralArray(&interpreter->stack, result);
+	Toy_freeLiteral(result);
+
+	return 1;
+}
+
 int main() {
 	{
 		size_t size = 0;
@@ -241,6 +266,49 @@ int main() {
 		Toy_freeInterpreter(&interpreter);
 	}
 
+	{
+		//natives reading their arguments in place can be called from both Toy and the host
+		size_t size = 0;
+		const unsigned char* tb = Toy_compileString("var a = 2; assert sum(a, 3) == 5, \"sum failed\"; assert sum() == 0, \"empty sum failed\"; assert sum(a, a, 1 + 1) == 6, \"nested sum failed\";", &size);
+
+		if (!tb) {
+			return -1;
+		}
+
+		Toy_Interpreter interpreter;
+		Toy_initInterpreter(&interpreter);
+		Toy_injectNativeViewFn(&interpreter, "sum", nativeSum);
+		Toy_runInterpreter(&interpreter, tb, size);
+
+		if (interpreter.panic) {
+			error("Native view failed in Toy");
+		}
+
+		interpreter.printOutput("Testing native view");
+
+		Toy_LiteralArray arguments;
+		Toy_initLiteralArray(&arguments);
+		Toy_LiteralArray returns;
+		Toy_initLiteralArray(&returns);
+
+		Toy_Literal one = TOY_TO_INTEGER_LITERAL(1);
+		Toy_Literal two = TOY_TO_INTEGER_LITERAL(2);
+		Toy_pushLiteralArray(&arguments, one);
+		Toy_pushLiteralArray(&arguments, two);
+
+		if (!Toy_callFn(&interpreter, "sum", &arguments, &returns)) {
+			error("Native view couldn't be called");
+		}
+
+		if (returns.count != 1 || !TOY_IS_INTEGER(returns.literals[0]) || TOY_AS_INTEGER(returns.literals[0]) != 3) {
+			error("Native view returned the wrong value");
+		}
+
+		Toy_freeLiteralArray(&arguments);
+		Toy_freeLiteralArray(&returns);
+		Toy_freeInterpreter(&interpreter);
+	}
+
 	printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
 	return 0;
 }
@@ -0,0 +1,110 @@
+#include "repl_cache.h"
+
+#include "toy_console_colors.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static bool checkDigest(const char* input, const char* expected) {
+	unsigned char digest[TOY_SHA256_SIZE];
+	Toy_hashSHA256((const unsigned char*)input, strlen(input), digest);
+
+	char hex[TOY_SHA256_SIZE * 2 + 1];
+	for (int i = 0; i < TOY_SHA256_SIZE; i++) {
+		snprintf(hex + i * 2, 3, "%02x", digest[i]);
+	}
+
+	return !strcmp(hex, expected);
+}
+
+int main() {
+	{
+		//test the hash against known digests, including ones that need a second padding block
+		if (
+			!checkDigest("", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855") ||
+			!checkDigest("abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad") ||
+			!checkDigest("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1")
+		) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: SHA-256 digest is wrong\n" TOY_CC_RESET);
+			return -1;
+		}
+	}
+
+	{
+		//test repeated sources are only compiled once, and the least recently used is evicted
+		Toy_initCompileCache(2, NULL);
+
+		Toy_RefBytecode* first = Toy_compileCached("print 1;");
+		Toy_RefBytecode* second = Toy_compileCached("print 2;");
+		Toy_RefBytecode* again = Toy_compileCached("print 1;"); //first is now the most recent
+		Toy_RefBytecode* third = Toy_compileCached("print 3;"); //evicts second
+		Toy_RefBytecode* evicted = Toy_compileCached("print 2;");
+
+		Toy_CompileCacheStats stats = Toy_getCompileCacheStats();
+
+		if (again != first || evicted == second || stats.memoryHits != 1 || stats.misses != 4) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Compile cache didn't hit or evict correctly\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		Toy_deleteRefBytecode(first);
+		Toy_deleteRefBytecode(second);
+		Toy_deleteRefBytecode(again);
+		Toy_deleteRefBytecode(third);
+		Toy_deleteRefBytecode(evicted);
+		Toy_freeCompileCache();
+	}
+
+	{
+		//test failed compilations aren't cached
+		Toy_initCompileCache(2, NULL);
+
+		if (Toy_compileCached("print +;") != NULL || Toy_compileCached("print +;") != NULL || Toy_getCompileCacheStats().memoryHits != 0) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Compile cache kept a failed compilation\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		Toy_freeCompileCache();
+	}
+
+	{
+		//test the bytecode is kept on disk between runs
+		const char* source = "var a = 42; print a;";
+
+		Toy_initCompileCache(0, ".");
+		Toy_RefBytecode* compiled = Toy_compileCached(source);
+
+		Toy_initCompileCache(0, ".");
+		Toy_RefBytecode* loaded = Toy_compileCached(source);
+
+		Toy_CompileCacheStats stats = Toy_getCompileCacheStats();
+
+		if (loaded == NULL || stats.diskHits != 1 || stats.misses != 0 || loaded->length != compiled->length || memcmp(loaded->data, compiled->data, compiled->length)) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Compile cache didn't load from disk\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		Toy_deleteRefBytecode(compiled);
+		Toy_deleteRefBytecode(loaded);
+		Toy_freeCompileCache();
+
+		//clean up the file, which is named by the digest
+		char path[128] = "./";
+		unsigned char digest[TOY_SHA256_SIZE];
+		Toy_hashCompileCacheKey(source, digest);
+
+		for (int i = 0; i < TOY_SHA256_SIZE; i++) {
+			snprintf(path + 2 + i * 2, 3, "%02x", digest[i]);
+		}
+		strcat(path, ".tb");
+
+		if (remove(path) != 0) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Compile cache file wasn't named by its digest: %s\n" TOY_CC_RESET, path);
+			return -1;
+		}
+	}
+
+	printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
+	return 0;
+}
@@ -88,6 +88,94 @@ int main() {
 		Toy_freeCompiler(&compiler);
 	}
 
+	{
+		//test literal deduplication, with enough literals to grow the index several times
+		char* source = TOY_ALLOCATE(char, 1024 * 64);
+		int length = 0;
+
+		for (int i = 0; i < 2000; i++) {
+			length += snprintf(source + length, 32, "print %d;print %d.0;", i, i);
+		}
+		length += snprintf(source + length, 128, "var a: [int] = [0];var b: [int] = [0];print \"0\";print \"0\";print 1999;");
+
+		Toy_Lexer lexer;
+		Toy_Parser parser;
+		Toy_Compiler compiler;
+
+		Toy_initLexer(&lexer, source);
+		Toy_initParser(&parser, &lexer);
+		Toy_initCompiler(&compiler);
+
+		Toy_ASTNode* node = Toy_scanParser(&parser);
+		while (node != NULL) {
+			Toy_writeCompiler(&compiler, node);
+			Toy_freeASTNode(node);
+			node = Toy_scanParser(&parser);
+		}
+
+		//count each kind of literal
+		int counts[TOY_LITERAL_INDEX_BLANK + 1] = { 0 };
+		for (int i = 0; i < compiler.literalCache.count; i++) {
+			counts[compiler.literalCache.literals[i].type]++;
+		}
+
+		//ints & floats are never merged, and the type of both arrays is only stored once
+		if (counts[TOY_LITERAL_INTEGER] != 2000 || counts[TOY_LITERAL_FLOAT] != 2000 || counts[TOY_LITERAL_STRING] != 1 || counts[TOY_LITERAL_TYPE_INTERMEDIATE] != 1) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Literals were not deduplicated correctly\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		//cleanup
+		TOY_FREE_ARRAY(char, source, 1024 * 64);
+		Toy_freeParser(&parser);
+		Toy_freeCompiler(&compiler);
+	}
+
+	{
+		//test function bodies are compiled for the register engine, unless they use something it can't run
+		char* source = "fn f(x) { var y = x; return y; } fn g(x) { var y = [x]; return y; }";
+
+		Toy_Lexer lexer;
+		Toy_Parser parser;
+		Toy_Compiler compiler;
+
+		Toy_initLexer(&lexer, source);
+		Toy_initParser(&parser, &lexer);
+		Toy_initCompiler(&compiler);
+		compiler.registers = true;
+
+		Toy_ASTNode* node = Toy_scanParser(&parser);
+		while (node != NULL) {
+			Toy_writeCompiler(&compiler, node);
+			Toy_freeASTNode(node);
+			node = Toy_scanParser(&parser);
+		}
+
+		//the body follows the parameter & return indexes
+		bool registers[2] = { false, false };
+		int functions = 0;
+		for (int i = 0; i < compiler.literalCache.count && functions < 2; i++) {
+			if (compiler.literalCache.literals[i].type == TOY_LITERAL_FUNCTION_INTERMEDIATE) {
+				Toy_Compiler* fnCompiler = compiler.literalCache.literals[i].as.function.inner.bytecode;
+				registers[functions++] = fnCompiler->count > 4 && fnCompiler->bytecode[4] == TOY_OP_REGISTER_CODE;
+			}
+		}
+
+		if (functions != 2 || !registers[0] || registers[1]) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Function bodies were not compiled for the right engine\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		//collate, which releases the function compilers
+		size_t size = 0;
+		unsigned char* bytecode = Toy_collateCompiler(&compiler, &size);
+
+		//cleanup
+		TOY_FREE_ARRAY(unsigned char, bytecode, size);
+		Toy_freeParser(&parser);
+		Toy_freeCompiler(&compiler);
+	}
+
 	printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
 	return 0;
 }
@@ -9,6 +9,7 @@
 
 #include "../repl/repl_tools.h"
 
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -58,6 +59,26 @@ void runSourceFileCustom(const char* fname) {
 	free((void*)source);
 }
 
+//collect the print output
+static char output[256];
+static size_t outputLength = 0;
+
+static void collectFn(const char* str) {
+	size_t length = strlen(str);
+	if (outputLength + length + 1 < sizeof(output)) {
+		memcpy(output + outputLength, str, length);
+		outputLength += length;
+		output[outputLength++] = '\n';
+	}
+}
+
+//stands in for a body compiled ahead of time
+static int calls = 0;
+static void resumeBody(Toy_Interpreter* interpreter) {
+	calls++;
+	Toy_resumeInterpreter(interpreter, 1);
+}
+
 int main() {
 	{
 		//test init & free
@@ -104,14 +125,173 @@ int main() {
 		Toy_freeInterpreter(&interpreter);
 	}
 
+	{
+		//test sharing one bytecode buffer between interpreters
+		size_t size = 0;
+		const unsigned char* tb = Toy_compileString("fn double(x) { return x * 2; } assert double(21) == 42, \"shared bytecode failed\";", &size);
+
+		Toy_RefBytecode* source = Toy_createRefBytecode(tb, size, Toy_releaseOwnedBytecode);
+
+		Toy_Interpreter first;
+		Toy_Interpreter second;
+		Toy_initInterpreter(&first);
+		Toy_initInterpreter(&second);
+		Toy_setInterpreterAssert(&first, noAssertFn);
+		Toy_setInterpreterAssert(&second, noAssertFn);
+
+		Toy_runInterpreterShared(&first, source);
+		Toy_runInterpreterShared(&second, source);
+
+		//each function left in scope still points into the buffer
+		if (source->refCount != 3) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Unexpected shared bytecode reference count %d\n" TOY_CC_RESET, source->refCount);
+			return -1;
+		}
+
+		Toy_freeInterpreter(&first);
+		Toy_freeInterpreter(&second);
+
+		if (source->refCount != 1) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Shared bytecode was not released by the interpreters\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		Toy_deleteRefBytecode(source);
+	}
+
+	{
+		//test jumps beyond 64KB of code, in the top level and within a function
+		const char* statement = "total = total + 1;\n";
+		const int repeats = 15000; //each statement is 5 bytes of code
+
+		size_t length = strlen(statement) * repeats * 2 + 1024;
+		char* source = malloc(length);
+		char* ptr = source;
+
+		ptr += sprintf(ptr, "var total = 0;\nvar i = 0;\nwhile (i < 2) {\ni++;\nif (i == 2) { continue; }\n");
+		for (int i = 0; i < repeats; i++) {
+			ptr += sprintf(ptr, "%s", statement);
+		}
+		ptr += sprintf(ptr, "}\nfn count(total) {\nfor (var j = 0; j < 3; j++) {\nif (j == 2) { break; }\n");
+		for (int i = 0; i < repeats; i++) {
+			ptr += sprintf(ptr, "%s", statement);
+		}
+		ptr += sprintf(ptr, "}\nreturn total;\n}\nassert total == %d, \"wide jumps failed\";\nassert count(0) == %d, \"wide jumps in functions failed\";\n", repeats, repeats * 2);
+
+		size_t size = 0;
+		const unsigned char* tb = Toy_compileString(source, &size);
+
+		if (!tb || size < 65536 * 2) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Failed to compile the wide jump test\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		runBinaryCustom(tb, size);
+		free(source);
+	}
+
+	{
+		//test the memory given to calls limits how deep they go, but not calls in tail position
+		size_t size = 0;
+		const unsigned char* tb = Toy_compileString("fn nested(n) { var m = n; if (m <= 0) return 0; return nested(m - 1) + 1; } fn tail(n) { var m = n; if (m <= 0) return 0; return tail(m - 1); } assert tail(1000) == 0, \"tail calls failed\"; var result = nested(1000);", &size);
+
+		Toy_Interpreter interpreter;
+		Toy_initInterpreter(&interpreter);
+		Toy_setInterpreterPrint(&interpreter, noPrintFn);
+		Toy_setInterpreterAssert(&interpreter, noAssertFn);
+		Toy_setInterpreterError(&interpreter, noPrintFn);
+		interpreter.callMemory = 16 * 1024;
+
+		Toy_runInterpreter(&interpreter, tb, size);
+
+		bool panicked = interpreter.panic;
+		Toy_freeInterpreter(&interpreter);
+
+		if (!panicked) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Calls were not limited by their memory\n" TOY_CC_RESET);
+			return -1;
+		}
+	}
+
+	{
+		//test bodies compiled ahead of time are found by their offset, and run in place of the bytecode
+		size_t size = 0;
+		const unsigned char* tb = Toy_compileString("fn f(x) { var y = x * 2; return y; } var total = 0; for (var i = 0; i < 4; i++) { total += f(i); } print total;", &size);
+
+		//every offset has a body, so the main code and the function are both found
+		Toy_CompiledBody* bodies = malloc(sizeof(Toy_CompiledBody) * size);
+		for (int i = 0; i < (int)size; i++) {
+			bodies[i].offset = i;
+			bodies[i].fn = resumeBody;
+		}
+
+		Toy_RefBytecode* source = Toy_createRefBytecode(tb, size, Toy_releaseOwnedBytecode);
+		source->compiled = bodies;
+		source->compiledCount = (int)size;
+
+		Toy_Interpreter interpreter;
+		Toy_initInterpreter(&interpreter);
+		Toy_setInterpreterPrint(&interpreter, collectFn);
+		Toy_setInterpreterError(&interpreter, collectFn);
+
+		Toy_runInterpreterShared(&interpreter, source);
+		Toy_freeInterpreter(&interpreter);
+		Toy_deleteRefBytecode(source);
+		free(bodies);
+
+		output[outputLength] = '\0';
+
+		if (calls != 5 || strcmp(output, "12\n") != 0) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Compiled bodies were not run as expected (%d)\n" TOY_CC_RESET, calls);
+			return -1;
+		}
+	}
+
+	{
+		//test a section size that would overflow past the end of the bytecode is rejected
+		size_t size = 0;
+		unsigned char* tb = (unsigned char*)Toy_compileString("print \"unreachable\";", &size);
+
+		//skip the version, build string and section end, then find the aligned table
+		int count = 3;
+		count += strlen((char*)tb + count) + 1;
+		count++;
+		while (count % TOY_SECTION_ALIGNMENT != 0) {
+			count++;
+		}
+
+		int huge = INT_MAX;
+		memcpy(tb + count + TOY_SECTION_CODE * 8 + 4, &huge, sizeof(int));
+
+		Toy_Interpreter interpreter;
+		Toy_initInterpreter(&interpreter);
+		Toy_setInterpreterPrint(&interpreter, collectFn);
+		Toy_setInterpreterError(&interpreter, collectFn);
+
+		outputLength = 0;
+		Toy_runInterpreter(&interpreter, tb, size);
+
+		bool panicked = interpreter.panic;
+		Toy_freeInterpreter(&interpreter);
+
+		output[outputLength] = '\0';
+
+		if (!panicked || strstr(output, "unreachable") != NULL) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: An overflowing section size was accepted\n" TOY_CC_RESET);
+			return -1;
+		}
+	}
+
 	{
 		//run each file in tests/scripts/
 		const char* filenames[] = {
 			"arithmetic.toy",
+			"builtin-shadowing.toy",
 			"casting-parentheses-bugfix.toy",
 			"casting.toy",
 			"coercions.toy",
 			"comparisons.toy",
+			"constant-folding.toy",
 			"dot-and-matrix.toy",
 			"dot-assignments-bugfix.toy",
 			"dot-chaining.toy",
@@ -122,7 +302,9 @@ int main() {
 			"index-assignment-both-bugfix.toy",
 			"index-assignment-left-bugfix.toy",
 			"index-dictionaries.toy",
+			"index-in-place.toy",
 			"index-strings.toy",
+			"inlining.toy",
 			"jumps.toy",
 			"jumps-in-functions.toy",
 			"logicals.toy",
@@ -134,8 +316,14 @@ int main() {
 			"panic-within-functions.toy",
 			"polyfill-insert.toy",
 			"polyfill-remove.toy",
+			"quickening.toy",
+			"registers.toy",
+			"scope-caching.toy",
 			"short-circuiting-support.toy",
+			"superinstructions.toy",
+			"tail-calls.toy",
 			"ternary-expressions.toy",
+			"typed-arithmetic.toy",
 			"types.toy",
 			NULL
 		};
@@ -148,10 +336,24 @@ int main() {
 
 			runSourceFileCustom(buffer);
 		}
+
+		//then again, with function bodies run by the register engine
+		Toy_commandLine.registers = true;
+
+		for (int i = 0; filenames[i]; i++) {
+			printf("Running %s with registers\n", filenames[i]);
+
+			char buffer[128];
+			snprintf(buffer, 128, "scripts/%s", filenames[i]);
+
+			runSourceFileCustom(buffer);
+		}
+
+		Toy_commandLine.registers = false;
 	}
 
-	//1, to allow for the assertion test
-	if (ignoredAssertions > 1) {
+	//2, to allow for the assertion test under each engine
+	if (ignoredAssertions > 2) {
 		fprintf(stderr, TOY_CC_ERROR "Assertions hidden: %d\n", ignoredAssertions);
 		return -1;
 	}
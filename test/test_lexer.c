@@ -1,4 +1,5 @@
 #include "toy_lexer.h"
+#include "toy_keyword_types.h"
 
 #include "toy_console_colors.h"
 
@@ -43,6 +44,52 @@ int main() {
 		}
 	}
 
+	{
+		//test every keyword is recognized, and nothing else
+		for (int i = 0; Toy_keywordTypes[i].keyword; i++) {
+			Toy_Lexer lexer;
+			Toy_initLexer(&lexer, Toy_keywordTypes[i].keyword);
+
+			Toy_Token token = Toy_private_scanLexer(&lexer);
+
+			if (token.type != Toy_keywordTypes[i].type || Toy_findTypeByKeyword(Toy_keywordTypes[i].keyword) != Toy_keywordTypes[i].type) {
+				fprintf(stderr, TOY_CC_ERROR "ERROR: keyword not recognized: %s\n" TOY_CC_RESET, Toy_keywordTypes[i].keyword);
+				return -1;
+			}
+		}
+
+		char* identifiers[] = { "a", "i", "fo", "nul", "nulls", "typeo", "asserts", "continu", "_while", "while_", "format", "tru", "xs", NULL };
+
+		for (int i = 0; identifiers[i]; i++) {
+			Toy_Lexer lexer;
+			Toy_initLexer(&lexer, identifiers[i]);
+
+			Toy_Token token = Toy_private_scanLexer(&lexer);
+
+			if (token.type != TOY_TOKEN_IDENTIFIER || token.length != (int)strlen(identifiers[i]) || Toy_findTypeByKeyword(identifiers[i]) != TOY_TOKEN_EOF) {
+				fprintf(stderr, TOY_CC_ERROR "ERROR: identifier mistaken for a keyword: %s\n" TOY_CC_RESET, identifiers[i]);
+				return -1;
+			}
+		}
+	}
+
+	{
+		//test whitespace & comments are skipped, and lines are still counted
+		char* source = "  \t// line comment\n/* block\ncomment\n*/\r\n  var/**/x // trailing";
+
+		Toy_Lexer lexer;
+		Toy_initLexer(&lexer, source);
+
+		Toy_Token var = Toy_private_scanLexer(&lexer);
+		Toy_Token x = Toy_private_scanLexer(&lexer);
+		Toy_Token eof = Toy_private_scanLexer(&lexer);
+
+		if (var.type != TOY_TOKEN_VAR || var.line != 5 || x.type != TOY_TOKEN_IDENTIFIER || x.length != 1 || eof.type != TOY_TOKEN_EOF) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: whitespace or comments were not skipped correctly\n" TOY_CC_RESET);
+			return -1;
+		}
+	}
+
 	printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
 	return 0;
 }
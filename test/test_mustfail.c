@@ -103,7 +103,10 @@ int main() {
 			"declare-types-dictionary-value.toy",
 			"index-access-bugfix.toy",
 			"index-arrays-non-integer.toy",
+			"index-assign-constant.toy",
+			"infinite-recursion.toy",
 			"string-concat.toy",
+			"tail-call-return-type.toy",
 			"unary-inverted-nothing.toy",
 			"unary-negative-nothing.toy",
 			NULL
@@ -0,0 +1,135 @@
+#include "toy_opcode_profile.h"
+#include "toy_opcodes.h"
+#include "toy_interpreter.h"
+
+#include "toy_console_colors.h"
+
+#include "../repl/repl_tools.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//suppress the print output
+static void noPrintFn(const char* output) {
+	//NO OP
+}
+
+static int countOf(Toy_OpcodeProfile* profile, const unsigned char* opcodes, int length) {
+	Toy_OpcodeSequence results[64];
+	int found = Toy_rankOpcodeProfile(profile, length, results, 64);
+
+	for (int i = 0; i < found && i < 64; i++) {
+		if (memcmp(results[i].opcodes, opcodes, length) == 0) {
+			return results[i].hits;
+		}
+	}
+
+	return 0;
+}
+
+int main() {
+	{
+		//test init & free
+		Toy_OpcodeProfile profile;
+		Toy_initOpcodeProfile(&profile);
+		Toy_freeOpcodeProfile(&profile);
+	}
+
+	{
+		//test counting & ranking sequences
+		Toy_OpcodeProfile profile;
+		Toy_initOpcodeProfile(&profile);
+
+		for (int i = 0; i < 3; i++) {
+			Toy_recordOpcodeProfile(&profile, TOY_OP_LITERAL);
+			Toy_recordOpcodeProfile(&profile, TOY_OP_LITERAL);
+			Toy_recordOpcodeProfile(&profile, TOY_OP_ADDITION);
+			Toy_recordOpcodeProfile(&profile, TOY_OP_JUMP); //sequences end here
+		}
+
+		const unsigned char pair[] = { TOY_OP_LITERAL, TOY_OP_LITERAL };
+		const unsigned char run[] = { TOY_OP_LITERAL, TOY_OP_LITERAL, TOY_OP_ADDITION, TOY_OP_JUMP };
+		const unsigned char across[] = { TOY_OP_JUMP, TOY_OP_LITERAL };
+
+		if (countOf(&profile, pair, 2) != 3 || countOf(&profile, run, 4) != 3 || countOf(&profile, across, 2) != 0) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Opcode profile counted the wrong sequences\n" TOY_CC_RESET);
+			Toy_freeOpcodeProfile(&profile);
+			return -1;
+		}
+
+		//the most frequent comes first
+		Toy_OpcodeSequence results[2];
+		Toy_recordOpcodeProfile(&profile, TOY_OP_PRINT);
+		Toy_recordOpcodeProfile(&profile, TOY_OP_POP_STACK);
+
+		if (Toy_rankOpcodeProfile(&profile, 2, results, 2) < 2 || results[0].hits < results[1].hits || results[0].hits != 3) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Opcode profile ranked sequences incorrectly\n" TOY_CC_RESET);
+			Toy_freeOpcodeProfile(&profile);
+			return -1;
+		}
+
+		Toy_freeOpcodeProfile(&profile);
+	}
+
+	{
+		//test profiling a script, which should use the superinstructions in it's loop
+		size_t size = 0;
+		const unsigned char* tb = Toy_compileString("var total = 0; for (var i = 0; i < 100; i++) { total += i; } assert total == 4950, \"profiled loop failed\";", &size);
+
+		Toy_OpcodeProfile profile;
+		Toy_initOpcodeProfile(&profile);
+
+		Toy_Interpreter interpreter;
+		Toy_initInterpreter(&interpreter);
+		Toy_setInterpreterPrint(&interpreter, noPrintFn);
+		interpreter.profile = &profile;
+
+		Toy_runInterpreter(&interpreter, tb, size);
+		Toy_freeInterpreter(&interpreter);
+
+		const unsigned char compareJump[] = { TOY_OP_COMPARE_JUMP };
+		const unsigned char arithmeticAssign[] = { TOY_OP_VAR_ARITHMETIC_ASSIGN };
+
+		if (countOf(&profile, compareJump, 1) != 101 || countOf(&profile, arithmeticAssign, 1) != 200) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Superinstructions were not executed as expected (%d, %d)\n" TOY_CC_RESET, countOf(&profile, compareJump, 1), countOf(&profile, arithmeticAssign, 1));
+			Toy_freeOpcodeProfile(&profile);
+			return -1;
+		}
+
+		Toy_freeOpcodeProfile(&profile);
+	}
+
+	{
+		//test functions quicken their arithmetic once the types are seen, and fall back when they change
+		size_t size = 0;
+		const unsigned char* tb = Toy_compileString("fn f(a, b) { var c = a * b; return c; } var x = 0; for (var i = 0; i < 10; i++) { x = f(i, 2); } x = f(1.5, 2); x = f(2.5, 2); x = f(3, 2); assert x == 6, \"quickened function failed\";", &size);
+
+		Toy_OpcodeProfile profile;
+		Toy_initOpcodeProfile(&profile);
+
+		Toy_Interpreter interpreter;
+		Toy_initInterpreter(&interpreter);
+		Toy_setInterpreterPrint(&interpreter, noPrintFn);
+		interpreter.profile = &profile;
+
+		Toy_runInterpreter(&interpreter, tb, size);
+		Toy_freeInterpreter(&interpreter);
+
+		const unsigned char generic[] = { TOY_OP_MULTIPLICATION };
+		const unsigned char integer[] = { TOY_OP_MULTIPLICATION_INT };
+		const unsigned char floating[] = { TOY_OP_MULTIPLICATION_FLOAT };
+
+		//the ints are quickened by the first call, the first float fails the guard, the second float is quickened, and the last call fails the guard again
+		if (countOf(&profile, generic, 1) != 2 || countOf(&profile, integer, 1) != 10 || countOf(&profile, floating, 1) != 1) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Arithmetic was not quickened as expected (%d, %d, %d)\n" TOY_CC_RESET, countOf(&profile, generic, 1), countOf(&profile, integer, 1), countOf(&profile, floating, 1));
+			Toy_freeOpcodeProfile(&profile);
+			return -1;
+		}
+
+		Toy_freeOpcodeProfile(&profile);
+	}
+
+	printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
+	return 0;
+}
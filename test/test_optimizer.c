@@ -0,0 +1,200 @@
+#include "toy_lexer.h"
+#include "toy_parser.h"
+#include "toy_compiler.h"
+#include "toy_optimizer.h"
+#include "toy_interpreter.h"
+
+#include "toy_console_colors.h"
+
+#include "toy_memory.h"
+
+#include "../repl/repl_tools.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//suppress the print output
+static void noPrintFn(const char* output) {
+	//NO OP
+}
+
+int failedAssertions = 0;
+static void noAssertFn(const char* output) {
+	if (strncmp(output, "!ignore", 7) == 0) {
+		return;
+	}
+
+	failedAssertions++;
+	fprintf(stderr, TOY_CC_ERROR "Assertion failure: ");
+	fprintf(stderr, "%s", output);
+	fprintf(stderr, "\n" TOY_CC_RESET); //default new line
+}
+
+//compile with the optimizer, and return the collated bytecode
+static unsigned char* compileOptimized(const char* source, size_t* size, Toy_OptimizerStats* stats) {
+	Toy_Lexer lexer;
+	Toy_Parser parser;
+	Toy_Compiler compiler;
+
+	Toy_initLexer(&lexer, source);
+	Toy_initParser(&parser, &lexer);
+	Toy_initCompiler(&compiler);
+
+	Toy_ASTNode* node = Toy_scanParser(&parser);
+	while (node != NULL) {
+		if (node->type == TOY_AST_NODE_ERROR) {
+			Toy_freeASTNode(node);
+			Toy_freeParser(&parser);
+			Toy_freeCompiler(&compiler);
+			return NULL;
+		}
+
+		Toy_writeCompiler(&compiler, node);
+		Toy_freeASTNode(node);
+
+		node = Toy_scanParser(&parser);
+	}
+
+	Toy_optimizeCompiler(&compiler, stats);
+
+	unsigned char* bytecode = Toy_collateCompiler(&compiler, size);
+
+	Toy_freeParser(&parser);
+	Toy_freeCompiler(&compiler);
+
+	return bytecode;
+}
+
+static void runBinaryCustom(unsigned char* tb, size_t size) {
+	Toy_Interpreter interpreter;
+	Toy_initInterpreter(&interpreter);
+
+	//NOTE: suppress print output for testing
+	Toy_setInterpreterPrint(&interpreter, noPrintFn);
+	Toy_setInterpreterAssert(&interpreter, noAssertFn);
+
+	Toy_runInterpreter(&interpreter, tb, size);
+	Toy_freeInterpreter(&interpreter);
+}
+
+int main() {
+	{
+		//test the optimizer removes redundant instructions, without changing the result
+		const char* source = "var a = 0; { a = (1 + 2) * (3); } pass; while (a < 10) { if (a == 5) { a += 2; continue; } a++; } assert a == 10, \"optimized result incorrect\";";
+
+		Toy_OptimizerStats stats;
+		Toy_initOptimizerStats(&stats);
+
+		size_t size = 0;
+		unsigned char* tb = compileOptimized(source, &size, &stats);
+
+		size_t plainSize = 0;
+		const unsigned char* plain = Toy_compileString(source, &plainSize);
+
+		if (!tb || !plain || stats.instructionsRemoved == 0 || stats.bytesRemoved == 0 || size >= plainSize) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: The optimizer failed to remove anything (%d instructions, %d bytes)\n" TOY_CC_RESET, stats.instructionsRemoved, stats.bytesRemoved);
+			return -1;
+		}
+
+		runBinaryCustom(tb, size);
+		TOY_FREE_ARRAY(unsigned char, plain, plainSize);
+	}
+
+	{
+		//test jump threading, with nested branches that end together
+		const char* source = "var r = 0; for (var i = 0; i < 4; i++) { if (i < 2) { if (i == 0) { r += 1; } else { r += 10; } } else { r += 100; } } assert r == 211, \"threaded jumps incorrect\";";
+
+		Toy_OptimizerStats stats;
+		Toy_initOptimizerStats(&stats);
+
+		size_t size = 0;
+		unsigned char* tb = compileOptimized(source, &size, &stats);
+
+		if (!tb || stats.jumpsThreaded == 0) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: The optimizer failed to thread any jumps\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		runBinaryCustom(tb, size);
+	}
+
+	{
+		//run each file in tests/scripts/ with the optimizer
+		const char* filenames[] = {
+			"arithmetic.toy",
+			"builtin-shadowing.toy",
+			"casting-parentheses-bugfix.toy",
+			"casting.toy",
+			"coercions.toy",
+			"comparisons.toy",
+			"constant-folding.toy",
+			"dot-and-matrix.toy",
+			"dot-assignments-bugfix.toy",
+			"dot-chaining.toy",
+			"dot-modulo-bugfix.toy",
+			"dottify-bugfix.toy",
+			"functions.toy",
+			"index-arrays.toy",
+			"index-assignment-both-bugfix.toy",
+			"index-assignment-left-bugfix.toy",
+			"index-dictionaries.toy",
+			"index-in-place.toy",
+			"index-strings.toy",
+			"inlining.toy",
+			"jumps.toy",
+			"jumps-in-functions.toy",
+			"logicals.toy",
+			"long-array.toy",
+			"long-dictionary.toy",
+			"long-literals.toy",
+			"native-functions.toy",
+			"or-chaining-bugfix.toy",
+			"panic-within-functions.toy",
+			"polyfill-insert.toy",
+			"polyfill-remove.toy",
+			"quickening.toy",
+			"registers.toy",
+			"scope-caching.toy",
+			"short-circuiting-support.toy",
+			"superinstructions.toy",
+			"tail-calls.toy",
+			"ternary-expressions.toy",
+			"typed-arithmetic.toy",
+			"types.toy",
+			NULL
+		};
+
+		for (int i = 0; filenames[i]; i++) {
+			printf("Running %s\n", filenames[i]);
+
+			char buffer[128];
+			snprintf(buffer, 128, "scripts/%s", filenames[i]);
+
+			size_t sourceLength = 0;
+			const char* source = (const char*)Toy_readFile(buffer, &sourceLength);
+
+			Toy_OptimizerStats stats;
+			Toy_initOptimizerStats(&stats);
+
+			size_t size = 0;
+			unsigned char* tb = compileOptimized(source, &size, &stats);
+			free((void*)source);
+
+			if (!tb) {
+				fprintf(stderr, TOY_CC_ERROR "ERROR: Failed to compile %s\n" TOY_CC_RESET, filenames[i]);
+				return -1;
+			}
+
+			runBinaryCustom(tb, size);
+		}
+	}
+
+	if (failedAssertions > 0) {
+		fprintf(stderr, TOY_CC_ERROR "Assertions failed: %d\n" TOY_CC_RESET, failedAssertions);
+		return -1;
+	}
+
+	printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
+	return 0;
+}
@@ -159,6 +159,39 @@ int main() {
 		Toy_freeParser(&parser);
 	}
 
+	{
+		//test parsing from a prepared token buffer, with lookahead
+		const char* source = "var a = 1;\nprint a;";
+
+		Toy_Lexer lexer;
+		Toy_initLexer(&lexer, source);
+
+		Toy_TokenBuffer tokens;
+		Toy_initTokenBuffer(&tokens, source);
+		Toy_tokenizeLexer(&tokens, &lexer);
+
+		Toy_Parser parser;
+		Toy_initParserWithTokens(&parser, &tokens);
+
+		if (Toy_private_peekParser(&parser, 0) != TOY_TOKEN_VAR || Toy_private_peekParser(&parser, 5) != TOY_TOKEN_PRINT || Toy_private_peekParser(&parser, 100) != TOY_TOKEN_EOF) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Parser lookahead is wrong\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		Toy_ASTNode* first = Toy_scanParser(&parser);
+		Toy_ASTNode* second = Toy_scanParser(&parser);
+
+		if (first == NULL || first->type != TOY_AST_NODE_VAR_DECL || second == NULL || second->type != TOY_AST_NODE_UNARY || Toy_scanParser(&parser) != NULL) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Parsing from a token buffer failed\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		Toy_freeASTNode(first);
+		Toy_freeASTNode(second);
+		Toy_freeParser(&parser);
+		Toy_freeTokenBuffer(&tokens);
+	}
+
 	printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
 	return 0;
 }
@@ -118,6 +118,93 @@ int main() {
 		Toy_freeLiteral(type);
 	}
 
+	{
+		//prerequisites
+		Toy_Literal identifier = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefString("foobar"));
+		Toy_Literal type = TOY_TO_TYPE_LITERAL(TOY_LITERAL_INTEGER, false);
+
+		Toy_ScopeCache cache;
+		Toy_initScopeCache(&cache);
+
+		//test cached lookups see assignments, and new declarations between the cached scope and the caller
+		Toy_Scope* scope = Toy_pushScope(NULL);
+		Toy_declareScopeVariable(scope, identifier, type);
+		Toy_setScopeVariable(scope, identifier, TOY_TO_INTEGER_LITERAL(42), true);
+
+		scope = Toy_pushScope(scope);
+		scope = Toy_pushScope(scope);
+
+		Toy_Literal ref = TOY_TO_NULL_LITERAL;
+		if (!Toy_getScopeVariableCached(scope, &cache, identifier, &ref) || TOY_AS_INTEGER(ref) != 42) {
+			printf(TOY_CC_ERROR "Failed to get the scope variable (cached)" TOY_CC_RESET);
+			return -1;
+		}
+
+		if (!Toy_setScopeVariableCached(scope, &cache, identifier, TOY_TO_INTEGER_LITERAL(43), true) || !Toy_getScopeVariableCached(scope, &cache, identifier, &ref) || TOY_AS_INTEGER(ref) != 43) {
+			printf(TOY_CC_ERROR "Failed to set the scope variable (cached)" TOY_CC_RESET);
+			return -1;
+		}
+
+		//shadow it in the middle scope
+		Toy_declareScopeVariable(scope->ancestor, identifier, type);
+		Toy_setScopeVariable(scope->ancestor, identifier, TOY_TO_INTEGER_LITERAL(69), true);
+
+		if (!Toy_getScopeVariableCached(scope, &cache, identifier, &ref) || TOY_AS_INTEGER(ref) != 69) {
+			printf(TOY_CC_ERROR "Failed to retreive the correct variable value (cached shadowing)" TOY_CC_RESET);
+			return -1;
+		}
+
+		//a fresh scope in the same place still resolves
+		scope = Toy_popScope(scope);
+		scope = Toy_popScope(scope);
+		scope = Toy_pushScope(scope);
+
+		if (!Toy_getScopeVariableCached(scope, &cache, identifier, &ref) || TOY_AS_INTEGER(ref) != 43) {
+			printf(TOY_CC_ERROR "Failed to retreive the correct variable value (cached unwind)" TOY_CC_RESET);
+			return -1;
+		}
+
+		//cleanup
+		scope = Toy_popScope(scope);
+		scope = Toy_popScope(scope);
+
+		Toy_freeLiteral(identifier);
+		Toy_freeLiteral(type);
+	}
+
+	{
+		//prerequisites
+		Toy_Literal identifier = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefString("length"));
+		Toy_Literal type = TOY_TO_TYPE_LITERAL(TOY_LITERAL_INTEGER, false);
+
+		//test declarations in the outermost scope don't count as shadowing, but any further in do
+		Toy_Scope* scope = Toy_pushScope(NULL);
+		Toy_declareScopeVariable(scope, identifier, type);
+
+		scope = Toy_pushScope(scope);
+		scope = Toy_pushScope(scope);
+
+		if (Toy_isShadowedScopeVariable(scope, identifier)) {
+			printf(TOY_CC_ERROR "Found shadowing in the outermost scope" TOY_CC_RESET);
+			return -1;
+		}
+
+		Toy_declareScopeVariable(scope->ancestor, identifier, type);
+
+		if (!Toy_isShadowedScopeVariable(scope, identifier)) {
+			printf(TOY_CC_ERROR "Failed to find the shadowing variable" TOY_CC_RESET);
+			return -1;
+		}
+
+		//cleanup
+		scope = Toy_popScope(scope);
+		scope = Toy_popScope(scope);
+		scope = Toy_popScope(scope);
+
+		Toy_freeLiteral(identifier);
+		Toy_freeLiteral(type);
+	}
+
 	printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
 	return 0;
 }
@@ -0,0 +1,142 @@
+#include "toy_token_buffer.h"
+
+#include "toy_console_colors.h"
+
+#include "toy_memory.h"
+
+#include "../repl/repl_tools.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//tokenize the source in chunks, and compare it to tokenizing all at once
+static int compareChunks(const char* source, int chunks) {
+	Toy_Lexer lexer;
+	Toy_initLexer(&lexer, source);
+
+	Toy_TokenBuffer whole;
+	Toy_initTokenBuffer(&whole, source);
+	Toy_tokenizeLexer(&whole, &lexer);
+
+	int starts[17];
+	int lines[17];
+	int count = Toy_splitTokenSource(source, true, chunks, starts, lines);
+
+	Toy_TokenBuffer joined;
+	Toy_initTokenBuffer(&joined, source);
+
+	for (int i = 0; i < count; i++) {
+		Toy_TokenBuffer part;
+		Toy_initTokenBuffer(&part, source);
+		Toy_tokenizeRange(&part, starts[i], starts[i + 1], lines[i], true);
+		Toy_appendTokenBuffer(&joined, &part);
+		Toy_freeTokenBuffer(&part);
+	}
+
+	int result = count;
+
+	if (joined.count != whole.count) {
+		fprintf(stderr, TOY_CC_ERROR "ERROR: Chunked token count is %d, expected %d\n" TOY_CC_RESET, joined.count, whole.count);
+		result = -1;
+	}
+
+	for (int i = 0; result >= 0 && i < whole.count; i++) {
+		Toy_Token expected = Toy_getTokenBuffer(&whole, i);
+		Toy_Token actual = Toy_getTokenBuffer(&joined, i);
+
+		if (expected.type != actual.type || expected.lexeme != actual.lexeme || expected.length != actual.length || expected.line != actual.line) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Chunked token %d doesn't match: %.*s\n" TOY_CC_RESET, i, expected.length, expected.lexeme);
+			result = -1;
+		}
+	}
+
+	Toy_freeTokenBuffer(&joined);
+	Toy_freeTokenBuffer(&whole);
+
+	return result;
+}
+
+int main() {
+	{
+		//test init & free
+		Toy_TokenBuffer buffer;
+		Toy_initTokenBuffer(&buffer, "print null;");
+		Toy_freeTokenBuffer(&buffer);
+	}
+
+	{
+		//test tokenizing, and reading past the end
+		const char* source = "var a = 42;\n\nprint a;";
+
+		Toy_Lexer lexer;
+		Toy_initLexer(&lexer, source);
+
+		Toy_TokenBuffer buffer;
+		Toy_initTokenBuffer(&buffer, source);
+		Toy_tokenizeLexer(&buffer, &lexer);
+
+		Toy_Token number = Toy_getTokenBuffer(&buffer, 3);
+		Toy_Token print = Toy_getTokenBuffer(&buffer, 5);
+		Toy_Token eof = Toy_getTokenBuffer(&buffer, 100);
+
+		if (buffer.count != 9 || number.type != TOY_TOKEN_LITERAL_INTEGER || strncmp(number.lexeme, "42", number.length) || print.line != 3 || eof.type != TOY_TOKEN_EOF || eof.line != 3) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Token buffer contents are wrong\n" TOY_CC_RESET);
+			Toy_freeTokenBuffer(&buffer);
+			return -1;
+		}
+
+		Toy_freeTokenBuffer(&buffer);
+	}
+
+	{
+		//test error tokens keep their messages
+		const char* source = "print 1 & 2; print $;";
+
+		Toy_Lexer lexer;
+		Toy_initLexer(&lexer, source);
+
+		Toy_TokenBuffer buffer;
+		Toy_initTokenBuffer(&buffer, source);
+		Toy_tokenizeLexer(&buffer, &lexer);
+
+		Toy_Token ampersand = Toy_getTokenBuffer(&buffer, 2);
+		Toy_Token dollar = Toy_getTokenBuffer(&buffer, 6);
+
+		if (ampersand.type != TOY_TOKEN_ERROR || strcmp(ampersand.lexeme, "Unexpected '&'") || dollar.type != TOY_TOKEN_ERROR || dollar.length != 1 || dollar.lexeme[0] != '$') {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Error tokens are wrong\n" TOY_CC_RESET);
+			Toy_freeTokenBuffer(&buffer);
+			return -1;
+		}
+
+		Toy_freeTokenBuffer(&buffer);
+	}
+
+	{
+		//test splitting skips strings, comments & nested statements
+		const char* source = "print \"a;b\\\";\";\n//c;d\n/* e;\nf; */fn g() { print 1; }\nfor (var i = 0; i < 1; i++) print i;\nprint 2 & 3;\n";
+
+		if (compareChunks(source, 16) != 5) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Source wasn't split at the top-level statements\n" TOY_CC_RESET);
+			return -1;
+		}
+	}
+
+	{
+		//test splitting a larger script, in several ways
+		size_t size = 0;
+		char* source = (char*)Toy_readFile("scripts/parser_sample_code.toy", &size);
+
+		for (int chunks = 1; chunks <= 16; chunks *= 2) {
+			if (compareChunks(source, chunks) < 0) {
+				TOY_FREE_ARRAY(char, source, size);
+				return -1;
+			}
+		}
+
+		TOY_FREE_ARRAY(char, source, size);
+	}
+
+	printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
+	return 0;
+}
@@ -0,0 +1,194 @@
+#include "toy_lexer.h"
+#include "toy_token_buffer.h"
+#include "toy_console_colors.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+//each file is scanned repeatedly, until at least this much time has passed
+#define MINIMUM_SECONDS 1.0
+
+#define MAX_THREADS 64
+
+static char* readFile(const char* path, size_t* fileSize) {
+	FILE* file = fopen(path, "rb");
+
+	if (file == NULL) {
+		fprintf(stderr, TOY_CC_ERROR "Could not open file \"%s\"\n" TOY_CC_RESET, path);
+		return NULL;
+	}
+
+	fseek(file, 0L, SEEK_END);
+	*fileSize = ftell(file);
+	rewind(file);
+
+	char* buffer = malloc(*fileSize + 1);
+
+	if (buffer == NULL || fread(buffer, sizeof(char), *fileSize, file) < *fileSize) {
+		fprintf(stderr, TOY_CC_ERROR "Could not read file \"%s\"\n" TOY_CC_RESET, path);
+		free(buffer);
+		fclose(file);
+		return NULL;
+	}
+
+	buffer[*fileSize] = '\0';
+	fclose(file);
+
+	return buffer;
+}
+
+//returns the number of tokens in the source, or -1 if there was an error token
+static long scanAll(const char* source) {
+	Toy_Lexer lexer;
+	Toy_initLexer(&lexer, source);
+
+	long count = 0;
+
+	for (;;) {
+		Toy_Token token = Toy_private_scanLexer(&lexer);
+
+		if (token.type == TOY_TOKEN_ERROR) {
+			return -1;
+		}
+
+		if (token.type == TOY_TOKEN_EOF) {
+			return count;
+		}
+
+		count++;
+	}
+}
+
+//split the source into chunks, and tokenize each on its own thread
+typedef struct {
+	Toy_TokenBuffer buffer;
+	int start;
+	int end;
+	int line;
+} Chunk;
+
+static void* tokenizeChunk(void* arg) {
+	Chunk* chunk = (Chunk*)arg;
+	Toy_tokenizeRange(&chunk->buffer, chunk->start, chunk->end, chunk->line, true);
+	return NULL;
+}
+
+static long scanParallel(const char* source, int threads) {
+	int starts[MAX_THREADS + 1];
+	int lines[MAX_THREADS + 1];
+	int count = Toy_splitTokenSource(source, true, threads, starts, lines);
+
+	Chunk chunks[MAX_THREADS];
+	pthread_t handles[MAX_THREADS];
+
+	for (int i = 0; i < count; i++) {
+		Toy_initTokenBuffer(&chunks[i].buffer, source);
+		chunks[i].start = starts[i];
+		chunks[i].end = starts[i + 1];
+		chunks[i].line = lines[i];
+		pthread_create(&handles[i], NULL, tokenizeChunk, &chunks[i]);
+	}
+
+	Toy_TokenBuffer tokens;
+	Toy_initTokenBuffer(&tokens, source);
+
+	for (int i = 0; i < count; i++) {
+		pthread_join(handles[i], NULL);
+		Toy_appendTokenBuffer(&tokens, &chunks[i].buffer);
+		Toy_freeTokenBuffer(&chunks[i].buffer);
+	}
+
+	//the EOF token is stored too
+	long result = tokens.count - 1;
+
+	for (int i = 0; i < tokens.count; i++) {
+		if (tokens.types[i] == TOY_TOKEN_ERROR) {
+			result = -1;
+		}
+	}
+
+	Toy_freeTokenBuffer(&tokens);
+
+	return result;
+}
+
+//wall clock time, as the threads run in parallel
+static double now() {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, const char* argv[]) {
+	int threads = 0;
+	int first = 1;
+
+	if (argc > 2 && !strcmp(argv[1], "-j")) {
+		threads = atoi(argv[2]);
+		first = 3;
+
+		if (threads < 1 || threads > MAX_THREADS) {
+			fprintf(stderr, TOY_CC_ERROR "Thread count must be between 1 and %d\n" TOY_CC_RESET, MAX_THREADS);
+			return -1;
+		}
+	}
+
+	if (argc <= first) {
+		fprintf(stderr, "Usage: %s [-j threads] file.toy [more files...]\n", argv[0]);
+		return -1;
+	}
+
+	long totalTokens = 0;
+	size_t totalBytes = 0;
+	double totalSeconds = 0;
+
+	for (int fileCounter = first; fileCounter < argc; fileCounter++) {
+		size_t size = 0;
+		char* source = readFile(argv[fileCounter], &size);
+
+		if (source == NULL) {
+			return -1;
+		}
+
+		long tokens = threads > 0 ? scanParallel(source, threads) : scanAll(source);
+
+		if (tokens < 0) {
+			fprintf(stderr, TOY_CC_ERROR "Lexer error in \"%s\"\n" TOY_CC_RESET, argv[fileCounter]);
+			free(source);
+			return -1;
+		}
+
+		//repeat the scan until the timing is meaningful
+		long passes = 0;
+		double seconds = 0;
+		double start = now();
+
+		do {
+			if (threads > 0) {
+				scanParallel(source, threads);
+			}
+			else {
+				scanAll(source);
+			}
+			passes++;
+			seconds = now() - start;
+		} while (seconds < MINIMUM_SECONDS);
+
+		printf("%s:\n\t%ld tokens, %ld bytes, %ld passes\n\t%.0f tokens/sec\n\t%.2f MB/sec\n", argv[fileCounter], tokens, (long)size, passes, tokens * passes / seconds, size * passes / seconds / (1024 * 1024));
+
+		totalTokens += tokens * passes;
+		totalBytes += size * passes;
+		totalSeconds += seconds;
+
+		free(source);
+	}
+
+	if (argc - first > 1) {
+		printf("Total:\n\t%.0f tokens/sec\n\t%.2f MB/sec\n", totalTokens / totalSeconds, totalBytes / totalSeconds / (1024 * 1024));
+	}
+
+	return 0;
+}
@@ -0,0 +1,628 @@
+#include "toy_common.h"
+#include "toy_opcodes.h"
+#include "toy_opcode_profile.h"
+#include "toy_interpreter.h"
+#include "toy_instructions.h"
+#include "toy_console_colors.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//translates a compiled .tb module into C, with each body's dispatch loop unrolled into direct calls to the named instructions, their operands written in as constants
+//the bytecode is embedded too, as the literals and function bodies are still read from it at runtime
+
+typedef struct Module {
+	const unsigned char* bytecode;
+	int length;
+	FILE* out;
+	int* labels; //scratch space, indexed by offset within a body
+	int* depths;
+	int* bodies; //the offsets of the bodies written so far
+	int bodyCount;
+	int bodyCapacity;
+} Module;
+
+static unsigned char* readFile(const char* path, int* fileSize) {
+	FILE* file = fopen(path, "rb");
+
+	if (file == NULL) {
+		fprintf(stderr, TOY_CC_ERROR "Could not open file \"%s\"\n" TOY_CC_RESET, path);
+		return NULL;
+	}
+
+	fseek(file, 0L, SEEK_END);
+	*fileSize = (int)ftell(file);
+	rewind(file);
+
+	unsigned char* buffer = malloc(*fileSize + 1);
+
+	if (buffer == NULL || fread(buffer, sizeof(unsigned char), *fileSize, file) < (size_t)*fileSize) {
+		fprintf(stderr, TOY_CC_ERROR "Could not read file \"%s\"\n" TOY_CC_RESET, path);
+		free(buffer);
+		fclose(file);
+		return NULL;
+	}
+
+	fclose(file);
+
+	return buffer;
+}
+
+static int readInt(const unsigned char* bytes) {
+	int value = 0;
+	memcpy(&value, bytes, sizeof(int));
+	return value;
+}
+
+static int readIndex(const unsigned char* bytes, int width) {
+	switch(width) {
+		case 1:
+			return bytes[0];
+
+		case 2: {
+			unsigned short value = 0;
+			memcpy(&value, bytes, sizeof(unsigned short));
+			return value;
+		}
+
+		default:
+			return readInt(bytes);
+	}
+}
+
+//check every jump lands on an instruction within the same grouping, and find the ones that are landed on
+static bool scanBody(Module* module, int base, int start, int end) {
+	int length = end - base;
+
+	for (int i = 0; i <= length; i++) {
+		module->labels[i] = 0;
+		module->depths[i] = -1;
+	}
+
+	int count = start;
+	int depth = 0;
+
+	//the targets are checked once every instruction is known
+	int* targets = malloc(sizeof(int) * (length + 1) * 2);
+	int targetCount = 0;
+
+	while (count < end) {
+		const unsigned char opcode = module->bytecode[count];
+		module->depths[count - base] = depth;
+
+		Toy_InstructionFn handler = NULL;
+		int argument = 0;
+		int operands = Toy_lookupInstruction(opcode, &handler, &argument);
+
+		if (operands < 0 || opcode == TOY_OP_EOF || opcode == TOY_OP_SECTION_END) {
+			if (operands >= 0 && depth != 0) {
+				free(targets);
+				return false;
+			}
+			break;
+		}
+
+		switch(opcode) {
+			case TOY_OP_GROUPING_BEGIN:
+				depth++;
+			break;
+
+			case TOY_OP_GROUPING_END:
+				depth = depth > 0 ? depth - 1 : 0;
+			break;
+
+			case TOY_OP_JUMP:
+			case TOY_OP_JUMP_WIDE:
+				targets[targetCount++] = readIndex(module->bytecode + count + 1, operands) + start - base;
+				targets[targetCount++] = depth;
+			break;
+
+			case TOY_OP_IF_FALSE_JUMP:
+			case TOY_OP_IF_FALSE_JUMP_WIDE:
+			case TOY_OP_COMPARE_JUMP:
+			case TOY_OP_COMPARE_JUMP_WIDE:
+				targets[targetCount++] = readIndex(module->bytecode + count + 1, argument) + start - base;
+				targets[targetCount++] = depth;
+			break;
+		}
+
+		count += 1 + operands;
+	}
+
+	//falling off the end finishes the body
+	if (count >= end) {
+		module->depths[length] = depth;
+	}
+
+	bool valid = true;
+
+	for (int i = 0; i < targetCount && valid; i += 2) {
+		if (targets[i] < 0 || targets[i] > length || module->depths[targets[i]] != targets[i + 1]) {
+			valid = false;
+		}
+		else {
+			module->labels[targets[i]] = 1;
+		}
+	}
+
+	free(targets);
+	return valid;
+}
+
+//the call to the named instruction, with the operands decoded - returns false if there isn't one
+static bool writeInstruction(char* call, size_t size, unsigned char opcode, const unsigned char* operands, int argument) {
+	switch(opcode) {
+		case TOY_OP_ASSERT:
+			snprintf(call, size, "Toy_instAssert(interpreter)");
+			return true;
+
+		case TOY_OP_PRINT:
+			snprintf(call, size, "Toy_instPrint(interpreter)");
+			return true;
+
+		case TOY_OP_LITERAL:
+		case TOY_OP_LITERAL_LONG:
+		case TOY_OP_LITERAL_WIDE:
+			snprintf(call, size, "Toy_instPushLiteral(interpreter, %d)", readIndex(operands, argument));
+			return true;
+
+		case TOY_OP_LITERAL_PAIR:
+			snprintf(call, size, "Toy_instPushLiteral(interpreter, %d) && Toy_instPushLiteral(interpreter, %d)", operands[0], operands[1]);
+			return true;
+
+		case TOY_OP_LITERAL_RAW:
+			snprintf(call, size, "Toy_instRawLiteral(interpreter)");
+			return true;
+
+		case TOY_OP_NEGATE:
+			snprintf(call, size, "Toy_instNegate(interpreter)");
+			return true;
+
+		case TOY_OP_ADDITION:
+		case TOY_OP_SUBTRACTION:
+		case TOY_OP_MULTIPLICATION:
+		case TOY_OP_DIVISION:
+		case TOY_OP_MODULO:
+			snprintf(call, size, "Toy_instArithmetic(interpreter, (Toy_Opcode)%d)", opcode);
+			return true;
+
+		case TOY_OP_VAR_ADDITION_ASSIGN:
+		case TOY_OP_VAR_SUBTRACTION_ASSIGN:
+		case TOY_OP_VAR_MULTIPLICATION_ASSIGN:
+		case TOY_OP_VAR_DIVISION_ASSIGN:
+		case TOY_OP_VAR_MODULO_ASSIGN:
+			snprintf(call, size, "Toy_instCompoundAssign(interpreter, (Toy_Opcode)%d)", opcode);
+			return true;
+
+		case TOY_OP_VAR_ARITHMETIC_ASSIGN:
+			snprintf(call, size, "Toy_instArithmeticAssignLiterals(interpreter, (Toy_Opcode)%d, %d, %d, %d)", operands[0], operands[1], operands[2], operands[3]);
+			return true;
+
+		case TOY_OP_ADDITION_INT:
+		case TOY_OP_SUBTRACTION_INT:
+		case TOY_OP_MULTIPLICATION_INT:
+		case TOY_OP_DIVISION_INT:
+		case TOY_OP_MODULO_INT:
+			snprintf(call, size, "Toy_instArithmeticInt(interpreter, (Toy_Opcode)%d)", opcode);
+			return true;
+
+		case TOY_OP_ADDITION_FLOAT:
+		case TOY_OP_SUBTRACTION_FLOAT:
+		case TOY_OP_MULTIPLICATION_FLOAT:
+		case TOY_OP_DIVISION_FLOAT:
+			snprintf(call, size, "Toy_instArithmeticFloat(interpreter, (Toy_Opcode)%d)", opcode);
+			return true;
+
+		case TOY_OP_COMPARE_LESS_INT:
+		case TOY_OP_COMPARE_LESS_EQUAL_INT:
+		case TOY_OP_COMPARE_GREATER_INT:
+		case TOY_OP_COMPARE_GREATER_EQUAL_INT:
+			snprintf(call, size, "Toy_instCompareInt(interpreter, (Toy_Opcode)%d)", opcode);
+			return true;
+
+		case TOY_OP_SCOPE_BEGIN:
+			snprintf(call, size, "Toy_instPushScope(interpreter)");
+			return true;
+
+		case TOY_OP_SCOPE_END:
+			snprintf(call, size, "Toy_instPopScope(interpreter)");
+			return true;
+
+		case TOY_OP_VAR_DECL:
+		case TOY_OP_VAR_DECL_LONG:
+		case TOY_OP_VAR_DECL_WIDE:
+			snprintf(call, size, "Toy_instVarDecl(interpreter, %d, %d)", readIndex(operands, argument), readIndex(operands + argument, argument));
+			return true;
+
+		case TOY_OP_FN_DECL:
+		case TOY_OP_FN_DECL_LONG:
+		case TOY_OP_FN_DECL_WIDE:
+			snprintf(call, size, "Toy_instFnDecl(interpreter, %d, %d)", readIndex(operands, argument), readIndex(operands + argument, argument));
+			return true;
+
+		case TOY_OP_VAR_ASSIGN:
+			snprintf(call, size, "Toy_instVarAssign(interpreter)");
+			return true;
+
+		case TOY_OP_TYPE_CAST:
+			snprintf(call, size, "Toy_instTypeCast(interpreter)");
+			return true;
+
+		case TOY_OP_TYPE_OF:
+			snprintf(call, size, "Toy_instTypeOf(interpreter)");
+			return true;
+
+		case TOY_OP_COMPARE_EQUAL:
+		case TOY_OP_COMPARE_NOT_EQUAL:
+			snprintf(call, size, "Toy_instCompareEqual(interpreter, %s)", argument ? "true" : "false");
+			return true;
+
+		case TOY_OP_COMPARE_LESS:
+		case TOY_OP_COMPARE_GREATER:
+			snprintf(call, size, "Toy_instCompareLess(interpreter, %s)", argument ? "true" : "false");
+			return true;
+
+		case TOY_OP_COMPARE_LESS_EQUAL:
+		case TOY_OP_COMPARE_GREATER_EQUAL:
+			snprintf(call, size, "Toy_instCompareLessEqual(interpreter, %s)", argument ? "true" : "false");
+			return true;
+
+		case TOY_OP_INVERT:
+			snprintf(call, size, "Toy_instInvert(interpreter)");
+			return true;
+
+		case TOY_OP_AND:
+			snprintf(call, size, "Toy_instAnd(interpreter)");
+			return true;
+
+		case TOY_OP_OR:
+			snprintf(call, size, "Toy_instOr(interpreter)");
+			return true;
+
+		case TOY_OP_IF_FALSE_JUMP:
+		case TOY_OP_IF_FALSE_JUMP_WIDE:
+			snprintf(call, size, "Toy_instFalseJump(interpreter, %d)", readIndex(operands, argument));
+			return true;
+
+		case TOY_OP_COMPARE_JUMP:
+		case TOY_OP_COMPARE_JUMP_WIDE:
+			snprintf(call, size, "Toy_instCompareJump(interpreter, %d, (Toy_Opcode)%d)", readIndex(operands, argument), operands[argument]);
+			return true;
+
+		case TOY_OP_FN_CALL:
+		case TOY_OP_DOT:
+			snprintf(call, size, "Toy_instFnCall(interpreter, %s)", argument ? "true" : "false");
+			return true;
+
+		case TOY_OP_TAIL_CALL:
+			snprintf(call, size, "Toy_instTailCall(interpreter)");
+			return true;
+
+		case TOY_OP_BUILTIN:
+			snprintf(call, size, "Toy_instBuiltin(interpreter, %d, %d)", operands[0], readIndex(operands + 1, 2));
+			return true;
+
+		case TOY_OP_FN_RETURN:
+			snprintf(call, size, "Toy_instFnReturn(interpreter)");
+			return true;
+
+		case TOY_OP_INDEX:
+			snprintf(call, size, "Toy_instIndex(interpreter)");
+			return true;
+
+		case TOY_OP_INDEX_GET:
+			snprintf(call, size, "Toy_instIndexGet(interpreter)");
+			return true;
+
+		case TOY_OP_INDEX_SET:
+			snprintf(call, size, "Toy_instIndexSet(interpreter, (Toy_Opcode)%d)", operands[0]);
+			return true;
+
+		case TOY_OP_POP_STACK:
+			snprintf(call, size, "Toy_instPopStack(interpreter)");
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+//offsets written into the code are relative to the body, as the runtime reads each function from it's own start
+static void writeBody(Module* module, int key, int base, int start, int end) {
+	FILE* out = module->out;
+	int length = end - base;
+	int count = start;
+	int depth = 0;
+	int levels = 0; //the deepest exit used
+	bool finished = false;
+
+	fprintf(out, "static void body_%d(Toy_Interpreter* interpreter) {\n", key);
+
+	while (!finished && count < end) {
+		const int at = count - base;
+		const unsigned char opcode = module->bytecode[count];
+
+		if (module->labels[at]) {
+			fprintf(out, "label_%d:\n", at);
+		}
+
+		Toy_InstructionFn handler = NULL;
+		int argument = 0;
+		int operands = Toy_lookupInstruction(opcode, &handler, &argument);
+
+		//the interpreter reports unknown opcodes, and nothing after this can be read
+		if (operands < 0) {
+			fprintf(out, "\tinterpreter->count = %d; goto exit_%d; //unknown opcode %d\n", at, depth + 1, opcode);
+			levels = depth + 1 > levels ? depth + 1 : levels;
+			break;
+		}
+
+		char call[256];
+		bool named = handler != NULL && writeInstruction(call, sizeof(call), opcode, module->bytecode + count + 1, argument);
+
+		switch(opcode) {
+			case TOY_OP_PASS:
+				//DO NOTHING
+			break;
+
+			case TOY_OP_GROUPING_BEGIN:
+				depth++;
+			break;
+
+			case TOY_OP_GROUPING_END:
+				if (depth == 0) {
+					fprintf(out, "\treturn;\n");
+				}
+				else {
+					depth--;
+				}
+			break;
+
+			case TOY_OP_JUMP:
+			case TOY_OP_JUMP_WIDE:
+				fprintf(out, "\tgoto label_%d;\n", readIndex(module->bytecode + count + 1, operands) + start - base);
+			break;
+
+			case TOY_OP_IF_FALSE_JUMP:
+			case TOY_OP_IF_FALSE_JUMP_WIDE:
+			case TOY_OP_COMPARE_JUMP:
+			case TOY_OP_COMPARE_JUMP_WIDE:
+				fprintf(out, "\tSTEP(%d, %s, exit_%d); //%s\n", at + 1 + operands, call, depth, Toy_getOpcodeName(opcode));
+				fprintf(out, "\tif (interpreter->count != %d) goto label_%d;\n", at + 1 + operands, readIndex(module->bytecode + count + 1, argument) + start - base);
+			break;
+
+			case TOY_OP_EOF:
+			case TOY_OP_SECTION_END:
+				fprintf(out, "\treturn;\n");
+				finished = true;
+			break;
+
+			default:
+				if (named) {
+					fprintf(out, "\tSTEP(%d, %s, exit_%d); //%s\n", at + 1 + operands, call, depth, Toy_getOpcodeName(opcode));
+				}
+				else {
+					//hand the rest of the body to the interpreter, starting with this instruction
+					fprintf(out, "\tinterpreter->count = %d; goto exit_%d; //%s\n", at, depth + 1, Toy_getOpcodeName(opcode));
+					levels = depth + 1 > levels ? depth + 1 : levels;
+				}
+			break;
+		}
+
+		levels = depth > levels ? depth : levels;
+		count += 1 + operands;
+	}
+
+	if (!finished) {
+		if (module->labels[length]) {
+			fprintf(out, "label_%d:\n", length);
+		}
+		fprintf(out, "\treturn;\n");
+	}
+
+	//each exit resumes a number of groupings in the interpreter
+	for (int i = 0; i <= levels; i++) {
+		fprintf(out, "exit_%d:\n", i);
+		if (i > 0) {
+			fprintf(out, "\tToy_resumeInterpreter(interpreter, %d);\n", i);
+		}
+		fprintf(out, "\treturn;\n");
+	}
+
+	fprintf(out, "}\n\n");
+}
+
+static void addBody(Module* module, int base) {
+	if (module->bodyCount + 1 > module->bodyCapacity) {
+		module->bodyCapacity = module->bodyCapacity < 8 ? 8 : module->bodyCapacity * 2;
+		module->bodies = realloc(module->bodies, sizeof(int) * module->bodyCapacity);
+	}
+
+	module->bodies[module->bodyCount++] = base;
+}
+
+//each body has the same layout - a section table, literals, function index, nested function bodies, then the code
+static bool translateBody(Module* module, int base, int length, bool isFunction) {
+	int count = base;
+
+	//skip the header
+	if (!isFunction) {
+		count += 3;
+		while (count < base + length && module->bytecode[count] != '\0') {
+			count++;
+		}
+		count += 2; //the terminator, then the end of the header section
+	}
+
+	while ((count - base) % TOY_SECTION_ALIGNMENT != 0) {
+		count++;
+	}
+
+	int sectionOffsets[TOY_SECTION_COUNT];
+	int sectionSizes[TOY_SECTION_COUNT];
+
+	for (int i = 0; i < TOY_SECTION_COUNT; i++) {
+		if (count + 8 > base + length) {
+			return false;
+		}
+
+		sectionOffsets[i] = readInt(module->bytecode + count);
+		sectionSizes[i] = readInt(module->bytecode + count + 4);
+		count += 8;
+
+		if (sectionOffsets[i] < 0 || sectionSizes[i] < 0 || sectionOffsets[i] + sectionSizes[i] > length) {
+			return false;
+		}
+	}
+
+	//nested functions come first, so the table ends up sorted by offset
+	for (int i = 0; i < sectionSizes[TOY_SECTION_FUNCTION_INDEX] / 8; i++) {
+		int entry = base + sectionOffsets[TOY_SECTION_FUNCTION_INDEX] + i * 8;
+		int offset = readInt(module->bytecode + entry);
+		int size = readInt(module->bytecode + entry + 4);
+
+		if (offset < 0 || size <= 0 || offset + size > length || !translateBody(module, base + offset, size, true)) {
+			return false;
+		}
+	}
+
+	//functions start with their parameter & return literals
+	int start = base + sectionOffsets[TOY_SECTION_CODE] + (isFunction ? 4 : 0);
+	int end = base + sectionOffsets[TOY_SECTION_CODE] + sectionSizes[TOY_SECTION_CODE];
+
+	//bodies that can't be translated are left to the interpreter
+	if (!scanBody(module, base, start, end)) {
+		fprintf(stderr, TOY_CC_WARN "Leaving the body at %d to the interpreter\n" TOY_CC_RESET, base);
+		return true;
+	}
+
+	//the main body is found by where it's code begins
+	int key = isFunction ? base : start;
+
+	writeBody(module, key, base, start, end);
+	addBody(module, key);
+	return true;
+}
+
+static int compareBodies(const void* lhs, const void* rhs) {
+	return *(const int*)lhs - *(const int*)rhs;
+}
+
+int main(int argc, const char* argv[]) {
+	const char* infile = NULL;
+	const char* outfile = "out.c";
+	const char* name = "toy_module";
+	bool withMain = false;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+			outfile = argv[++i];
+		}
+		else if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+			name = argv[++i];
+		}
+		else if (!strcmp(argv[i], "-m")) {
+			withMain = true;
+		}
+		else if (infile == NULL) {
+			infile = argv[i];
+		}
+		else {
+			infile = NULL;
+			break;
+		}
+	}
+
+	if (infile == NULL) {
+		fprintf(stderr, "Usage: %s file.tb [-o out.c] [-n name] [-m]\n\n", argv[0]);
+		fprintf(stderr, "  -o outfile\tName of the C file to write (default: out.c).\n");
+		fprintf(stderr, "  -n name\tThe module is run with void name_run(Toy_Interpreter*) (default: toy_module).\n");
+		fprintf(stderr, "  -m\t\tAlso write a main() that runs the module.\n");
+		return -1;
+	}
+
+	Module module;
+	module.bytecode = readFile(infile, &module.length);
+
+	if (module.bytecode == NULL) {
+		return -1;
+	}
+
+	if (module.length < 4 || module.bytecode[0] != TOY_VERSION_MAJOR || module.bytecode[1] != TOY_VERSION_MINOR) {
+		fprintf(stderr, TOY_CC_ERROR "\"%s\" wasn't compiled by Toy %d.%d\n" TOY_CC_RESET, infile, TOY_VERSION_MAJOR, TOY_VERSION_MINOR);
+		free((void*)module.bytecode);
+		return -1;
+	}
+
+	module.out = fopen(outfile, "w");
+
+	if (module.out == NULL) {
+		fprintf(stderr, TOY_CC_ERROR "Could not open file \"%s\"\n" TOY_CC_RESET, outfile);
+		free((void*)module.bytecode);
+		return -1;
+	}
+
+	module.labels = malloc(sizeof(int) * (module.length + 1));
+	module.depths = malloc(sizeof(int) * (module.length + 1));
+	module.bodies = NULL;
+	module.bodyCount = 0;
+	module.bodyCapacity = 0;
+
+	FILE* out = module.out;
+
+	fprintf(out, "//generated by toy2c from %s - link against libtoy, and call %s_run() instead of running the bytecode\n", infile, name);
+	fprintf(out, "#include \"toy_interpreter.h\"\n");
+	fprintf(out, "#include \"toy_instructions.h\"\n\n");
+
+	fprintf(out, "static const unsigned char bytecode[%d] = {", module.length);
+	for (int i = 0; i < module.length; i++) {
+		fprintf(out, "%s%d,", i % 24 == 0 ? "\n\t" : "", module.bytecode[i]);
+	}
+	fprintf(out, "\n};\n\n");
+
+	fprintf(out, "//count is left after the operands, where the interpreter resumes from if the instruction fails\n");
+	fprintf(out, "#define STEP(position, call, failure) interpreter->count = (position); if (!(call)) goto failure; if (interpreter->panic) return;\n\n");
+
+	bool success = translateBody(&module, 0, module.length, false);
+
+	if (success) {
+		qsort(module.bodies, module.bodyCount, sizeof(int), compareBodies);
+
+		fprintf(out, "static const Toy_CompiledBody bodies[%d] = {\n", module.bodyCount > 0 ? module.bodyCount : 1);
+		for (int i = 0; i < module.bodyCount; i++) {
+			fprintf(out, "\t{ %d, body_%d },\n", module.bodies[i], module.bodies[i]);
+		}
+		fprintf(out, "};\n\n");
+
+		fprintf(out, "void %s_run(Toy_Interpreter* interpreter) {\n", name);
+		fprintf(out, "\tToy_RefBytecode* source = Toy_createRefBytecode(bytecode, sizeof(bytecode), NULL);\n");
+		fprintf(out, "\tsource->compiled = bodies;\n");
+		fprintf(out, "\tsource->compiledCount = %d;\n", module.bodyCount);
+		fprintf(out, "\tToy_runInterpreterShared(interpreter, source);\n");
+		fprintf(out, "\tToy_deleteRefBytecode(source);\n");
+		fprintf(out, "}\n");
+
+		if (withMain) {
+			fprintf(out, "\nint main() {\n");
+			fprintf(out, "\tToy_Interpreter interpreter;\n");
+			fprintf(out, "\tToy_initInterpreter(&interpreter);\n");
+			fprintf(out, "\t%s_run(&interpreter);\n", name);
+			fprintf(out, "\tToy_freeInterpreter(&interpreter);\n");
+			fprintf(out, "\treturn 0;\n");
+			fprintf(out, "}\n");
+		}
+	}
+	else {
+		fprintf(stderr, TOY_CC_ERROR "Malformed bytecode in \"%s\"\n" TOY_CC_RESET, infile);
+	}
+
+	fclose(out);
+
+	free(module.bodies);
+	free(module.depths);
+	free(module.labels);
+	free((void*)module.bytecode);
+
+	return success ? 0 : -1;
+}